@@ -63,6 +63,9 @@ static AOCSScanDesc aocs_beginscan_internal(Relation relation,
 						bool *proj,
 						AOCSProjectionKind projKind,
 						uint32 flags);
+static void aocs_batch_free(AOCSBatch batch);
+static inline void aocs_batch_reset(AOCSBatch batch);
+static bool aocs_batch_seg_has_missing(AOCSScanDesc scan, int segno);
 /*
  * Open the segment file for a specified column associated with the datum
  * stream.
@@ -291,6 +294,18 @@ close_ds_read(DatumStreamRead **ds, AttrNumber natts)
 	}
 }
 
+static void
+add_ds_read_stats(DatumStreamRead **ds, AttrNumber natts,
+				  int64 *prefetchBytes, instr_time *stallTime)
+{
+	for (AttrNumber attno = 0; attno < natts; attno++)
+	{
+		if (ds[attno])
+			BufferedReadAddStats(&ds[attno]->ao_read.bufferedRead,
+								 prefetchBytes, stallTime);
+	}
+}
+
 static void
 close_ds_write(DatumStreamWrite **ds, int nvp)
 {
@@ -478,6 +493,21 @@ open_next_scan_seg(AOCSScanDesc scan)
 
 				open_all_datumstreamread_segfiles(scan, curSegInfo);
 
+				/*
+				 * Load the ranges of rows the zone maps rule out.  We don't
+				 * bother in segfiles with missing values.
+				 */
+				scan->zonemapNextRow = InvalidAORowNum;
+				if (scan->zonemapFilter)
+				{
+					if (aocs_batch_seg_has_missing(scan, curSegInfo->segno))
+						appendonly_zonemap_filter_clear(scan->zonemapFilter);
+					else
+						appendonly_zonemap_filter_load(scan->zonemapFilter,
+													   scan->appendOnlyMetaDataSnapshot,
+													   curSegInfo->segno);
+				}
+
 				return scan->cur_seg;
 			}
 		}
@@ -531,6 +561,59 @@ close_cur_scan_seg(AOCSScanDesc scan)
 		AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
 }
 
+/*
+ * Close the current segfile of a sequential scan, if any, and open the next
+ * one with rows in it.
+ *
+ * Returns false, with cur_seg reset, if there are no more.
+ */
+static bool
+advance_scan_seg(AOCSScanDesc scan)
+{
+	close_cur_scan_seg(scan);
+	if (open_next_scan_seg(scan) < 0)
+	{
+		/* No more seg, we are at the end */
+		scan->cur_seg = -1;
+		return false;
+	}
+	scan->segrowsprocessed = 0;
+	return true;
+}
+
+/*
+ * If the zone maps rule out the rows from scan->zonemapNextRow on, up to
+ * some row, move every projected column past them, without reading the
+ * blocks in between.
+ *
+ * Returns false if that took us past the end of the segfile.
+ */
+static bool
+aocs_zonemap_skip(AOCSScanDesc scan)
+{
+	int64		skipto;
+
+	if (scan->zonemapNextRow == InvalidAORowNum)
+		return true;
+
+	skipto = appendonly_zonemap_filter_skip(scan->zonemapFilter, scan->zonemapNextRow);
+	if (skipto == scan->zonemapNextRow)
+		return true;
+
+	for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+	{
+		AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+		if (!datumstreamread_skip_to(scan->columnScanInfo.ds[attno], skipto))
+			return false;
+
+		AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
+	}
+
+	scan->zonemapNextRow = skipto;
+	return true;
+}
+
 static void
 aocs_blkdirscan_init(AOCSScanDesc scan)
 {
@@ -757,9 +840,17 @@ aocs_beginscan_internal(Relation relation,
 void
 aocs_rescan(AOCSScanDesc scan)
 {
+	if (scan->batch)
+		aocs_batch_reset(scan->batch);
+
 	close_cur_scan_seg(scan);
 	if (scan->columnScanInfo.ds)
+	{
+		add_ds_read_stats(scan->columnScanInfo.ds,
+						  scan->columnScanInfo.relationTupleDesc->natts,
+						  &scan->prefetchBytes, &scan->stallTime);
 		close_ds_read(scan->columnScanInfo.ds, scan->columnScanInfo.relationTupleDesc->natts);
+	}
 	initscan_with_colinfo(scan);
 
 
@@ -796,6 +887,10 @@ aocs_positionscan(AOCSScanDesc scan,
 	Assert(colIdx >= 0 && colIdx < scan->columnScanInfo.num_proj_atts);
 	Assert(dirEntry);
 
+	/* Rows decoded ahead belong to the old position */
+	if (scan->batch)
+		aocs_batch_reset(scan->batch);
+
 	if (colIdx == 0)
 	{
 		if (scan->columnScanInfo.relationTupleDesc == NULL)
@@ -832,11 +927,41 @@ aocs_positionscan(AOCSScanDesc scan,
 	return true;
 }
 
+/*
+ * aocs_read_stats
+ *
+ * Return the bytes the scan prefetched and the time it stalled in reads,
+ * over all the columns it reads and across its rescans.
+ */
+void
+aocs_read_stats(AOCSScanDesc scan, int64 *prefetchBytes, instr_time *stallTime)
+{
+	*prefetchBytes = scan->prefetchBytes;
+	*stallTime = scan->stallTime;
+
+	if (scan->columnScanInfo.ds)
+		add_ds_read_stats(scan->columnScanInfo.ds,
+						  scan->columnScanInfo.relationTupleDesc->natts,
+						  prefetchBytes, stallTime);
+}
+
 void
 aocs_endscan(AOCSScanDesc scan)
 {
 	close_cur_scan_seg(scan);
 
+	if (scan->batch)
+	{
+		aocs_batch_free(scan->batch);
+		scan->batch = NULL;
+	}
+
+	if (scan->zonemapFilter)
+	{
+		appendonly_zonemap_filter_free(scan->zonemapFilter);
+		scan->zonemapFilter = NULL;
+	}
+
 	if (scan->columnScanInfo.ds)
 	{
 		Assert(scan->columnScanInfo.proj_atts);
@@ -1439,6 +1564,34 @@ aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
 	natts = slot->tts_tupleDescriptor->natts;
 	Assert(natts <= scan->columnScanInfo.relationTupleDesc->natts);
 
+	/* Hand out the next row of the current batch, decoding a new one as needed */
+	if (scan->batch != NULL)
+	{
+		AOCSBatch	batch = scan->batch;
+		int			r;
+
+		if (batch->nextrow >= batch->nrows &&
+			aocs_getnext_batch(scan, batch) == 0)
+		{
+			ExecClearTuple(slot);
+			return false;
+		}
+
+		r = batch->nextrow++;
+		for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+		{
+			AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+			d[attno] = batch->values[attno][r];
+			null[attno] = batch->isnull[attno][r];
+		}
+
+		scan->cdb_fake_ctid = batch->tids[r];
+		slot->tts_nvalid = natts;
+		slot->tts_tid = scan->cdb_fake_ctid;
+		return true;
+	}
+
 	while (1)
 	{
 		AOCSFileSegInfo *curseginfo;
@@ -1454,15 +1607,12 @@ ReadNext:
 			if (scan->columnScanInfo.num_proj_atts == 0)
 				return false;
 
-			err = open_next_scan_seg(scan);
-			if (err < 0)
+			if (!advance_scan_seg(scan))
 			{
-				/* No more seg, we are at the end */
 				ExecClearTuple(slot);
-				scan->cur_seg = -1;
 				return false;
 			}
-			scan->segrowsprocessed = 0;
+			err = 0;
 		}
 
 		/* We shouldn't have a 0-column projection as we should've bailed out above */
@@ -1471,6 +1621,12 @@ ReadNext:
 		Assert(scan->cur_seg >= 0);
 		curseginfo = scan->seginfo[scan->cur_seg];
 
+		if (scan->zonemapFilter && !aocs_zonemap_skip(scan))
+		{
+			err = -1;
+			goto ReadNext;
+		}
+
 		/* Read from cur_seg */
 		for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
 		{
@@ -1511,7 +1667,6 @@ ReadNext:
 					/*
 					 * Ha, cannot read next block, we need to go to next seg
 					 */
-					close_cur_scan_seg(scan);
 					goto ReadNext;
 				}
 
@@ -1550,6 +1705,20 @@ ReadNext:
 #endif
 		}
 
+		/*
+		 * If the zone maps rule out this row, skip it, and the rest of the
+		 * range it is in.
+		 */
+		if (scan->zonemapFilter && rowNum != InvalidAORowNum)
+		{
+			scan->zonemapNextRow = rowNum + 1;
+			if (appendonly_zonemap_filter_skip(scan->zonemapFilter, rowNum) != rowNum)
+			{
+				rowNum = InvalidAORowNum;
+				goto ReadNext;
+			}
+		}
+
 		scan->segrowsprocessed++;
 		if (rowNum == InvalidAORowNum)
 		{
@@ -1578,6 +1747,346 @@ ReadNext:
 }
 
 
+/*
+ * Number of rows left to read in the current block of a column.
+ */
+static inline int
+aocs_batch_rows_in_block(DatumStreamRead *ds)
+{
+	if (ds->largeObjectState == DatumStreamLargeObjectState_None)
+		return ds->blockRead.logical_row_count - (ds->blockRead.nth + 1);
+
+	/* A large object is a single datum, possibly spanning several blocks */
+	return (ds->largeObjectState == DatumStreamLargeObjectState_HaveAoContent) ? 1 : 0;
+}
+
+/*
+ * Read the next block of column 'attno' in the current segfile.
+ *
+ * Returns false if there are no more blocks.
+ */
+static bool
+aocs_batch_read_block(AOCSScanDesc scan, AttrNumber attno)
+{
+	if (datumstreamread_block(scan->columnScanInfo.ds[attno],
+							  scan->blockDirectory, attno) < 0)
+		return false;
+
+	AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
+	pgstat_count_buffer_read_ao(scan->rs_base.rs_rd,
+								RelationGuessNumberOfBlocksFromSize(scan->totalBytesRead));
+	return true;
+}
+
+/*
+ * Does any projected column, other than the anchor, have missing values in
+ * the given segfile, due to a missing-mode ADD COLUMN?
+ */
+static bool
+aocs_batch_seg_has_missing(AOCSScanDesc scan, int segno)
+{
+	for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+	{
+		AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+		if (i == ANCHOR_COL_IN_PROJ)
+			continue;
+		if (scan->columnScanInfo.attnum_to_rownum[attno * MAX_AOREL_CONCURRENCY + segno] > 0)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * aocs_batch_create
+ *
+ * Create an empty batch for aocs_getnext_batch(). The column vectors are
+ * allocated on first use, once the projection of the scan is known.
+ */
+AOCSBatch
+aocs_batch_create(AOCSScanDesc scan, int maxrows)
+{
+	MemoryContext oldCtx;
+	AOCSBatch	batch;
+
+	Assert(maxrows > 0);
+
+	oldCtx = MemoryContextSwitchTo(scan->columnScanInfo.scanCtx);
+
+	batch = (AOCSBatch) palloc0(sizeof(AOCSBatchData));
+	batch->maxrows = maxrows;
+	batch->tids = (ItemPointerData *) palloc(maxrows * sizeof(ItemPointerData));
+	batch->rownums = (int64 *) palloc(maxrows * sizeof(int64));
+
+	MemoryContextSwitchTo(oldCtx);
+
+	return batch;
+}
+
+static void
+aocs_batch_alloc_vectors(AOCSScanDesc scan, AOCSBatch batch)
+{
+	MemoryContext oldCtx;
+	AttrNumber	natts = scan->columnScanInfo.relationTupleDesc->natts;
+
+	oldCtx = MemoryContextSwitchTo(scan->columnScanInfo.scanCtx);
+
+	batch->natts = natts;
+	batch->values = (Datum **) palloc0(natts * sizeof(Datum *));
+	batch->isnull = (bool **) palloc0(natts * sizeof(bool *));
+	for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+	{
+		AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+		batch->values[attno] = (Datum *) palloc(batch->maxrows * sizeof(Datum));
+		batch->isnull[attno] = (bool *) palloc(batch->maxrows * sizeof(bool));
+	}
+
+	MemoryContextSwitchTo(oldCtx);
+}
+
+static void
+aocs_batch_free(AOCSBatch batch)
+{
+	if (batch->values)
+	{
+		for (AttrNumber attno = 0; attno < batch->natts; attno++)
+		{
+			if (batch->values[attno])
+			{
+				pfree(batch->values[attno]);
+				pfree(batch->isnull[attno]);
+			}
+		}
+		pfree(batch->values);
+		pfree(batch->isnull);
+	}
+	pfree(batch->tids);
+	pfree(batch->rownums);
+	pfree(batch);
+}
+
+static inline void
+aocs_batch_reset(AOCSBatch batch)
+{
+	batch->nrows = 0;
+	batch->nextrow = 0;
+}
+
+/*
+ * aocs_getnext_batch
+ *
+ * Fill 'batch' with the next visible rows of the scan, and return how many
+ * there are; 0 means the scan is done.
+ *
+ * Unlike aocs_getnext(), which steps every datum stream once per row, each
+ * column is decoded in one tight loop over its current block.  The number
+ * of rows is capped by the rows left in the current block of every
+ * projected column, so that no stream moves to a new block while values
+ * from the old one are still referenced from the batch.  In segfiles where
+ * a projected column has missing values we fall back to one row per batch,
+ * reading blocks lazily just as aocs_getnext() does.
+ */
+int
+aocs_getnext_batch(AOCSScanDesc scan, AOCSBatch batch)
+{
+	bool		isSnapshotAny = (scan->rs_base.rs_snapshot == SnapshotAny);
+	AttrNumber *proj_atts;
+	AttrNumber	num_proj_atts;
+	TupleDesc	tupdesc;
+
+	if (scan->columnScanInfo.relationTupleDesc == NULL)
+	{
+		scan->columnScanInfo.relationTupleDesc = RelationGetDescr(scan->rs_base.rs_rd);
+		/* Pin it! ... and of course release it upon destruction / rescan */
+		PinTupleDesc(scan->columnScanInfo.relationTupleDesc);
+		initscan_with_colinfo(scan);
+	}
+
+	tupdesc = scan->columnScanInfo.relationTupleDesc;
+	proj_atts = scan->columnScanInfo.proj_atts;
+	num_proj_atts = scan->columnScanInfo.num_proj_atts;
+
+	aocs_batch_reset(batch);
+
+	if (num_proj_atts == 0)
+		return 0;
+
+	if (batch->values == NULL)
+		aocs_batch_alloc_vectors(scan, batch);
+
+	if (scan->cur_seg < 0 && !advance_scan_seg(scan))
+		return 0;
+
+	while (1)
+	{
+		AOCSFileSegInfo *curseginfo = scan->seginfo[scan->cur_seg];
+		int			segno = curseginfo->segno;
+		bool		hasmissing;
+		bool		segdone = false;
+		int			nrows;
+		int			nvisible;
+		int			err;
+
+		hasmissing = aocs_batch_seg_has_missing(scan, segno);
+
+		/* Step over the rows the zone maps rule out */
+		if (scan->zonemapFilter && !aocs_zonemap_skip(scan))
+			segdone = true;
+
+		/*
+		 * Load a block into every column that has run out, and see how many
+		 * rows all of them can deliver without moving on.
+		 */
+		nrows = hasmissing ? 1 : batch->maxrows;
+		for (AttrNumber i = 0; i < num_proj_atts && !segdone; i++)
+		{
+			AttrNumber	attno = proj_atts[i];
+			DatumStreamRead *ds = scan->columnScanInfo.ds[attno];
+
+			if (hasmissing && i != ANCHOR_COL_IN_PROJ)
+				continue;
+
+			if (aocs_batch_rows_in_block(ds) == 0 &&
+				!aocs_batch_read_block(scan, attno))
+				segdone = true;
+			else
+				nrows = Min(nrows, aocs_batch_rows_in_block(ds));
+		}
+
+		/*
+		 * Decode column by column.  The anchor column goes first, and gives
+		 * us the row numbers.
+		 */
+		for (AttrNumber i = 0; i < num_proj_atts && !segdone; i++)
+		{
+			AttrNumber	attno = proj_atts[i];
+			DatumStreamRead *ds = scan->columnScanInfo.ds[attno];
+			Datum	   *values = batch->values[attno];
+			bool	   *isnull = batch->isnull[attno];
+
+			if (!hasmissing)
+			{
+				int			lastnth;
+
+				err = datumstreamread_get_batch(ds, values, isnull, nrows);
+				Assert(err == nrows);
+
+				if (i == ANCHOR_COL_IN_PROJ)
+				{
+					lastnth = datumstreamread_nth(ds);
+					for (int r = 0; r < nrows; r++)
+					{
+						if (ds->blockFirstRowNum != InvalidAORowNum)
+						{
+							Assert(ds->blockFirstRowNum > 0);
+							batch->rownums[r] = ds->blockFirstRowNum + lastnth - (nrows - 1) + r;
+						}
+						else
+							batch->rownums[r] = InvalidAORowNum;
+					}
+				}
+				continue;
+			}
+
+			for (int r = 0; r < nrows; r++)
+			{
+				if (hasmissing && i != ANCHOR_COL_IN_PROJ)
+				{
+					Assert(batch->rownums[r] > 0);
+					if (AO_ATTR_VAL_IS_MISSING(batch->rownums[r],
+											   attno,
+											   segno,
+											   scan->columnScanInfo.attnum_to_rownum))
+					{
+						values[r] = getmissingattr(tupdesc, attno + 1, &isnull[r]);
+						continue;
+					}
+
+					if (aocs_batch_rows_in_block(ds) == 0 &&
+						!aocs_batch_read_block(scan, attno))
+					{
+						segdone = true;
+						break;
+					}
+				}
+
+				err = datumstreamread_advance(ds);
+				Assert(err > 0);
+				datumstreamread_get(ds, &values[r], &isnull[r]);
+
+				if (i == ANCHOR_COL_IN_PROJ)
+				{
+					if (ds->blockFirstRowNum != InvalidAORowNum)
+					{
+						Assert(ds->blockFirstRowNum > 0);
+						batch->rownums[r] = ds->blockFirstRowNum + datumstreamread_nth(ds);
+					}
+					else
+						batch->rownums[r] = InvalidAORowNum;
+				}
+			}
+		}
+
+		if (segdone)
+		{
+			/* Ha, cannot read next block, we need to go to next seg */
+			if (!advance_scan_seg(scan))
+				return 0;
+			continue;
+		}
+
+		/*
+		 * Check visibility, squeezing the invisible rows, and those the zone
+		 * maps rule out, out of the vectors.
+		 */
+		nvisible = 0;
+		for (int r = 0; r < nrows; r++)
+		{
+			AOTupleId	aoTupleId;
+
+			scan->segrowsprocessed++;
+			if (batch->rownums[r] == InvalidAORowNum)
+				AOTupleIdInit(&aoTupleId, segno, scan->segrowsprocessed);
+			else
+			{
+				if (scan->zonemapFilter &&
+					appendonly_zonemap_filter_skip(scan->zonemapFilter,
+												   batch->rownums[r]) != batch->rownums[r])
+					continue;
+				AOTupleIdInit(&aoTupleId, segno, batch->rownums[r]);
+			}
+
+			if (!isSnapshotAny && !AppendOnlyVisimap_IsVisible(&scan->visibilityMap, &aoTupleId))
+				continue;
+
+			if (nvisible != r)
+			{
+				for (AttrNumber i = 0; i < num_proj_atts; i++)
+				{
+					AttrNumber	attno = proj_atts[i];
+
+					batch->values[attno][nvisible] = batch->values[attno][r];
+					batch->isnull[attno][nvisible] = batch->isnull[attno][r];
+				}
+			}
+			batch->tids[nvisible++] = *((ItemPointer) &aoTupleId);
+		}
+
+		if (batch->rownums[nrows - 1] != InvalidAORowNum)
+			scan->zonemapNextRow = batch->rownums[nrows - 1] + 1;
+
+		if (nvisible > 0)
+		{
+			batch->nrows = nvisible;
+			return nvisible;
+		}
+	}
+
+	Assert(!"Never here");
+	return 0;
+}
+
 /* Open next file segment for write.  See SetCurrentFileSegForWrite */
 /* XXX Right now, we put each column to different files */
 static void
@@ -1715,6 +2224,13 @@ aocs_insert_init(Relation rel, int segno, int64 num_rows)
 											(FileSegInfo *) desc->fsInfo, desc->lastSequence,
 											rel, segno, tupleDesc->natts, true);
 
+	/* With a block directory, record zone maps of the blocks we write */
+	if (AppendOnlyBlockDirectory_RecordsZoneMaps(&desc->blockDirectory))
+	{
+		for (int i = 0; i < tupleDesc->natts; i++)
+			datumstreamwrite_track_zonemap(desc->ds[i]);
+	}
+
 	return desc;
 }
 
@@ -2925,6 +3441,8 @@ aocs_writecol_newsegfiles(AOCSWriteColumnDesc desc, AOCSFileSegInfo *seginfo)
 								   &rnode, fileSegNo,
 								   version);
 		desc->dsw[i]->blockFirstRowNum = 1;
+		if (AppendOnlyBlockDirectory_RecordsZoneMaps(&desc->blockDirectory))
+			datumstreamwrite_track_zonemap(desc->dsw[i]);
 		i++;
 	}
 	desc->cur_segno = seginfo->segno;
@@ -578,6 +578,22 @@ aoco_beginscan_extractcolumns(Relation rel, Snapshot snapshot,
 							projKind,
 							flags);
 
+	/*
+	 * Plain sequential scans decode a batch of rows column-at-a-time, and
+	 * hand them out one by one from aocs_getnext().
+	 */
+	if (gp_enable_aocs_batch_scan &&
+		(flags & (SO_TYPE_ANALYZE | SO_TYPE_SAMPLESCAN)) == 0)
+		aoscan->batch = aocs_batch_create(aoscan, AOCS_BATCH_MAX_ROWS);
+
+	/*
+	 * Let the scan skip the rows that the zone maps in the block directory
+	 * show can't satisfy the quals.
+	 */
+	if (snapshot != SnapshotAny &&
+		(flags & (SO_TYPE_ANALYZE | SO_TYPE_SAMPLESCAN)) == 0)
+		aoscan->zonemapFilter = appendonly_zonemap_filter_create(rel, qual);
+
 	if (needFree)
 		pfree(proj);
 	return (TableScanDesc)aoscan;
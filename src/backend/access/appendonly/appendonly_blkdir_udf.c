@@ -113,6 +113,8 @@ gp_aoblkdir(PG_FUNCTION_ARGS)
 										   0,
 										   NULL);
 		context->currMinipage.minipage = palloc0(minipage_size(NUM_MINIPAGE_ENTRIES));
+		context->currMinipage.zonemaps = NULL;
+		context->currMinipage.nzonemaps = 0;
 		context->currMinipageValid = false;
 		context->currMinipageEntryIdx = -1;
 		funcctx->user_fctx = (void *) context;
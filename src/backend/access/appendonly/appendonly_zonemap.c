@@ -0,0 +1,485 @@
+/*------------------------------------------------------------------------------
+ *
+ * appendonly_zonemap.c
+ *	  Skip blocks of append-optimized tables using the zone maps in their
+ *	  block directory.
+ *
+ * When zone maps are enabled, every block written through the block directory
+ * is recorded in it with the smallest and largest value in the block of each
+ * fixed-length, pass-by-value column (see datumstreamwrite_track_zonemap() for
+ * AO_COLUMN tables, and appendonly_insert() for AO_ROW ones).  A sequential
+ * scan with quals of the form "column op constant" compares them against the
+ * zone maps, before reading a segfile, and turns the blocks that can't have a
+ * matching row into ranges of row numbers that the scan then steps over,
+ * without reading or decompressing them.
+ *
+ * Copyright (c) 2024-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/access/appendonly/appendonly_zonemap.c
+ *
+ *------------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/genam.h"
+#include "access/htup_details.h"
+#include "access/nbtree.h"
+#include "access/stratnum.h"
+#include "access/table.h"
+#include "catalog/aoblkdir.h"
+#include "catalog/aocatalog.h"
+#include "catalog/pg_appendonly.h"
+#include "cdb/cdbappendonlyblockdirectory.h"
+#include "utils/fmgroids.h"
+#include "utils/guc.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/typcache.h"
+
+/*
+ * A qual "column op constant" that zone maps can refute.
+ */
+typedef struct AppendOnlyZoneMapKey
+{
+	AttrNumber	attno;			/* zero based */
+	int			slot;			/* its zone map in a minipage entry */
+	StrategyNumber strategy;	/* btree strategy of op */
+	Datum		value;			/* the constant */
+	FmgrInfo	cmp;			/* btree comparison function of the column's
+								 * type and the constant's */
+} AppendOnlyZoneMapKey;
+
+/*
+ * A range [start, end) of row numbers that can't satisfy the quals.
+ */
+typedef struct AppendOnlyZoneMapRange
+{
+	int64		start;
+	int64		end;
+} AppendOnlyZoneMapRange;
+
+typedef struct AppendOnlyZoneMapFilterData
+{
+	Oid			blkdirrelid;
+	bool		isAOCol;
+
+	int			nkeys;
+	AppendOnlyZoneMapKey *keys;
+
+	/* Refuted ranges of the current segfile, sorted and non-overlapping */
+	int			nranges;
+	int			maxranges;
+	AppendOnlyZoneMapRange *ranges;
+	int			currange;		/* first range that may still matter */
+
+	/* Blocks whose zone maps were checked, and those ruled out, so far */
+	int64		nblocks;
+	int64		nrefuted;
+} AppendOnlyZoneMapFilterData;
+
+/*
+ * If 'qual' is "column op constant" (or "constant op column") on a column
+ * that has zone maps, with op in the column type's default btree opfamily,
+ * fill in 'key' and return true.  The constant may be of another type of the
+ * opfamily, as in "int8col < 1000".
+ */
+static bool
+zonemap_key_from_qual(Relation rel, Expr *qual, AppendOnlyZoneMapKey *key)
+{
+	OpExpr	   *opexpr;
+	Expr	   *leftop;
+	Expr	   *rightop;
+	Oid			opno;
+	Var		   *var;
+	Const	   *cnst;
+	Form_pg_attribute attr;
+	TypeCacheEntry *typentry;
+	Oid			cmpproc;
+	int			strategy;
+	Oid			lefttype;
+	Oid			righttype;
+
+	if (!IsA(qual, OpExpr))
+		return false;
+	opexpr = (OpExpr *) qual;
+	if (list_length(opexpr->args) != 2)
+		return false;
+
+	leftop = (Expr *) linitial(opexpr->args);
+	rightop = (Expr *) lsecond(opexpr->args);
+	if (leftop && IsA(leftop, RelabelType))
+		leftop = ((RelabelType *) leftop)->arg;
+	if (rightop && IsA(rightop, RelabelType))
+		rightop = ((RelabelType *) rightop)->arg;
+
+	opno = opexpr->opno;
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		cnst = (Const *) rightop;
+	}
+	else if (IsA(leftop, Const) && IsA(rightop, Var))
+	{
+		var = (Var *) rightop;
+		cnst = (Const *) leftop;
+		opno = get_commutator(opno);
+		if (!OidIsValid(opno))
+			return false;
+	}
+	else
+		return false;
+
+	if (var->varlevelsup != 0 || var->varattno <= 0 ||
+		var->varattno > RelationGetNumberOfAttributes(rel))
+		return false;
+
+	/* btree operators are strict, so a NULL constant is refuted elsewhere */
+	if (cnst->constisnull)
+		return false;
+
+	/* Only the columns that zone maps are recorded for */
+	attr = TupleDescAttr(RelationGetDescr(rel), var->varattno - 1);
+	if (attr->attisdropped)
+		return false;
+	key->slot = AppendOnlyBlockDirectory_ZoneMapSlot(rel, var->varattno - 1);
+	if (key->slot < 0)
+		return false;
+
+	typentry = lookup_type_cache(attr->atttypid, TYPECACHE_BTREE_OPFAMILY);
+	if (!OidIsValid(typentry->btree_opf))
+		return false;
+
+	if (!op_in_opfamily(opno, typentry->btree_opf))
+		return false;
+	get_op_opfamily_properties(opno, typentry->btree_opf, false,
+							   &strategy, &lefttype, &righttype);
+	if (lefttype != typentry->btree_opintype)
+		return false;
+
+	/* Compares a min or max of the column with the constant */
+	cmpproc = get_opfamily_proc(typentry->btree_opf, lefttype, righttype,
+								BTORDER_PROC);
+	if (!OidIsValid(cmpproc))
+		return false;
+
+	key->attno = var->varattno - 1;
+	key->strategy = strategy;
+	key->value = cnst->constvalue;
+	fmgr_info(cmpproc, &key->cmp);
+	return true;
+}
+
+/*
+ * appendonly_zonemap_filter_create
+ *
+ * Build a zone map filter from the quals of a scan, which are implicitly
+ * ANDed.  Returns NULL if the table has no block directory, its block
+ * directory can't have zone maps, or none of the quals can be checked against
+ * them.
+ */
+AppendOnlyZoneMapFilter
+appendonly_zonemap_filter_create(Relation rel, List *qual)
+{
+	AppendOnlyZoneMapFilter filter;
+	Oid			blkdirrelid;
+	ListCell   *lc;
+
+	if (!gp_enable_blkdir_zonemap || qual == NIL)
+		return NULL;
+
+	if (AppendOnlyBlockDirectory_ZoneMapWidth(rel) == 0)
+		return NULL;
+
+	GetAppendOnlyEntryAuxOids(rel, NULL, &blkdirrelid, NULL);
+	if (!OidIsValid(blkdirrelid))
+		return NULL;
+
+	filter = palloc0(sizeof(AppendOnlyZoneMapFilterData));
+	filter->blkdirrelid = blkdirrelid;
+	filter->isAOCol = RelationIsAoCols(rel);
+	filter->keys = palloc(list_length(qual) * sizeof(AppendOnlyZoneMapKey));
+
+	foreach(lc, qual)
+	{
+		if (zonemap_key_from_qual(rel, (Expr *) lfirst(lc),
+								  &filter->keys[filter->nkeys]))
+			filter->nkeys++;
+	}
+
+	if (filter->nkeys == 0)
+	{
+		appendonly_zonemap_filter_free(filter);
+		return NULL;
+	}
+
+	return filter;
+}
+
+/*
+ * Can no row in a block with the given zone map satisfy the key?
+ */
+static bool
+zonemap_refutes(AppendOnlyZoneMapKey *key, MinipageZoneMap *zonemap)
+{
+	int32		cmpmin;
+	int32		cmpmax;
+
+	if ((zonemap->flags & MINIPAGE_ZONEMAP_VALID) == 0)
+		return false;
+
+	/* All NULLs, which never satisfy a strict operator */
+	if ((zonemap->flags & MINIPAGE_ZONEMAP_HAS_VALUES) == 0)
+		return true;
+
+	/* The comparisons are "min vs. value" and "max vs. value" */
+	cmpmin = DatumGetInt32(FunctionCall2Coll(&key->cmp, InvalidOid,
+											 zonemap->min, key->value));
+	cmpmax = DatumGetInt32(FunctionCall2Coll(&key->cmp, InvalidOid,
+											 zonemap->max, key->value));
+
+	switch (key->strategy)
+	{
+		case BTLessStrategyNumber:
+			return cmpmin >= 0;		/* col < value, but min >= value */
+		case BTLessEqualStrategyNumber:
+			return cmpmin > 0;		/* col <= value, but min > value */
+		case BTEqualStrategyNumber:
+			return cmpmin > 0 || cmpmax < 0;
+		case BTGreaterEqualStrategyNumber:
+			return cmpmax < 0;		/* col >= value, but max < value */
+		case BTGreaterStrategyNumber:
+			return cmpmax <= 0;		/* col > value, but max <= value */
+		default:
+			return false;
+	}
+}
+
+static void
+zonemap_add_range(AppendOnlyZoneMapFilter filter, int64 start, int64 end)
+{
+	if (filter->nranges == filter->maxranges)
+	{
+		filter->maxranges = Max(filter->maxranges * 2, 64);
+		if (filter->ranges == NULL)
+			filter->ranges = palloc(filter->maxranges * sizeof(AppendOnlyZoneMapRange));
+		else
+			filter->ranges = repalloc(filter->ranges,
+									  filter->maxranges * sizeof(AppendOnlyZoneMapRange));
+	}
+
+	filter->ranges[filter->nranges].start = start;
+	filter->ranges[filter->nranges].end = end;
+	filter->nranges++;
+}
+
+static int
+zonemap_range_cmp(const void *a, const void *b)
+{
+	const AppendOnlyZoneMapRange *ra = (const AppendOnlyZoneMapRange *) a;
+	const AppendOnlyZoneMapRange *rb = (const AppendOnlyZoneMapRange *) b;
+
+	if (ra->start < rb->start)
+		return -1;
+	if (ra->start > rb->start)
+		return 1;
+	return 0;
+}
+
+/*
+ * Check the 'nkeys' keys against the zone maps in the minipages of column
+ * group 'columngroupno' of segfile 'segno'.
+ */
+static void
+zonemap_check_columngroup(AppendOnlyZoneMapFilter filter, Relation blkdirRel,
+						  Relation blkdirIdx, Snapshot snapshot, int segno,
+						  int columngroupno, AppendOnlyZoneMapKey *keys, int nkeys)
+{
+	TupleDesc	tupdesc = RelationGetDescr(blkdirRel);
+	ScanKeyData scanKey[2];
+	SysScanDesc indexScan;
+	HeapTuple	tuple;
+
+	ScanKeyInit(&scanKey[0],
+				Anum_pg_aoblkdir_segno,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(segno));
+	ScanKeyInit(&scanKey[1],
+				Anum_pg_aoblkdir_columngroupno,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(columngroupno));
+
+	indexScan = systable_beginscan_ordered(blkdirRel, blkdirIdx, snapshot,
+										   2 /* nkeys */, scanKey);
+
+	while ((tuple = systable_getnext_ordered(indexScan, ForwardScanDirection)) != NULL)
+	{
+		Datum		value;
+		bool		isnull;
+		Minipage   *minipage;
+		MinipageZoneMap *zonemaps;
+		uint32		nzonemaps;
+
+		value = heap_getattr(tuple, Anum_pg_aoblkdir_minipage, tupdesc, &isnull);
+		if (isnull)
+			continue;
+
+		/* Take a copy, the entries need to be properly aligned */
+		minipage = (Minipage *) PG_DETOAST_DATUM_COPY(value);
+		zonemaps = minipage_get_zonemaps(minipage, &nzonemaps);
+		for (uint32 i = 0; zonemaps != NULL && i < minipage->nEntry; i++)
+		{
+			MinipageEntry *entry = &minipage->entry[i];
+			bool		checked = false;
+			bool		refuted = false;
+
+			/*
+			 * The blocks written before a column was added have no valid zone
+			 * map for it, if their minipage has one at all.
+			 */
+			for (int k = 0; k < nkeys && !refuted; k++)
+			{
+				MinipageZoneMap *zonemap;
+
+				if ((uint32) keys[k].slot >= nzonemaps)
+					continue;
+				zonemap = &zonemaps[i * nzonemaps + keys[k].slot];
+				if ((zonemap->flags & MINIPAGE_ZONEMAP_VALID) == 0)
+					continue;
+				checked = true;
+				refuted = zonemap_refutes(&keys[k], zonemap);
+			}
+
+			if (checked)
+				filter->nblocks++;
+			if (refuted)
+			{
+				filter->nrefuted++;
+				zonemap_add_range(filter, entry->firstRowNum,
+								  entry->firstRowNum + entry->rowCount);
+			}
+		}
+
+		pfree(minipage);
+	}
+
+	systable_endscan_ordered(indexScan);
+}
+
+/*
+ * appendonly_zonemap_filter_load
+ *
+ * Read the zone maps of segfile 'segno' from the block directory, and collect
+ * the row ranges refuted by any of the keys.
+ */
+void
+appendonly_zonemap_filter_load(AppendOnlyZoneMapFilter filter, Snapshot snapshot,
+							   int segno)
+{
+	Relation	blkdirRel;
+	Relation	blkdirIdx;
+	int			nmerged;
+
+	appendonly_zonemap_filter_clear(filter);
+
+	blkdirRel = table_open(filter->blkdirrelid, AccessShareLock);
+	blkdirIdx = index_open(AppendonlyGetAuxIndex(blkdirRel), AccessShareLock);
+
+	/*
+	 * An AO_COLUMN table has a column group, with its own blocks, per column.
+	 * An AO_ROW one has a single column group with the zone maps of all the
+	 * columns.
+	 */
+	if (filter->isAOCol)
+	{
+		for (int k = 0; k < filter->nkeys; k++)
+			zonemap_check_columngroup(filter, blkdirRel, blkdirIdx, snapshot,
+									  segno, filter->keys[k].attno,
+									  &filter->keys[k], 1);
+	}
+	else
+		zonemap_check_columngroup(filter, blkdirRel, blkdirIdx, snapshot,
+								  segno, 0, filter->keys, filter->nkeys);
+
+	index_close(blkdirIdx, AccessShareLock);
+	table_close(blkdirRel, AccessShareLock);
+
+	if (filter->nranges == 0)
+		return;
+
+	/* Sort the ranges, and merge the ones that overlap or touch */
+	qsort(filter->ranges, filter->nranges, sizeof(AppendOnlyZoneMapRange),
+		  zonemap_range_cmp);
+	nmerged = 0;
+	for (int i = 1; i < filter->nranges; i++)
+	{
+		AppendOnlyZoneMapRange *last = &filter->ranges[nmerged];
+
+		if (filter->ranges[i].start <= last->end)
+			last->end = Max(last->end, filter->ranges[i].end);
+		else
+			filter->ranges[++nmerged] = filter->ranges[i];
+	}
+	filter->nranges = nmerged + 1;
+}
+
+/*
+ * appendonly_zonemap_filter_clear
+ *
+ * Forget the ranges of the previous segfile, refuting nothing.
+ */
+void
+appendonly_zonemap_filter_clear(AppendOnlyZoneMapFilter filter)
+{
+	filter->nranges = 0;
+	filter->currange = 0;
+}
+
+/*
+ * appendonly_zonemap_filter_skip
+ *
+ * If row 'rowNum' of the current segfile can't satisfy the quals, return the
+ * row number following the refuted range it is in.  Otherwise return rowNum
+ * itself.  Successive calls must pass non-decreasing row numbers.
+ */
+int64
+appendonly_zonemap_filter_skip(AppendOnlyZoneMapFilter filter, int64 rowNum)
+{
+	while (filter->currange < filter->nranges &&
+		   filter->ranges[filter->currange].end <= rowNum)
+		filter->currange++;
+
+	if (filter->currange < filter->nranges &&
+		filter->ranges[filter->currange].start <= rowNum)
+		return filter->ranges[filter->currange].end;
+
+	return rowNum;
+}
+
+/*
+ * appendonly_zonemap_filter_stats
+ *
+ * Return the number of blocks whose zone maps the filter checked, and how
+ * many of them it ruled out, since it was created.  The blocks of every
+ * column of an AO_COLUMN table count separately.
+ */
+void
+appendonly_zonemap_filter_stats(AppendOnlyZoneMapFilter filter, int64 *nblocks,
+						  int64 *nrefuted)
+{
+	*nblocks = filter->nblocks;
+	*nrefuted = filter->nrefuted;
+}
+
+void
+appendonly_zonemap_filter_free(AppendOnlyZoneMapFilter filter)
+{
+	if (filter->ranges)
+		pfree(filter->ranges);
+	pfree(filter->keys);
+	pfree(filter);
+}
@@ -63,6 +63,7 @@
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/snapmgr.h"
+#include "utils/typcache.h"
 
 
 typedef enum AoExecutorBlockKind
@@ -97,6 +98,8 @@ static void AppendOnlyExecutorReadBlock_ResetCounts(
 static void AppendOnlyScanDesc_UpdateTotalBytesRead(
 										AppendOnlyScanDesc scan);
 
+static void init_insert_zonemaps(AppendOnlyInsertDesc aoInsertDesc);
+
 /* ----------------
  *		initscan - scan code common to appendonly_beginscan and appendonly_rescan
  * ----------------
@@ -271,6 +274,12 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 												 &scan->executorReadBlock,
 												  /* blockFirstRowNum */ 1);
 
+	/* Find the blocks of the segfile that zone maps rule out */
+	if (scan->zonemapFilter)
+		appendonly_zonemap_filter_load(scan->zonemapFilter,
+									   scan->appendOnlyMetaDataSnapshot,
+									   segno);
+
 	/* ready to go! */
 	scan->aos_need_new_segfile = false;
 
@@ -1151,6 +1160,20 @@ getNextBlock(AppendOnlyScanDesc scan)
 			scan->executorReadBlock.rowCount);
 	}
 
+	/*
+	 * Step over the block without reading its contents if its zone maps
+	 * rule out all of its rows.
+	 */
+	if (scan->zonemapFilter &&
+		appendonly_zonemap_filter_skip(scan->zonemapFilter,
+									   scan->executorReadBlock.blockFirstRowNum) >=
+		scan->executorReadBlock.blockFirstRowNum + scan->executorReadBlock.rowCount)
+	{
+		AppendOnlyExecutionReadBlock_FinishedScanBlock(&scan->executorReadBlock);
+		AppendOnlyStorageRead_SkipCurrentBlock(&scan->storageRead);
+		return false;
+	}
+
 	AppendOnlyExecutorReadBlock_GetContents(
 											&scan->executorReadBlock);
 
@@ -1660,12 +1683,25 @@ finishWriteBlock(AppendOnlyInsertDesc aoInsertDesc)
 			aoInsertDesc->bufferCount);
 
 	/* Insert an entry to the block directory */
-	AppendOnlyBlockDirectory_InsertEntry(
-		&aoInsertDesc->blockDirectory,
-		0,
-		aoInsertDesc->blockFirstRowNum,
-		AppendOnlyStorageWrite_LogicalBlockStartOffset(&aoInsertDesc->storageWrite),
-		itemCount);
+	if (aoInsertDesc->zonemaps != NULL)
+	{
+		AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+			&aoInsertDesc->blockDirectory,
+			0,
+			aoInsertDesc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&aoInsertDesc->storageWrite),
+			itemCount,
+			aoInsertDesc->zonemaps);
+		MemSet(aoInsertDesc->zonemaps, 0,
+			   sizeof(MinipageZoneMap) * aoInsertDesc->nzonemaps);
+	}
+	else
+		AppendOnlyBlockDirectory_InsertEntry(
+			&aoInsertDesc->blockDirectory,
+			0,
+			aoInsertDesc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&aoInsertDesc->storageWrite),
+			itemCount);
 
 	Assert(aoInsertDesc->nonCompressedData == NULL);
 	Assert(!AppendOnlyStorageWrite_IsBufferAllocated(&aoInsertDesc->storageWrite));
@@ -1971,6 +2007,10 @@ appendonly_rescan(TableScanDesc scan, ScanKey key,
 
 	CloseScannedFileSeg(aoscan);
 
+	if (aoscan->initedStorageRoutines)
+		BufferedReadAddStats(&aoscan->storageRead.bufferedRead,
+							 &aoscan->prefetchBytes, &aoscan->stallTime);
+
 	AppendOnlyStorageRead_FinishSession(&aoscan->storageRead);
 
 	aoscan->initedStorageRoutines = false;
@@ -2031,6 +2071,24 @@ appendonly_positionscan(AppendOnlyScanDesc aoscan,
 	return true;
 }
 
+/*
+ * appendonly_read_stats
+ *
+ * Return the bytes the scan prefetched and the time it stalled in reads,
+ * across its rescans.
+ */
+void
+appendonly_read_stats(AppendOnlyScanDesc aoscan, int64 *prefetchBytes,
+					  instr_time *stallTime)
+{
+	*prefetchBytes = aoscan->prefetchBytes;
+	*stallTime = aoscan->stallTime;
+
+	if (aoscan->initedStorageRoutines)
+		BufferedReadAddStats(&aoscan->storageRead.bufferedRead,
+							 prefetchBytes, stallTime);
+}
+
 /* ----------------
  *		appendonly_endscan	- end relation scan
  * ----------------
@@ -2069,6 +2127,9 @@ appendonly_endscan(TableScanDesc scan)
 	if (aoscan->blkdirscan != NULL)
 		appendonly_blkdirscan_finish(aoscan);
 
+	if (aoscan->zonemapFilter)
+		appendonly_zonemap_filter_free(aoscan->zonemapFilter);
+
 	if (aoscan->aofetch)
 	{
 		appendonly_fetch_finish(aoscan->aofetch);
@@ -3178,9 +3239,56 @@ aoInsertDesc->appendOnlyMetaDataSnapshot, //CONCERN:Safe to assume all block dir
 											aoInsertDesc->fsInfo, aoInsertDesc->lastSequence,
 											rel, segno, 1, false);
 
+	if (AppendOnlyBlockDirectory_RecordsZoneMaps(&aoInsertDesc->blockDirectory))
+		init_insert_zonemaps(aoInsertDesc);
+
 	return aoInsertDesc;
 }
 
+/*
+ * init_insert_zonemaps
+ *
+ * Set up to record the zone maps of the blocks we write, in the block
+ * directory: one per zone map slot (see AppendOnlyBlockDirectory_ZoneMapSlot()),
+ * of the columns whose type has a default btree opclass to order them by.
+ */
+static void
+init_insert_zonemaps(AppendOnlyInsertDesc aoInsertDesc)
+{
+	Relation	rel = aoInsertDesc->aoi_rel;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	int			nzonemaps = AppendOnlyBlockDirectory_ZoneMapWidth(rel);
+
+	if (nzonemaps == 0)
+		return;
+
+	aoInsertDesc->nzonemaps = nzonemaps;
+	aoInsertDesc->zonemaps = palloc0(sizeof(MinipageZoneMap) * nzonemaps);
+	aoInsertDesc->zonemapAttnums = palloc0(sizeof(AttrNumber) * nzonemaps);
+	aoInsertDesc->zonemapSsup = palloc0(sizeof(SortSupportData) * nzonemaps);
+
+	for (int i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		int			slot = AppendOnlyBlockDirectory_ZoneMapSlot(rel, i);
+		TypeCacheEntry *typentry;
+		SortSupport ssup;
+
+		if (slot < 0 || attr->attisdropped)
+			continue;
+
+		typentry = lookup_type_cache(attr->atttypid, TYPECACHE_LT_OPR);
+		if (!OidIsValid(typentry->lt_opr))
+			continue;
+
+		ssup = &aoInsertDesc->zonemapSsup[slot];
+		ssup->ssup_cxt = CurrentMemoryContext;
+		ssup->ssup_collation = InvalidOid;
+		PrepareSortSupportFromOrderingOp(typentry->lt_opr, ssup);
+		aoInsertDesc->zonemapAttnums[slot] = attr->attnum;
+	}
+}
+
 
 /*
  *	appendonly_insert		- insert tuple into a varblock
@@ -3344,6 +3452,21 @@ appendonly_insert(AppendOnlyInsertDesc aoInsertDesc,
 
 		if (itemLen > 0)
 			memcpy(itemPtr, tup, itemLen);
+
+		/* Fold the row into the zone maps of the block */
+		for (int i = 0; i < aoInsertDesc->nzonemaps; i++)
+		{
+			Datum		d;
+			bool		null;
+
+			if (aoInsertDesc->zonemapAttnums[i] == InvalidAttrNumber)
+				continue;
+
+			d = memtuple_getattr(instup, aoInsertDesc->mt_bind,
+								 aoInsertDesc->zonemapAttnums[i], &null);
+			minipage_zonemap_add(&aoInsertDesc->zonemaps[i], d, null,
+								 &aoInsertDesc->zonemapSsup[i]);
+		}
 	}
 	else
 	{
@@ -3436,6 +3559,13 @@ appendonly_insert_finish(AppendOnlyInsertDesc aoInsertDesc)
 
 	destroy_memtuple_binding(aoInsertDesc->mt_bind);
 
+	if (aoInsertDesc->zonemaps != NULL)
+	{
+		pfree(aoInsertDesc->zonemaps);
+		pfree(aoInsertDesc->zonemapAttnums);
+		pfree(aoInsertDesc->zonemapSsup);
+	}
+
 	pfree(aoInsertDesc->title);
 	pfree(aoInsertDesc);
 }
@@ -497,10 +497,32 @@ appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
 /* ------------------------------------------------------------------------
  * Seq Scan callbacks for appendonly AM
  *
- * These are in appendonlyam.c
+ * These are in appendonlyam.c, except the one below
  * ------------------------------------------------------------------------
  */
 
+/*
+ * A row oriented scan reads every column anyway, so only the quals matter:
+ * let the scan skip the blocks that the zone maps in the block directory
+ * show can't satisfy them.
+ */
+static TableScanDesc
+appendonly_beginscan_extractcolumns(Relation rel, Snapshot snapshot,
+									List *targetlist, List *qual, bool *proj,
+									List *constraintList, uint32 flags)
+{
+	AppendOnlyScanDesc aoscan;
+
+	aoscan = (AppendOnlyScanDesc) appendonly_beginscan(rel, snapshot,
+													   0, NULL, NULL, flags);
+
+	if (snapshot != SnapshotAny &&
+		(flags & (SO_TYPE_ANALYZE | SO_TYPE_SAMPLESCAN)) == 0)
+		aoscan->zonemapFilter = appendonly_zonemap_filter_create(rel, qual);
+
+	return (TableScanDesc) aoscan;
+}
+
 /* ------------------------------------------------------------------------
  * Index Scan Callbacks for appendonly AM
  * ------------------------------------------------------------------------
@@ -2415,6 +2437,7 @@ static const TableAmRoutine ao_row_methods = {
 	.slot_callbacks = appendonly_slot_callbacks,
 
 	.scan_begin = appendonly_beginscan,
+	.scan_begin_extractcolumns = appendonly_beginscan_extractcolumns,
 	.scan_end = appendonly_endscan,
 	.scan_rescan = appendonly_rescan,
 	.scan_getnextslot = appendonly_getnextslot,
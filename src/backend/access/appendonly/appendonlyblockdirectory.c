@@ -58,7 +58,8 @@ insert_new_entry(AppendOnlyBlockDirectory *blockDirectory,
 				 int columnGroupNo,
 				 int64 firstRowNum,
 				 int64 fileOffset,
-				 int64 rowCount);
+				 int64 rowCount,
+				 const MinipageZoneMap *zonemaps);
 static void clear_minipage(MinipagePerColumnGroup *minipagePerColumnGroup);
 
 static int findFileSegInfo(AppendOnlyBlockDirectory *blockDirectory,
@@ -145,8 +146,10 @@ init_internal(AppendOnlyBlockDirectory *blockDirectory)
 		MinipagePerColumnGroup *minipageInfo =
 							&blockDirectory->minipages[groupNo];
 
-		minipageInfo->minipage =
-			palloc0(minipage_size(NUM_MINIPAGE_ENTRIES));
+		/* room for the zone maps, which write_minipage() appends */
+		minipageInfo->minipage = palloc0(MINIPAGE_MAX_SIZE);
+		minipageInfo->zonemaps = NULL;
+		minipageInfo->nzonemaps = 0;
 		minipageInfo->numMinipageEntries = 0;
 		ItemPointerSetInvalid(&minipageInfo->tupleTid);
 		minipageInfo->cached_entry_no = InvalidEntryNum;
@@ -155,6 +158,39 @@ init_internal(AppendOnlyBlockDirectory *blockDirectory)
 	MemoryContextSwitchTo(oldcxt);
 }
 
+/*
+ * init_zonemaps
+ *
+ * Make room for the zone maps of the minipage entries, for block directories
+ * that write minipages, if the relation may have zone maps.  This is done
+ * whether or not new entries will get zone maps, so that rewriting the last
+ * minipage of a segfile keeps those of its existing entries.
+ */
+static void
+init_zonemaps(AppendOnlyBlockDirectory *blockDirectory)
+{
+	MemoryContext oldcxt;
+	int			nzonemaps;
+
+	nzonemaps = AppendOnlyBlockDirectory_ZoneMapWidth(blockDirectory->aoRel);
+	if (nzonemaps == 0)
+		return;
+
+	oldcxt = MemoryContextSwitchTo(blockDirectory->memoryContext);
+
+	for (int i = 0; i < blockDirectory->num_proj_atts; i++)
+	{
+		MinipagePerColumnGroup *minipageInfo =
+			&blockDirectory->minipages[blockDirectory->proj_atts[i]];
+
+		minipageInfo->zonemaps =
+			palloc0(sizeof(MinipageZoneMap) * nzonemaps * NUM_MINIPAGE_ENTRIES);
+		minipageInfo->nzonemaps = nzonemaps;
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+}
+
 /*
  * init_internal_proj
  *
@@ -463,6 +499,8 @@ AppendOnlyBlockDirectory_Init_forInsert(
 
 	init_internal(blockDirectory);
 
+	init_zonemaps(blockDirectory);
+
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
 			  (errmsg("Append-only block directory init for insert: "
 					  "(segno, numColumnGroups, isAOCol, lastSequence)="
@@ -540,6 +578,8 @@ AppendOnlyBlockDirectory_Init_writeCols(
 	init_internal_proj(blockDirectory, NULL, false);
 
 	init_internal(blockDirectory);
+
+	init_zonemaps(blockDirectory);
 }
 
 static bool
@@ -1249,7 +1289,107 @@ AppendOnlyBlockDirectory_InsertEntry(AppendOnlyBlockDirectory *blockDirectory,
 									 int64 rowCount)
 {
 	return insert_new_entry(blockDirectory, columnGroupNo, firstRowNum,
-							fileOffset, rowCount);
+							fileOffset, rowCount, NULL);
+}
+
+/*
+ * AppendOnlyBlockDirectory_InsertEntryWithZoneMap
+ *
+ * Same as AppendOnlyBlockDirectory_InsertEntry(), but also records the zone
+ * maps of the block, AppendOnlyBlockDirectory_ZoneMapWidth() of them, so that
+ * scans can skip it without reading it.  Only call this if
+ * AppendOnlyBlockDirectory_RecordsZoneMaps() says so.
+ */
+bool
+AppendOnlyBlockDirectory_InsertEntryWithZoneMap(AppendOnlyBlockDirectory *blockDirectory,
+												int columnGroupNo,
+												int64 firstRowNum,
+												int64 fileOffset,
+												int64 rowCount,
+												const MinipageZoneMap *zonemaps)
+{
+	return insert_new_entry(blockDirectory, columnGroupNo, firstRowNum,
+							fileOffset, rowCount, zonemaps);
+}
+
+/*
+ * AppendOnlyBlockDirectory_ZoneMapWidth
+ *
+ * The number of zone maps in a minipage entry of the relation: one for an
+ * AO_COLUMN table, one per zone map slot for an AO_ROW table (see
+ * AppendOnlyBlockDirectory_ZoneMapSlot()).  Zero if the relation was created,
+ * or last rewritten, before block directory minipages could have zone maps;
+ * older releases couldn't read them.
+ */
+int
+AppendOnlyBlockDirectory_ZoneMapWidth(Relation aoRel)
+{
+	TupleDesc	tupdesc = RelationGetDescr(aoRel);
+	int			nslots = 0;
+
+	if (!AORelationVersion_Validate(aoRel, AORelationVersion_BlkdirZoneMap))
+		return 0;
+
+	if (RelationIsAoCols(aoRel))
+		return 1;
+
+	for (int i = 0; i < tupdesc->natts && nslots < MINIPAGE_MAX_ROW_ZONEMAPS; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+
+		if (attr->attbyval && attr->attlen > 0)
+			nslots++;
+	}
+
+	return nslots;
+}
+
+/*
+ * AppendOnlyBlockDirectory_ZoneMapSlot
+ *
+ * The zone map of column 'attno' (zero based) in a minipage entry, or -1 if
+ * the column has none.  An AO_COLUMN minipage entry only has the zone map of
+ * its column group's column.  An AO_ROW one has a slot for each of the first
+ * MINIPAGE_MAX_ROW_ZONEMAPS columns of a fixed-length, pass-by-value type, in
+ * column order.  Dropped columns keep their length and byval-ness, so they
+ * keep their slot and the other columns don't move.
+ */
+int
+AppendOnlyBlockDirectory_ZoneMapSlot(Relation aoRel, int attno)
+{
+	TupleDesc	tupdesc = RelationGetDescr(aoRel);
+	Form_pg_attribute attr = TupleDescAttr(tupdesc, attno);
+	int			slot = 0;
+
+	if (!attr->attbyval || attr->attlen <= 0)
+		return -1;
+
+	if (RelationIsAoCols(aoRel))
+		return 0;
+
+	for (int i = 0; i < attno; i++)
+	{
+		Form_pg_attribute prev = TupleDescAttr(tupdesc, i);
+
+		if (prev->attbyval && prev->attlen > 0)
+			slot++;
+	}
+
+	return slot < MINIPAGE_MAX_ROW_ZONEMAPS ? slot : -1;
+}
+
+/*
+ * AppendOnlyBlockDirectory_RecordsZoneMaps
+ *
+ * Should the blocks written through the block directory get zone maps?
+ */
+bool
+AppendOnlyBlockDirectory_RecordsZoneMaps(AppendOnlyBlockDirectory *blockDirectory)
+{
+	return gp_enable_blkdir_zonemap &&
+		blockDirectory->blkdirRel != NULL &&
+		blockDirectory->num_proj_atts > 0 &&
+		blockDirectory->minipages[blockDirectory->proj_atts[0]].zonemaps != NULL;
 }
 
 /*
@@ -1314,7 +1454,8 @@ insert_new_entry(AppendOnlyBlockDirectory *blockDirectory,
 				 int columnGroupNo,
 				 int64 firstRowNum,
 				 int64 fileOffset,
-				 int64 rowCount)
+				 int64 rowCount,
+				 const MinipageZoneMap *zonemaps)
 {
 	MinipageEntry *entry = NULL;
 	MinipagePerColumnGroup *minipageInfo;
@@ -1350,6 +1491,20 @@ insert_new_entry(AppendOnlyBlockDirectory *blockDirectory,
 	entry->fileOffset = fileOffset;
 	entry->rowCount = rowCount;
 
+	if (minipageInfo->zonemaps != NULL)
+	{
+		MinipageZoneMap *entry_zonemaps =
+			&minipageInfo->zonemaps[minipageInfo->numMinipageEntries *
+									minipageInfo->nzonemaps];
+
+		if (zonemaps != NULL)
+			memcpy(entry_zonemaps, zonemaps,
+				   sizeof(MinipageZoneMap) * minipageInfo->nzonemaps);
+		else
+			MemSet(entry_zonemaps, 0,
+				   sizeof(MinipageZoneMap) * minipageInfo->nzonemaps);
+	}
+
 	minipageInfo->numMinipageEntries++;
 
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
@@ -1671,8 +1826,10 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 	Relation	blkdirRel = blockDirectory->blkdirRel;
 	CatalogIndexState indinfo = blockDirectory->indinfo;
 	TupleDesc	heapTupleDesc = RelationGetDescr(blkdirRel);
+	uint32		nEntry = minipageInfo->numMinipageEntries;
+	bool		has_zonemaps = false;
 
-	Assert(minipageInfo->numMinipageEntries > 0);
+	Assert(nEntry > 0);
 
 	oldcxt = MemoryContextSwitchTo(blockDirectory->memoryContext);
 
@@ -1690,9 +1847,38 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 		Int64GetDatum(minipageInfo->minipage->entry[0].firstRowNum);
 	nulls[Anum_pg_aoblkdir_firstrownum - 1] = false;
 
-	SET_VARSIZE(minipageInfo->minipage,
-				minipage_size(minipageInfo->numMinipageEntries));
-	minipageInfo->minipage->nEntry = minipageInfo->numMinipageEntries;
+	/*
+	 * If any entry carries a zone map, append the zone maps of all entries
+	 * after the entry array and mark the minipage as such.  Otherwise the
+	 * minipage is written in the basic format, so tables without zone maps
+	 * look exactly as before.  A minipage loaded back from the relation with
+	 * more entries than fit along with our zone maps is written without
+	 * them.
+	 */
+	if (minipageInfo->zonemaps != NULL &&
+		minipage_zonemap_size(nEntry, minipageInfo->nzonemaps) <= MINIPAGE_MAX_SIZE)
+	{
+		for (uint32 i = 0; i < nEntry * minipageInfo->nzonemaps && !has_zonemaps; i++)
+		{
+			if (minipageInfo->zonemaps[i].flags & MINIPAGE_ZONEMAP_VALID)
+				has_zonemaps = true;
+		}
+	}
+
+	minipageInfo->minipage->nEntry = nEntry;
+	if (has_zonemaps)
+	{
+		minipageInfo->minipage->version = MINIPAGE_VERSION_ZONEMAP;
+		memcpy(&minipageInfo->minipage->entry[nEntry], minipageInfo->zonemaps,
+			   sizeof(MinipageZoneMap) * nEntry * minipageInfo->nzonemaps);
+		SET_VARSIZE(minipageInfo->minipage,
+					minipage_zonemap_size(nEntry, minipageInfo->nzonemaps));
+	}
+	else
+	{
+		minipageInfo->minipage->version = MINIPAGE_VERSION_BASIC;
+		SET_VARSIZE(minipageInfo->minipage, minipage_size(nEntry));
+	}
 	values[Anum_pg_aoblkdir_minipage - 1] =
 		PointerGetDatum(minipageInfo->minipage);
 	nulls[Anum_pg_aoblkdir_minipage - 1] = false;
@@ -1747,6 +1933,10 @@ clear_minipage(MinipagePerColumnGroup *minipagePerColumnGroup)
 {
 	MemSet(minipagePerColumnGroup->minipage->entry, 0,
 		   minipagePerColumnGroup->numMinipageEntries * sizeof(MinipageEntry));
+	if (minipagePerColumnGroup->zonemaps != NULL)
+		MemSet(minipagePerColumnGroup->zonemaps, 0,
+			   minipagePerColumnGroup->numMinipageEntries *
+			   minipagePerColumnGroup->nzonemaps * sizeof(MinipageZoneMap));
 	minipagePerColumnGroup->numMinipageEntries = 0;
 	ItemPointerSetInvalid(&minipagePerColumnGroup->tupleTid);
 	minipagePerColumnGroup->cached_entry_no = InvalidEntryNum;
@@ -1811,7 +2001,7 @@ AppendOnlyBlockDirectory_InsertPlaceholder(AppendOnlyBlockDirectory *blockDirect
 
 	/* insert placeholder entry with a max row count */
 	insert_new_entry(blockDirectory, columnGroupNo, firstRowNum, fileOffset,
-					 AOTupleId_MaxRowNum);
+					 AOTupleId_MaxRowNum, NULL);
 	/* insert placeholder row containing placeholder entry */
 	write_minipage(blockDirectory, columnGroupNo, minipagePerColumnGroup);
 	/*
@@ -1519,6 +1519,36 @@ CREATE OR REPLACE VIEW gp_distributed_log AS
 
 GRANT SELECT ON gp_distributed_log TO PUBLIC;
 
+------------------------------------------------------------------
+-- GPDB view of the optimizer plan cache of the current backend
+------------------------------------------------------------------
+CREATE VIEW gp_opt_plan_cache AS
+    SELECT entries, size, hits, misses,
+           CASE WHEN hits + misses > 0
+                THEN hits::float8 / (hits + misses) END AS hit_rate,
+           evictions, invalidations, resets, saved_time_ms
+      FROM gp_opt_plan_cache_stats();
+
+GRANT SELECT ON gp_opt_plan_cache TO PUBLIC;
+
+------------------------------------------------------------------
+-- GPDB view of the interconnect connections the backends of the coordinator
+-- and of all segments sent data on, since each of them started.
+------------------------------------------------------------------
+CREATE VIEW gp_interconnect_stats AS
+    SELECT segid, receiver, connections, packets, bytes, local_bytes,
+           retransmits,
+           CASE WHEN packets > 0
+                THEN retransmits::float8 / packets END AS retransmit_ratio,
+           CASE WHEN send_time_ms > 0
+                THEN bytes * 1000 / send_time_ms END AS bytes_per_sec,
+           min_rtt_ms, rtt_ms
+      FROM (SELECT (gp_interconnect_conn_stats()).* FROM gp_id
+            UNION ALL
+            SELECT (gp_interconnect_conn_stats()).* FROM gp_dist_random('gp_id')) AS stats;
+
+GRANT SELECT ON gp_interconnect_stats TO PUBLIC;
+
 ------------------------------------------------------------------
 -- GPDB view for aggregating the backends information of subtransactions overflowed
 ------------------------------------------------------------------
@@ -25,6 +25,8 @@
 
 static void BufferedReadIo(
 			   BufferedRead *bufferedRead);
+static void BufferedReadPrefetch(
+			   BufferedRead *bufferedRead);
 static uint8 *BufferedReadUseBeforeBuffer(
 							BufferedRead *bufferedRead,
 							int32 maxReadAheadLen,
@@ -111,6 +113,14 @@ BufferedReadInit(
 	 */
 	bufferedRead->haveTemporaryLimitInEffect = false;
 	bufferedRead->temporaryLimitFileLen = 0;
+
+	/*
+	 * Read-ahead and statistics.
+	 */
+	bufferedRead->prefetchPosition = 0;
+	bufferedRead->readBytes = 0;
+	bufferedRead->prefetchBytes = 0;
+	INSTR_TIME_SET_ZERO(bufferedRead->stallTime);
 }
 
 /*
@@ -144,6 +154,7 @@ BufferedReadSetFile(
 	bufferedRead->haveTemporaryLimitInEffect = false;
 	bufferedRead->temporaryLimitFileLen = 0;
 	bufferedRead->fileOff =0;
+	bufferedRead->prefetchPosition = 0;
 
 	if (fileLen > 0)
 	{
@@ -180,8 +191,8 @@ BufferedReadIo(
 		instr_time	io_start,
 					io_time;
 
-		if (track_io_timing)
-			INSTR_TIME_SET_CURRENT(io_start);
+		/* One clock read per large read is cheap, so always time them */
+		INSTR_TIME_SET_CURRENT(io_start);
 
 		actualLen = FileRead(bufferedRead->file,
 							 (char *) largeReadMemory,
@@ -191,10 +202,11 @@ BufferedReadIo(
 
 		SIMPLE_FAULT_INJECTOR("ao_storage_read_after_fileread");
 
+		INSTR_TIME_SET_CURRENT(io_time);
+		INSTR_TIME_SUBTRACT(io_time, io_start);
+		INSTR_TIME_ADD(bufferedRead->stallTime, io_time);
 		if (track_io_timing)
 		{
-			INSTR_TIME_SET_CURRENT(io_time);
-			INSTR_TIME_SUBTRACT(io_time, io_start);
 			pgstat_count_buffer_read_time(INSTR_TIME_GET_MICROSEC(io_time));
 			INSTR_TIME_ADD(pgBufferUsage.blk_read_time, io_time);
 		}
@@ -223,6 +235,7 @@ BufferedReadIo(
 								   bufferedRead->largeReadLen)));
 
 		bufferedRead->fileOff += actualLen;
+		bufferedRead->readBytes += actualLen;
 
 		elogif(Debug_appendonly_print_read_block, LOG,
 			   "Append-Only storage read: table \"%s\", segment file \"%s\", read position " INT64_FORMAT " (small offset %d), "
@@ -242,6 +255,49 @@ BufferedReadIo(
 
 	if (VacuumCostActive)
 		VacuumCostBalance += VacuumCostPageMiss;
+
+	BufferedReadPrefetch(bufferedRead);
+}
+
+/*
+ * Ask the kernel to read ahead the part of the file that follows the current
+ * large read, up to gp_appendonly_prefetch_size bytes, so that the next large
+ * reads find it in the page cache instead of waiting for the device.
+ *
+ * The window is only topped up once half of it has been consumed, to avoid a
+ * system call for every large read.  Reads within a temporary range are
+ * random access, for which read-ahead is of no use.
+ */
+static void
+BufferedReadPrefetch(
+					 BufferedRead *bufferedRead)
+{
+	int64		window;
+	int64		start;
+	int64		end;
+
+	window = (int64) gp_appendonly_prefetch_size * 1024;
+	if (window == 0 || bufferedRead->haveTemporaryLimitInEffect)
+		return;
+
+	start = Max(bufferedRead->prefetchPosition, bufferedRead->fileOff);
+	end = Min(bufferedRead->fileOff + window, bufferedRead->fileLen);
+	if (start >= end || start - bufferedRead->fileOff > window / 2)
+		return;
+
+	(void) FilePrefetch(bufferedRead->file, start, (int) (end - start),
+						WAIT_EVENT_DATA_FILE_PREFETCH);
+
+	elogif(Debug_appendonly_print_read_block, LOG,
+		   "Append-Only storage prefetch: table \"%s\", segment file \"%s\", "
+		   "prefetch position " INT64_FORMAT ", length " INT64_FORMAT,
+		   bufferedRead->relationName,
+		   bufferedRead->filePathName,
+		   start,
+		   end - start);
+
+	bufferedRead->prefetchPosition = end;
+	bufferedRead->prefetchBytes += end - start;
 }
 
 static uint8 *
@@ -426,6 +482,7 @@ BufferedReadSetTemporaryRange(
 		 */
 		bufferedRead->fileOff = beginFileOffset;
 		bufferedRead->bufferOffset = 0;
+		bufferedRead->prefetchPosition = 0;
 
 		remainingFileLen = afterFileOffset - beginFileOffset;
 		if (remainingFileLen > bufferedRead->maxLargeReadLen)
@@ -670,8 +727,23 @@ BufferedReadCompleteFile(
 
 	bufferedRead->largeReadPosition = 0;
 	bufferedRead->largeReadLen = 0;
+
+	bufferedRead->prefetchPosition = 0;
 }
 
+/*
+ * Add the bytes prefetched and the time stalled in reads so far to
+ * *prefetchBytes and *stallTime, for EXPLAIN ANALYZE of the scans.
+ */
+void
+BufferedReadAddStats(BufferedRead *bufferedRead, int64 *prefetchBytes,
+					 instr_time *stallTime)
+{
+	Assert(bufferedRead != NULL);
+
+	*prefetchBytes += bufferedRead->prefetchBytes;
+	INSTR_TIME_ADD(*stallTime, bufferedRead->stallTime);
+}
 
 /*
  * Finish with reading all together.
@@ -50,9 +50,80 @@ bool gp_use_legacy_hashops = false;
 /* Fast mod using a bit mask, assuming that y is a power of 2 */
 #define FASTMOD(x,y)		((x) & ((y)-1))
 
+/* rotate hashkey left 1 bit, done at each attribute */
+#define ROTATE_LEFT_1(x)	(((x) << 1) | ((x) >> 31))
+
 /* local function declarations */
 static int	ispowof2(int numsegs);
 static inline int32 jump_consistent_hash(uint64 key, int32 num_segments);
+static CdbHashKernel cdbhash_kernel_for_func(Oid funcid);
+static uint32 cdbhash_fmgr(CdbHash *h, int attno, Datum datum);
+
+/*================================================================
+ *
+ * HASH KERNELS
+ *
+ * The hash functions of the most common distribution key types, inlined.
+ * Going through the function manager for every attribute of every tuple
+ * costs more than the hashing itself for fixed-width types.  These must
+ * give the same results as the functions they replace, or rows would land
+ * on the wrong segments.
+ *
+ *================================================================
+ */
+
+/* hashint8() */
+static inline uint32
+cdbhash_int8(int64 val)
+{
+	uint32		lohalf = (uint32) val;
+	uint32		hihalf = (uint32) (val >> 32);
+
+	lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+
+	return hash_bytes_uint32(lohalf);
+}
+
+/*
+ * hashtext().  cdbhash() always passes the default collation, which is
+ * deterministic, so this is just a hash of the bytes.
+ */
+static inline uint32
+cdbhash_text(Datum datum)
+{
+	text	   *key = DatumGetTextPP(datum);
+	uint32		result;
+
+	result = hash_bytes((unsigned char *) VARDATA_ANY(key),
+						VARSIZE_ANY_EXHDR(key));
+
+	if ((Pointer) key != DatumGetPointer(datum))
+		pfree(key);
+
+	return result;
+}
+
+/*
+ * Hash a non-null value of attribute 'attno'.
+ */
+static inline uint32
+cdbhash_datum(CdbHash *h, int attno, Datum datum)
+{
+	switch (h->kernels[attno - 1])
+	{
+		case CDBHASH_KERNEL_INT2:
+			return hash_bytes_uint32((uint32) (int32) DatumGetInt16(datum));
+		case CDBHASH_KERNEL_INT4:
+			return hash_bytes_uint32((uint32) DatumGetInt32(datum));
+		case CDBHASH_KERNEL_INT8:
+			return cdbhash_int8(DatumGetInt64(datum));
+		case CDBHASH_KERNEL_TEXT:
+			return cdbhash_text(datum);
+		case CDBHASH_KERNEL_FMGR:
+			break;
+	}
+	return cdbhash_fmgr(h, attno, datum);
+}
 
 /*================================================================
  *
@@ -94,6 +165,7 @@ makeCdbHash(int numsegs, int natts, Oid *hashfuncs)
 
 	/* Load hash function info */
 	h->hashfuncs = (FmgrInfo *) palloc(natts * sizeof(FmgrInfo));
+	h->kernels = (CdbHashKernel *) palloc(natts * sizeof(CdbHashKernel));
 	for (i = 0; i < natts; i++)
 	{
 		Oid			funcid = hashfuncs[i];
@@ -102,6 +174,7 @@ makeCdbHash(int numsegs, int natts, Oid *hashfuncs)
 			is_legacy_hash = true;
 
 		fmgr_info(funcid, &h->hashfuncs[i]);
+		h->kernels[i] = cdbhash_kernel_for_func(funcid);
 	}
 	h->natts = natts;
 	h->is_legacy_hash = is_legacy_hash;
@@ -160,6 +233,8 @@ void freeCdbHash(CdbHash *hash)
 	{
 		if (hash->hashfuncs)
 			pfree(hash->hashfuncs);
+		if (hash->kernels)
+			pfree(hash->kernels);
 		pfree(hash);
 	}
 }
@@ -193,57 +268,72 @@ cdbhash(CdbHash *h, int attno, Datum datum, bool isnull)
 	if (!h->is_legacy_hash)
 	{
 		/* rotate hashkey left 1 bit at each step */
-		hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
+		hashkey = ROTATE_LEFT_1(hashkey);
 
 		if (!isnull)
-		{
-			LOCAL_FCINFO(fcinfo, 1);
-			uint32		hkey;
-
-			InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[attno - 1], 1,
-									 DEFAULT_COLLATION_OID, /* have to specify collation for attribute of text or bpchar */
-									 NULL, NULL);
-
-			fcinfo->args[0].value = datum;
-			fcinfo->args[0].isnull = false;
-
-			hkey = DatumGetUInt32(FunctionCallInvoke(fcinfo));
-
-			/* Check for null result, since caller is clearly not expecting one */
-			if (fcinfo->isnull)
-				elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
-
-			hashkey ^= hkey;
-		}
+			hashkey ^= cdbhash_datum(h, attno, datum);
 	}
 	else
 	{
 		magic_hash_stash = hashkey;
 		if (!isnull)
-		{
-			LOCAL_FCINFO(fcinfo, 1);
-			uint32		hkey;
+			hashkey = cdbhash_datum(h, attno, datum);
+		else
+			hashkey = cdblegacyhash_null();
+		magic_hash_stash = FNV1_32_INIT;
+	}
+	h->hash = hashkey;
+}
+
+/*
+ * Call the hash function of attribute 'attno' on a non-null value.
+ */
+static uint32
+cdbhash_fmgr(CdbHash *h, int attno, Datum datum)
+{
+	LOCAL_FCINFO(fcinfo, 1);
+	uint32		hkey;
 
-			InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[attno - 1], 1,
-									 DEFAULT_COLLATION_OID, /* legacy hash functions don't care about collations */
-									 NULL, NULL);
+	/*
+	 * Have to specify collation for attribute of text or bpchar.  Legacy hash
+	 * functions don't care about collations.
+	 */
+	InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[attno - 1], 1,
+							 DEFAULT_COLLATION_OID,
+							 NULL, NULL);
 
-			fcinfo->args[0].value = datum;
-			fcinfo->args[0].isnull = false;
+	fcinfo->args[0].value = datum;
+	fcinfo->args[0].isnull = false;
 
-			hkey = DatumGetUInt32(FunctionCallInvoke(fcinfo));
+	hkey = DatumGetUInt32(FunctionCallInvoke(fcinfo));
 
-			/* Check for null result, since caller is clearly not expecting one */
-			if (fcinfo->isnull)
-				elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
+	/* Check for null result, since caller is clearly not expecting one */
+	if (fcinfo->isnull)
+		elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
 
-			hashkey = hkey;
-		}
-		else
-			hashkey = cdblegacyhash_null();
-		magic_hash_stash = FNV1_32_INIT;
+	return hkey;
+}
+
+/*
+ * Pick the inline kernel for a hash function, if there is one.
+ */
+static CdbHashKernel
+cdbhash_kernel_for_func(Oid funcid)
+{
+	switch (funcid)
+	{
+		case F_HASHINT2:
+			return CDBHASH_KERNEL_INT2;
+		case F_HASHINT4:
+			return CDBHASH_KERNEL_INT4;
+		case F_HASHINT8:
+		case F_TIMESTAMP_HASH:
+			return CDBHASH_KERNEL_INT8;
+		case F_HASHTEXT:
+			return CDBHASH_KERNEL_TEXT;
+		default:
+			return CDBHASH_KERNEL_FMGR;
 	}
-	h->hash = hashkey;
 }
 
 /*
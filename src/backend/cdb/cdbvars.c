@@ -204,6 +204,7 @@ int			Gp_interconnect_timer_checking_period = 20;
 int			Gp_interconnect_default_rtt = 20;
 int			Gp_interconnect_min_rto = 20;
 int			Gp_interconnect_fc_method = INTERCONNECT_FC_METHOD_LOSS;
+int			Gp_interconnect_compression = INTERCONNECT_COMPRESSION_OFF;
 int			Gp_interconnect_transmit_timeout = 3600;
 int			Gp_interconnect_min_retries_before_timeout = 100;
 int			Gp_interconnect_debug_retry_interval = 10;
@@ -220,6 +221,12 @@ bool		gp_interconnect_full_crc = false;	/* sanity check UDP data. */
 
 bool		gp_interconnect_log_stats = false;	/* emit stats at log-level */
 
+bool		gp_interconnect_explain_bytes = false;	/* bytes sent in EXPLAIN
+													 * ANALYZE */
+
+bool		gp_interconnect_shm = false;	/* shared memory between processes of
+										 * a segment */
+
 bool		gp_interconnect_cache_future_packets = true;
 
 int			Gp_postmaster_address_family_type = POSTMASTER_ADDRESS_FAMILY_TYPE_AUTO;
@@ -66,12 +66,13 @@ static void processIncomingChunks(MotionLayerState *mlStates,
 					  ChunkTransportState *transportStates,
 					  MotionNodeEntry *pMNEntry,
 					  int16 motNodeID,
-					  int16 srcRoute);
+					  int16 srcRoute,
+					  bool wait);
 
 static inline void reconstructTuple(MotionNodeEntry *pMNEntry, ChunkSorterEntry *pCSEntry, TupleRemapper *remapper);
 
 /* Stats-function declarations. */
-static void statSendTuple(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, TupleChunkList tcList);
+static void statSendTuple(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, TupleChunkList tcList, bool zerocopy);
 static void statSendEOS(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry);
 static void statChunksProcessed(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, int chunksProcessed, int chunkBytes, int tupleBytes);
 static void statNewTupleArrived(MotionNodeEntry *pMNEntry, ChunkSorterEntry *pCSEntry);
@@ -91,6 +92,15 @@ reconstructTuple(MotionNodeEntry *pMNEntry, ChunkSorterEntry *pCSEntry, TupleRem
 {
 	MinimalTuple tup;
 	SerTupInfo *pSerInfo = &pMNEntry->ser_tup_info;
+	int			wholeBytes = 0;
+
+	/*
+	 * A tuple that came in one chunk is copied once, out of the receive
+	 * buffer.  The chunks of a bigger one have been copied out of it already,
+	 * and are copied again to reassemble the tuple.
+	 */
+	if (pCSEntry->chunk_list.num_chunks == 1)
+		wholeBytes = pCSEntry->chunk_list.p_first->chunk_length - TUPLE_CHUNK_HEADER_SIZE;
 
 	/*
 	 * Convert the list of chunks into a tuple, then stow it away.
@@ -103,6 +113,9 @@ reconstructTuple(MotionNodeEntry *pMNEntry, ChunkSorterEntry *pCSEntry, TupleRem
 	if (!tup)
 		return;
 
+	/* Stats */
+	pMNEntry->stat_tuple_bytes_recvd_whole += wholeBytes;
+
 	tup = TRCheckAndRemap(remapper, pSerInfo->tupdesc, tup);
 
 	htfifo_addtuple(pCSEntry->ready_tuples, tup);
@@ -289,6 +302,7 @@ UpdateMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool preserve
 	pEntry->stat_total_chunks_sent = 0;
 	pEntry->stat_total_bytes_sent = 0;
 	pEntry->stat_tuple_bytes_sent = 0;
+	pEntry->stat_tuple_bytes_sent_zerocopy = 0;
 	pEntry->stat_total_sends = 0;
 	pEntry->stat_total_recvs = 0;
 	pEntry->stat_tuples_available = 0;
@@ -296,6 +310,7 @@ UpdateMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool preserve
 	pEntry->stat_total_chunks_recvd = 0;
 	pEntry->stat_total_bytes_recvd = 0;
 	pEntry->stat_tuple_bytes_recvd = 0;
+	pEntry->stat_tuple_bytes_recvd_whole = 0;
 
 	pEntry->cleanedUp = false;
 	pEntry->stopped = false;
@@ -421,7 +436,7 @@ CheckAndSendRecordCache(MotionLayerState *mlStates,
 	else
 	{
 		/* update stats */
-		statSendTuple(mlStates, pMNEntry, &tcList);
+		statSendTuple(mlStates, pMNEntry, &tcList, false);
 	}
 
 	/* cleanup */
@@ -444,6 +459,7 @@ SendTuple(MotionLayerState *mlStates,
 	TupleChunkListData tcList;
 	MemoryContext oldCtxt;
 	SendReturnCode rc;
+	bool		zerocopy;
 
 	AssertArg(!TupIsNull(slot));
 
@@ -473,7 +489,7 @@ SendTuple(MotionLayerState *mlStates,
 	/* Create and store the serialized form, and some stats about it. */
 	oldCtxt = MemoryContextSwitchTo(mlStates->motion_layer_mctx);
 
-	sent = SerializeTuple(slot, &pMNEntry->ser_tup_info, &b, &tcList, targetRoute);
+	sent = SerializeTuple(slot, &pMNEntry->ser_tup_info, &b, &tcList, targetRoute, &zerocopy);
 
 	MemoryContextSwitchTo(oldCtxt);
 	if (sent > 0)
@@ -485,7 +501,7 @@ SendTuple(MotionLayerState *mlStates,
 		tcList.serialized_data_length = sent;
 
 		/* update stats */
-		statSendTuple(mlStates, pMNEntry, &tcList);
+		statSendTuple(mlStates, pMNEntry, &tcList, zerocopy);
 
 		return SEND_COMPLETE;
 	}
@@ -510,7 +526,7 @@ SendTuple(MotionLayerState *mlStates,
 	else
 	{
 		/* update stats */
-		statSendTuple(mlStates, pMNEntry, &tcList);
+		statSendTuple(mlStates, pMNEntry, &tcList, false);
 
 		rc = SEND_COMPLETE;
 	}
@@ -615,7 +631,7 @@ RecvTupleFrom(MotionLayerState *mlStates,
 			break;
 		}
 
-		processIncomingChunks(mlStates, transportStates, pMNEntry, motNodeID, srcRoute);
+		processIncomingChunks(mlStates, transportStates, pMNEntry, motNodeID, srcRoute, true);
 	}
 
 	/* Stats */
@@ -625,6 +641,83 @@ RecvTupleFrom(MotionLayerState *mlStates,
 	return tuple;
 }
 
+/*
+ * Receive a batch of tuples from any sender.
+ *
+ * Like RecvTupleFrom() with ANY_ROUTE, but the tuples that are ready, all
+ * those of the packets received so far, come out of the FIFO at once, and
+ * the motion-node lookup and the stats are done once per batch.
+ */
+int
+RecvTuplesFrom(MotionLayerState *mlStates,
+			   ChunkTransportState *transportStates,
+			   int16 motNodeID,
+			   MinimalTuple *tuples,
+			   int maxTuples)
+{
+	MotionNodeEntry *pMNEntry;
+	int			ntuples;
+
+#ifdef AMS_VERBOSE_LOGGING
+	elog(DEBUG5, "RecvTuplesFrom( motNodeID = %d, maxTuples = %d )", motNodeID, maxTuples);
+#endif
+
+	pMNEntry = getMotionNodeEntry(mlStates, motNodeID);
+	Assert(pMNEntry->preserve_order == 0);
+
+	for (;;)
+	{
+		/* Get the tuples in the FIFO, if there are any. */
+		ntuples = htfifo_gettuples(pMNEntry->ready_tuples, tuples, maxTuples);
+		if (ntuples > 0)
+			break;
+
+		/* No more tuples are going to show up after end-of-stream. */
+		if (!pMNEntry->moreNetWork)
+			break;
+
+		processIncomingChunks(mlStates, transportStates, pMNEntry, motNodeID, ANY_ROUTE, true);
+	}
+
+	/* Stats, see statRecvTuple() */
+	pMNEntry->stat_total_recvs += ntuples;
+	pMNEntry->stat_tuples_available -= ntuples;
+
+	return ntuples;
+}
+
+/*
+ * Decode the next packet from a sender of an ordered receive, if all the
+ * tuples of the previous one have been taken and it has arrived already.
+ *
+ * A merge takes its next tuple from whichever sender has the lowest one,
+ * and a sender whose tuples were all taken may not come up again for a
+ * while.  Taking its next packet right away gives the receive buffer back,
+ * so that the sender can go on sending, instead of keeping it until the
+ * merge gets to that sender again.
+ */
+void
+PrefetchTuplesFrom(MotionLayerState *mlStates,
+				   ChunkTransportState *transportStates,
+				   int16 motNodeID,
+				   int16 srcRoute)
+{
+	MotionNodeEntry *pMNEntry;
+	ChunkSorterEntry *pCSEntry;
+
+	if (transportStates->PollTupleChunkFrom == NULL)
+		return;
+
+	pMNEntry = getMotionNodeEntry(mlStates, motNodeID);
+	Assert(pMNEntry->preserve_order != 0);
+
+	pCSEntry = getChunkSorterEntry(mlStates, pMNEntry, srcRoute);
+	if (pCSEntry->end_of_stream || !htfifo_empty(pCSEntry->ready_tuples))
+		return;
+
+	processIncomingChunks(mlStates, transportStates, pMNEntry, motNodeID, srcRoute, false);
+}
+
 
 /*
  * This helper function is the receive-tuple workhorse.  It pulls
@@ -635,13 +728,17 @@ RecvTupleFrom(MotionLayerState *mlStates,
  * return.  It can also be called during other operations if that
  * seems like a good idea.  For example, it can be called sometime
  * during send-tuple operations as well.
+ *
+ * If wait is false, it only takes chunks that have arrived already from
+ * srcRoute, through the transport's PollTupleChunkFrom.
  */
 static void
 processIncomingChunks(MotionLayerState *mlStates,
 					  ChunkTransportState *transportStates,
 					  MotionNodeEntry *pMNEntry,
 					  int16 motNodeID,
-					  int16 srcRoute)
+					  int16 srcRoute,
+					  bool wait)
 {
 	TupleChunkListItem tcItem,
 				tcNext;
@@ -663,8 +760,10 @@ processIncomingChunks(MotionLayerState *mlStates,
 	 */
 	if (srcRoute == ANY_ROUTE)
 		tcItem = transportStates->RecvTupleChunkFromAny(transportStates, motNodeID, &srcRoute);
-	else
+	else if (wait)
 		tcItem = transportStates->RecvTupleChunkFrom(transportStates, motNodeID, srcRoute);
+	else
+		tcItem = transportStates->PollTupleChunkFrom(transportStates, motNodeID, srcRoute);
 
 	/* Look up various things related to the sender that we received chunks from. */
 	chunkSorterEntry = getChunkSorterEntry(mlStates, pMNEntry, srcRoute);
@@ -811,20 +910,24 @@ EndMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool flushCommLa
 		if (pMNEntry->stat_total_bytes_sent > 0)
 		{
 			elog(LOG, "Interconnect seg%d slice%d sent " UINT64_FORMAT " tuples, "
-				 UINT64_FORMAT " total bytes, " UINT64_FORMAT " tuple bytes, "
+				 UINT64_FORMAT " total bytes, " UINT64_FORMAT " tuple bytes ("
+				 UINT64_FORMAT " copied, " UINT64_FORMAT " zero-copy), "
 				 UINT64_FORMAT " chunks.",
 				 GpIdentity.segindex,
 				 currentSliceId,
 				 pMNEntry->stat_total_sends,
 				 pMNEntry->stat_total_bytes_sent,
 				 pMNEntry->stat_tuple_bytes_sent,
+				 pMNEntry->stat_tuple_bytes_sent - pMNEntry->stat_tuple_bytes_sent_zerocopy,
+				 pMNEntry->stat_tuple_bytes_sent_zerocopy,
 				 pMNEntry->stat_total_chunks_sent
 				);
 		}
 		if (pMNEntry->stat_total_bytes_recvd > 0)
 		{
 			elog(LOG, "Interconnect seg%d slice%d received from slice%d: " UINT64_FORMAT " tuples, "
-				 UINT64_FORMAT " total bytes, " UINT64_FORMAT " tuple bytes, "
+				 UINT64_FORMAT " total bytes, " UINT64_FORMAT " tuple bytes ("
+				 UINT64_FORMAT " in single chunks), "
 				 UINT64_FORMAT " chunks.",
 				 GpIdentity.segindex,
 				 currentSliceId,
@@ -832,6 +935,7 @@ EndMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool flushCommLa
 				 pMNEntry->stat_total_recvs,
 				 pMNEntry->stat_total_bytes_recvd,
 				 pMNEntry->stat_tuple_bytes_recvd,
+				 pMNEntry->stat_tuple_bytes_recvd_whole,
 				 pMNEntry->stat_total_chunks_recvd
 				);
 		}
@@ -1144,7 +1248,7 @@ addChunkToSorter(ChunkTransportState *transportStates,
  * SerializeTupleDirect() only fills those fields out.
  */
 static void
-statSendTuple(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, TupleChunkList tcList)
+statSendTuple(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, TupleChunkList tcList, bool zerocopy)
 {
 	int			headerOverhead;
 
@@ -1157,6 +1261,8 @@ statSendTuple(MotionLayerState *mlStates, MotionNodeEntry *pMNEntry, TupleChunkL
 	pMNEntry->stat_total_chunks_sent += tcList->num_chunks;
 	pMNEntry->stat_total_bytes_sent += tcList->serialized_data_length + headerOverhead;
 	pMNEntry->stat_tuple_bytes_sent += tcList->serialized_data_length;
+	if (zerocopy)
+		pMNEntry->stat_tuple_bytes_sent_zerocopy += tcList->serialized_data_length;
 
 	/* Update global motion-layer statistics. */
 	mlStates->stat_total_chunks_sent += tcList->num_chunks;
@@ -174,3 +174,43 @@ htfifo_gettuple(htup_fifo htf)
 
 	return tup;
 }
+
+
+/*
+ * Retrieve up to maxTuples tuples from the start of the FIFO into tups[],
+ * and return how many were retrieved, 0 if the FIFO is empty.  The entries
+ * go back to the freelist all at once.
+ */
+int
+htfifo_gettuples(htup_fifo htf, MinimalTuple *tups, int maxTuples)
+{
+	htf_entry	p_first;
+	htf_entry	p_last = NULL;
+	htf_entry	p_ent;
+	int			ntuples = 0;
+
+	AssertArg(htf != NULL);
+	AssertArg(maxTuples > 0);
+
+	p_first = htf->p_first;
+	for (p_ent = p_first; p_ent != NULL && ntuples < maxTuples;
+		 p_ent = p_ent->p_next)
+	{
+		AssertState(p_ent->tup != NULL);
+		tups[ntuples++] = p_ent->tup;
+		p_last = p_ent;
+	}
+
+	if (p_last == NULL)
+		return 0;
+
+	/* Unhook the entries from the FIFO, and put them on the freelist. */
+	htf->p_first = p_last->p_next;
+	if (htf->p_first == NULL)
+		htf->p_last = NULL;
+
+	p_last->p_next = htf->freelist;
+	htf->freelist = p_first;
+
+	return ntuples;
+}
@@ -31,6 +31,10 @@
 #include <sys/time.h>
 #include <netinet/in.h>
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 /*
   #define AMS_VERBOSE_LOGGING
 */
@@ -47,6 +51,26 @@ typedef struct interconnect_handle_t
 	struct interconnect_handle_t *prev;
 } interconnect_handle_t;
 
+/*
+ * Interconnect compression.
+ *
+ * Each transport buffer is compressed on its own, as an independent zstd
+ * frame: the UDP interconnect drops, resends and reorders packets, so the
+ * receiver can't count on seeing the frames of a stream in order.  The
+ * header of the buffer is left alone, and a flag in it tells the receiver
+ * that the payload behind it is compressed.  Small buffers, such as the ones
+ * carrying just an end-of-stream, and buffers that don't shrink are sent raw.
+ */
+#define IC_COMPRESS_LEVEL		1
+#define IC_COMPRESS_MIN_BYTES	256
+
+/*
+ * With gp_interconnect_compression = auto, a connection whose buffers don't
+ * compress to less than 90% of their size sends that many buffers raw before
+ * trying again.
+ */
+#define IC_COMPRESS_SKIP_BUFFERS	256
+
 /*=========================================================================
  * GLOBAL STATE VARIABLES
  */
@@ -58,6 +82,14 @@ int			UDP_listenerFd;
 static interconnect_handle_t *open_interconnect_handles;
 static bool interconnect_resowner_callback_registered;
 
+#ifdef USE_ZSTD
+/* compression contexts and scratch buffers, reused across messages */
+static ZSTD_CCtx *ic_compress_cxt = NULL;
+static ZSTD_DCtx *ic_decompress_cxt = NULL;
+static char *ic_compress_buf = NULL;
+static char *ic_decompress_buf = NULL;
+#endif
+
 /*=========================================================================
  * FUNCTIONS PROTOTYPES
  */
@@ -70,6 +102,8 @@ static void cleanup_interconnect_handle(interconnect_handle_t *h);
 static interconnect_handle_t *allocate_interconnect_handle(void);
 static void destroy_interconnect_handle(interconnect_handle_t *h);
 static interconnect_handle_t *find_interconnect_handle(ChunkTransportState *icContext);
+static void decompressMotionMessage(MotionConn *conn, int hdrlen,
+									uint8 **msgPos, int32 *msgSize);
 
 static void
 logChunkParseDetails(MotionConn *conn, uint32 ic_instance_id)
@@ -96,6 +130,8 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 	TupleChunkListItem lastTcItem = NULL;
 	uint32		tcSize;
 	int			bytesProcessed = 0;
+	uint8	   *msgPos;
+	int32		msgSize;
 
 	if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP ||
 		Gp_interconnect_type == INTERCONNECT_TYPE_PROXY)
@@ -112,25 +148,35 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 		bytesProcessed = sizeof(struct icpkthdr);
 	}
 
+	/*
+	 * The chunks of a compressed message are formed from a decompressed copy
+	 * of it.  The bookkeeping of the receive buffer, below, is still done
+	 * with the size of the message as it came in.
+	 */
+	msgPos = conn->msgPos;
+	msgSize = conn->msgSize;
+	if (conn->msgCompressed)
+		decompressMotionMessage(conn, bytesProcessed, &msgPos, &msgSize);
+
 #ifdef AMS_VERBOSE_LOGGING
 	elog(DEBUG5, "recvtuple chunk recv bytes %d msgsize %d conn->pBuff %p conn->msgPos: %p",
 		 conn->recvBytes, conn->msgSize, conn->pBuff, conn->msgPos);
 #endif
 
-	while (bytesProcessed != conn->msgSize)
+	while (bytesProcessed != msgSize)
 	{
-		if (conn->msgSize - bytesProcessed < TUPLE_CHUNK_HEADER_SIZE)
+		if (msgSize - bytesProcessed < TUPLE_CHUNK_HEADER_SIZE)
 		{
 			logChunkParseDetails(conn, transportStates->sliceTable->ic_instance_id);
 
 			ereport(ERROR,
 					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
 					 errmsg("interconnect error parsing message: insufficient data received"),
-					 errdetail("conn->msgSize %d bytesProcessed %d < chunk-header %d",
-							   conn->msgSize, bytesProcessed, TUPLE_CHUNK_HEADER_SIZE)));
+					 errdetail("msgSize %d bytesProcessed %d < chunk-header %d",
+							   msgSize, bytesProcessed, TUPLE_CHUNK_HEADER_SIZE)));
 		}
 
-		tcSize = TUPLE_CHUNK_HEADER_SIZE + (*(uint16 *) (conn->msgPos + bytesProcessed));
+		tcSize = TUPLE_CHUNK_HEADER_SIZE + (*(uint16 *) (msgPos + bytesProcessed));
 
 		/* sanity check */
 		if (tcSize > Gp_max_packet_size)
@@ -157,7 +203,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 					 errdetail("tcSize %d > max %d header %d processed %d/%d from %p",
 							   tcSize, Gp_max_packet_size,
 							   TUPLE_CHUNK_HEADER_SIZE, bytesProcessed,
-							   conn->msgSize, conn->msgPos)));
+							   msgSize, msgPos)));
 		}
 
 
@@ -168,7 +214,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 		if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP ||
 			Gp_interconnect_type == INTERCONNECT_TYPE_PROXY)
 		{
-			if (tcSize >= conn->msgSize)
+			if (tcSize >= msgSize)
 			{
 				/*
 				 * see MPP-720: it is possible that our message got messed up
@@ -181,11 +227,11 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 				ereport(ERROR,
 						(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
 						 errmsg("interconnect error parsing message"),
-						 errdetail("tcSize %d >= conn->msgSize %d",
-								   tcSize, conn->msgSize)));
+						 errdetail("tcSize %d >= msgSize %d",
+								   tcSize, msgSize)));
 			}
 		}
-		Assert(tcSize < conn->msgSize);
+		Assert(tcSize < msgSize);
 
 		/*
 		 * We store the data inplace, and handle any necessary copying later
@@ -195,7 +241,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 
 		tcItem->p_next = NULL;
 		tcItem->chunk_length = tcSize;
-		tcItem->inplace = (char *) (conn->msgPos + bytesProcessed);
+		tcItem->inplace = (char *) (msgPos + bytesProcessed);
 
 		bytesProcessed += tcSize;
 
@@ -221,10 +267,218 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 	}
 
 	conn->msgSize = 0;
+	conn->msgCompressed = false;
 
 	return firstTcItem;
 }
 
+/*
+ * Compress the payload in 'buf', the bytes from 'hdrlen' up to *size, in
+ * place.
+ *
+ * Returns true, with *size set to the size of the compressed message, if
+ * the payload was compressed; the caller flags the message header
+ * accordingly.  Returns false, leaving the buffer alone, if the message is
+ * to be sent raw.  *skip counts the messages left to send raw after one
+ * didn't compress well, and the payload size before and after compression
+ * is added to *rawBytes and *wireBytes.
+ */
+bool
+compressMotionData(uint8 *buf, int32 *size, int hdrlen, int *skip,
+				   uint64 *rawBytes, uint64 *wireBytes)
+{
+#ifdef USE_ZSTD
+	int			rawlen = *size - hdrlen;
+	size_t		complen;
+
+	if (Gp_interconnect_compression == INTERCONNECT_COMPRESSION_OFF ||
+		rawlen < IC_COMPRESS_MIN_BYTES)
+		return false;
+
+	*rawBytes += rawlen;
+
+	if (*skip > 0)
+	{
+		(*skip)--;
+		*wireBytes += rawlen;
+		return false;
+	}
+
+	if (ic_compress_cxt == NULL)
+	{
+		ic_compress_cxt = ZSTD_createCCtx();
+		if (ic_compress_cxt == NULL)
+			elog(ERROR, "out of memory");
+		ic_compress_buf = MemoryContextAlloc(TopMemoryContext, Gp_max_packet_size);
+	}
+
+	/*
+	 * Give zstd one byte less than the raw payload to write into: if it
+	 * doesn't fit in that, there's nothing to gain.
+	 */
+	complen = ZSTD_compressCCtx(ic_compress_cxt,
+								ic_compress_buf, rawlen - 1,
+								buf + hdrlen, rawlen,
+								IC_COMPRESS_LEVEL);
+	if (ZSTD_isError(complen))
+		complen = rawlen;
+
+	if (Gp_interconnect_compression == INTERCONNECT_COMPRESSION_AUTO &&
+		complen * 10 > (size_t) rawlen * 9)
+		*skip = IC_COMPRESS_SKIP_BUFFERS;
+
+	if (complen >= rawlen)
+	{
+		*wireBytes += rawlen;
+		return false;
+	}
+
+	memcpy(buf + hdrlen, ic_compress_buf, complen);
+	*size = hdrlen + complen;
+	*wireBytes += complen;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Compress the payload in the buffer of 'conn', see compressMotionData().
+ */
+bool
+compressMotionBuffer(MotionConn *conn, int hdrlen)
+{
+	return compressMotionData(conn->pBuff, &conn->msgSize, hdrlen,
+							  &conn->compressSkip,
+							  &conn->stat_compress_raw_bytes,
+							  &conn->stat_compress_wire_bytes);
+}
+
+/*
+ * Decompress the message in the buffer of 'conn', whose payload follows a
+ * header of 'hdrlen' bytes.
+ *
+ * The header and the decompressed payload are put in a scratch buffer,
+ * returned in *msgPos and *msgSize.  It is overwritten by the next message
+ * decompressed, the chunks formed from it are materialized before that if
+ * they need to be kept.
+ */
+static void
+decompressMotionMessage(MotionConn *conn, int hdrlen,
+						uint8 **msgPos, int32 *msgSize)
+{
+#ifdef USE_ZSTD
+	size_t		rawlen;
+
+	if (ic_decompress_cxt == NULL)
+	{
+		ic_decompress_cxt = ZSTD_createDCtx();
+		if (ic_decompress_cxt == NULL)
+			elog(ERROR, "out of memory");
+		ic_decompress_buf = MemoryContextAlloc(TopMemoryContext, Gp_max_packet_size);
+	}
+
+	memcpy(ic_decompress_buf, conn->msgPos, hdrlen);
+	rawlen = ZSTD_decompressDCtx(ic_decompress_cxt,
+								 ic_decompress_buf + hdrlen,
+								 Gp_max_packet_size - hdrlen,
+								 conn->msgPos + hdrlen,
+								 conn->msgSize - hdrlen);
+	if (ZSTD_isError(rawlen))
+		ereport(ERROR,
+				(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+				 errmsg("interconnect error: could not decompress message"),
+				 errdetail("From seg%d at %s: %s",
+						   conn->remoteContentId, conn->remoteHostAndPort,
+						   ZSTD_getErrorName(rawlen))));
+
+	conn->stat_compress_wire_bytes += conn->msgSize - hdrlen;
+	conn->stat_compress_raw_bytes += rawlen;
+
+	*msgPos = (uint8 *) ic_decompress_buf;
+	*msgSize = hdrlen + rawlen;
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+			 errmsg("interconnect error: received a compressed message"),
+			 errdetail("Interconnect compression is not supported by this build.")));
+#endif
+}
+
+/*
+ * Sum up the compression statistics of the connections of a Motion node,
+ * for EXPLAIN ANALYZE.  Both are left at 0 if nothing was compressed, or if
+ * the Motion node has no connections here.
+ */
+void
+getMotionCompressionStats(ChunkTransportState *transportStates,
+						  int16 motNodeID,
+						  uint64 *rawBytes,
+						  uint64 *wireBytes)
+{
+	ChunkTransportStateEntry *pEntry;
+
+	*rawBytes = 0;
+	*wireBytes = 0;
+
+	if (transportStates == NULL ||
+		motNodeID <= 0 || motNodeID > transportStates->size)
+		return;
+
+	pEntry = &transportStates->states[motNodeID - 1];
+	if (!pEntry->valid || pEntry->motNodeId != motNodeID)
+		return;
+
+	for (int i = 0; i < pEntry->numConns; i++)
+	{
+		MotionConn *conn = pEntry->conns + i;
+
+		*rawBytes += conn->stat_compress_raw_bytes;
+		*wireBytes += conn->stat_compress_wire_bytes;
+	}
+}
+
+/*
+ * Sum up the bytes a Motion node sent, the part of them it sent through
+ * shared memory, and count the receivers it sent them to, for EXPLAIN
+ * ANALYZE.  All are left at 0 if the Motion node sends nothing from here.
+ */
+void
+getMotionSendStats(ChunkTransportState *transportStates,
+				   int16 motNodeID,
+				   uint64 *bytesSent,
+				   uint64 *localBytes,
+				   int *numReceivers)
+{
+	ChunkTransportStateEntry *pEntry;
+
+	*bytesSent = 0;
+	*localBytes = 0;
+	*numReceivers = 0;
+
+	if (transportStates == NULL ||
+		motNodeID <= 0 || motNodeID > transportStates->size)
+		return;
+
+	pEntry = &transportStates->states[motNodeID - 1];
+	if (!pEntry->valid || pEntry->motNodeId != motNodeID)
+		return;
+
+	for (int i = 0; i < pEntry->numConns; i++)
+	{
+		MotionConn *conn = pEntry->conns + i;
+
+		if (conn->stat_bytes_sent == 0)
+			continue;
+
+		*bytesSent += conn->stat_bytes_sent;
+		if (conn->shmLocal)
+			*localBytes += conn->stat_bytes_sent;
+		(*numReceivers)++;
+	}
+}
+
 /*=========================================================================
  * VISIBLE FUNCTIONS
  */
@@ -275,6 +529,62 @@ CleanUpMotionLayerIPC(void)
 	UDP_listenerFd = -1;
 }
 
+/*
+ * Add a chunk a Broadcast Motion sends to the broadcast buffer of the
+ * Motion node, sending the buffer to all receivers first if the chunk
+ * doesn't fit.  Returns true if the buffer was sent, which may have found
+ * receivers that don't want more tuples.
+ *
+ * Chunks are copied here once, and the transport compresses the buffer
+ * once.  TCP then writes the same bytes to every socket; UDPIFC still copies
+ * the buffer into a packet of each connection, since every connection
+ * retransmits its own packets, but that is one copy per packet rather than
+ * one per chunk.
+ */
+static bool
+broadcastChunk(ChunkTransportState *transportStates,
+			   ChunkTransportStateEntry *pEntry,
+			   TupleChunkListItem tcItem)
+{
+	bool		sent = false;
+
+	if (pEntry->bcastBuff == NULL)
+	{
+		pEntry->bcastBuff = MemoryContextAlloc(GetMemoryChunkContext(pEntry->conns),
+											   Gp_max_packet_size);
+		pEntry->bcastSize = transportStates->broadcastHdrLen;
+		pEntry->bcastTupleCount = 0;
+	}
+
+	if (pEntry->bcastSize + tcItem->chunk_length > Gp_max_packet_size)
+	{
+		flushBroadcastBuffer(transportStates, pEntry);
+		sent = true;
+	}
+
+	memcpy(pEntry->bcastBuff + pEntry->bcastSize,
+		   tcItem->chunk_data, tcItem->chunk_length);
+	pEntry->bcastSize += tcItem->chunk_length;
+	pEntry->bcastTupleCount++;
+
+	return sent;
+}
+
+/* See ml_ipc.h */
+void
+flushBroadcastBuffer(ChunkTransportState *transportStates,
+					 ChunkTransportStateEntry *pEntry)
+{
+	if (pEntry->bcastBuff == NULL ||
+		pEntry->bcastSize <= transportStates->broadcastHdrLen)
+		return;
+
+	transportStates->SendBroadcast(transportStates, pEntry);
+
+	pEntry->bcastSize = transportStates->broadcastHdrLen;
+	pEntry->bcastTupleCount = 0;
+}
+
 /* See ml_ipc.h */
 bool
 SendTupleChunkToAMS(MotionLayerState *mlStates,
@@ -317,10 +627,19 @@ SendTupleChunkToAMS(MotionLayerState *mlStates,
 
 		if (targetRoute == BROADCAST_SEGIDX)
 		{
-			doBroadcast(transportStates, pEntry, currItem, &recount);
+			if (transportStates->SendBroadcast != NULL && pEntry->numConns > 1)
+			{
+				if (broadcastChunk(transportStates, pEntry, currItem))
+					recount = 1;
+			}
+			else
+				doBroadcast(transportStates, pEntry, currItem, &recount);
 		}
 		else
 		{
+			/* keep the order of what was broadcast before */
+			flushBroadcastBuffer(transportStates, pEntry);
+
 			if (targetRoute < 0 || targetRoute >= pEntry->numConns)
 			{
 				elog(FATAL, "SendTupleChunkToAMS: targetRoute is %d, must be between 0 and %d .",
@@ -389,6 +708,9 @@ getTransportDirectBuffer(ChunkTransportState *transportStates,
 	{
 		getChunkTransportState(transportStates, motNodeID, &pEntry);
 
+		/* keep the order of what was broadcast before */
+		flushBroadcastBuffer(transportStates, pEntry);
+
 		/* handle pt-to-pt message. Primary */
 		conn = pEntry->conns + targetRoute;
 		/* only send to interested connections */
@@ -643,6 +965,11 @@ createChunkTransportState(ChunkTransportState *transportStates,
 
 	pEntry->conns = palloc0(pEntry->numConns * sizeof(pEntry->conns[0]));
 
+	pEntry->bcastBuff = NULL;
+	pEntry->bcastSize = 0;
+	pEntry->bcastTupleCount = 0;
+	pEntry->bcastCompressSkip = 0;
+
 	for (i = 0; i < pEntry->numConns; i++)
 	{
 		MotionConn *conn = &pEntry->conns[i];
@@ -704,6 +1031,12 @@ removeChunkTransportState(ChunkTransportState *transportStates,
 		pEntry = &transportStates->states[motNodeID - 1];
 	}
 
+	if (pEntry->bcastBuff != NULL)
+	{
+		pfree(pEntry->bcastBuff);
+		pEntry->bcastBuff = NULL;
+	}
+
 	MPP_FD_ZERO(&pEntry->readSet);
 
 	return pEntry;
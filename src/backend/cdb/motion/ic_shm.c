@@ -0,0 +1,485 @@
+/*-------------------------------------------------------------------------
+ * ic_shm.c
+ *	   Shared-memory queues for Motion connections between two processes of
+ *	   the same segment.
+ *
+ * A connection whose sender and receiver run under the same postmaster,
+ * that is, the two QEs of a segment on either side of a Motion, or the QD
+ * and the entry-db QE, doesn't need to go through the network stack.  Its
+ * packets are passed through a shm_mq in a DSM segment of its own instead,
+ * and the transport keeps the MotionConn and ChunkTransportState interface
+ * for it: only the way the buffer of the connection is carried changes.
+ *
+ * The two ends of a connection meet in a registry in shared memory, keyed
+ * by the session, the interconnect instance, the Motion node and the pids
+ * of the sender and the receiver.  Whichever end comes first creates the
+ * segment and registers it; the other end attaches to it and removes the
+ * entry.  The segment is pinned while it is registered, so that a sender
+ * done before its receiver even came can leave its packets behind.  A
+ * receiver gone before its sender came leaves a closed entry, which tells
+ * the sender that nobody wants its tuples, the way a stop message would.
+ * The entries whose peer never came are freed once the interconnect
+ * instance they belong to is over, see icShmSlotIsStale().
+ *
+ * DSM segments are private to a postmaster, so peers of two segments on
+ * the same host still use the network.
+ *
+ * Copyright (c) 2024-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/cdb/motion/ic_shm.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "miscadmin.h"
+#include "storage/dsm.h"
+#include "storage/ipc.h"
+#include "storage/lwlock.h"
+#include "storage/proc.h"
+#include "storage/shm_mq.h"
+#include "storage/shmem.h"
+
+#include "cdb/cdbgang.h"
+#include "cdb/cdbinterconnect.h"
+#include "cdb/cdbvars.h"
+#include "cdb/ic_shm.h"
+
+/*
+ * Registry slots per backend.  A QE has a connection in the registry only
+ * until its peer attaches, for each Motion node it sends or receives.
+ */
+#define IC_SHM_SLOTS_PER_BACKEND	4
+
+/* Packets a queue holds before the sender has to wait for the receiver */
+#define IC_SHM_QUEUE_PACKETS		32
+
+typedef struct ICShmSlot
+{
+	/* key */
+	int32		sessionId;
+	uint32		icId;
+	int16		motNodeId;
+	int32		senderPid;
+	int32		receiverPid;
+
+	/* pid of the backend that registered the slot, 0 if the slot is free */
+	int32		creatorPid;
+
+	/* segment of the queue, invalid once the receiver closed the slot */
+	dsm_handle	handle;
+} ICShmSlot;
+
+typedef struct ICShmRegistry
+{
+	int			numSlots;
+	ICShmSlot	slots[FLEXIBLE_ARRAY_MEMBER];
+} ICShmRegistry;
+
+static ICShmRegistry *icShmRegistry = NULL;
+
+static bool icShmExitCallbackRegistered = false;
+
+static int	icShmNumSlots(void);
+static ICShmSlot *icShmFindSlot(int32 sessionId, uint32 icId, int16 motNodeId,
+								int32 senderPid, int32 receiverPid);
+static void icShmFreeSlot(ICShmSlot *slot);
+static bool icShmSlotIsStale(ICShmSlot *slot, uint32 icId, bool tornDown);
+static dsm_segment *icShmTakeSlot(ICShmSlot *slot, int16 motNodeId);
+static void icShmDropSegment(dsm_segment *seg);
+static void icShmExitCallback(int code, Datum arg);
+
+static int
+icShmNumSlots(void)
+{
+	return MaxBackends * IC_SHM_SLOTS_PER_BACKEND;
+}
+
+/*
+ * Size of the registry of shared-memory connections.
+ */
+Size
+ICShmShmemSize(void)
+{
+	return add_size(offsetof(ICShmRegistry, slots),
+					mul_size(icShmNumSlots(), sizeof(ICShmSlot)));
+}
+
+/*
+ * Initialize the registry of shared-memory connections.
+ */
+void
+ICShmShmemInit(void)
+{
+	bool		found;
+
+	icShmRegistry = ShmemInitStruct("Interconnect Shared Memory Queues",
+									ICShmShmemSize(),
+									&found);
+	if (!found)
+	{
+		MemSet(icShmRegistry, 0, ICShmShmemSize());
+		icShmRegistry->numSlots = icShmNumSlots();
+	}
+}
+
+/*
+ * Does the connection to or from the given process go through shared
+ * memory?  Both ends of a connection come to the same answer.
+ */
+bool
+icShmPeerIsLocal(struct CdbProcess *cdbProc)
+{
+	return gp_interconnect_shm &&
+		Gp_interconnect_type == INTERCONNECT_TYPE_UDPIFC &&
+		cdbProc != NULL &&
+		cdbProc->dbid == GpIdentity.dbid;
+}
+
+/*
+ * Find the slot with the given key.
+ *
+ * MUST BE CALLED WITH InterconnectShmLock HELD.
+ */
+static ICShmSlot *
+icShmFindSlot(int32 sessionId, uint32 icId, int16 motNodeId,
+			  int32 senderPid, int32 receiverPid)
+{
+	for (int i = 0; i < icShmRegistry->numSlots; i++)
+	{
+		ICShmSlot  *slot = &icShmRegistry->slots[i];
+
+		if (slot->creatorPid != 0 &&
+			slot->sessionId == sessionId &&
+			slot->icId == icId &&
+			slot->motNodeId == motNodeId &&
+			slot->senderPid == senderPid &&
+			slot->receiverPid == receiverPid)
+			return slot;
+	}
+
+	return NULL;
+}
+
+/*
+ * Free a slot, and let its segment go once nobody maps it anymore.
+ *
+ * MUST BE CALLED WITH InterconnectShmLock HELD.
+ */
+static void
+icShmFreeSlot(ICShmSlot *slot)
+{
+	if (slot->handle != DSM_HANDLE_INVALID)
+		dsm_unpin_segment(slot->handle);
+
+	MemSet(slot, 0, sizeof(ICShmSlot));
+}
+
+/*
+ * Is a slot this backend registered one that no peer will come for anymore?
+ * 'icId' is the interconnect instance being set up, or, if 'tornDown', the
+ * one being torn down.
+ *
+ * The QD tears an instance down once its QEs are done with it, so none of
+ * their ends is still to come then.  It may run several instances at once,
+ * for cursors, so the slots of the others are left alone.  A QE runs one
+ * instance at a time, and the QD waits for all of the QEs of an instance
+ * before it starts the next, so the slots of earlier instances are stale;
+ * those of the current one may still be claimed after we tore it down.
+ *
+ * MUST BE CALLED WITH InterconnectShmLock HELD.
+ */
+static bool
+icShmSlotIsStale(ICShmSlot *slot, uint32 icId, bool tornDown)
+{
+	if (slot->creatorPid != MyProcPid || slot->sessionId != gp_session_id)
+		return false;
+
+	if (Gp_role == GP_ROLE_DISPATCH)
+		return tornDown && slot->icId == icId;
+
+	return slot->icId != icId;
+}
+
+/*
+ * Free the slots this backend registered that no peer will come for anymore,
+ * at the teardown of interconnect instance 'icId'.
+ */
+void
+icShmReleaseSlots(uint32 icId)
+{
+	if (icShmRegistry == NULL || !icShmExitCallbackRegistered)
+		return;
+
+	LWLockAcquire(InterconnectShmLock, LW_EXCLUSIVE);
+	for (int i = 0; i < icShmRegistry->numSlots; i++)
+	{
+		ICShmSlot  *slot = &icShmRegistry->slots[i];
+
+		if (icShmSlotIsStale(slot, icId, true))
+			icShmFreeSlot(slot);
+	}
+	LWLockRelease(InterconnectShmLock);
+}
+
+/*
+ * Free the slots this backend registered and its peers never claimed, when
+ * it exits.
+ */
+static void
+icShmExitCallback(int code, Datum arg)
+{
+	LWLockAcquire(InterconnectShmLock, LW_EXCLUSIVE);
+	for (int i = 0; i < icShmRegistry->numSlots; i++)
+	{
+		ICShmSlot  *slot = &icShmRegistry->slots[i];
+
+		if (slot->creatorPid == MyProcPid)
+			icShmFreeSlot(slot);
+	}
+	LWLockRelease(InterconnectShmLock);
+}
+
+/*
+ * Take the segment of a slot registered by the peer of a connection out of
+ * the registry, and attach to it.  The slot's pin keeps the segment alive
+ * until we have mapped it, so that is done without the lock.
+ *
+ * MUST BE CALLED WITH InterconnectShmLock HELD, returns with it released.
+ */
+static dsm_segment *
+icShmTakeSlot(ICShmSlot *slot, int16 motNodeId)
+{
+	dsm_handle	handle = slot->handle;
+	dsm_segment *seg;
+
+	MemSet(slot, 0, sizeof(ICShmSlot));
+	LWLockRelease(InterconnectShmLock);
+
+	seg = dsm_attach(handle);
+	dsm_unpin_segment(handle);
+	if (seg == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+				 errmsg("interconnect error: could not attach to the shared memory queue of Motion node %d",
+						motNodeId)));
+	dsm_pin_mapping(seg);
+
+	return seg;
+}
+
+/*
+ * Destroy a segment we created but didn't get to register.
+ */
+static void
+icShmDropSegment(dsm_segment *seg)
+{
+	dsm_unpin_segment(dsm_segment_handle(seg));
+	dsm_detach(seg);
+}
+
+/*
+ * Set up the shared-memory queue of a connection of Motion node
+ * 'motNodeId' of interconnect instance 'icId', whose peer is conn->cdbProc.
+ *
+ * The segment of a new queue is created without InterconnectShmLock held,
+ * since that takes system calls; the lock is only taken to look the peer up
+ * in the registry and to register the segment.  The peer may have
+ * registered its own segment in between, in which case ours is dropped.
+ *
+ * Returns false if the connection is closed already: the receiver was
+ * done before the sender came.
+ */
+bool
+icShmAttach(MotionConn *conn, uint32 icId, int16 motNodeId, bool isSender)
+{
+	int32		senderPid = isSender ? MyProcPid : conn->cdbProc->pid;
+	int32		receiverPid = isSender ? conn->cdbProc->pid : MyProcPid;
+	Size		size = MAXALIGN(IC_SHM_QUEUE_PACKETS * (Size) Gp_max_packet_size);
+	ICShmSlot  *slot;
+	dsm_segment *seg = NULL;
+	dsm_segment *newSeg = NULL;
+	shm_mq	   *mq;
+
+	Assert(icShmRegistry != NULL);
+
+	for (;;)
+	{
+		LWLockAcquire(InterconnectShmLock, LW_EXCLUSIVE);
+
+		slot = icShmFindSlot(gp_session_id, icId, motNodeId, senderPid, receiverPid);
+		if (slot != NULL && slot->handle == DSM_HANDLE_INVALID)
+		{
+			/* closed by the receiver */
+			Assert(isSender);
+			icShmFreeSlot(slot);
+			LWLockRelease(InterconnectShmLock);
+
+			if (newSeg != NULL)
+				icShmDropSegment(newSeg);
+
+			conn->shmLocal = true;
+			return false;
+		}
+
+		if (slot != NULL)
+		{
+			/* the peer came first, take over its segment */
+			seg = icShmTakeSlot(slot, motNodeId);
+			if (newSeg != NULL)
+				icShmDropSegment(newSeg);
+			mq = (shm_mq *) dsm_segment_address(seg);
+			break;
+		}
+
+		if (newSeg == NULL)
+		{
+			/* create a segment, and look again */
+			LWLockRelease(InterconnectShmLock);
+
+			newSeg = dsm_create(size, 0);
+			dsm_pin_mapping(newSeg);
+			shm_mq_create(dsm_segment_address(newSeg), size);
+
+			/* keep the segment until the peer has attached to it */
+			dsm_pin_segment(newSeg);
+			continue;
+		}
+
+		/* still first, register our segment */
+		for (int i = 0; i < icShmRegistry->numSlots; i++)
+		{
+			ICShmSlot  *free_slot = &icShmRegistry->slots[i];
+
+			/* a slot of ours no peer will come for is free too */
+			if (icShmSlotIsStale(free_slot, icId, false))
+				icShmFreeSlot(free_slot);
+
+			if (free_slot->creatorPid == 0)
+			{
+				slot = free_slot;
+				break;
+			}
+		}
+		if (slot == NULL)
+		{
+			LWLockRelease(InterconnectShmLock);
+			icShmDropSegment(newSeg);
+			ereport(ERROR,
+					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+					 errmsg("interconnect error: out of shared memory queue slots"),
+					 errhint("Set gp_interconnect_shm to off to send the tuples of all Motion nodes over the network.")));
+		}
+
+		slot->sessionId = gp_session_id;
+		slot->icId = icId;
+		slot->motNodeId = motNodeId;
+		slot->senderPid = senderPid;
+		slot->receiverPid = receiverPid;
+		slot->creatorPid = MyProcPid;
+		slot->handle = dsm_segment_handle(newSeg);
+
+		LWLockRelease(InterconnectShmLock);
+
+		if (!icShmExitCallbackRegistered)
+		{
+			before_shmem_exit(icShmExitCallback, 0);
+			icShmExitCallbackRegistered = true;
+		}
+
+		seg = newSeg;
+		mq = (shm_mq *) dsm_segment_address(seg);
+		break;
+	}
+
+	if (isSender)
+		shm_mq_set_sender(mq, MyProc);
+	else
+		shm_mq_set_receiver(mq, MyProc);
+
+	conn->shmSeg = seg;
+	conn->shmQueue = shm_mq_attach(mq, seg, NULL);
+	conn->shmLocal = true;
+
+	return true;
+}
+
+/*
+ * Send a packet through the shared-memory queue of a connection, waiting
+ * for room in the queue if needed.
+ *
+ * Returns false if the receiver doesn't want more tuples.
+ */
+bool
+icShmSend(MotionConn *conn, const void *data, Size size)
+{
+	shm_mq_result res;
+
+	Assert(conn->shmQueue != NULL);
+
+	res = shm_mq_send(conn->shmQueue, size, data, false);
+	if (res == SHM_MQ_DETACHED)
+		return false;
+
+	Assert(res == SHM_MQ_SUCCESS);
+	return true;
+}
+
+/*
+ * Take the next packet from the shared-memory queue of a connection,
+ * without waiting.  The packet stays valid until the next call.
+ */
+shm_mq_result
+icShmReceive(MotionConn *conn, void **data, Size *size)
+{
+	Assert(conn->shmQueue != NULL);
+
+	return shm_mq_receive(conn->shmQueue, size, data, true);
+}
+
+/*
+ * Detach from the shared-memory queue of a connection.
+ *
+ * A sender leaves a queue its receiver didn't come for yet to it, unless
+ * the query failed.  A receiver closes it, so that a sender still to come
+ * knows that nobody wants its tuples.
+ *
+ * Doesn't throw errors, it is called during teardown.
+ */
+void
+icShmDetach(MotionConn *conn, bool isSender, bool hasErrors)
+{
+	dsm_handle	handle;
+
+	if (conn->shmSeg == NULL)
+		return;
+
+	handle = dsm_segment_handle(conn->shmSeg);
+
+	LWLockAcquire(InterconnectShmLock, LW_EXCLUSIVE);
+	for (int i = 0; i < icShmRegistry->numSlots; i++)
+	{
+		ICShmSlot  *slot = &icShmRegistry->slots[i];
+
+		if (slot->creatorPid != MyProcPid || slot->handle != handle)
+			continue;
+
+		if (!isSender)
+		{
+			dsm_unpin_segment(slot->handle);
+			slot->handle = DSM_HANDLE_INVALID;
+		}
+		else if (hasErrors)
+			icShmFreeSlot(slot);
+		break;
+	}
+	LWLockRelease(InterconnectShmLock);
+
+	shm_mq_detach(conn->shmQueue);
+	dsm_detach(conn->shmSeg);
+	conn->shmQueue = NULL;
+	conn->shmSeg = NULL;
+}
@@ -118,6 +118,12 @@ static bool SendChunkTCP(ChunkTransportState *transportStates,
 static bool flushBuffer(ChunkTransportState *transportStates,
 			ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId);
 
+static bool sendPacketTCP(ChunkTransportState *transportStates, MotionConn *conn,
+			  char *sendptr, int len);
+
+static void SendBroadcastTCP(ChunkTransportState *transportStates,
+				 ChunkTransportStateEntry *pEntry);
+
 static void doSendStopMessageTCP(ChunkTransportState *transportStates, int16 motNodeID);
 
 #ifdef AMS_VERBOSE_LOGGING
@@ -323,6 +329,20 @@ CleanupMotionTCP(void)
  *	 conn - MotionConn to read the packet from.
  *
  */
+/*
+ * Read the size word at the start of the message at conn->msgPos into
+ * conn->msgSize, and whether its payload is compressed.
+ */
+static inline void
+readPacketHeader(MotionConn *conn)
+{
+	uint32		hdr;
+
+	memcpy(&hdr, conn->msgPos, sizeof(uint32));
+	conn->msgCompressed = (hdr & PACKET_COMPRESSED_FLAG) != 0;
+	conn->msgSize = hdr & ~PACKET_COMPRESSED_FLAG;
+}
+
 /* static inline void */
 void
 readPacket(MotionConn *conn, ChunkTransportState *transportStates)
@@ -340,7 +360,7 @@ readPacket(MotionConn *conn, ChunkTransportState *transportStates)
 	/* do we have a complete message waiting to be processed ? */
 	if (conn->recvBytes >= PACKET_HEADER_SIZE)
 	{
-		memcpy(&conn->msgSize, conn->msgPos, sizeof(uint32));
+		readPacketHeader(conn);
 		gotHeader = true;
 		if (conn->recvBytes >= conn->msgSize)
 		{
@@ -449,7 +469,7 @@ readPacket(MotionConn *conn, ChunkTransportState *transportStates)
 			if (!gotHeader && bytesRead >= PACKET_HEADER_SIZE)
 			{
 				/* got the header */
-				memcpy(&conn->msgSize, conn->msgPos, sizeof(uint32));
+				readPacketHeader(conn);
 				gotHeader = true;
 			}
 			conn->recvBytes = bytesRead;
@@ -1289,6 +1309,8 @@ SetupTCPInterconnect(EState *estate)
 	interconnect_context->RecvTupleChunkFromAny = RecvTupleChunkFromAnyTCP;
 	interconnect_context->SendEos = SendEosTCP;
 	interconnect_context->SendChunk = SendChunkTCP;
+	interconnect_context->SendBroadcast = SendBroadcastTCP;
+	interconnect_context->broadcastHdrLen = PACKET_HEADER_SIZE;
 	interconnect_context->doSendStopMessage = doSendStopMessageTCP;
 
 #ifdef ENABLE_IC_PROXY
@@ -2763,6 +2785,9 @@ SendEosTCP(ChunkTransportState *transportStates,
 		elog(DEBUG3, "Interconnect seg%d slice%d sending end-of-stream to slice%d",
 			 GpIdentity.segindex, motNodeID, pEntry->recvSlice->sliceIndex);
 
+	/* tuples still in the broadcast buffer go before the end-of-stream */
+	flushBroadcastBuffer(transportStates, pEntry);
+
 	/*
 	 * we want to add our tcItem onto each of the outgoing buffers -- this is
 	 * guaranteed to leave things in a state where a flush is *required*.
@@ -2785,31 +2810,20 @@ SendEosTCP(ChunkTransportState *transportStates,
 	return;
 }
 
+/*
+ * Send the 'len' bytes at 'sendptr', a complete packet, to the receiver of
+ * 'conn'.  Returns false, with the connection marked inactive, if the
+ * receiver asked us to stop sending or tore down the interconnect.
+ */
 static bool
-flushBuffer(ChunkTransportState *transportStates,
-			ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId)
+sendPacketTCP(ChunkTransportState *transportStates, MotionConn *conn,
+			  char *sendptr, int len)
 {
-	char	   *sendptr;
 	int			n,
-				sent = 0;
+				sent;
 	mpp_fd_set	wset;
 	mpp_fd_set	rset;
 
-#ifdef AMS_VERBOSE_LOGGING
-	{
-		struct timeval snapTime;
-
-		gettimeofday(&snapTime, NULL);
-		elog(DEBUG5, "----sending chunk @%s.%d time is %d.%d",
-			 __FILE__, __LINE__, (int) snapTime.tv_sec, (int) snapTime.tv_usec);
-	}
-#endif
-
-	/* first set header length */
-	*(uint32 *) conn->pBuff = conn->msgSize;
-
-	/* now send message */
-	sendptr = (char *) conn->pBuff;
 	sent = 0;
 	do
 	{
@@ -2837,7 +2851,7 @@ flushBuffer(ChunkTransportState *transportStates,
 			return false;
 		}
 
-		if ((n = send(conn->sockfd, sendptr + sent, conn->msgSize - sent, 0)) < 0)
+		if ((n = send(conn->sockfd, sendptr + sent, len - sent, 0)) < 0)
 		{
 			int			send_errno = errno;
 
@@ -2949,7 +2963,39 @@ flushBuffer(ChunkTransportState *transportStates,
 		{
 			sent += n;
 		}
-	} while (sent < conn->msgSize);
+	} while (sent < len);
+
+	conn->stat_bytes_sent += len;
+
+	return true;
+}
+
+static bool
+flushBuffer(ChunkTransportState *transportStates,
+			ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId)
+{
+#ifdef AMS_VERBOSE_LOGGING
+	{
+		struct timeval snapTime;
+
+		gettimeofday(&snapTime, NULL);
+		elog(DEBUG5, "----sending chunk @%s.%d time is %d.%d",
+			 __FILE__, __LINE__, (int) snapTime.tv_sec, (int) snapTime.tv_usec);
+	}
+#endif
+
+	/*
+	 * first set header length.  The proxy reads the length of the packets it
+	 * forwards, so we only compress when talking to the peer directly.
+	 */
+	if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP &&
+		compressMotionBuffer(conn, PACKET_HEADER_SIZE))
+		*(uint32 *) conn->pBuff = conn->msgSize | PACKET_COMPRESSED_FLAG;
+	else
+		*(uint32 *) conn->pBuff = conn->msgSize;
+
+	if (!sendPacketTCP(transportStates, conn, (char *) conn->pBuff, conn->msgSize))
+		return false;
 
 	conn->tupleCount = 0;
 	conn->msgSize = PACKET_HEADER_SIZE;
@@ -2957,6 +3003,57 @@ flushBuffer(ChunkTransportState *transportStates,
 	return true;
 }
 
+/*
+ * Send the broadcast buffer of a Motion node to all its receivers, see
+ * broadcastChunk() in ic_common.c.
+ *
+ * The header is filled in and the payload compressed once, and the same
+ * bytes are then written to the socket of each receiver.
+ */
+static void
+SendBroadcastTCP(ChunkTransportState *transportStates,
+				 ChunkTransportStateEntry *pEntry)
+{
+	uint64		rawBytes = 0;
+	uint64		wireBytes = 0;
+	int			i,
+				index;
+
+	if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP &&
+		compressMotionData(pEntry->bcastBuff, &pEntry->bcastSize,
+						   PACKET_HEADER_SIZE, &pEntry->bcastCompressSkip,
+						   &rawBytes, &wireBytes))
+		*(uint32 *) pEntry->bcastBuff = pEntry->bcastSize | PACKET_COMPRESSED_FLAG;
+	else
+		*(uint32 *) pEntry->bcastBuff = pEntry->bcastSize;
+
+	/* same order as doBroadcast() */
+	index = Max(0, GpIdentity.segindex);
+	for (i = 0; i < pEntry->numConns; i++, index++)
+	{
+		MotionConn *conn;
+
+		if (index >= pEntry->numConns)
+			index = 0;
+		conn = pEntry->conns + index;
+
+		if (!conn->stillActive)
+			continue;
+
+		/* whatever was put in the buffer of the connection goes first */
+		if (conn->msgSize > PACKET_HEADER_SIZE &&
+			!flushBuffer(transportStates, pEntry, conn, pEntry->motNodeId))
+			continue;
+
+		if (sendPacketTCP(transportStates, conn,
+						  (char *) pEntry->bcastBuff, pEntry->bcastSize))
+		{
+			conn->stat_compress_raw_bytes += rawBytes;
+			conn->stat_compress_wire_bytes += wireBytes;
+		}
+	}
+}
+
 /* The Function sendChunk() is used to send a tcItem to a single
  * destination. Tuples often are *very small* we aggregate in our
  * local buffer before sending into the kernel.
@@ -34,6 +34,7 @@
 #include "access/transam.h"
 #include "access/xact.h"
 #include "common/ip.h"
+#include "funcapi.h"
 #include "nodes/execnodes.h"
 #include "nodes/pg_list.h"
 #include "nodes/print.h"
@@ -45,6 +46,8 @@
 #include "postmaster/postmaster.h"
 #include "storage/latch.h"
 #include "storage/pmsignal.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
 #include "utils/builtins.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
@@ -56,6 +59,7 @@
 #include "cdb/cdbdisp.h"
 #include "cdb/cdbdispatchresult.h"
 #include "cdb/cdbicudpfaultinjection.h"
+#include "cdb/ic_shm.h"
 
 #ifdef WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -151,6 +155,7 @@ int
 #define UDPIC_FLAGS_DISORDER    		(32)
 #define UDPIC_FLAGS_DUPLICATE   		(64)
 #define UDPIC_FLAGS_CAPACITY    		(128)
+#define UDPIC_FLAGS_COMPRESSED			(256)
 
 #define UDPIC_MIN_BUF_SIZE (128 * 1024)
 
@@ -367,6 +372,21 @@ struct SendControlInfo
 	/* slow start threshold */
 	float		ssthresh;
 
+	/*
+	 * Delay based flow control, see updateDelayBasedWindow().  Times are in
+	 * microseconds, delivery rates in packets per microsecond.
+	 */
+	uint64		minRtt;			/* smallest recent RTT sample */
+	uint64		minRttStamp;	/* when minRtt was sampled */
+	double		maxBw;			/* largest recent delivery rate */
+	int			maxBwAge;		/* rounds since maxBw was sampled */
+	uint64		delivered;		/* packets acknowledged so far */
+	uint64		roundStart;		/* start of the current round */
+	uint64		roundDelivered; /* delivered at the start of the round */
+	bool		roundAppLimited;	/* was the window not full in the round? */
+	bool		fullBw;			/* out of startup? */
+	double		fullBwTarget;	/* delivery rate startup tries to beat */
+	int			fullBwCount;	/* rounds it failed to */
 };
 
 /*
@@ -412,6 +432,13 @@ struct ICGlobalControlInfo
 	pthread_mutex_t lock;
 	Latch		latch;
 
+	/*
+	 * The latch the main thread waits on for packets: the process latch
+	 * while it also waits on shared-memory queues, whose senders set that
+	 * one, see receiveChunksUDPIFC().  Protected by the lock.
+	 */
+	Latch	   *mainLatch;
+
 	/* Am I a sender? */
 	bool		isSender;
 
@@ -527,6 +554,30 @@ static ICGlobalControlInfo ic_control_info;
 
 #define MAX_SEQS_IN_DISORDER_ACK (4)
 
+/*
+ * Parameters of delay based flow control, see updateDelayBasedWindow().
+ *
+ * The smallest RTT sample is kept for DELAY_FC_MIN_RTT_WINDOW, the largest
+ * delivery rate for DELAY_FC_BW_WINDOW_ROUNDS rounds.  Startup ends once the
+ * delivery rate grew by less than DELAY_FC_FULL_BW_GROWTH for
+ * DELAY_FC_FULL_BW_ROUNDS rounds in a row, after which the congestion window
+ * is DELAY_FC_CWND_GAIN times the estimated bandwidth-delay product.
+ */
+#define DELAY_FC_MIN_RTT_WINDOW (10 * 1000 * 1000)	/* 10s */
+#define DELAY_FC_BW_WINDOW_ROUNDS (10)
+#define DELAY_FC_FULL_BW_GROWTH (1.25)
+#define DELAY_FC_FULL_BW_ROUNDS (3)
+#define DELAY_FC_CWND_GAIN (2.0)
+
+/*
+ * Loss and delay based flow control both use the unack queue ring and the
+ * shared send buffers; they only differ in how they size the congestion
+ * window.
+ */
+#define FC_METHOD_USES_CWND \
+	(Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS || \
+	 Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_DELAY)
+
 /*
  * UnackQueueRing
  *
@@ -638,6 +689,45 @@ typedef struct ICStatistics
 /* Statistics for UDP interconnect. */
 static ICStatistics ic_statistics;
 
+/*
+ * ICConnStats
+ *
+ * Statistics of the connections the backends of this segment sent data on,
+ * by the content id of the receiver, summed up at teardown since the
+ * segment started.  They are kept in shared memory, so that those of every
+ * backend, of every slice, count.  See gp_interconnect_conn_stats().
+ *
+ * connections - the number of connections torn down.
+ * packets     - the number of data packets sent, not counting resends.
+ * bytes       - the number of bytes sent, headers included.
+ * localBytes  - the part of bytes sent through shared memory.
+ * retransmits - the number of packets sent again.
+ * sendTime    - the time the connections were open, in us.
+ * minRtt      - the smallest RTT sample, in us, 0 if none was taken.
+ * rtt         - the smoothed RTT at the last teardown, in us.
+ */
+typedef struct ICConnStats
+{
+	slock_t		mutex;			/* protects the fields below */
+	uint64		connections;
+	uint64		packets;
+	uint64		bytes;
+	uint64		localBytes;
+	uint64		retransmits;
+	uint64		sendTime;
+	uint64		minRtt;
+	uint64		rtt;
+} ICConnStats;
+
+/*
+ * The receivers whose connections are counted: the QD, and the segments
+ * with a content id below this.
+ */
+#define IC_CONN_STATS_MAX_RECEIVERS	1024
+
+/* Indexed by the content id of the receiver plus one, for the QD. */
+static ICConnStats *ic_conn_stats = NULL;
+
 /* Cached sockaddr of the listening udp socket */
 static struct sockaddr_storage udp_dummy_packet_sockaddr;
 
@@ -712,20 +802,31 @@ static inline TupleChunkListItem RecvTupleChunkFromAnyUDPIFC_Internal(ChunkTrans
 									 int16 *srcRoute);
 static inline TupleChunkListItem RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 								  int16 motNodeID,
-								  int16 srcRoute);
+								  int16 srcRoute,
+								  bool wait);
 static void TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 									bool hasErrors);
 
 static void freeDisorderedPackets(MotionConn *conn);
 
 static void prepareRxConnForRead(MotionConn *conn);
+static bool receiveShmPacket(MotionConn *conn);
+static MotionConn *receiveShmConns(ChunkTransportStateEntry *pEntry, MotionConn *conn);
+static bool hasActiveShmConns(ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static TupleChunkListItem RecvTupleChunkFromAnyUDPIFC(ChunkTransportState *transportStates,
 							int16 motNodeID,
 							int16 *srcRoute);
 
+static TupleChunkListItem recvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
+						 int16 motNodeID,
+						 int16 srcRoute,
+						 bool wait);
 static TupleChunkListItem RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
 						 int16 motNodeID,
 						 int16 srcRoute);
+static TupleChunkListItem PollTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
+						 int16 motNodeID,
+						 int16 srcRoute);
 static TupleChunkListItem receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEntry *pEntry,
 					int16 motNodeID, int16 *srcRoute, MotionConn *conn);
 
@@ -736,6 +837,11 @@ static void SendEosUDPIFC(ChunkTransportState *transportStates,
 			  int motNodeID, TupleChunkListItem tcItem);
 static bool SendChunkUDPIFC(ChunkTransportState *transportStates,
 				ChunkTransportStateEntry *pEntry, MotionConn *conn, TupleChunkListItem tcItem, int16 motionId);
+static bool pushBufferUDPIFC(ChunkTransportState *transportStates,
+				 ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId);
+static bool pushBufferShm(MotionConn *conn);
+static void SendBroadcastUDPIFC(ChunkTransportState *transportStates,
+					ChunkTransportStateEntry *pEntry);
 
 static void doSendStopMessageUDPIFC(ChunkTransportState *transportStates, int16 motNodeID);
 static void dispatcherAYT(void);
@@ -745,6 +851,7 @@ static void checkQDConnectionAlive(void);
 static void *rxThreadFunc(void *arg);
 
 static bool handleMismatch(icpkthdr *pkt, struct sockaddr_storage *peer, int peer_len);
+static void updateDelayBasedWindow(uint64 rtt, uint64 now, int inflight);
 static void handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now);
 static bool handleAcks(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry);
 static void handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, int16 motionId);
@@ -754,6 +861,7 @@ static bool handleAckForDuplicatePkt(MotionConn *conn, icpkthdr *pkt);
 static bool handleAckForDisorderPkt(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn, icpkthdr *pkt);
 
 static inline void prepareXmit(MotionConn *conn);
+static inline void prepareXmitHeader(MotionConn *conn, bool compressed);
 static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
@@ -778,6 +886,7 @@ static void initMutex(pthread_mutex_t *mutex);
 
 static inline void logPkt(char *prefix, icpkthdr *pkt);
 static void aggregateStatistics(ChunkTransportStateEntry *pEntry);
+static void recordConnStats(MotionConn *conn);
 
 static inline bool pollAcks(ChunkTransportState *transportStates, int fd, int timeout);
 
@@ -1428,6 +1537,7 @@ InitMotionUDPIFC(int *listenerSocketFd, uint16 *listenerPort)
 													   ALLOCSET_DEFAULT_MAXSIZE);
 	initMutex(&ic_control_info.lock);
 	InitLatch(&ic_control_info.latch);
+	ic_control_info.mainLatch = &ic_control_info.latch;
 	pg_atomic_init_u32(&ic_control_info.shutdown, 0);
 	ic_control_info.threadCreated = false;
 	ic_control_info.ic_instance_id = 0;
@@ -2002,6 +2112,13 @@ MlPutRxBufferIFC(ChunkTransportState *transportStates, int motNodeID, int route)
 
 	conn = pEntry->conns + route;
 
+	/* the packet stays in the queue until the next one is read */
+	if (conn->shmLocal)
+	{
+		conn->pBuff = NULL;
+		return;
+	}
+
 	memset(&param, 0, sizeof(AckSendParam));
 
 	pthread_mutex_lock(&ic_control_info.lock);
@@ -2773,6 +2890,7 @@ setupOutgoingUDPConnection(ChunkTransportState *transportStates, ChunkTransportS
 	conn->wakeup_ms = 0;
 	conn->remoteContentId = cdbProc->contentid;
 	conn->stat_min_ack_time = ~((uint64) 0);
+	conn->stat_setup_time = getCurrentTime();
 
 	/* Save the information for the error message if getaddrinfo fails */
 	if (strchr(cdbProc->listenerAddr, ':') != 0)
@@ -2890,6 +3008,10 @@ setupOutgoingUDPConnection(ChunkTransportState *transportStates, ChunkTransportS
 	conn->conn_info.seq = 1;
 	Assert(conn->peer.ss_family == AF_INET || conn->peer.ss_family == AF_INET6);
 
+	/* a receiver gone already doesn't want our tuples */
+	if (icShmPeerIsLocal(cdbProc) &&
+		!icShmAttach(conn, sliceTbl->ic_instance_id, pEntry->motNodeId, true))
+		conn->stillActive = false;
 }								/* setupOutgoingUDPConnection */
 
 /*
@@ -3022,7 +3144,10 @@ SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable)
 	interconnect_context->RecvTupleChunkFromAny = RecvTupleChunkFromAnyUDPIFC;
 	interconnect_context->SendEos = SendEosUDPIFC;
 	interconnect_context->SendChunk = SendChunkUDPIFC;
+	interconnect_context->SendBroadcast = SendBroadcastUDPIFC;
+	interconnect_context->broadcastHdrLen = sizeof(icpkthdr);
 	interconnect_context->doSendStopMessage = doSendStopMessageUDPIFC;
+	interconnect_context->PollTupleChunkFrom = PollTupleChunkFromUDPIFC;
 
 	mySlice = &interconnect_context->sliceTable->slices[sliceTable->localSlice];
 
@@ -3165,6 +3290,10 @@ SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable)
 				conn->conn_info.flags = UDPIC_FLAGS_RECEIVER_TO_SENDER;
 
 				connAddHash(&ic_control_info.connHtab, conn);
+
+				if (icShmPeerIsLocal(conn->cdbProc))
+					icShmAttach(conn, sliceTable->ic_instance_id,
+								pEntry->motNodeId, false);
 			}
 		}
 	}
@@ -3172,6 +3301,17 @@ SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable)
 	snd_control_info.cwnd = 0;
 	snd_control_info.minCwnd = 0;
 	snd_control_info.ssthresh = 0;
+	snd_control_info.minRtt = 0;
+	snd_control_info.minRttStamp = 0;
+	snd_control_info.maxBw = 0;
+	snd_control_info.maxBwAge = 0;
+	snd_control_info.delivered = 0;
+	snd_control_info.roundStart = 0;
+	snd_control_info.roundDelivered = 0;
+	snd_control_info.roundAppLimited = false;
+	snd_control_info.fullBw = false;
+	snd_control_info.fullBwTarget = 0;
+	snd_control_info.fullBwCount = 0;
 
 	/* Initiate outgoing connections. */
 	if (mySlice->parentIndex != -1)
@@ -3476,6 +3616,9 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 					/* compute some statistics */
 					computeNetworkStatistics(conn->rtt, &minRtt, &maxRtt, &avgRtt);
 					computeNetworkStatistics(conn->dev, &minDev, &maxDev, &avgDev);
+					recordConnStats(conn);
+
+					icShmDetach(conn, true, hasErrors);
 
 					icBufferListReturn(&conn->sndQueue, false);
 					icBufferListReturn(&conn->unackQueue, Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_CAPACITY ? false : true);
@@ -3552,6 +3695,8 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 
 					connDelHash(&ic_control_info.connHtab, conn);
 
+					icShmDetach(conn, false, hasErrors);
+
 					/*
 					 * putRxBufferAndSendAck() dequeues messages and moves
 					 * them to pBuff
@@ -3609,6 +3754,9 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		rx_control_info.lastTornIcId = transportStates->sliceTable->ic_instance_id;
 	}
 
+	/* Free the shared-memory queues no peer will come for anymore */
+	icShmReleaseSlots(transportStates->sliceTable->ic_instance_id);
+
 	elog((gp_interconnect_log_stats ? LOG : DEBUG1), "Interconnect State: "
 		 "isSender %d isReceiver %d "
 		 "snd_queue_depth %d recv_queue_depth %d Gp_max_packet_size %d "
@@ -3703,7 +3851,92 @@ prepareRxConnForRead(MotionConn *conn)
 	conn->pBuff = conn->pkt_q[conn->pkt_q_head];
 	conn->msgPos = conn->pBuff;
 	conn->msgSize = ((icpkthdr *) conn->pBuff)->len;
+	conn->msgCompressed = (((icpkthdr *) conn->pBuff)->flags & UDPIC_FLAGS_COMPRESSED) != 0;
+	conn->recvBytes = conn->msgSize;
+}
+
+/*
+ * receiveShmPacket
+ * 		Prepare a connection going through shared memory for reading, if
+ * 		its sender put a packet in the queue.
+ *
+ * The packet stays in the queue until MlPutRxBufferIFC() releases it: the
+ * next one is only taken from the queue after that.
+ *
+ * MUST BE CALLED WITH ic_control_info.lock LOCKED.
+ */
+static bool
+receiveShmPacket(MotionConn *conn)
+{
+	if (conn->shmQueue == NULL || !conn->stillActive)
+		return false;
+
+	if (conn->pBuff == NULL)
+	{
+		void	   *data;
+		Size		nbytes;
+
+		/*
+		 * A sender detached before its end-of-stream failed, wait for the
+		 * cancel like for a sender that stopped sending over the network.
+		 */
+		if (icShmReceive(conn, &data, &nbytes) != SHM_MQ_SUCCESS)
+			return false;
+
+		Assert(nbytes == ((icpkthdr *) data)->len);
+		conn->pBuff = data;
+	}
+
+	conn->msgPos = conn->pBuff;
+	conn->msgSize = ((icpkthdr *) conn->pBuff)->len;
+	conn->msgCompressed = (((icpkthdr *) conn->pBuff)->flags & UDPIC_FLAGS_COMPRESSED) != 0;
 	conn->recvBytes = conn->msgSize;
+
+	return true;
+}
+
+/*
+ * receiveShmConns
+ * 		Find a connection going through shared memory with a packet to read:
+ * 		the given one for a directed receive, any of the Motion node
+ * 		otherwise.
+ *
+ * MUST BE CALLED WITH ic_control_info.lock LOCKED.
+ */
+static MotionConn *
+receiveShmConns(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	if (conn != NULL)
+		return receiveShmPacket(conn) ? conn : NULL;
+
+	for (int i = 0; i < pEntry->numConns; i++)
+	{
+		MotionConn *rxconn = pEntry->conns + (pEntry->scanStart + i) % pEntry->numConns;
+
+		if (receiveShmPacket(rxconn))
+			return rxconn;
+	}
+
+	return NULL;
+}
+
+/*
+ * hasActiveShmConns
+ * 		Does a receive wait on a connection going through shared memory?
+ */
+static bool
+hasActiveShmConns(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	if (conn != NULL)
+		return conn->shmQueue != NULL;
+
+	for (int i = 0; i < pEntry->numConns; i++)
+	{
+		if (pEntry->conns[i].shmQueue != NULL && pEntry->conns[i].stillActive)
+			return true;
+	}
+
+	return false;
 }
 
 /*
@@ -3719,6 +3952,7 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 	int 		nFds = 0;
 	int 		*waitFds = NULL;
 	int 		nevent = 0;
+	Latch	   *latch;
 	TupleChunkListItem	tcItem = NULL;
 
 #ifdef AMS_VERBOSE_LOGGING
@@ -3741,6 +3975,13 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 							 pTransportStates->sliceTable->ic_instance_id);
 	}
 
+	/*
+	 * The senders of shared-memory queues set the process latch, wait on
+	 * that one while they may send, and have the rx thread set it too.
+	 */
+	latch = hasActiveShmConns(pEntry, conn) ? MyLatch : &ic_control_info.latch;
+	ic_control_info.mainLatch = latch;
+
 	nevent = 2; /* nevent = waited fds number + 2 (latch and postmaster) */
 	if (Gp_role == GP_ROLE_DISPATCH)
 	{
@@ -3759,7 +4000,7 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 	 */
 	PG_TRY();
 	{
-		AddWaitEventToSet(ICWaitSet, WL_LATCH_SET, PGINVALID_SOCKET, &ic_control_info.latch, NULL);
+		AddWaitEventToSet(ICWaitSet, WL_LATCH_SET, PGINVALID_SOCKET, latch, NULL);
 		AddWaitEventToSet(ICWaitSet, WL_POSTMASTER_DEATH, PGINVALID_SOCKET, NULL, NULL);
 		for (int i = 0; i < nFds; i++)
 		{
@@ -3799,6 +4040,13 @@ receiveChunksUDPIFCLoop(ChunkTransportState *pTransportStates, ChunkTransportSta
 	/* we didn't have any data, so we've got to read it from the network. */
 	for (;;)
 	{
+		/*
+		 * Arm the latch (before looking for messages, with the mutex held),
+		 * the RX thread and the senders of shared-memory queues will wake us
+		 * up using it when more messages arrive.
+		 */
+		ResetLatch(ic_control_info.mainLatch);
+
 		/* 1. Do we have data ready */
 		if (rx_control_info.mainWaitingState.reachRoute != ANY_ROUTE)
 		{
@@ -3809,6 +4057,8 @@ receiveChunksUDPIFCLoop(ChunkTransportState *pTransportStates, ChunkTransportSta
 			elog(DEBUG2, "receiveChunksUDPIFC: non-directed rx woke on route %d", rx_control_info.mainWaitingState.reachRoute);
 			resetMainThreadWaiting(&rx_control_info.mainWaitingState);
 		}
+		else if ((rxconn = receiveShmConns(pEntry, conn)) != NULL)
+			resetMainThreadWaiting(&rx_control_info.mainWaitingState);
 
 		aggregateStatistics(pEntry);
 
@@ -3831,11 +4081,9 @@ receiveChunksUDPIFCLoop(ChunkTransportState *pTransportStates, ChunkTransportSta
 		retries++;
 
 		/*
-		 * Ok, we've processed all the items currently in the queue. Arm the
-		 * latch (before releasing the mutex), and wait for more messages to
-		 * arrive. The RX thread will wake us up using the latch.
+		 * Ok, we've processed all the items currently in the queue, wait for
+		 * more messages to arrive.
 		 */
-		ResetLatch(&ic_control_info.latch);
 		pthread_mutex_unlock(&ic_control_info.lock);
 
 		if (gp_log_interconnect >= GPVARS_VERBOSITY_DEBUG)
@@ -3948,6 +4196,12 @@ RecvTupleChunkFromAnyUDPIFC_Internal(ChunkTransportState *transportStates,
 			prepareRxConnForRead(conn);
 			break;
 		}
+
+		if (receiveShmPacket(conn))
+		{
+			found = true;
+			break;
+		}
 	}
 
 	if (found)
@@ -4011,11 +4265,14 @@ RecvTupleChunkFromAnyUDPIFC(ChunkTransportState *transportStates,
 /*
  * RecvTupleChunkFromUDPIFC_Internal
  * 		Receive tuple chunks from a specific route (connection)
+ *
+ * If wait is false, returns NULL when no packet is there yet.
  */
 static inline TupleChunkListItem
 RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 								  int16 motNodeID,
-								  int16 srcRoute)
+								  int16 srcRoute,
+								  bool wait)
 {
 	ChunkTransportStateEntry *pEntry = NULL;
 	MotionConn *conn = NULL;
@@ -4062,9 +4319,10 @@ RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 	ic_statistics.totalRecvQueueSize += conn->pkt_q_size;
 	ic_statistics.recvQueueSizeCountingTime++;
 
-	if (conn->pkt_q[conn->pkt_q_head] != NULL)
+	if (conn->pkt_q[conn->pkt_q_head] != NULL || receiveShmPacket(conn))
 	{
-		prepareRxConnForRead(conn);
+		if (conn->shmQueue == NULL)
+			prepareRxConnForRead(conn);
 
 		pthread_mutex_unlock(&ic_control_info.lock);
 
@@ -4075,6 +4333,12 @@ RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 		return tcItem;
 	}
 
+	if (!wait)
+	{
+		pthread_mutex_unlock(&ic_control_info.lock);
+		return NULL;
+	}
+
 	/* no existing data, we've got to read a packet */
 	/* receiveChunksUDPIFC() releases ic_control_info.lock as a side-effect */
 
@@ -4084,19 +4348,21 @@ RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 }
 
 /*
- * RecvTupleChunkFromUDPIFC
- * 		Receive tuple chunks from a specific route (connection)
+ * recvTupleChunkFromUDPIFC
+ * 		Receive tuple chunks from a specific route (connection), waiting for
+ * 		them or not
  */
 static TupleChunkListItem
-RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
+recvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
 						 int16 motNodeID,
-						 int16 srcRoute)
+						 int16 srcRoute,
+						 bool wait)
 {
 	TupleChunkListItem icItem = NULL;
 
 	PG_TRY();
 	{
-		icItem = RecvTupleChunkFromUDPIFC_Internal(transportStates, motNodeID, srcRoute);
+		icItem = RecvTupleChunkFromUDPIFC_Internal(transportStates, motNodeID, srcRoute, wait);
 
 		/* error if mutex still held (debug build only) */
 		Assert(pthread_mutex_unlock(&ic_control_info.lock) != 0);
@@ -4112,6 +4378,31 @@ RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
 	return icItem;
 }
 
+/*
+ * RecvTupleChunkFromUDPIFC
+ * 		Receive tuple chunks from a specific route (connection)
+ */
+static TupleChunkListItem
+RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
+						 int16 motNodeID,
+						 int16 srcRoute)
+{
+	return recvTupleChunkFromUDPIFC(transportStates, motNodeID, srcRoute, true);
+}
+
+/*
+ * PollTupleChunkFromUDPIFC
+ * 		Receive tuple chunks from a specific route (connection) if a packet
+ * 		is there already
+ */
+static TupleChunkListItem
+PollTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
+						 int16 motNodeID,
+						 int16 srcRoute)
+{
+	return recvTupleChunkFromUDPIFC(transportStates, motNodeID, srcRoute, false);
+}
+
 /*
  * markUDPConnInactiveIFC
  * 		Mark the connection inactive.
@@ -4161,6 +4452,67 @@ aggregateStatistics(ChunkTransportStateEntry *pEntry)
 	}
 }
 
+/*
+ * ICConnStatsShmemSize
+ * 		Size of the connection statistics in shared memory.
+ */
+Size
+ICConnStatsShmemSize(void)
+{
+	return mul_size(IC_CONN_STATS_MAX_RECEIVERS + 1, sizeof(ICConnStats));
+}
+
+/*
+ * ICConnStatsShmemInit
+ * 		Initialize the connection statistics in shared memory.
+ */
+void
+ICConnStatsShmemInit(void)
+{
+	bool		found;
+
+	ic_conn_stats = ShmemInitStruct("Interconnect Connection Statistics",
+									ICConnStatsShmemSize(),
+									&found);
+	if (!found)
+	{
+		MemSet(ic_conn_stats, 0, ICConnStatsShmemSize());
+		for (int i = 0; i <= IC_CONN_STATS_MAX_RECEIVERS; i++)
+			SpinLockInit(&ic_conn_stats[i].mutex);
+	}
+}
+
+/*
+ * recordConnStats
+ * 		Add the statistics of an outgoing connection being torn down to
+ * 		those of its receiver.
+ */
+static void
+recordConnStats(MotionConn *conn)
+{
+	ICConnStats *stats;
+	int			idx = conn->remoteContentId + 1;
+	uint64		sendTime = getCurrentTime() - conn->stat_setup_time;
+
+	if (ic_conn_stats == NULL || idx < 0 || idx > IC_CONN_STATS_MAX_RECEIVERS)
+		return;
+
+	stats = &ic_conn_stats[idx];
+	SpinLockAcquire(&stats->mutex);
+	stats->connections++;
+	stats->packets += conn->sentSeq;
+	stats->bytes += conn->stat_bytes_sent;
+	if (conn->shmLocal)
+		stats->localBytes += conn->stat_bytes_sent;
+	stats->retransmits += conn->stat_count_resent;
+	stats->sendTime += sendTime;
+	if (conn->stat_min_ack_time != ~((uint64) 0) &&
+		(stats->minRtt == 0 || conn->stat_min_ack_time < stats->minRtt))
+		stats->minRtt = conn->stat_min_ack_time;
+	stats->rtt = conn->rtt;
+	SpinLockRelease(&stats->mutex);
+}
+
 /*
  * logPkt
  * 		Log a packet.
@@ -4186,6 +4538,97 @@ logPkt(char *prefix, icpkthdr *pkt)
 			  pkt->flags);
 }
 
+/*
+ * updateDelayBasedWindow
+ * 		Adjust the congestion window of delay based flow control to an
+ * 		acknowledgement, whose packet took 'rtt' to be acknowledged.
+ *
+ * The window is sized from two estimates, in the manner of BBR: the
+ * bottleneck bandwidth, as the largest delivery rate of the last rounds,
+ * and the round-trip propagation delay, as the smallest RTT sample of the
+ * last few seconds.  A round is a minimal RTT worth of acknowledgements;
+ * its delivery rate is the number of packets acknowledged in it over its
+ * duration.
+ *
+ * In startup the window grows by a packet per acknowledgement, doubling
+ * every round, until the delivery rate stops growing.  From then on it is a
+ * small multiple of the bandwidth-delay product, which keeps the queues at
+ * the bottleneck short however many connections share it, instead of
+ * filling them until packets get lost as loss based flow control does.
+ *
+ * 'inflight' is the number of packets that were out against the window when
+ * the acknowledgement came.  While it is below the window the senders are
+ * app-limited: they had less to send than the window allowed, and the
+ * delivery rate only says how fast they produced data.  As BBR does, the
+ * window does not grow on such acknowledgements, and the delivery rate of a
+ * round with any is only taken if it beats the estimate, and does not count
+ * towards the end of startup.
+ */
+static void
+updateDelayBasedWindow(uint64 rtt, uint64 now, int inflight)
+{
+	SendControlInfo *info = &snd_control_info;
+	bool		appLimited;
+	double		bw;
+
+	appLimited = (inflight + 1 < info->cwnd - info->minCwnd);
+	info->delivered++;
+
+	if (info->minRtt == 0 || rtt <= info->minRtt ||
+		now - info->minRttStamp > DELAY_FC_MIN_RTT_WINDOW)
+	{
+		info->minRtt = Max(rtt, MIN_RTT);
+		info->minRttStamp = now;
+	}
+
+	if (!info->fullBw && !appLimited)
+		info->cwnd += 1;
+
+	if (info->roundStart == 0)
+	{
+		info->roundStart = now;
+		info->roundDelivered = info->delivered;
+		info->roundAppLimited = appLimited;
+	}
+	else if (now - info->roundStart >= info->minRtt)
+	{
+		bool		roundAppLimited = info->roundAppLimited || appLimited;
+
+		/* end of a round, take a delivery rate sample */
+		bw = (double) (info->delivered - info->roundDelivered) /
+			(double) (now - info->roundStart);
+		info->roundStart = now;
+		info->roundDelivered = info->delivered;
+		info->roundAppLimited = false;
+
+		if (bw >= info->maxBw ||
+			(!roundAppLimited && ++info->maxBwAge >= DELAY_FC_BW_WINDOW_ROUNDS))
+		{
+			info->maxBw = bw;
+			info->maxBwAge = 0;
+		}
+
+		if (!info->fullBw && !roundAppLimited)
+		{
+			if (info->maxBw >= info->fullBwTarget * DELAY_FC_FULL_BW_GROWTH)
+			{
+				info->fullBwTarget = info->maxBw;
+				info->fullBwCount = 0;
+			}
+			else if (++info->fullBwCount >= DELAY_FC_FULL_BW_ROUNDS)
+				info->fullBw = true;
+		}
+
+		if (info->fullBw)
+			info->cwnd = DELAY_FC_CWND_GAIN * info->maxBw * info->minRtt;
+	}
+	else if (appLimited)
+		info->roundAppLimited = true;
+
+	info->cwnd = Max(info->cwnd, info->minCwnd);
+	info->cwnd = Min(info->cwnd, snd_buffer_pool.maxCount);
+}
+
 /*
  * handleAckedPacket
  * 		Called by sender to process acked packet.
@@ -4216,12 +4659,13 @@ static void
 handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now)
 {
 	uint64		ackTime = 0;
+	int			inflight = unack_queue_ring.numSharedOutStanding;
 
 	bool		bufIsHead = (&buf->primary == icBufferListFirst(&ackConn->unackQueue));
 
 	buf = icBufferListDelete(&ackConn->unackQueue, buf);
 
-	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
+	if (FC_METHOD_USES_CWND)
 	{
 		buf = icBufferListDelete(&unack_queue_ring.slots[buf->unackQueueRingSlot], buf);
 		unack_queue_ring.numOutStanding--;
@@ -4253,13 +4697,24 @@ handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now)
 				buf->conn->dev = newDEV;
 
 				/* adjust the congestion control window. */
-				if (snd_control_info.cwnd < snd_control_info.ssthresh)
-					snd_control_info.cwnd += 1;
-				else
-					snd_control_info.cwnd += 1 / snd_control_info.cwnd;
-				snd_control_info.cwnd = Min(snd_control_info.cwnd, snd_buffer_pool.maxCount);
+				if (Gp_interconnect_fc_method != INTERCONNECT_FC_METHOD_DELAY)
+				{
+					if (snd_control_info.cwnd < snd_control_info.ssthresh)
+						snd_control_info.cwnd += 1;
+					else
+						snd_control_info.cwnd += 1 / snd_control_info.cwnd;
+					snd_control_info.cwnd = Min(snd_control_info.cwnd, snd_buffer_pool.maxCount);
+				}
 			}
 		}
+
+		/*
+		 * Delay based flow control keeps its own estimates of the RTT, so it
+		 * runs in udp_testmode too, where it is stress tested.
+		 */
+		if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_DELAY &&
+			buf->nRetry == 0)
+			updateDelayBasedWindow(ackTime, now, inflight);
 	}
 
 	buf->conn->stat_total_ack_time += ackTime;
@@ -4561,13 +5016,33 @@ prepareXmit(MotionConn *conn)
 {
 	Assert(conn != NULL);
 
+	/* compression doesn't pay off through shared memory */
+	prepareXmitHeader(conn, !conn->shmLocal &&
+					  compressMotionBuffer(conn, sizeof(conn->conn_info)));
+}
+
+/*
+ * prepareXmitHeader
+ * 		Fill in the header of the packet in the buffer of the connection,
+ * 		whose payload is compressed already if 'compressed' is set.
+ */
+static inline void
+prepareXmitHeader(MotionConn *conn, bool compressed)
+{
 	conn->conn_info.len = conn->msgSize;
 	conn->conn_info.crc = 0;
 
+	/* the flag only goes into this packet's header, not the connection's */
+	if (compressed)
+		conn->conn_info.flags |= UDPIC_FLAGS_COMPRESSED;
+
 	memcpy(conn->pBuff, &conn->conn_info, sizeof(conn->conn_info));
 
+	conn->conn_info.flags &= ~UDPIC_FLAGS_COMPRESSED;
+
 	/* increase the sequence no */
 	conn->conn_info.seq++;
+	conn->stat_bytes_sent += conn->msgSize;
 
 	if (gp_interconnect_full_crc)
 	{
@@ -4803,7 +5278,7 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 	{
 		ICBuffer   *buf = NULL;
 
-		if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS &&
+		if (FC_METHOD_USES_CWND &&
 			(icBufferListLength(&conn->unackQueue) > 0 &&
 			 unack_queue_ring.numSharedOutStanding >= (snd_control_info.cwnd - snd_control_info.minCwnd)))
 			break;
@@ -4824,7 +5299,7 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 
 		icBufferListAppend(&conn->unackQueue, buf);
 
-		if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
+		if (FC_METHOD_USES_CWND)
 		{
 			unack_queue_ring.numOutStanding++;
 			if (icBufferListLength(&conn->unackQueue) > 1)
@@ -5000,7 +5475,7 @@ handleAckForDisorderPkt(ChunkTransportState *transportStates,
 			/* this is a lost packet, retransmit */
 
 			buf->nRetry++;
-			if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
+			if (FC_METHOD_USES_CWND)
 			{
 				buf = icBufferListDelete(&unack_queue_ring.slots[buf->unackQueueRingSlot], buf);
 				putIntoUnackQueueRing(&unack_queue_ring, buf,
@@ -5011,6 +5486,7 @@ handleAckForDisorderPkt(ChunkTransportState *transportStates,
 #endif
 
 			sendOnce(transportStates, pEntry, buf, buf->conn);
+			buf->conn->stat_count_resent++;
 
 #ifdef AMS_VERBOSE_LOGGING
 			write_log("RESEND a buffer for DISORDER: seq %d", buf->pkt->seq);
@@ -5046,6 +5522,11 @@ handleAckForDisorderPkt(ChunkTransportState *transportStates,
 			lostPktCnt--;
 		}
 	}
+
+	/*
+	 * Delay based flow control doesn't take a lost packet for congestion,
+	 * the window follows the delivery rate and RTT it measures.
+	 */
 	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
 	{
 		snd_control_info.ssthresh = Max(snd_control_info.cwnd / 2, snd_control_info.minCwnd);
@@ -5239,7 +5720,20 @@ checkExpiration(ChunkTransportState *transportStates,
 	if (retransmits > 0)
 	{
 		snd_control_info.ssthresh = Max(snd_control_info.cwnd / 2, snd_control_info.minCwnd);
-		snd_control_info.cwnd = snd_control_info.minCwnd;
+
+		/*
+		 * Packets timed out: loss based flow control starts over from the
+		 * minimal window.  Delay based flow control only drains what it has
+		 * in flight beyond the bandwidth-delay product, so that a burst of
+		 * timeouts doesn't stall all connections.
+		 */
+		if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_DELAY &&
+			snd_control_info.fullBw)
+			snd_control_info.cwnd = Min(snd_control_info.cwnd,
+										Max(snd_control_info.minCwnd,
+											snd_control_info.maxBw * snd_control_info.minRtt));
+		else
+			snd_control_info.cwnd = snd_control_info.minCwnd;
 	}
 }
 
@@ -5415,7 +5909,7 @@ checkExceptions(ChunkTransportState *transportStates,
 		checkExpirationCapacityFC(transportStates, pEntry, conn, timeout);
 	}
 
-	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
+	if (FC_METHOD_USES_CWND)
 	{
 		uint64		now = getCurrentTime();
 
@@ -5468,7 +5962,7 @@ computeTimeout(MotionConn *conn, int retry)
 	if (buf->nRetry == 0 && retry == 0)
 		return 0;
 
-	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
+	if (FC_METHOD_USES_CWND)
 		return TIMER_CHECKING_PERIOD;
 
 	/* for capacity based flow control */
@@ -5476,53 +5970,32 @@ computeTimeout(MotionConn *conn, int retry)
 }
 
 /*
- * SendChunkUDPIFC
- * 		is used to send a tcItem to a single destination. Tuples often are
- * 		*very small* we aggregate in our local buffer before sending into the kernel.
+ * pushBufferUDPIFC
+ * 		Put the packet in the buffer of the connection, prepared for
+ * 		transmit, into the send queue, and get a new buffer for the
+ * 		connection.
  *
- * PARAMETERS
- *	 conn - MotionConn that the tcItem is to be sent to.
- *	 tcItem - message to be sent.
- *	 motionId - Node Motion Id.
+ * Returns false if the connection is not active anymore, because of the stop
+ * messages received while waiting for a buffer.
  */
 static bool
-SendChunkUDPIFC(ChunkTransportState *transportStates,
-				ChunkTransportStateEntry *pEntry,
-				MotionConn *conn,
-				TupleChunkListItem tcItem,
-				int16 motionId)
+pushBufferUDPIFC(ChunkTransportState *transportStates,
+				 ChunkTransportStateEntry *pEntry,
+				 MotionConn *conn,
+				 int16 motionId)
 {
-
-	int			length = tcItem->chunk_length;
 	int			retry = 0;
 	bool		doCheckExpiration = false;
 	bool		gotStops = false;
 
-	Assert(conn->msgSize > 0);
-
-#ifdef AMS_VERBOSE_LOGGING
-	elog(DEBUG3, "sendChunk: msgSize %d this chunk length %d conn seq %d",
-		 conn->msgSize, tcItem->chunk_length, conn->conn_info.seq);
-#endif
-
-	if (conn->msgSize + length <= Gp_max_packet_size)
-	{
-		memcpy(conn->pBuff + conn->msgSize, tcItem->chunk_data, tcItem->chunk_length);
-		conn->msgSize += length;
-
-		conn->tupleCount++;
-		return true;
-	}
-
-	/* prepare this for transmit */
+	if (conn->shmQueue != NULL)
+		return pushBufferShm(conn);
 
 	ic_statistics.totalCapacity += conn->capacity;
 	ic_statistics.capacityCountingTime++;
 
 	/* try to send it */
 
-	prepareXmit(conn);
-
 	icBufferListAppend(&conn->sndQueue, conn->curBuff);
 	sendBuffers(transportStates, pEntry, conn);
 
@@ -5568,14 +6041,81 @@ SendChunkUDPIFC(ChunkTransportState *transportStates,
 		/* handling stop message will make some connection not active anymore */
 		handleStopMsgs(transportStates, pEntry, motionId);
 		if (!conn->stillActive)
-			return true;
+			return false;
 	}
 
 	/* reinitialize connection */
 	conn->tupleCount = 0;
 	conn->msgSize = sizeof(conn->conn_info);
 
-	/* now we can copy the input to the new buffer */
+	return true;
+}
+
+/*
+ * pushBufferShm
+ * 		Send the buffer of a connection going through shared memory,
+ * 		waiting for room in the queue if the receiver is behind.
+ *
+ * The packet is copied into the queue, so the connection keeps its buffer.
+ * Nothing is acknowledged or resent.
+ *
+ * Returns false if the receiver doesn't want more tuples.
+ */
+static bool
+pushBufferShm(MotionConn *conn)
+{
+	if (!icShmSend(conn, conn->pBuff, conn->msgSize))
+	{
+		conn->stillActive = false;
+		return false;
+	}
+
+	conn->sentSeq = conn->conn_info.seq - 1;
+
+	/* reinitialize connection */
+	conn->tupleCount = 0;
+	conn->msgSize = sizeof(conn->conn_info);
+
+	return true;
+}
+
+/*
+ * SendChunkUDPIFC
+ * 		is used to send a tcItem to a single destination. Tuples often are
+ * 		*very small* we aggregate in our local buffer before sending into the kernel.
+ *
+ * PARAMETERS
+ *	 conn - MotionConn that the tcItem is to be sent to.
+ *	 tcItem - message to be sent.
+ *	 motionId - Node Motion Id.
+ */
+static bool
+SendChunkUDPIFC(ChunkTransportState *transportStates,
+				ChunkTransportStateEntry *pEntry,
+				MotionConn *conn,
+				TupleChunkListItem tcItem,
+				int16 motionId)
+{
+
+	int			length = tcItem->chunk_length;
+
+	Assert(conn->msgSize > 0);
+
+#ifdef AMS_VERBOSE_LOGGING
+	elog(DEBUG3, "sendChunk: msgSize %d this chunk length %d conn seq %d",
+		 conn->msgSize, tcItem->chunk_length, conn->conn_info.seq);
+#endif
+
+	if (conn->msgSize + length > Gp_max_packet_size)
+	{
+		/* prepare this for transmit */
+		prepareXmit(conn);
+
+		if (!pushBufferUDPIFC(transportStates, pEntry, conn, motionId))
+			return true;
+	}
+
+	/* now we can copy the input to the buffer */
 	memcpy(conn->pBuff + conn->msgSize, tcItem->chunk_data, tcItem->chunk_length);
 	conn->msgSize += length;
 
@@ -5584,6 +6124,73 @@ SendChunkUDPIFC(ChunkTransportState *transportStates,
 	return true;
 }
 
+/*
+ * SendBroadcastUDPIFC
+ * 		send the broadcast buffer of a Motion node to all its receivers, see
+ * 		broadcastChunk() in ic_common.c.
+ *
+ * The payload is compressed once, and copied into a packet of each
+ * connection: every connection numbers, acknowledges and retransmits its
+ * own packets, so each needs a buffer with its own header.  Compression
+ * doesn't pay off through shared memory, so the connections through a
+ * shared-memory queue get their copy before the payload is compressed.
+ */
+static void
+SendBroadcastUDPIFC(ChunkTransportState *transportStates,
+					ChunkTransportStateEntry *pEntry)
+{
+	int			hdrlen = sizeof(icpkthdr);
+	uint64		rawBytes = 0;
+	uint64		wireBytes = 0;
+	bool		compressed = false;
+	int			pass,
+				i,
+				index;
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		bool		shmPass = (pass == 0);
+
+		if (!shmPass)
+			compressed = compressMotionData(pEntry->bcastBuff, &pEntry->bcastSize,
+											hdrlen, &pEntry->bcastCompressSkip,
+											&rawBytes, &wireBytes);
+
+		/* same order as doBroadcast() */
+		index = Max(0, GpIdentity.segindex);
+		for (i = 0; i < pEntry->numConns; i++, index++)
+		{
+			MotionConn *conn;
+
+			if (index >= pEntry->numConns)
+				index = 0;
+			conn = pEntry->conns + index;
+
+			if (!conn->stillActive || conn->shmLocal != shmPass)
+				continue;
+
+			/* whatever was put in the buffer of the connection goes first */
+			if (conn->msgSize > hdrlen)
+			{
+				prepareXmit(conn);
+				if (!pushBufferUDPIFC(transportStates, pEntry, conn, pEntry->motNodeId))
+					continue;
+			}
+
+			memcpy(conn->pBuff + hdrlen, pEntry->bcastBuff + hdrlen,
+				   pEntry->bcastSize - hdrlen);
+			conn->msgSize = pEntry->bcastSize;
+			conn->tupleCount = pEntry->bcastTupleCount;
+
+			conn->stat_compress_raw_bytes += rawBytes;
+			conn->stat_compress_wire_bytes += wireBytes;
+
+			prepareXmitHeader(conn, compressed);
+			pushBufferUDPIFC(transportStates, pEntry, conn, pEntry->motNodeId);
+		}
+	}
+}
+
 /*
  * SendEosUDPIFC
  * 		broadcast eos messages to receivers.
@@ -5624,6 +6231,9 @@ SendEosUDPIFC(ChunkTransportState *transportStates,
 		elog(DEBUG1, "Interconnect seg%d slice%d sending end-of-stream to slice%d",
 			 GpIdentity.segindex, motNodeID, pEntry->recvSlice->sliceIndex);
 
+	/* tuples still in the broadcast buffer go before the end-of-stream */
+	flushBroadcastBuffer(transportStates, pEntry);
+
 	/*
 	 * we want to add our tcItem onto each of the outgoing buffers -- this is
 	 * guaranteed to leave things in a state where a flush is *required*.
@@ -5653,6 +6263,19 @@ SendEosUDPIFC(ChunkTransportState *transportStates,
 
 			prepareXmit(conn);
 
+			/* nothing to wait for once it is in the queue */
+			if (conn->shmQueue != NULL)
+			{
+				pushBufferShm(conn);
+
+				icBufferListAppend(&snd_buffer_pool.freeList, conn->curBuff);
+				conn->curBuff = NULL;
+				conn->pBuff = NULL;
+				conn->state = mcsEosSent;
+				conn->stillActive = false;
+				continue;
+			}
+
 			/* place it into the send queue */
 			icBufferListAppend(&conn->sndQueue, conn->curBuff);
 			sendBuffers(transportStates, pEntry, conn);
@@ -5756,7 +6379,13 @@ doSendStopMessageUDPIFC(ChunkTransportState *transportStates, int16 motNodeID)
 		 */
 		if (conn->stillActive)
 		{
-			if (conn->conn_info.flags & UDPIC_FLAGS_EOS)
+			if (conn->shmQueue != NULL)
+			{
+				/* the sender stops when it finds the queue detached */
+				conn->stillActive = false;
+				icShmDetach(conn, false, false);
+			}
+			else if (conn->conn_info.flags & UDPIC_FLAGS_EOS)
 			{
 				/*
 				 * we have a queued packet that has EOS in it. We've acked it,
@@ -6372,6 +7001,7 @@ rxThreadFunc(void *arg)
 #endif
 
 			bool		wakeup_mainthread = false;
+			Latch	   *mainLatch;
 			AckSendParam param;
 
 			memset(&param, 0, sizeof(AckSendParam));
@@ -6418,10 +7048,13 @@ rxThreadFunc(void *arg)
 					ic_statistics.mismatchNum++;
 				}
 			}
+
+			/* the main thread switches latches with the lock held */
+			mainLatch = ic_control_info.mainLatch;
 			pthread_mutex_unlock(&ic_control_info.lock);
 
 			if (wakeup_mainthread)
-				SetLatch(&ic_control_info.latch);
+				SetLatch(mainLatch);
 
 			/*
 			 * real ack sending is after lock release to decrease the lock
@@ -7061,3 +7694,69 @@ getActiveMotionConns(void)
 {
 	return ic_statistics.activeConnectionsNum;
 }
+
+/*
+ * gp_interconnect_conn_stats
+ * 		Return the statistics of the UDPIFC connections the backends of this
+ * 		segment sent data on, a row per receiving segment, see ICConnStats.
+ */
+Datum
+gp_interconnect_conn_stats(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	int		   *next;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		MemoryContext oldcontext;
+		TupleDesc	tupdesc;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+			elog(ERROR, "return type must be a row type");
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+		funcctx->user_fctx = palloc0(sizeof(int));
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	next = (int *) funcctx->user_fctx;
+
+	while (ic_conn_stats != NULL && *next <= IC_CONN_STATS_MAX_RECEIVERS)
+	{
+		ICConnStats stats;
+		Datum		values[10];
+		bool		nulls[10];
+		HeapTuple	tuple;
+
+		/* Take a consistent copy */
+		SpinLockAcquire(&ic_conn_stats[*next].mutex);
+		stats = ic_conn_stats[*next];
+		SpinLockRelease(&ic_conn_stats[*next].mutex);
+		(*next)++;
+
+		if (stats.connections == 0)
+			continue;
+
+		MemSet(nulls, 0, sizeof(nulls));
+		values[0] = Int32GetDatum(GpIdentity.segindex);
+		values[1] = Int32GetDatum(*next - 2);
+		values[2] = Int64GetDatum(stats.connections);
+		values[3] = Int64GetDatum(stats.packets);
+		values[4] = Int64GetDatum(stats.bytes);
+		values[5] = Int64GetDatum(stats.localBytes);
+		values[6] = Int64GetDatum(stats.retransmits);
+		values[7] = Float8GetDatum(stats.sendTime / 1000.0);
+		values[8] = Float8GetDatum(stats.minRtt / 1000.0);
+		values[9] = Float8GetDatum(stats.rtt / 1000.0);
+		nulls[8] = (stats.minRtt == 0);
+
+		tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+	}
+
+	SRF_RETURN_DONE(funcctx);
+}
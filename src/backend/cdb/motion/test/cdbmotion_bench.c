@@ -0,0 +1,110 @@
+/*
+ * Micro-benchmark of the receive side of cdbmotion.c: per-tuple cost of
+ * taking the tuples that are ready off an unordered receiver's FIFO with
+ * RecvTupleFrom(), a tuple at a time, versus RecvTuplesFrom(), in batches
+ * of the size execMotionUnsortedReceiver() asks for.
+ *
+ * The tuples are queued directly, so this measures the motion layer alone,
+ * without the interconnect.  It only reports, it checks nothing;
+ * cdbmotion_test.c does.  Run it with "make bench" in this directory.
+ */
+#include "../cdbmotion.c"
+
+#include "portability/instr_time.h"
+#include "utils/memutils.h"
+
+#define BENCH_BATCH_SIZE	256
+
+static void
+bench_fill(MotionNodeEntry *pMNEntry, MinimalTuple *tups, int ntuples)
+{
+	for (int i = 0; i < ntuples; i++)
+		htfifo_addtuple(pMNEntry->ready_tuples, tups[i]);
+	pMNEntry->stat_tuples_available += ntuples;
+}
+
+static void
+bench_receive(int ntuples, int loops)
+{
+	TupleDesc	tupdesc = CreateTemplateTupleDesc(1);
+	MotionLayerState mlStates;
+	MotionNodeEntry mnEntry;
+	MinimalTuple *tups = palloc(ntuples * sizeof(MinimalTuple));
+	MinimalTuple batch[BENCH_BATCH_SIZE];
+	instr_time	start;
+	instr_time	end;
+	instr_time	tupleTime;
+	instr_time	batchTime;
+	long		nreceived = 0;
+
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+	for (int i = 0; i < ntuples; i++)
+	{
+		Datum		value = Int32GetDatum(i);
+		bool		isnull = false;
+
+		tups[i] = heap_form_minimal_tuple(tupdesc, &value, &isnull);
+	}
+
+	memset(&mlStates, 0, sizeof(mlStates));
+	memset(&mnEntry, 0, sizeof(mnEntry));
+	mlStates.mneCount = 1;
+	mlStates.mnEntries = &mnEntry;
+	mnEntry.valid = true;
+	mnEntry.motion_node_id = 1;
+	mnEntry.moreNetWork = false;
+	mnEntry.ready_tuples = htfifo_create();
+
+	INSTR_TIME_SET_ZERO(tupleTime);
+	INSTR_TIME_SET_ZERO(batchTime);
+
+	for (int l = 0; l < loops; l++)
+	{
+		bench_fill(&mnEntry, tups, ntuples);
+		INSTR_TIME_SET_CURRENT(start);
+		while (RecvTupleFrom(&mlStates, NULL, 1, ANY_ROUTE) != NULL)
+			nreceived++;
+		INSTR_TIME_SET_CURRENT(end);
+		INSTR_TIME_ACCUM_DIFF(tupleTime, end, start);
+
+		bench_fill(&mnEntry, tups, ntuples);
+		INSTR_TIME_SET_CURRENT(start);
+		for (;;)
+		{
+			int			n = RecvTuplesFrom(&mlStates, NULL, 1, batch,
+										   BENCH_BATCH_SIZE);
+
+			if (n == 0)
+				break;
+			nreceived += n;
+		}
+		INSTR_TIME_SET_CURRENT(end);
+		INSTR_TIME_ACCUM_DIFF(batchTime, end, start);
+	}
+
+	if (nreceived != 2L * loops * ntuples)
+		printf("received %ld tuples, expected %ld\n",
+			   nreceived, 2L * loops * ntuples);
+
+	printf("%7d tuples ready: RecvTupleFrom %.2f ns/tuple, RecvTuplesFrom %.2f ns/tuple\n",
+		   ntuples,
+		   INSTR_TIME_GET_DOUBLE(tupleTime) * 1e9 / ((double) loops * ntuples),
+		   INSTR_TIME_GET_DOUBLE(batchTime) * 1e9 / ((double) loops * ntuples));
+
+	htfifo_destroy(mnEntry.ready_tuples);
+	pfree(tups);
+}
+
+int
+main(int argc, char* argv[])
+{
+	int			sizes[] = {16, 256, 4096, 65536};
+	long		totalTuples = 10000000;
+
+	MemoryContextInit();
+
+	for (int i = 0; i < lengthof(sizes); i++)
+		bench_receive(sizes[i], totalTuples / sizes[i]);
+
+	return 0;
+}
@@ -0,0 +1,348 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../cdbmotion.c"
+
+#include "utils/memutils.h"
+
+/*
+ * Serialize a one-column int4 tuple the way the sender does: the length of
+ * the tuple body, followed by the body.
+ */
+static char *
+make_serialized_tuple(TupleDesc tupdesc, int32 value, int *len)
+{
+	Datum		values[1];
+	bool		nulls[1];
+	MinimalTuple tup;
+	int			bodylen;
+	char	   *data;
+
+	values[0] = Int32GetDatum(value);
+	nulls[0] = false;
+	tup = heap_form_minimal_tuple(tupdesc, values, nulls);
+
+	bodylen = tup->t_len - MINIMAL_TUPLE_DATA_OFFSET;
+	*len = sizeof(int) + bodylen;
+	data = palloc(*len);
+	memcpy(data, &bodylen, sizeof(int));
+	memcpy(data + sizeof(int), (char *) tup + MINIMAL_TUPLE_DATA_OFFSET, bodylen);
+
+	pfree(tup);
+	return data;
+}
+
+/*
+ * Make a chunk of the given type around the given data.  A chunk that
+ * points into the receive buffer gets a buffer of its own to point into.
+ */
+static TupleChunkListItem
+make_chunk(TupleChunkType type, const char *data, int len, bool inplace)
+{
+	TupleChunkListItem tcItem;
+	uint8	   *chunk;
+
+	if (inplace)
+	{
+		tcItem = palloc(sizeof(TupleChunkListItemData));
+		chunk = palloc(TUPLE_CHUNK_HEADER_SIZE + len);
+		tcItem->inplace = (char *) chunk;
+	}
+	else
+	{
+		tcItem = palloc(sizeof(TupleChunkListItemData) + TUPLE_CHUNK_HEADER_SIZE + len);
+		chunk = tcItem->chunk_data;
+		tcItem->inplace = NULL;
+	}
+
+	SetChunkDataSize(chunk, len);
+	SetChunkType(chunk, type);
+	memcpy(chunk + TUPLE_CHUNK_HEADER_SIZE, data, len);
+	tcItem->chunk_length = TUPLE_CHUNK_HEADER_SIZE + len;
+	tcItem->p_next = NULL;
+
+	return tcItem;
+}
+
+static int32
+get_value(TupleDesc tupdesc, MinimalTuple tup)
+{
+	HeapTupleData htup;
+	bool		isnull;
+
+	htup.t_len = tup->t_len + MINIMAL_TUPLE_OFFSET;
+	htup.t_data = (HeapTupleHeader) ((char *) tup - MINIMAL_TUPLE_OFFSET);
+
+	return DatumGetInt32(heap_getattr(&htup, 1, tupdesc, &isnull));
+}
+
+/*
+ * Only the bytes of tuples that came in a single chunk count towards
+ * stat_tuple_bytes_recvd_whole, whether the chunk points into the receive
+ * buffer or not.  The tuples of several chunks don't.
+ */
+static void
+test__reconstructTuple__CountsWholeTupleBytes(void **state)
+{
+	MotionNodeEntry pMNEntry;
+	ChunkSorterEntry pCSEntry;
+	TupleRemapper *remapper;
+	TupleDesc	tupdesc;
+	char	   *data;
+	int			len;
+	int			half;
+	int			whole = 0;
+
+	tupdesc = CreateTemplateTupleDesc(1);
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+
+	memset(&pMNEntry, 0, sizeof(pMNEntry));
+	pMNEntry.ser_tup_info.tupdesc = tupdesc;
+	memset(&pCSEntry, 0, sizeof(pCSEntry));
+	pCSEntry.ready_tuples = htfifo_create();
+	remapper = CreateTupleRemapper();
+
+	/* a tuple in one chunk, pointing into the receive buffer */
+	data = make_serialized_tuple(tupdesc, 42, &len);
+	appendChunkToTCList(&pCSEntry.chunk_list, make_chunk(TC_WHOLE, data, len, true));
+	reconstructTuple(&pMNEntry, &pCSEntry, remapper);
+	whole += len;
+
+	assert_int_equal(pMNEntry.stat_tuple_bytes_recvd_whole, whole);
+	assert_int_equal(pMNEntry.stat_tuples_available, 1);
+	assert_int_equal(get_value(tupdesc, htfifo_gettuple(pCSEntry.ready_tuples)), 42);
+	pfree(data);
+
+	/* a tuple in two chunks, materialized out of the receive buffer */
+	data = make_serialized_tuple(tupdesc, 43, &len);
+	half = len / 2;
+	appendChunkToTCList(&pCSEntry.chunk_list,
+						make_chunk(TC_PARTIAL_START, data, half, false));
+	appendChunkToTCList(&pCSEntry.chunk_list,
+						make_chunk(TC_PARTIAL_END, data + half, len - half, false));
+	reconstructTuple(&pMNEntry, &pCSEntry, remapper);
+
+	assert_int_equal(pMNEntry.stat_tuple_bytes_recvd_whole, whole);
+	assert_int_equal(pMNEntry.stat_tuples_available, 2);
+	assert_int_equal(get_value(tupdesc, htfifo_gettuple(pCSEntry.ready_tuples)), 43);
+	assert_int_equal(pCSEntry.chunk_list.num_chunks, 0);
+	pfree(data);
+
+	/* a tuple in one chunk that has its own copy of the data counts too */
+	data = make_serialized_tuple(tupdesc, 44, &len);
+	appendChunkToTCList(&pCSEntry.chunk_list, make_chunk(TC_WHOLE, data, len, false));
+	reconstructTuple(&pMNEntry, &pCSEntry, remapper);
+	whole += len;
+
+	assert_int_equal(pMNEntry.stat_tuple_bytes_recvd_whole, whole);
+	assert_int_equal(get_value(tupdesc, htfifo_gettuple(pCSEntry.ready_tuples)), 44);
+	pfree(data);
+
+	htfifo_destroy(pCSEntry.ready_tuples);
+}
+
+static TupleDesc
+make_int4_tupdesc(void)
+{
+	TupleDesc	tupdesc = CreateTemplateTupleDesc(1);
+
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+
+	return tupdesc;
+}
+
+static MinimalTuple
+make_tuple(TupleDesc tupdesc, int32 value)
+{
+	Datum		values[1];
+	bool		nulls[1];
+
+	values[0] = Int32GetDatum(value);
+	nulls[0] = false;
+
+	return heap_form_minimal_tuple(tupdesc, values, nulls);
+}
+
+static void
+fill_fifo(htup_fifo htf, TupleDesc tupdesc, int first, int count)
+{
+	for (int i = first; i < first + count; i++)
+		htfifo_addtuple(htf, make_tuple(tupdesc, i));
+}
+
+static int
+freelist_length(htup_fifo htf)
+{
+	int			n = 0;
+
+	for (htf_entry p_ent = htf->freelist; p_ent != NULL; p_ent = p_ent->p_next)
+		n++;
+
+	return n;
+}
+
+/*
+ * A batch smaller than the FIFO takes the tuples at its head, in order, and
+ * leaves the rest for the next one.
+ */
+static void
+test__htfifo_gettuples__PartialDrain(void **state)
+{
+	TupleDesc	tupdesc = make_int4_tupdesc();
+	htup_fifo	htf = htfifo_create();
+	MinimalTuple tups[4];
+
+	fill_fifo(htf, tupdesc, 0, 10);
+
+	for (int batch = 0; batch < 2; batch++)
+	{
+		assert_int_equal(htfifo_gettuples(htf, tups, 4), 4);
+		for (int i = 0; i < 4; i++)
+			assert_int_equal(get_value(tupdesc, tups[i]), batch * 4 + i);
+		assert_false(htfifo_empty(htf));
+	}
+
+	/* the single tuple path goes on from where the batch stopped */
+	assert_int_equal(get_value(tupdesc, htfifo_gettuple(htf)), 8);
+
+	assert_int_equal(htfifo_gettuples(htf, tups, 4), 1);
+	assert_int_equal(get_value(tupdesc, tups[0]), 9);
+	assert_true(htfifo_empty(htf));
+	assert_true(htf->p_last == NULL);
+
+	htfifo_destroy(htf);
+}
+
+/*
+ * A batch larger than the FIFO empties it, and the FIFO is usable again
+ * afterwards.  An empty FIFO gives an empty batch.
+ */
+static void
+test__htfifo_gettuples__FullDrain(void **state)
+{
+	TupleDesc	tupdesc = make_int4_tupdesc();
+	htup_fifo	htf = htfifo_create();
+	MinimalTuple tups[16];
+
+	assert_int_equal(htfifo_gettuples(htf, tups, 16), 0);
+
+	fill_fifo(htf, tupdesc, 0, 5);
+	assert_int_equal(htfifo_gettuples(htf, tups, 16), 5);
+	for (int i = 0; i < 5; i++)
+		assert_int_equal(get_value(tupdesc, tups[i]), i);
+	assert_true(htfifo_empty(htf));
+	assert_true(htf->p_last == NULL);
+	assert_int_equal(htfifo_gettuples(htf, tups, 16), 0);
+
+	/* exactly as many tuples as the batch holds */
+	fill_fifo(htf, tupdesc, 5, 16);
+	assert_int_equal(htfifo_gettuples(htf, tups, 16), 16);
+	assert_int_equal(get_value(tupdesc, tups[15]), 20);
+	assert_true(htfifo_empty(htf));
+
+	fill_fifo(htf, tupdesc, 21, 1);
+	assert_true(htf->p_first == htf->p_last);
+	assert_int_equal(get_value(tupdesc, htfifo_gettuple(htf)), 21);
+	assert_true(htfifo_gettuple(htf) == NULL);
+
+	htfifo_destroy(htf);
+}
+
+/*
+ * The entries of a batch go back to the freelist, and new tuples take them
+ * from there instead of allocating.
+ */
+static void
+test__htfifo_gettuples__ReusesFreelist(void **state)
+{
+	TupleDesc	tupdesc = make_int4_tupdesc();
+	htup_fifo	htf = htfifo_create();
+	MinimalTuple tups[8];
+	htf_entry	head;
+
+	fill_fifo(htf, tupdesc, 0, 6);
+	assert_int_equal(freelist_length(htf), 0);
+
+	assert_int_equal(htfifo_gettuples(htf, tups, 4), 4);
+	assert_int_equal(freelist_length(htf), 4);
+	assert_int_equal(htfifo_gettuples(htf, tups, 8), 2);
+	assert_int_equal(freelist_length(htf), 6);
+
+	head = htf->freelist;
+	fill_fifo(htf, tupdesc, 6, 3);
+	assert_true(htf->p_first == head);
+	assert_int_equal(freelist_length(htf), 3);
+
+	assert_int_equal(htfifo_gettuples(htf, tups, 8), 3);
+	for (int i = 0; i < 3; i++)
+		assert_int_equal(get_value(tupdesc, tups[i]), 6 + i);
+	assert_int_equal(freelist_length(htf), 6);
+
+	htfifo_destroy(htf);
+}
+
+/*
+ * RecvTuplesFrom() takes the ready tuples a batch at a time, keeps the same
+ * stats as RecvTupleFrom() does a tuple at a time, and returns 0 at
+ * end-of-stream.
+ */
+static void
+test__RecvTuplesFrom__TakesReadyTuples(void **state)
+{
+	TupleDesc	tupdesc = make_int4_tupdesc();
+	MotionLayerState mlStates;
+	MotionNodeEntry mnEntry;
+	MinimalTuple tups[4];
+
+	memset(&mlStates, 0, sizeof(mlStates));
+	memset(&mnEntry, 0, sizeof(mnEntry));
+	mlStates.mneCount = 1;
+	mlStates.mnEntries = &mnEntry;
+	mnEntry.valid = true;
+	mnEntry.motion_node_id = 1;
+	mnEntry.moreNetWork = false;
+	mnEntry.ready_tuples = htfifo_create();
+
+	fill_fifo(mnEntry.ready_tuples, tupdesc, 0, 7);
+	mnEntry.stat_tuples_available = 7;
+
+	assert_int_equal(RecvTuplesFrom(&mlStates, NULL, 1, tups, 4), 4);
+	assert_int_equal(get_value(tupdesc, tups[3]), 3);
+	assert_int_equal(mnEntry.stat_total_recvs, 4);
+	assert_int_equal(mnEntry.stat_tuples_available, 3);
+
+	assert_int_equal(get_value(tupdesc, RecvTupleFrom(&mlStates, NULL, 1, ANY_ROUTE)), 4);
+	assert_int_equal(mnEntry.stat_total_recvs, 5);
+	assert_int_equal(mnEntry.stat_tuples_available, 2);
+
+	assert_int_equal(RecvTuplesFrom(&mlStates, NULL, 1, tups, 4), 2);
+	assert_int_equal(get_value(tupdesc, tups[0]), 5);
+	assert_int_equal(get_value(tupdesc, tups[1]), 6);
+	assert_int_equal(mnEntry.stat_total_recvs, 7);
+	assert_int_equal(mnEntry.stat_tuples_available, 0);
+
+	assert_int_equal(RecvTuplesFrom(&mlStates, NULL, 1, tups, 4), 0);
+	assert_int_equal(mnEntry.stat_total_recvs, 7);
+
+	htfifo_destroy(mnEntry.ready_tuples);
+}
+
+int
+main(int argc, char* argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const UnitTest tests[] = {
+		unit_test(test__reconstructTuple__CountsWholeTupleBytes),
+		unit_test(test__htfifo_gettuples__PartialDrain),
+		unit_test(test__htfifo_gettuples__FullDrain),
+		unit_test(test__htfifo_gettuples__ReusesFreelist),
+		unit_test(test__RecvTuplesFrom__TakesReadyTuples)
+	};
+
+	MemoryContextInit();
+
+	return run_tests(tests);
+}
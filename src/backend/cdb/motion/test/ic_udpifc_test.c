@@ -0,0 +1,159 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../../motion/ic_udpifc.c"
+
+/*
+ * Drive the estimator of delay based flow control with synthetic
+ * acknowledgements: every one has an RTT of TEST_RTT, and a round is
+ * TEST_RTT long, so a round of n acknowledgements samples a delivery rate of
+ * n / TEST_RTT.
+ */
+#define TEST_RTT	100
+
+static uint64 test_now;
+
+static void
+reset_estimator(float cwnd, float minCwnd)
+{
+	memset(&snd_control_info, 0, sizeof(snd_control_info));
+	snd_control_info.cwnd = cwnd;
+	snd_control_info.minCwnd = minCwnd;
+	snd_buffer_pool.maxCount = 1000;
+	test_now = 1000;
+}
+
+/* The packets out against the window fill it */
+static int
+full_window(void)
+{
+	return (int) (snd_control_info.cwnd - snd_control_info.minCwnd);
+}
+
+static void
+ack(bool appLimited)
+{
+	updateDelayBasedWindow(TEST_RTT, test_now, appLimited ? 0 : full_window());
+}
+
+/* Acknowledge 'acks' packets evenly over a round */
+static void
+deliver_round(int acks, bool appLimited)
+{
+	for (int i = 0; i < acks; i++)
+	{
+		test_now += TEST_RTT / acks;
+		ack(appLimited);
+	}
+}
+
+static void
+test__updateDelayBasedWindow__grows_when_window_limited(void **state)
+{
+	reset_estimator(20, 2);
+
+	ack(false);
+	deliver_round(10, false);
+
+	assert_true(snd_control_info.cwnd == 31);
+	assert_false(snd_control_info.fullBw);
+}
+
+static void
+test__updateDelayBasedWindow__holds_when_app_limited(void **state)
+{
+	reset_estimator(20, 2);
+
+	ack(true);
+	deliver_round(10, true);
+
+	assert_true(snd_control_info.cwnd == 20);
+	assert_true(snd_control_info.delivered == 11);
+}
+
+static void
+test__updateDelayBasedWindow__app_limited_rounds_stay_in_startup(void **state)
+{
+	reset_estimator(20, 2);
+	ack(false);
+
+	/* a flat delivery rate, but the senders had nothing more to send */
+	for (int r = 0; r < 2 * DELAY_FC_FULL_BW_ROUNDS; r++)
+		deliver_round(10, true);
+	assert_false(snd_control_info.fullBw);
+
+	/* the same rate with the window full: the bandwidth is reached */
+	for (int r = 0; r < DELAY_FC_FULL_BW_ROUNDS; r++)
+	{
+		assert_false(snd_control_info.fullBw);
+		deliver_round(10, false);
+	}
+	assert_false(snd_control_info.fullBw);
+	deliver_round(10, false);
+	assert_true(snd_control_info.fullBw);
+
+	/* the window is then sized to twice the bandwidth-delay product */
+	assert_true(snd_control_info.cwnd == DELAY_FC_CWND_GAIN * 10);
+}
+
+static void
+test__updateDelayBasedWindow__app_limited_rounds_keep_bandwidth(void **state)
+{
+	reset_estimator(20, 2);
+	ack(false);
+
+	deliver_round(50, false);
+	assert_true(snd_control_info.maxBw == 50.0 / TEST_RTT);
+
+	/* slower rounds while app-limited do not age the estimate out */
+	for (int r = 0; r < 2 * DELAY_FC_BW_WINDOW_ROUNDS; r++)
+		deliver_round(10, true);
+	assert_true(snd_control_info.maxBw == 50.0 / TEST_RTT);
+
+	/* a faster one is taken all the same */
+	deliver_round(100, true);
+	assert_true(snd_control_info.maxBw == 100.0 / TEST_RTT);
+
+	/* slower rounds with the window full do, after the window of rounds */
+	for (int r = 0; r < DELAY_FC_BW_WINDOW_ROUNDS - 1; r++)
+		deliver_round(10, false);
+	assert_true(snd_control_info.maxBw == 100.0 / TEST_RTT);
+	deliver_round(10, false);
+	assert_true(snd_control_info.maxBw == 10.0 / TEST_RTT);
+}
+
+static void
+test__updateDelayBasedWindow__app_limited_ack_marks_round(void **state)
+{
+	reset_estimator(20, 2);
+	ack(false);
+
+	deliver_round(50, false);
+
+	/* a single app-limited acknowledgement is enough to discount a round */
+	test_now += TEST_RTT / 2;
+	ack(true);
+	test_now += TEST_RTT / 2;
+	ack(false);
+	assert_true(snd_control_info.maxBw == 50.0 / TEST_RTT);
+	assert_true(snd_control_info.maxBwAge == 0);
+	assert_false(snd_control_info.roundAppLimited);
+}
+
+int
+main(int argc, char *argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const		UnitTest tests[] = {
+		unit_test(test__updateDelayBasedWindow__grows_when_window_limited),
+		unit_test(test__updateDelayBasedWindow__holds_when_app_limited),
+		unit_test(test__updateDelayBasedWindow__app_limited_rounds_stay_in_startup),
+		unit_test(test__updateDelayBasedWindow__app_limited_rounds_keep_bandwidth),
+		unit_test(test__updateDelayBasedWindow__app_limited_ack_marks_round),
+	};
+
+	return run_tests(tests);
+}
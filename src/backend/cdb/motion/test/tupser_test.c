@@ -0,0 +1,354 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../tupser.c"
+
+#include "utils/memutils.h"
+
+#define TEST_BUFFER_SIZE	1024
+
+/*
+ * Let InitSerTupInfo() look up the pg_type row of each attribute of
+ * 'tupdesc'.
+ */
+static void
+expect_type_lookups(TupleDesc tupdesc)
+{
+	for (int i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		int			hoff = MAXALIGN(SizeofHeapTupleHeader);
+		HeapTuple	tuple;
+		Form_pg_type pt;
+
+		tuple = palloc0(HEAPTUPLESIZE + hoff + sizeof(FormData_pg_type));
+		tuple->t_data = (HeapTupleHeader) ((char *) tuple + HEAPTUPLESIZE);
+		tuple->t_data->t_hoff = hoff;
+		pt = (Form_pg_type) GETSTRUCT(tuple);
+		pt->typtype = TYPTYPE_BASE;
+		pt->typisdefined = true;
+		pt->typlen = attr->attlen;
+		pt->typbyval = attr->attbyval;
+
+		expect_value(SearchSysCache1, cacheId, TYPEOID);
+		expect_value(SearchSysCache1, key1, ObjectIdGetDatum(attr->atttypid));
+		will_return(SearchSysCache1, tuple);
+		expect_value(ReleaseSysCache, tuple, tuple);
+		will_be_called(ReleaseSysCache);
+	}
+}
+
+/* int4, bool, int8 and int4: all fixed width, with alignment padding */
+static TupleDesc
+make_fixed_tupdesc(void)
+{
+	TupleDesc	tupdesc = CreateTemplateTupleDesc(4);
+
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 2, "b", BOOLOID, -1, 0);
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 3, "c", INT8OID, -1, 0);
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 4, "d", INT4OID, -1, 0);
+
+	return tupdesc;
+}
+
+/* int4 and text */
+static TupleDesc
+make_varlena_tupdesc(void)
+{
+	TupleDesc	tupdesc = CreateTemplateTupleDesc(2);
+
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+	TupleDescInitBuiltinEntry(tupdesc, (AttrNumber) 2, "b", TEXTOID, -1, 0);
+
+	return tupdesc;
+}
+
+static void
+fixed_values(Datum *values, bool *nulls)
+{
+	values[0] = Int32GetDatum(-42);
+	values[1] = BoolGetDatum(true);
+	values[2] = Int64GetDatum(INT64CONST(0x0123456789abcdef));
+	values[3] = Int32GetDatum(7);
+	memset(nulls, 0, 4 * sizeof(bool));
+}
+
+static void
+init_buffer(struct directTransportBuffer *b, int len)
+{
+	b->pri = palloc0(len);
+	b->prilen = len;
+}
+
+/*
+ * Check that the buffer holds the chunk SerializeTuple() would send for a
+ * tuple of these values: a TC_WHOLE chunk header, the length of the tuple
+ * body, and the body of the tuple heap_form_minimal_tuple() forms.
+ */
+static void
+assert_serialized_as(struct directTransportBuffer *b, int len,
+					 TupleDesc tupdesc, Datum *values, bool *nulls)
+{
+	MinimalTuple mintuple = heap_form_minimal_tuple(tupdesc, values, nulls);
+	int			bodylen = mintuple->t_len - MINIMAL_TUPLE_DATA_OFFSET;
+	uint16		datalen;
+	uint16		type;
+
+	assert_int_equal(len, TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + bodylen);
+
+	/* the chunk header is the data size and the chunk type, see tupchunk.h */
+	memcpy(&datalen, b->pri, sizeof(uint16));
+	memcpy(&type, b->pri + sizeof(uint16), sizeof(uint16));
+	assert_int_equal(datalen, sizeof(int) + bodylen);
+	assert_int_equal(type, TC_WHOLE);
+	assert_memory_equal(b->pri + TUPLE_CHUNK_HEADER_SIZE, &bodylen, sizeof(int));
+	assert_memory_equal(b->pri + TUPLE_CHUNK_HEADER_SIZE + sizeof(int),
+						(char *) mintuple + MINIMAL_TUPLE_DATA_OFFSET, bodylen);
+
+	pfree(mintuple);
+}
+
+/* Store the values in 'slot', the way a scan of its kind would */
+static void
+store_values(TupleTableSlot *slot, Datum *values, bool *nulls)
+{
+	TupleDesc	tupdesc = slot->tts_tupleDescriptor;
+
+	if (TTS_IS_VIRTUAL(slot))
+	{
+		ExecClearTuple(slot);
+		memcpy(slot->tts_values, values, tupdesc->natts * sizeof(Datum));
+		memcpy(slot->tts_isnull, nulls, tupdesc->natts * sizeof(bool));
+		ExecStoreVirtualTuple(slot);
+	}
+	else if (TTS_IS_MINIMALTUPLE(slot))
+		ExecStoreMinimalTuple(heap_form_minimal_tuple(tupdesc, values, nulls),
+							  slot, true);
+	else
+		ExecForceStoreHeapTuple(heap_form_tuple(tupdesc, values, nulls),
+								slot, true);
+}
+
+static void
+test__InitSerTupInfo__fixed_layout(void **state)
+{
+	TupleDesc	tupdesc = make_fixed_tupdesc();
+	SerTupInfo	serInfo;
+
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+
+	assert_true(serInfo.fixed_layout);
+	assert_int_equal(serInfo.myinfo[0].fixed_offset, 0);
+	assert_int_equal(serInfo.myinfo[1].fixed_offset, 4);
+	assert_int_equal(serInfo.myinfo[2].fixed_offset, 8);
+	assert_int_equal(serInfo.myinfo[3].fixed_offset, 16);
+	assert_int_equal(serInfo.fixed_data_len, 20);
+	assert_int_equal(serInfo.fixed_header_len,
+					 MAXALIGN(SizeofMinimalTupleHeader) - MINIMAL_TUPLE_DATA_OFFSET);
+
+	CleanupSerTupInfo(&serInfo);
+	assert_false(serInfo.fixed_layout);
+	assert_true(serInfo.fixed_header == NULL);
+}
+
+static void
+test__InitSerTupInfo__no_fixed_layout(void **state)
+{
+	TupleDesc	tupdesc = make_varlena_tupdesc();
+	SerTupInfo	serInfo;
+
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+	assert_false(serInfo.fixed_layout);
+	CleanupSerTupInfo(&serInfo);
+
+	/* a dropped column has no place in the layout either */
+	tupdesc = make_fixed_tupdesc();
+	TupleDescAttr(tupdesc, 1)->attisdropped = true;
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+	assert_false(serInfo.fixed_layout);
+	CleanupSerTupInfo(&serInfo);
+}
+
+/*
+ * A tuple of every kind of slot serializes to the bytes of the MinimalTuple
+ * the slow path forms.
+ */
+static void
+test__SerializeTupleDirect__matches_minimal_tuple(void **state)
+{
+	const TupleTableSlotOps *ops[] = {
+		&TTSOpsVirtual, &TTSOpsHeapTuple, &TTSOpsBufferHeapTuple, &TTSOpsMinimalTuple
+	};
+	TupleDesc	tupdesc = make_fixed_tupdesc();
+	SerTupInfo	serInfo;
+	struct directTransportBuffer b;
+	Datum		values[4];
+	bool		nulls[4];
+
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+	fixed_values(values, nulls);
+
+	for (int i = 0; i < lengthof(ops); i++)
+	{
+		TupleTableSlot *slot = MakeSingleTupleTableSlot(tupdesc, ops[i]);
+		int			len;
+
+		init_buffer(&b, TEST_BUFFER_SIZE);
+		store_values(slot, values, nulls);
+		len = SerializeTupleDirect(slot, &serInfo, &b);
+		assert_serialized_as(&b, len, tupdesc, values, nulls);
+
+		ExecDropSingleTupleTableSlot(slot);
+		pfree(b.pri);
+	}
+
+	CleanupSerTupInfo(&serInfo);
+}
+
+/*
+ * Tuples with variable width values or NULLs take the direct path if the
+ * slot holds them formed already, but a virtual slot can't.
+ */
+static void
+test__SerializeTupleDirect__varlena_and_nulls(void **state)
+{
+	const TupleTableSlotOps *ops[] = {
+		&TTSOpsHeapTuple, &TTSOpsBufferHeapTuple, &TTSOpsMinimalTuple
+	};
+	TupleDesc	tupdesc = make_varlena_tupdesc();
+	TupleDesc	fixed_tupdesc = make_fixed_tupdesc();
+	SerTupInfo	serInfo;
+	struct directTransportBuffer b;
+	TupleTableSlot *slot;
+	Datum		values[4];
+	bool		nulls[4];
+
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+	values[0] = Int32GetDatum(1);
+	values[1] = CStringGetTextDatum("abcdefghijklmnopqrstuvwxyz");
+	nulls[0] = nulls[1] = false;
+
+	for (int i = 0; i < lengthof(ops); i++)
+	{
+		int			len;
+
+		slot = MakeSingleTupleTableSlot(tupdesc, ops[i]);
+		init_buffer(&b, TEST_BUFFER_SIZE);
+
+		store_values(slot, values, nulls);
+		len = SerializeTupleDirect(slot, &serInfo, &b);
+		assert_serialized_as(&b, len, tupdesc, values, nulls);
+
+		nulls[1] = true;
+		store_values(slot, values, nulls);
+		len = SerializeTupleDirect(slot, &serInfo, &b);
+		assert_serialized_as(&b, len, tupdesc, values, nulls);
+		nulls[1] = false;
+
+		ExecDropSingleTupleTableSlot(slot);
+		pfree(b.pri);
+	}
+
+	slot = MakeSingleTupleTableSlot(tupdesc, &TTSOpsVirtual);
+	init_buffer(&b, TEST_BUFFER_SIZE);
+	store_values(slot, values, nulls);
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), 0);
+	ExecDropSingleTupleTableSlot(slot);
+	CleanupSerTupInfo(&serInfo);
+
+	/* a NULL breaks the fixed layout */
+	expect_type_lookups(fixed_tupdesc);
+	InitSerTupInfo(fixed_tupdesc, &serInfo);
+	fixed_values(values, nulls);
+	nulls[2] = true;
+	slot = MakeSingleTupleTableSlot(fixed_tupdesc, &TTSOpsVirtual);
+	store_values(slot, values, nulls);
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), 0);
+	ExecDropSingleTupleTableSlot(slot);
+	CleanupSerTupInfo(&serInfo);
+	pfree(b.pri);
+}
+
+/*
+ * Tuples with toasted values, tuples written before a column was added, and
+ * tuples that don't fit are left to the slow path.
+ */
+static void
+test__SerializeTupleDirect__falls_back(void **state)
+{
+	TupleDesc	tupdesc = make_varlena_tupdesc();
+	TupleDesc	old_tupdesc = CreateTemplateTupleDesc(1);
+	SerTupInfo	serInfo;
+	struct directTransportBuffer b;
+	TupleTableSlot *slot;
+	struct varlena *external;
+	varatt_external toast_pointer;
+	Datum		values[2];
+	bool		nulls[2];
+	int			len;
+
+	expect_type_lookups(tupdesc);
+	InitSerTupInfo(tupdesc, &serInfo);
+	slot = MakeSingleTupleTableSlot(tupdesc, &TTSOpsHeapTuple);
+	init_buffer(&b, TEST_BUFFER_SIZE);
+
+	/* an on-disk toast pointer */
+	memset(&toast_pointer, 0, sizeof(toast_pointer));
+	toast_pointer.va_rawsize = 1000000 + VARHDRSZ;
+	toast_pointer.va_extsize = 1000000;
+	external = palloc0(TOAST_POINTER_SIZE);
+	SET_VARTAG_EXTERNAL(external, VARTAG_ONDISK);
+	memcpy(VARDATA_EXTERNAL(external), &toast_pointer, sizeof(toast_pointer));
+
+	values[0] = Int32GetDatum(1);
+	values[1] = PointerGetDatum(external);
+	nulls[0] = nulls[1] = false;
+	store_values(slot, values, nulls);
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), 0);
+
+	/* a tuple of the table before column b was added */
+	TupleDescInitBuiltinEntry(old_tupdesc, (AttrNumber) 1, "a", INT4OID, -1, 0);
+	ExecForceStoreHeapTuple(heap_form_tuple(old_tupdesc, values, nulls),
+							slot, true);
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), 0);
+
+	/* a tuple that fits exactly, and one that doesn't */
+	values[1] = CStringGetTextDatum("abc");
+	store_values(slot, values, nulls);
+	len = SerializeTupleDirect(slot, &serInfo, &b);
+	assert_serialized_as(&b, len, tupdesc, values, nulls);
+	b.prilen = len;
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), len);
+	b.prilen = len - 1;
+	assert_int_equal(SerializeTupleDirect(slot, &serInfo, &b), 0);
+
+	ExecDropSingleTupleTableSlot(slot);
+	CleanupSerTupInfo(&serInfo);
+	pfree(b.pri);
+}
+
+int
+main(int argc, char* argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const UnitTest tests[] = {
+		unit_test(test__InitSerTupInfo__fixed_layout),
+		unit_test(test__InitSerTupInfo__no_fixed_layout),
+		unit_test(test__SerializeTupleDirect__matches_minimal_tuple),
+		unit_test(test__SerializeTupleDirect__varlena_and_nulls),
+		unit_test(test__SerializeTupleDirect__falls_back)
+	};
+
+	MemoryContextInit();
+
+	return run_tests(tests);
+}
@@ -23,6 +23,7 @@
 #include "cdb/cdbsrlz.h"
 #include "cdb/tupser.h"
 #include "cdb/cdbvars.h"
+#include "executor/tuptable.h"
 #include "libpq/pqformat.h"
 #include "storage/smgr.h"
 #include "utils/acl.h"
@@ -70,6 +71,7 @@ InitSerTupInfo(TupleDesc tupdesc, SerTupInfo *pSerInfo)
 {
 	int			i,
 				numAttrs;
+	int			data_len;
 
 	AssertArg(tupdesc != NULL);
 	AssertArg(pSerInfo != NULL);
@@ -142,6 +144,43 @@ InitSerTupInfo(TupleDesc tupdesc, SerTupInfo *pSerInfo)
 			ReleaseSysCache(typeTuple);
 		}
 	}
+
+	/*
+	 * See if tuples without nulls all have the same layout, and work it out.
+	 * This must match what heap_form_minimal_tuple() would produce.
+	 */
+	pSerInfo->fixed_layout = true;
+	data_len = 0;
+	for (i = 0; i < numAttrs; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+
+		if (attr->attisdropped || attr->attlen <= 0)
+		{
+			pSerInfo->fixed_layout = false;
+			break;
+		}
+		data_len = att_align_nominal(data_len, attr->attalign);
+		pSerInfo->myinfo[i].fixed_offset = data_len;
+		data_len += attr->attlen;
+	}
+
+	if (pSerInfo->fixed_layout)
+	{
+		int			hoff = MAXALIGN(SizeofMinimalTupleHeader);
+		MinimalTuple header = (MinimalTuple) palloc0(hoff);
+
+		HeapTupleHeaderSetNatts(header, numAttrs);
+		header->t_hoff = hoff + MINIMAL_TUPLE_OFFSET;
+
+		pSerInfo->fixed_header_len = hoff - MINIMAL_TUPLE_DATA_OFFSET;
+		pSerInfo->fixed_header = palloc(pSerInfo->fixed_header_len);
+		memcpy(pSerInfo->fixed_header, (char *) header + MINIMAL_TUPLE_DATA_OFFSET,
+			   pSerInfo->fixed_header_len);
+		pSerInfo->fixed_data_len = data_len;
+
+		pfree(header);
+	}
 }
 
 
@@ -168,6 +207,11 @@ CleanupSerTupInfo(SerTupInfo *pSerInfo)
 		pfree(pSerInfo->nulls);
 	pSerInfo->nulls = NULL;
 
+	if (pSerInfo->fixed_header != NULL)
+		pfree(pSerInfo->fixed_header);
+	pSerInfo->fixed_header = NULL;
+	pSerInfo->fixed_layout = false;
+
 	pSerInfo->tupdesc = NULL;
 
 	while (pSerInfo->chunkCache.items != NULL)
@@ -333,6 +377,141 @@ CandidateForSerializeDirect(int16 targetRoute, struct directTransportBuffer *b)
 	return targetRoute != BROADCAST_SEGIDX && b->pri != NULL && b->prilen > TUPLE_CHUNK_HEADER_SIZE;
 }
 
+/*
+ * Write the tuple in 'slot' into the direct transport buffer, straight from
+ * where the slot keeps it, without forming a MinimalTuple first.  That is
+ * possible when the slot holds a heap or minimal tuple with no toasted
+ * values, which is already in the wire format, or when it holds the values
+ * of a tuple with a fixed layout.
+ *
+ * Returns the number of bytes written, including the chunk header, or 0 if
+ * the tuple doesn't qualify or doesn't fit in the buffer.
+ */
+static int
+SerializeTupleDirect(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTransportBuffer *b)
+{
+	TupleDesc	tupdesc = pSerInfo->tupdesc;
+	MinimalTuple mintuple = NULL;
+	char	   *tupbody;
+	unsigned int tupbodylen;
+	unsigned int tuplen;
+	char	   *pos;
+
+	if (TTS_IS_MINIMALTUPLE(slot))
+		mintuple = ((MinimalTupleTableSlot *) slot)->mintuple;
+	else if (TTS_IS_HEAPTUPLE(slot) || TTS_IS_BUFFERTUPLE(slot))
+	{
+		HeapTuple	tuple = ((HeapTupleTableSlot *) slot)->tuple;
+
+		/* a heap tuple without its transaction fields is a minimal tuple */
+		if (tuple != NULL)
+			mintuple = (MinimalTuple) ((char *) tuple->t_data + MINIMAL_TUPLE_OFFSET);
+	}
+
+	if (mintuple != NULL)
+	{
+		/*
+		 * Toasted values have to be fetched, and missing attributes of tuples
+		 * written before a column was added have to be filled in.
+		 */
+		if (HeapTupleHeaderHasExternal(mintuple) ||
+			HeapTupleHeaderGetNatts(mintuple) != tupdesc->natts)
+			return 0;
+
+		/* the heap tuple's t_len is not filled in its header, see above */
+		if (TTS_IS_MINIMALTUPLE(slot))
+			tuplen = mintuple->t_len;
+		else
+			tuplen = ((HeapTupleTableSlot *) slot)->tuple->t_len - MINIMAL_TUPLE_OFFSET;
+
+		tupbody = (char *) mintuple + MINIMAL_TUPLE_DATA_OFFSET;
+		tupbodylen = tuplen - MINIMAL_TUPLE_DATA_OFFSET;
+
+		if (TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + tupbodylen > b->prilen)
+			return 0;
+
+		pos = (char *) b->pri + TUPLE_CHUNK_HEADER_SIZE;
+		memcpy(pos, &tupbodylen, sizeof(tupbodylen));
+		memcpy(pos + sizeof(int), tupbody, tupbodylen);
+	}
+	else if (TTS_IS_VIRTUAL(slot) && pSerInfo->fixed_layout)
+	{
+		int			natts = tupdesc->natts;
+		char	   *data;
+
+		tupbodylen = pSerInfo->fixed_header_len + pSerInfo->fixed_data_len;
+		if (TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + tupbodylen > b->prilen)
+			return 0;
+
+		slot_getallattrs(slot);
+		for (int i = 0; i < natts; i++)
+		{
+			if (slot->tts_isnull[i])
+				return 0;
+		}
+
+		pos = (char *) b->pri + TUPLE_CHUNK_HEADER_SIZE;
+		memcpy(pos, &tupbodylen, sizeof(tupbodylen));
+		memcpy(pos + sizeof(int), pSerInfo->fixed_header, pSerInfo->fixed_header_len);
+
+		/* the same as heap_fill_tuple(), but the buffer is not aligned */
+		data = pos + sizeof(int) + pSerInfo->fixed_header_len;
+		memset(data, 0, pSerInfo->fixed_data_len);
+		for (int i = 0; i < natts; i++)
+		{
+			SerAttrInfo *attrInfo = &pSerInfo->myinfo[i];
+			Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+			char	   *attdata = data + attrInfo->fixed_offset;
+			Datum		value = slot->tts_values[i];
+
+			if (attr->attbyval)
+			{
+				switch (attr->attlen)
+				{
+					case sizeof(char):
+						{
+							char		v = DatumGetChar(value);
+
+							memcpy(attdata, &v, sizeof(v));
+						}
+						break;
+					case sizeof(int16):
+						{
+							int16		v = DatumGetInt16(value);
+
+							memcpy(attdata, &v, sizeof(v));
+						}
+						break;
+					case sizeof(int32):
+						{
+							int32		v = DatumGetInt32(value);
+
+							memcpy(attdata, &v, sizeof(v));
+						}
+						break;
+#if SIZEOF_DATUM == 8
+					case sizeof(Datum):
+						memcpy(attdata, &value, sizeof(Datum));
+						break;
+#endif
+					default:
+						elog(ERROR, "unsupported byval length: %d",
+							 (int) attr->attlen);
+				}
+			}
+			else
+				memcpy(attdata, DatumGetPointer(value), attr->attlen);
+		}
+	}
+	else
+		return 0;
+
+	SetChunkType(b->pri, TC_WHOLE);
+	SetChunkDataSize(b->pri, sizeof(int) + tupbodylen);
+
+	return TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + tupbodylen;
+}
+
 /*
  *
  * First try to serialize a tuple directly into a buffer.
@@ -345,7 +524,7 @@ CandidateForSerializeDirect(int16 targetRoute, struct directTransportBuffer *b)
  * This code is based on the printtup_internal_20() function in printtup.c.
  */
 int
-SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTransportBuffer *b, TupleChunkList tcList, int16 targetRoute)
+SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTransportBuffer *b, TupleChunkList tcList, int16 targetRoute, bool *zerocopy)
 {
 	int                natts;
 	int                dataSize = TUPLE_CHUNK_HEADER_SIZE;
@@ -364,6 +543,8 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 	tupdesc = pSerInfo->tupdesc;
 	natts = tupdesc->natts;
 
+	*zerocopy = false;
+
 	if (natts == 0 && CandidateForSerializeDirect(targetRoute, b))
 	{
 		/* TC_EMPTY is just one chunk */
@@ -373,6 +554,17 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 		return TUPLE_CHUNK_HEADER_SIZE;
 	}
 
+	if (CandidateForSerializeDirect(targetRoute, b))
+	{
+		dataSize = SerializeTupleDirect(slot, pSerInfo, b);
+		if (dataSize > 0)
+		{
+			*zerocopy = true;
+			return dataSize;
+		}
+		dataSize = TUPLE_CHUNK_HEADER_SIZE;
+	}
+
 	tcList->p_first = NULL;
 	tcList->p_last = NULL;
 	tcList->num_chunks = 0;
@@ -518,6 +710,7 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 	TupleChunkListItem firstTcItem;
 	MinimalTuple tup;
 	TupleChunkType tcType;
+	char	   *tupbuf = NULL;
 
 	AssertArg(tcList != NULL);
 	AssertArg(tcList->p_first != NULL);
@@ -599,7 +792,13 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 			tcItem = tcItem->p_next;
 		}
 
-		serData.data = palloc(total_len);
+		/*
+		 * Reassemble the data right where it ends up in the tuple: the length
+		 * word goes just before the tuple body, so only t_len needs to be
+		 * filled in afterwards.
+		 */
+		tupbuf = palloc(MINIMAL_TUPLE_DATA_OFFSET - sizeof(int) + total_len);
+		serData.data = tupbuf + MINIMAL_TUPLE_DATA_OFFSET - sizeof(int);
 		serData.len = serData.maxlen = total_len;
 		serData.cursor = 0;
 		serDataMustFree = true;
@@ -658,10 +857,21 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 
 			/* Free up memory we used. */
 			if (serDataMustFree)
-				pfree(serData.data);
+				pfree(tupbuf);
 
 			return NULL;
 		}
+		else if (serDataMustFree)
+		{
+			/* A normal MinimalTuple, already in place */
+			if (tupbodylen != serData.len - sizeof(int))
+				ereport(ERROR,
+						(errcode(ERRCODE_PROTOCOL_VIOLATION),
+						 errmsg("chunked tuple length %d does not match its chunks", tupbodylen)));
+
+			tup = (MinimalTuple) tupbuf;
+			tup->t_len = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+		}
 		else
 		{
 			/* A normal MinimalTuple */
@@ -676,9 +886,5 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 		}
 	}
 
-	/* Free up memory we used. */
-	if (serDataMustFree)
-		pfree(serData.data);
-
 	return tup;
 }
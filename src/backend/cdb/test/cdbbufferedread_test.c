@@ -12,7 +12,7 @@ test__BufferedReadInit__IsConsistent(void **state)
 {
 	BufferedRead *bufferedRead = palloc(sizeof(BufferedRead));
 	int32 memoryLen = 512; /* maxBufferLen + largeReadLen */
-	uint8 *memory = malloc(sizeof(memoryLen));
+	uint8 *memory = malloc(memoryLen);
 	char *relname = "test";
 	int32 maxBufferLen = 128;
 	int32 maxLargeReadLen = 128;
@@ -39,7 +39,7 @@ test__BufferedReadUseBeforeBuffer__IsNextReadLenZero(void **state)
 {
     BufferedRead *bufferedRead = palloc(sizeof(BufferedRead));
     int32 memoryLen = 512; /* maxBufferLen + largeReadLen */
-	uint8 *memory = malloc(sizeof(memoryLen));
+	uint8 *memory = malloc(memoryLen);
 	char *relname = "test";
 	int32 maxBufferLen = 128;
 	int32 maxLargeReadLen = 128;
@@ -84,6 +84,97 @@ test__BufferedReadUseBeforeBuffer__IsNextReadLenZero(void **state)
 	PG_END_TRY();	
 }
 
+/*
+ * Expect a large read of the given length at the given offset, and return
+ * that many bytes.
+ */
+static void
+expect_file_read(File file, int amount, off_t offset)
+{
+	expect_value(FileRead, file, file);
+	expect_any(FileRead, buffer);
+	expect_value(FileRead, amount, amount);
+	expect_value(FileRead, offset, offset);
+	expect_any(FileRead, wait_event_info);
+	will_return(FileRead, amount);
+}
+
+static void
+expect_file_prefetch(File file, off_t offset, int amount)
+{
+	expect_value(FilePrefetch, file, file);
+	expect_value(FilePrefetch, offset, offset);
+	expect_value(FilePrefetch, amount, amount);
+	expect_any(FilePrefetch, wait_event_info);
+	will_return(FilePrefetch, 0);
+}
+
+/*
+ * The read statistics count the bytes read, and the read-ahead window of
+ * gp_appendonly_prefetch_size is topped up only once half of it has been
+ * consumed.  BufferedReadAddStats() adds them to a scan's totals.
+ */
+static void
+test__BufferedReadIo__CountsReadAndPrefetchBytes(void **state)
+{
+	BufferedRead *bufferedRead = palloc0(sizeof(BufferedRead));
+	int32		maxBufferLen = 128;
+	int32		maxLargeReadLen = 128;
+	int32		memoryLen = maxBufferLen + maxLargeReadLen;
+	uint8	   *memory = palloc(memoryLen);
+	File		file = 1;
+	int64		prefetchBytes;
+	instr_time	stallTime;
+
+	BufferedReadInit(bufferedRead, memory, memoryLen, maxBufferLen,
+					 maxLargeReadLen, "test");
+	gp_appendonly_prefetch_size = 1;	/* kB */
+
+	/* the first read prefetches the next 1kB */
+	expect_file_read(file, 128, 0);
+	expect_file_prefetch(file, 128, 1024);
+	BufferedReadSetFile(bufferedRead, file, "test_file", 4096);
+
+	assert_int_equal(bufferedRead->readBytes, 128);
+	assert_int_equal(bufferedRead->prefetchBytes, 1024);
+
+	/* the next reads eat into the window, without prefetching more */
+	expect_file_read(file, 128, 128);
+	BufferedReadIo(bufferedRead);
+	expect_file_read(file, 128, 256);
+	BufferedReadIo(bufferedRead);
+	expect_file_read(file, 128, 384);
+	BufferedReadIo(bufferedRead);
+
+	assert_int_equal(bufferedRead->readBytes, 512);
+	assert_int_equal(bufferedRead->prefetchBytes, 1024);
+
+	/* until half of it is consumed: then it is topped up to 1kB again */
+	expect_file_read(file, 128, 512);
+	expect_file_prefetch(file, 1152, 512);
+	BufferedReadIo(bufferedRead);
+
+	assert_int_equal(bufferedRead->readBytes, 640);
+	assert_int_equal(bufferedRead->prefetchBytes, 1536);
+
+	/* no prefetching at all with gp_appendonly_prefetch_size = 0 */
+	gp_appendonly_prefetch_size = 0;
+	expect_file_read(file, 128, 640);
+	BufferedReadIo(bufferedRead);
+
+	assert_int_equal(bufferedRead->readBytes, 768);
+	assert_int_equal(bufferedRead->prefetchBytes, 1536);
+
+	/* EXPLAIN ANALYZE adds them up over the readers of a scan */
+	prefetchBytes = 100;
+	INSTR_TIME_SET_ZERO(stallTime);
+	BufferedReadAddStats(bufferedRead, &prefetchBytes, &stallTime);
+
+	assert_int_equal(prefetchBytes, 1636);
+	assert_true(INSTR_TIME_GET_DOUBLE(stallTime) ==
+				INSTR_TIME_GET_DOUBLE(bufferedRead->stallTime));
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -91,7 +182,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] = {
 		unit_test(test__BufferedReadUseBeforeBuffer__IsNextReadLenZero),
-		unit_test(test__BufferedReadInit__IsConsistent)
+		unit_test(test__BufferedReadInit__IsConsistent),
+		unit_test(test__BufferedReadIo__CountsReadAndPrefetchBytes)
 	};
 
 	MemoryContextInit();
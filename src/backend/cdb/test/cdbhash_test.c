@@ -0,0 +1,81 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "postgres.h"
+#include "utils/memutils.h"
+
+#include "../cdbhash.c"
+
+#define NROWS 100
+
+/*
+ * Set up a CdbHash for the given hash functions by hand, the way
+ * makeCdbHash() does for non-legacy ones.  Only the inline kernels are
+ * exercised here, so no FmgrInfos are needed.
+ */
+static CdbHash *
+make_test_hash(int numsegs, int natts, Oid *hashfuncs)
+{
+	CdbHash    *h = palloc0(sizeof(CdbHash));
+
+	h->numsegs = numsegs;
+	h->natts = natts;
+	h->reducealg = REDUCE_JUMP_HASH;
+	h->kernels = palloc(natts * sizeof(CdbHashKernel));
+	for (int i = 0; i < natts; i++)
+	{
+		h->kernels[i] = cdbhash_kernel_for_func(hashfuncs[i]);
+		assert_int_not_equal(h->kernels[i], CDBHASH_KERNEL_FMGR);
+	}
+
+	return h;
+}
+
+static int64
+test_value(int i)
+{
+	/* both signs, and values that need all 64 bits */
+	return (i % 2 ? -1 : 1) * ((int64) i * INT64CONST(0x123456789ab));
+}
+
+static void
+test__cdbhash_kernels_match_hash_functions(void **state)
+{
+	Oid			funcs[] = {F_HASHINT2, F_HASHINT4, F_HASHINT8, F_HASHTEXT};
+	CdbHash    *h = make_test_hash(3, 4, funcs);
+
+	for (int i = 0; i < NROWS; i++)
+	{
+		int64		v = test_value(i);
+		char		str[32];
+		Datum		t;
+
+		snprintf(str, sizeof(str), "value " INT64_FORMAT, v);
+		t = PointerGetDatum(cstring_to_text(str));
+
+		assert_int_equal(cdbhash_datum(h, 1, Int16GetDatum((int16) v)),
+						 DatumGetUInt32(DirectFunctionCall1(hashint2, Int16GetDatum((int16) v))));
+		assert_int_equal(cdbhash_datum(h, 2, Int32GetDatum((int32) v)),
+						 DatumGetUInt32(DirectFunctionCall1(hashint4, Int32GetDatum((int32) v))));
+		assert_int_equal(cdbhash_datum(h, 3, Int64GetDatum(v)),
+						 DatumGetUInt32(DirectFunctionCall1(hashint8, Int64GetDatum(v))));
+		assert_int_equal(cdbhash_datum(h, 4, t),
+						 DatumGetUInt32(DirectFunctionCall1Coll(hashtext, DEFAULT_COLLATION_OID, t)));
+	}
+}
+
+int
+main(int argc, char* argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	MemoryContextInit();
+
+	const UnitTest tests[] = {
+		unit_test(test__cdbhash_kernels_match_hash_functions)
+	};
+
+	return run_tests(tests);
+}
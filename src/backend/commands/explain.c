@@ -986,6 +986,12 @@ ExplainPrintPlan(ExplainState *es, QueryDesc *queryDesc)
 #ifdef USE_ORCA
 	else
 		ExplainPropertyStringInfo("Optimizer", es, "GPORCA");
+
+	if (es->verbose && queryDesc->plannedstmt->optimizerBudgetStage > 0)
+		ExplainPropertyStringInfo("Optimizer Budget Exhausted", es,
+								  "search stage %d of %d",
+								  queryDesc->plannedstmt->optimizerBudgetStage,
+								  queryDesc->plannedstmt->optimizerSearchStages);
 #endif
 
 	ExplainPrintSettings(es);
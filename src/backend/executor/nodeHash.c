@@ -37,15 +37,21 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "executor/nodeSeqscan.h"
+#include "lib/bloomfilter.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/parsetree.h"
 #include "pgstat.h"
 #include "port/atomics.h"
 #include "port/pg_bitutils.h"
 #include "utils/dynahash.h"
+#include "utils/guc.h"
 #include "utils/memutils.h"
 #include "utils/lsyscache.h"
 #include "utils/faultinjector.h"
 #include "utils/syscache.h"
+#include "utils/typcache.h"
 
 #include "cdb/cdbexplain.h"
 #include "cdb/cdbutil.h"
@@ -98,6 +104,8 @@ static void ExecParallelHashCloseBatchAccessors(HashJoinTable hashtable);
 
 static inline void ResetWorkFileSetStatsInfo(HashJoinTable hashtable);
 
+static void BuildRuntimeFilters(HashState *node, ExprContext *econtext);
+
 /* ----------------------------------------------------------------
  *		ExecHash
  *
@@ -160,6 +168,7 @@ MultiExecPrivateHash(HashState *node)
 	TupleTableSlot *slot;
 	ExprContext *econtext;
 	uint32		hashvalue;
+	ListCell   *lc;
 
 	/*
 	 * get state info from node
@@ -175,6 +184,10 @@ MultiExecPrivateHash(HashState *node)
 
 	SIMPLE_FAULT_INJECTOR("multi_exec_hash_large_vmem");
 
+	/* Start runtime filters afresh, in case this is a rebuild */
+	if (node->filters != NIL)
+		ExecHashResetRuntimeFilters(node);
+
 	/*
 	 * Get all tuples from the node below the Hash node and insert into the
 	 * hash table (or temp files).
@@ -209,6 +222,9 @@ MultiExecPrivateHash(HashState *node)
 				ExecHashTableInsert(node, hashtable, slot, hashvalue);
 			}
 			hashtable->totalTuples += 1;
+
+			if (node->filters != NIL)
+				BuildRuntimeFilters(node, econtext);
 		}
 
 		if (hashkeys_null)
@@ -222,6 +238,10 @@ MultiExecPrivateHash(HashState *node)
 		}
 	}
 
+	/* The whole inner side is in, so the outer scan may use the filters */
+	foreach(lc, node->filters)
+		((AttrFilter *) lfirst(lc))->ready = true;
+
 	/* Now we have set up all the initial batches & primary overflow batches. */
 	hashtable->nbatch_outstart = hashtable->nbatch;
 
@@ -2408,6 +2428,202 @@ ExecReScanHash(HashState *node)
 }
 
 
+/*
+ * ExecHashInitRuntimeFilters
+ *		Set up runtime filters on the hash join keys, and push them down to
+ *		the SeqScan on the outer side of the join.
+ *
+ * Called by ExecInitHashJoin() once both children have been initialized.
+ * The filters are filled in by MultiExecPrivateHash(); until then the outer
+ * scan passes every row through.
+ *
+ * A filter is only safe when an outer row without a join partner is never
+ * returned by the join, so outer, anti and NOT IN joins are left alone, as
+ * are IS NOT DISTINCT FROM joins which match NULL keys.  The outer child
+ * must be the SeqScan itself: anything else, a Motion in particular, means
+ * the scan is not ours to filter.
+ */
+void
+ExecHashInitRuntimeFilters(HashState *node, HashJoinState *hjstate)
+{
+	HashJoin   *hj = (HashJoin *) hjstate->js.ps.plan;
+	Hash	   *hash = (Hash *) node->ps.plan;
+	PlanState  *outerNode = outerPlanState(hjstate);
+	SeqScan    *scan;
+	ListCell   *lco;
+	ListCell   *lci;
+	ListCell   *lcop;
+	ListCell   *lccoll;
+	int			keyno = 0;
+
+	if (!gp_enable_runtime_filter_pushdown)
+		return;
+
+	if (hjstate->js.jointype != JOIN_INNER &&
+		hjstate->js.jointype != JOIN_SEMI &&
+		hjstate->js.jointype != JOIN_RIGHT)
+		return;
+
+	if (hjstate->hj_nonequijoin || hash->plan.parallel_aware)
+		return;
+
+	if (!IsA(outerNode, SeqScanState) || outerNode->plan->parallel_aware)
+		return;
+	scan = (SeqScan *) outerNode->plan;
+
+	forfour(lco, hj->hashkeys, lci, hash->hashkeys,
+			lcop, hj->hashoperators, lccoll, hj->hashcollations)
+	{
+		Expr	   *okey = (Expr *) lfirst(lco);
+		Expr	   *ikey = (Expr *) lfirst(lci);
+		Oid			hashop = lfirst_oid(lcop);
+		Oid			outer_hashfn;
+		Oid			inner_hashfn;
+		Oid			typid;
+		TargetEntry *tle;
+		Var		   *var;
+		AttrFilter *filter;
+
+		keyno++;
+
+		/* The outer key must be a plain column of the scanned relation */
+		while (IsA(okey, RelabelType))
+			okey = ((RelabelType *) okey)->arg;
+		if (!IsA(okey, Var) || ((Var *) okey)->varno != OUTER_VAR)
+			continue;
+
+		tle = get_tle_by_resno(scan->plan.targetlist, ((Var *) okey)->varattno);
+		if (tle == NULL || !IsA(tle->expr, Var))
+			continue;
+		var = (Var *) tle->expr;
+		if (var->varno != scan->scanrelid || var->varattno <= 0)
+			continue;
+
+		if (!get_op_hash_functions(hashop, &outer_hashfn, &inner_hashfn))
+			continue;
+
+		filter = (AttrFilter *) palloc0(sizeof(AttrFilter));
+		filter->keyno = keyno - 1;
+		filter->lattno = var->varattno;
+		filter->target = outerNode;
+		filter->collation = lfirst_oid(lccoll);
+		filter->nelems = (int64) Max(hash->plan.plan_rows, 1.0);
+		filter->empty = true;
+		fmgr_info(inner_hashfn, &filter->inner_hashfn);
+		fmgr_info(outer_hashfn, &filter->outer_hashfn);
+
+		/*
+		 * Keep a min/max range too, when both sides have the same by-value
+		 * type and the join uses its default equality, so that the btree
+		 * comparison agrees with the join's notion of equality.
+		 */
+		typid = exprType((Node *) ikey);
+		if (typid == var->vartype && get_typbyval(typid))
+		{
+			TypeCacheEntry *typentry;
+
+			typentry = lookup_type_cache(typid,
+										 TYPECACHE_EQ_OPR |
+										 TYPECACHE_CMP_PROC_FINFO);
+			if (typentry->eq_opr == hashop &&
+				OidIsValid(typentry->cmp_proc_finfo.fn_oid))
+			{
+				fmgr_info_copy(&filter->cmpfn, &typentry->cmp_proc_finfo,
+							   CurrentMemoryContext);
+				filter->has_range = true;
+			}
+		}
+
+		node->filters = lappend(node->filters, filter);
+		ExecSeqScanAddRuntimeFilter((SeqScanState *) outerNode, filter);
+	}
+}
+
+/*
+ * ExecHashResetRuntimeFilters
+ *		Forget the contents of the runtime filters, before the hash table is
+ *		rebuilt.
+ */
+void
+ExecHashResetRuntimeFilters(HashState *node)
+{
+	ListCell   *lc;
+
+	foreach(lc, node->filters)
+	{
+		AttrFilter *filter = (AttrFilter *) lfirst(lc);
+
+		filter->ready = false;
+		filter->empty = true;
+		filter->min = (Datum) 0;
+		filter->max = (Datum) 0;
+		if (filter->blm_filter)
+		{
+			bloom_free(filter->blm_filter);
+			filter->blm_filter = NULL;
+		}
+	}
+}
+
+/*
+ * BuildRuntimeFilters
+ *		Add the current inner tuple's join keys to the runtime filters.
+ *
+ * Called with econtext->ecxt_outertuple set to the inner tuple, right after
+ * ExecHashGetHashValue() accepted it.
+ */
+static void
+BuildRuntimeFilters(HashState *node, ExprContext *econtext)
+{
+	MemoryContext oldContext;
+	ListCell   *lc;
+
+	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	foreach(lc, node->filters)
+	{
+		AttrFilter *filter = (AttrFilter *) lfirst(lc);
+		ExprState  *keyexpr = (ExprState *) list_nth(node->hashkeys, filter->keyno);
+		Datum		keyval;
+		bool		isNull;
+		uint32		hkey;
+
+		keyval = ExecEvalExpr(keyexpr, econtext, &isNull);
+		if (isNull)
+			continue;
+
+		if (filter->blm_filter == NULL)
+		{
+			MemoryContextSwitchTo(oldContext);
+			filter->blm_filter = bloom_create(filter->nelems, work_mem, 0);
+			MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+		}
+
+		hkey = DatumGetUInt32(FunctionCall1Coll(&filter->inner_hashfn,
+												 filter->collation,
+												 keyval));
+		bloom_add_element(filter->blm_filter, (unsigned char *) &hkey,
+						  sizeof(hkey));
+
+		if (filter->has_range)
+		{
+			if (filter->empty)
+				filter->min = filter->max = keyval;
+			else if (DatumGetInt32(FunctionCall2Coll(&filter->cmpfn,
+													 filter->collation,
+													 keyval, filter->min)) < 0)
+				filter->min = keyval;
+			else if (DatumGetInt32(FunctionCall2Coll(&filter->cmpfn,
+													 filter->collation,
+													 keyval, filter->max)) > 0)
+				filter->max = keyval;
+		}
+		filter->empty = false;
+	}
+
+	MemoryContextSwitchTo(oldContext);
+}
+
 /*
  * ExecHashTableExplainInit
  *      Called after ExecHashTableCreate to set up EXPLAIN ANALYZE reporting.
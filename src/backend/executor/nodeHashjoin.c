@@ -933,6 +933,12 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	/*
+	 * GPDB: push bloom and min/max filters on the join keys down to the
+	 * outer scan, if it is in this slice.
+	 */
+	ExecHashInitRuntimeFilters((HashState *) innerPlanState(hjstate), hjstate);
+
 	return hjstate;
 }
 
@@ -1654,6 +1660,12 @@ ExecReScanHashJoin(HashJoinState *node)
 			node->hj_HashTable = NULL;
 			node->hj_JoinState = HJ_BUILD_HASHTABLE;
 
+			/*
+			 * The runtime filters describe the old inner side; the outer
+			 * scan must not use them until the hash table is rebuilt.
+			 */
+			ExecHashResetRuntimeFilters(hashNode);
+
 			/*
 			 * if chgParam of subnode is not null then plan will be re-scanned
 			 * by first ExecProcNode.
@@ -21,16 +21,24 @@
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
 #include "cdb/cdbhash.h"
+#include "cdb/ml_ipc.h"
 #include "executor/executor.h"
 #include "executor/execdebug.h"
 #include "executor/execUtils.h"
 #include "executor/nodeMotion.h"
-#include "lib/binaryheap.h"
+#include "lib/losertree.h"
+#include "lib/stringinfo.h"
 #include "utils/tuplesort.h"
 #include "miscadmin.h"
 #include "utils/memutils.h"
 
 
+/*
+ * Number of tuples an unsorted receiver takes from the motion layer at a
+ * time.
+ */
+#define MOTION_RECV_BATCH_SIZE 256
+
 /* #define MEASURE_MOTION_TIME */
 
 #ifdef MEASURE_MOTION_TIME
@@ -52,11 +60,14 @@ static TupleTableSlot *execMotionSender(MotionState *node);
 static TupleTableSlot *execMotionUnsortedReceiver(MotionState *node);
 static TupleTableSlot *execMotionSortedReceiver(MotionState *node);
 
-static int	CdbMergeComparator(Datum lhs, Datum rhs, void *context);
+static int	CdbMergeComparator(int lSegIdx, int rSegIdx, void *context);
+static void storeMergeHead(MotionState *node, int segIdx, MinimalTuple tuple);
+static void abortMergeAbbrev(MotionState *node);
 static uint32 evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash *h);
 
 static void doSendEndOfStream(Motion *motion, MotionState *node);
 static void doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot);
+static void ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 
 /*=========================================================================
@@ -348,11 +359,22 @@ execMotionUnsortedReceiver(MotionState *node)
 			ereport(ERROR, (errmsg("Interconnect is down unexpectedly.")));
 	}
 
-	tuple = RecvTupleFrom(node->ps.state->motionlayer_context,
-						  node->ps.state->interconnect_context,
-						  motion->motionID, ANY_ROUTE);
+	/*
+	 * Take all the tuples the motion layer has ready in one go, once the
+	 * previous batch has been handed out.
+	 */
+	if (node->nextRecvTuple == node->numRecvTuples)
+	{
+		node->numRecvTuples = RecvTuplesFrom(node->ps.state->motionlayer_context,
+											 node->ps.state->interconnect_context,
+											 motion->motionID,
+											 node->recvTuples,
+											 MOTION_RECV_BATCH_SIZE);
+		node->nextRecvTuple = 0;
+		node->numTuplesFromAMS += node->numRecvTuples;
+	}
 
-	if (!tuple)
+	if (node->numRecvTuples == 0)
 	{
 #ifdef CDB_MOTION_DEBUG
 		if (gp_log_interconnect >= GPVARS_VERBOSITY_DEBUG)
@@ -364,7 +386,7 @@ execMotionUnsortedReceiver(MotionState *node)
 		return NULL;
 	}
 
-	node->numTuplesFromAMS++;
+	tuple = node->recvTuples[node->nextRecvTuple++];
 	node->numTuplesToParent++;
 
 	/* store it in our result slot and return this. */
@@ -411,7 +433,7 @@ execMotionUnsortedReceiver(MotionState *node)
  * --------------------
  *
  * The 1st time we execute, we need to pull a tuple from each of our source
- * and store them in our tupleheap.  Once that is done, we can pick the lowest
+ * and store them in our mergetree.  Once that is done, we can pick the lowest
  * (or whatever the criterion is) value from amongst all the sources.  This
  * works since each stream is sorted itself.
  *
@@ -421,21 +443,29 @@ execMotionUnsortedReceiver(MotionState *node)
  * Subsequent calls to this function (after the 1st time) will start by
  * trying to receive a tuple for the slot that was emptied the previous call.
  * Then we again select the lowest value and return that tuple.
+ *
+ * The streams are merged with a tree of losers rather than a binary heap:
+ * replacing the lowest tuple then takes one comparison per level of the
+ * tree, instead of up to two.  With hundreds of senders, the comparisons
+ * are most of the cost of the merge, so the leading sort key of the tuple
+ * at the head of each stream is also kept aside, abbreviated if its type
+ * allows and as long as that pays off, and most comparisons are decided on
+ * it alone.
  */
 
-/* Sorted receiver using binary heap */
+/* Sorted receiver using a loser tree */
 static TupleTableSlot *
 execMotionSortedReceiver(MotionState *node)
 {
 	TupleTableSlot *slot;
-	binaryheap *hp = node->tupleheap;
+	losertree  *lt = node->mergetree;
 	MinimalTuple inputTuple;
 	Motion	   *motion = (Motion *) node->ps.plan;
 	EState	   *estate = node->ps.state;
 
 	AssertState(motion->motionType == MOTIONTYPE_GATHER &&
 				motion->sendSorted &&
-				hp != NULL);
+				lt != NULL);
 
 	/* Notify senders and return EOS if caller doesn't want any more data. */
 	if (node->stopRequested)
@@ -474,10 +504,9 @@ execMotionSortedReceiver(MotionState *node)
 	/*
 	 * On first call, fill the priority queue with each sender's first tuple.
 	 */
-	if (!node->tupleheapReady)
+	if (!node->mergetreeReady)
 	{
 		MinimalTuple inputTuple;
-		binaryheap *hp = node->tupleheap;
 		Motion	   *motion = (Motion *) node->ps.plan;
 		int			iSegIdx;
 		ListCell   *lcProcess;
@@ -510,17 +539,9 @@ execMotionSortedReceiver(MotionState *node)
 													  &TTSOpsMinimalTuple);
 			MemoryContextSwitchTo(oldcxt);
 
-			/*
-			 * Store the tuple in the slot, and add it to the heap.
-			 *
-			 * Use slot_getsomeattrs() to materialize the columns we need for
-			 * the comparisons in the tts_values/isnull arrays. The comparator
-			 * can then peek directly into the arrays, which is cheaper than
-			 * calling slot_getattr() all the time.
-			 */
-			ExecStoreMinimalTuple(inputTuple, node->slots[iSegIdx], true);
-			slot_getsomeattrs(node->slots[iSegIdx], node->lastSortColIdx);
-			binaryheap_add_unordered(hp, iSegIdx);
+			/* Store the tuple in the slot, and add it to the tree. */
+			storeMergeHead(node, iSegIdx, inputTuple);
+			losertree_add_unordered(lt, iSegIdx);
 
 			node->numTuplesFromAMS++;
 
@@ -542,14 +563,10 @@ execMotionSortedReceiver(MotionState *node)
 		}
 		Assert(iSegIdx == node->numInputSegs);
 
-		/*
-		 * Done adding the elements, now arrange the heap to satisfy the heap
-		 * property. This is quicker than inserting the initial elements one by
-		 * one.
-		 */
-		binaryheap_build(hp);
+		/* Done adding the elements, now play the matches of the tree. */
+		losertree_build(lt);
 
-		node->tupleheapReady = true;
+		node->mergetreeReady = true;
 	}
 
 	/*
@@ -559,11 +576,11 @@ execMotionSortedReceiver(MotionState *node)
 	else
 	{
 		/* sanity check */
-		if (binaryheap_empty(hp))
+		if (losertree_empty(lt))
 			elog(ERROR, "sorted Gather Motion called again after already receiving all data");
 
-		/* Old element is still at the head of the pq. */
-		Assert(DatumGetInt32(binaryheap_first(hp)) == node->routeIdNext);
+		/* Old element is still the winner of the tree. */
+		Assert(losertree_first(lt) == node->routeIdNext);
 
 		/* Receive the successor of the tuple that we returned last time. */
 		inputTuple = RecvTupleFrom(node->ps.state->motionlayer_context,
@@ -571,12 +588,20 @@ execMotionSortedReceiver(MotionState *node)
 								   motion->motionID,
 								   node->routeIdNext);
 
-		/* Substitute it in the pq for its predecessor. */
+		/* Substitute it in the tree for its predecessor. */
 		if (inputTuple)
 		{
-			ExecStoreMinimalTuple(inputTuple, node->slots[node->routeIdNext], true);
-			slot_getsomeattrs(node->slots[node->routeIdNext], node->lastSortColIdx);
-			binaryheap_replace_first(hp, Int32GetDatum(node->routeIdNext));
+			storeMergeHead(node, node->routeIdNext, inputTuple);
+			losertree_replace_first(lt);
+
+			/*
+			 * If that was the last tuple we had from this sender, take its
+			 * next packet now if it is there, see PrefetchTuplesFrom().
+			 */
+			PrefetchTuplesFrom(node->ps.state->motionlayer_context,
+							   node->ps.state->interconnect_context,
+							   motion->motionID,
+							   node->routeIdNext);
 
 			node->numTuplesFromAMS++;
 
@@ -598,13 +623,13 @@ execMotionSortedReceiver(MotionState *node)
 		}
 		else
 		{
-			/* At EOS, drop this sender from the priority queue. */
-			binaryheap_remove_first(hp);
+			/* At EOS, drop this sender from the tree. */
+			losertree_remove_first(lt);
 		}
 	}
 
 	/* Finished if all senders have returned EOS. */
-	if (binaryheap_empty(hp))
+	if (losertree_empty(lt))
 	{
 		Assert(node->numTuplesFromAMS == node->numTuplesToParent);
 		Assert(node->numTuplesFromChild == 0);
@@ -613,15 +638,14 @@ execMotionSortedReceiver(MotionState *node)
 	}
 
 	/*
-	 * Our next result tuple, with lowest key among all senders, is now at the
-	 * head of the priority queue.  Get it from there.
+	 * Our next result tuple, with lowest key among all senders, is now the
+	 * winner of the tree.  Get it from there.
 	 *
-	 * We transfer ownership of the tuple from the pq element to our caller,
-	 * but the pq element itself will remain in place until the next time we
-	 * are called, to avoid an unnecessary rearrangement of the priority
-	 * queue.
+	 * We transfer ownership of the tuple from the slot to our caller, but the
+	 * winner itself will remain in place until the next time we are called,
+	 * when its successor replaces it.
 	 */
-	node->routeIdNext = binaryheap_first(hp);
+	node->routeIdNext = losertree_first(lt);
 	slot = node->slots[node->routeIdNext];
 
 	/* Update counters. */
@@ -754,7 +778,7 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 		/* TODO: If neither sending nor receiving, don't bother to initialize. */
 	}
 
-	motionstate->tupleheapReady = false;
+	motionstate->mergetreeReady = false;
 	motionstate->sentEndOfStream = false;
 
 	motionstate->otherTime.tv_sec = 0;
@@ -770,6 +794,10 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 	motionstate->stopRequested = false;
 	motionstate->numInputSegs = list_length(sendSlice->segments);
 
+	/* Report the interconnect compression ratio in EXPLAIN ANALYZE. */
+	if (motionstate->mstype != MOTIONSTATE_NONE)
+		motionstate->ps.cdbexplainfun = ExecMotionExplainEnd;
+
 	/*
 	 * Miscellaneous initialization
 	 *
@@ -822,8 +850,12 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 										   node->hashFuncs);
 	}
 
+	/* Set up the array of the tuples received in a batch */
+	if (!node->sendSorted && motionstate->mstype == MOTIONSTATE_RECV)
+		motionstate->recvTuples = palloc(MOTION_RECV_BATCH_SIZE * sizeof(MinimalTuple));
+
 	/*
-	 * Merge Receive: Set up the key comparator and priority queue.
+	 * Merge Receive: Set up the key comparator and loser tree.
 	 *
 	 * This is very similar to a Merge Append.
 	 */
@@ -834,6 +866,9 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 
 		/* Allocate array to slots for the next tuple from each sender */
 		motionstate->slots = palloc0(numInputSegs * sizeof(TupleTableSlot *));
+		motionstate->headKeys = palloc0(numInputSegs * sizeof(Datum));
+		motionstate->headIsnull = palloc0(numInputSegs * sizeof(bool));
+		motionstate->abbrevNext = 10;
 
 		/* Prepare SortSupport data for each column */
 		motionstate->numSortCols = node->numSortCols;
@@ -850,6 +885,8 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 			sortKey->ssup_collation = node->collations[i];
 			sortKey->ssup_nulls_first = node->nullsFirst[i];
 			sortKey->ssup_attno = node->sortColIdx[i];
+			/* Abbreviate the leading key, as kept in headKeys */
+			sortKey->abbreviate = (i == 0);
 
 			PrepareSortSupportFromOrderingOp(node->sortOperators[i], sortKey);
 
@@ -858,10 +895,10 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 				lastSortColIdx = node->sortColIdx[i];
 		}
 		motionstate->lastSortColIdx = lastSortColIdx;
-		motionstate->tupleheap =
-			binaryheap_allocate(motionstate->numInputSegs,
-								CdbMergeComparator,
-								motionstate);
+		motionstate->mergetree =
+			losertree_allocate(motionstate->numInputSegs,
+							   CdbMergeComparator,
+							   motionstate);
 	}
 
 	/*
@@ -964,11 +1001,21 @@ ExecEndMotion(MotionState *node)
 	}
 #endif							/* MEASURE_MOTION_TIME */
 
-	/* Merge Receive: Free the priority queue and associated structures. */
-	if (node->tupleheap != NULL)
+	/* Merge Receive: Free the loser tree and associated structures. */
+	if (node->mergetree != NULL)
 	{
-		binaryheap_free(node->tupleheap);
-		node->tupleheap = NULL;
+		losertree_free(node->mergetree);
+		node->mergetree = NULL;
+	}
+
+	/*
+	 * Unsorted Receive: Free the batch array.  Tuples left in it after a stop
+	 * belong to the motion layer, and go away with it.
+	 */
+	if (node->recvTuples != NULL)
+	{
+		pfree(node->recvTuples);
+		node->recvTuples = NULL;
 	}
 
 	/* Free the slices and routes */
@@ -993,22 +1040,140 @@ ExecEndMotion(MotionState *node)
 }
 
 
+/*
+ * ExecMotionExplainEnd
+ *		Called before ExecutorEnd to finish EXPLAIN ANALYZE reporting.
+ */
+static void
+ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	MotionState *node = (MotionState *) planstate;
+	Motion	   *motion = (Motion *) node->ps.plan;
+	uint64		rawBytes;
+	uint64		wireBytes;
+	uint64		bytesSent;
+	uint64		localBytes;
+	int			numReceivers;
+
+	getMotionCompressionStats(node->ps.state->interconnect_context,
+							  motion->motionID, &rawBytes, &wireBytes);
+	if (rawBytes != 0)
+		appendStringInfo(buf, "Interconnect compression: " UINT64_FORMAT " bytes %s as " UINT64_FORMAT " bytes\n",
+						 rawBytes,
+						 node->mstype == MOTIONSTATE_SEND ? "sent" : "received",
+						 wireBytes);
+
+	if (!gp_interconnect_explain_bytes || node->mstype != MOTIONSTATE_SEND)
+		return;
+
+	getMotionSendStats(node->ps.state->interconnect_context,
+					   motion->motionID, &bytesSent, &localBytes, &numReceivers);
+	if (bytesSent == 0)
+		return;
+
+	appendStringInfo(buf, "Interconnect bytes sent: " UINT64_FORMAT " bytes to %d receivers",
+					 bytesSent, numReceivers);
+	if (localBytes != 0)
+		appendStringInfo(buf, " (" UINT64_FORMAT " bytes through shared memory)",
+						 localBytes);
+	appendStringInfoChar(buf, '\n');
+}
 
 /*=========================================================================
  * HELPER FUNCTIONS
  */
 
+/*
+ * storeMergeHead:
+ * Store a tuple received from a sender of a sorted motion node in the slot of
+ * the sender, and keep its leading sort key aside.
+ */
+static void
+storeMergeHead(MotionState *node, int segIdx, MinimalTuple tuple)
+{
+	TupleTableSlot *slot = node->slots[segIdx];
+	SortSupport ssup = &node->sortKeys[0];
+	Datum		datum;
+	bool		isnull;
+
+	/*
+	 * Use slot_getsomeattrs() to materialize the columns we need for the
+	 * comparisons in the tts_values/isnull arrays. The comparator can then
+	 * peek directly into the arrays, which is cheaper than calling
+	 * slot_getattr() all the time.
+	 */
+	ExecStoreMinimalTuple(tuple, slot, true);
+	slot_getsomeattrs(slot, node->lastSortColIdx);
+
+	datum = slot->tts_values[ssup->ssup_attno - 1];
+	isnull = slot->tts_isnull[ssup->ssup_attno - 1];
+
+	/*
+	 * Abbreviated keys are pass-by-value, but converting may detoast, so do
+	 * it in the per-tuple context.
+	 */
+	if (!isnull && ssup->abbrev_converter != NULL)
+	{
+		ExprContext *econtext = node->ps.ps_ExprContext;
+		MemoryContext oldcxt;
+
+		ResetExprContext(econtext);
+		oldcxt = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+		datum = ssup->abbrev_converter(datum, ssup);
+		MemoryContextSwitchTo(oldcxt);
+	}
+
+	node->headKeys[segIdx] = datum;
+	node->headIsnull[segIdx] = isnull;
+
+	/*
+	 * As tuplesort does, check now and then whether the abbreviated keys
+	 * tell the tuples apart well enough to be worth converting every tuple,
+	 * and stop abbreviating if not.
+	 */
+	if (ssup->abbrev_converter != NULL &&
+		++node->abbrevCount >= node->abbrevNext)
+	{
+		node->abbrevNext *= 2;
+		if (ssup->abbrev_abort(node->abbrevCount, ssup))
+			abortMergeAbbrev(node);
+	}
+}
+
+/*
+ * abortMergeAbbrev:
+ * Stop abbreviating the leading sort key, and replace the abbreviated keys
+ * kept aside with the full ones.  The loser tree stays valid, as the order
+ * of the abbreviated keys agrees with that of the full keys.
+ */
+static void
+abortMergeAbbrev(MotionState *node)
+{
+	SortSupport ssup = &node->sortKeys[0];
+	AttrNumber	attno = ssup->ssup_attno;
+
+	ssup->comparator = ssup->abbrev_full_comparator;
+	ssup->abbrev_converter = NULL;
+	ssup->abbrev_abort = NULL;
+	ssup->abbrev_full_comparator = NULL;
+
+	for (int i = 0; i < node->numInputSegs; i++)
+	{
+		TupleTableSlot *slot = node->slots[i];
+
+		if (!TupIsNull(slot))
+			node->headKeys[i] = slot->tts_values[attno - 1];
+	}
+}
+
 /*
  * CdbMergeComparator:
  * Used to compare tuples for a sorted motion node.
  */
 static int
-CdbMergeComparator(Datum lhs, Datum rhs, void *context)
+CdbMergeComparator(int lSegIdx, int rSegIdx, void *context)
 {
 	MotionState *node = (MotionState *) context;
-	int			lSegIdx = DatumGetInt32(lhs);
-	int			rSegIdx = DatumGetInt32(rhs);
-
 	TupleTableSlot *lslot = node->slots[lSegIdx];
 	TupleTableSlot *rslot = node->slots[rSegIdx];
 	SortSupport	sortKeys = node->sortKeys;
@@ -1016,8 +1181,21 @@ CdbMergeComparator(Datum lhs, Datum rhs, void *context)
 	int			compare;
 
 	Assert(lslot && rslot);
+	Assert(node->numSortCols > 0);
 
-	for (nkey = 0; nkey < node->numSortCols; nkey++)
+	/* Compare the leading keys kept aside first, like tuplesort does. */
+	compare = ApplySortComparator(node->headKeys[lSegIdx], node->headIsnull[lSegIdx],
+								  node->headKeys[rSegIdx], node->headIsnull[rSegIdx],
+								  &sortKeys[0]);
+	if (compare != 0)
+		return compare;
+
+	/*
+	 * Abbreviated keys that are equal tell nothing about the full keys, and
+	 * the first column has to be compared again with the full comparator.
+	 */
+	nkey = sortKeys[0].abbrev_converter != NULL ? 0 : 1;
+	for (; nkey < node->numSortCols; nkey++)
 	{
 		SortSupport ssup = &sortKeys[nkey];
 		AttrNumber	attno = ssup->ssup_attno;
@@ -1036,14 +1214,16 @@ CdbMergeComparator(Datum lhs, Datum rhs, void *context)
 		datum2 = rslot->tts_values[attno - 1];
 		isnull2 = rslot->tts_isnull[attno - 1];
 
-		compare = ApplySortComparator(datum1, isnull1,
-									  datum2, isnull2,
-									  ssup);
+		if (nkey == 0)
+			compare = ApplySortAbbrevFullComparator(datum1, isnull1,
+													datum2, isnull2,
+													ssup);
+		else
+			compare = ApplySortComparator(datum1, isnull1,
+										  datum2, isnull2,
+										  ssup);
 		if (compare != 0)
-		{
-			INVERT_COMPARE_RESULT(compare);
 			return compare;
-		}
 	}
 	return 0;
 }								/* CdbMergeComparator */
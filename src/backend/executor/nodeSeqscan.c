@@ -29,12 +29,19 @@
 
 #include "access/relscan.h"
 #include "access/tableam.h"
+#include "cdb/cdbaocsam.h"
+#include "cdb/cdbappendonlyam.h"
 #include "executor/execdebug.h"
 #include "executor/nodeSeqscan.h"
+#include "lib/bloomfilter.h"
+#include "lib/stringinfo.h"
+#include "miscadmin.h"
 #include "utils/rel.h"
 #include "nodes/nodeFuncs.h"
 
 static TupleTableSlot *SeqNext(SeqScanState *node);
+static bool PassByRuntimeFilters(SeqScanState *node, TupleTableSlot *slot);
+static void ExecSeqScanExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 /* ----------------------------------------------------------------
  *						Scan Support
@@ -85,12 +92,85 @@ SeqNext(SeqScanState *node)
 
 	/*
 	 * get the next tuple from the table
+	 *
+	 * GPDB: rows that fail a runtime filter pushed down from a hash join
+	 * cannot find a join partner; drop them here, before qual evaluation
+	 * and projection.
 	 */
-	if (table_scan_getnextslot(scandesc, direction, slot))
-		return slot;
+	while (table_scan_getnextslot(scandesc, direction, slot))
+	{
+		if (node->filters == NIL || PassByRuntimeFilters(node, slot))
+			return slot;
+
+		CHECK_FOR_INTERRUPTS();
+		ResetExprContext(node->ss.ps.ps_ExprContext);
+	}
 	return NULL;
 }
 
+/*
+ * PassByRuntimeFilters -- check a scanned tuple against the runtime filters
+ *
+ * Returns false if some filter proves that the tuple's join key has no
+ * match on the build side of the hash join.  Filters whose build side has
+ * not been loaded yet let everything through.
+ */
+static bool
+PassByRuntimeFilters(SeqScanState *node, TupleTableSlot *slot)
+{
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+	MemoryContext oldContext;
+	ListCell   *lc;
+	bool		pass = true;
+
+	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	foreach(lc, node->filters)
+	{
+		AttrFilter *filter = (AttrFilter *) lfirst(lc);
+		Datum		val;
+		bool		isnull;
+		uint32		hkey;
+
+		if (!filter->ready)
+			continue;
+
+		filter->nprobed++;
+
+		/* A NULL key never matches, nor does anything if the build side was empty */
+		val = slot_getattr(slot, filter->lattno, &isnull);
+		if (isnull || filter->empty)
+			pass = false;
+		else if (filter->has_range &&
+				 (DatumGetInt32(FunctionCall2Coll(&filter->cmpfn,
+												  filter->collation,
+												  val, filter->min)) < 0 ||
+				  DatumGetInt32(FunctionCall2Coll(&filter->cmpfn,
+												  filter->collation,
+												  val, filter->max)) > 0))
+			pass = false;
+		else
+		{
+			hkey = DatumGetUInt32(FunctionCall1Coll(&filter->outer_hashfn,
+													 filter->collation,
+													 val));
+			if (bloom_lacks_element(filter->blm_filter,
+									(unsigned char *) &hkey, sizeof(hkey)))
+				pass = false;
+		}
+
+		if (!pass)
+		{
+			filter->nfiltered++;
+			break;
+		}
+	}
+
+	MemoryContextSwitchTo(oldContext);
+
+	return pass;
+}
+
 /*
  * SeqRecheck -- access method routine to recheck a tuple in EvalPlanQual
  */
@@ -191,6 +271,13 @@ ExecInitSeqScanForPartition(SeqScan *node, EState *estate,
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->plan.qual, (PlanState *) scanstate);
 
+	/*
+	 * Report the read-ahead of an AO table, and the blocks the zone maps of
+	 * an AOCS table ruled out.
+	 */
+	if (RelationIsAppendOptimized(currentRelation))
+		scanstate->ss.ps.cdbexplainfun = ExecSeqScanExplainEnd;
+
 	return scanstate;
 }
 
@@ -229,6 +316,88 @@ ExecEndSeqScan(SeqScanState *node)
 		table_endscan(scanDesc);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanAddRuntimeFilter
+ *
+ *		Attach a runtime filter built by a Hash node in the same slice,
+ *		see ExecHashInitRuntimeFilters().
+ * ----------------------------------------------------------------
+ */
+void
+ExecSeqScanAddRuntimeFilter(SeqScanState *node, AttrFilter *filter)
+{
+	Assert(filter->target == (PlanState *) node);
+
+	node->filters = lappend(node->filters, filter);
+
+	/* Report the rows removed by each filter in EXPLAIN ANALYZE. */
+	node->ss.ps.cdbexplainfun = ExecSeqScanExplainEnd;
+}
+
+/*
+ * ExecSeqScanExplainEnd
+ *		Called before ExecutorEnd to finish EXPLAIN ANALYZE reporting.
+ */
+static void
+ExecSeqScanExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	SeqScanState *node = (SeqScanState *) planstate;
+	TupleDesc	tupdesc = RelationGetDescr(node->ss.ss_currentRelation);
+	AppendOnlyZoneMapFilter zonemapFilter = NULL;
+	int64		prefetchBytes = 0;
+	instr_time	stallTime;
+	ListCell   *lc;
+
+	foreach(lc, node->filters)
+	{
+		AttrFilter *filter = (AttrFilter *) lfirst(lc);
+
+		appendStringInfo(buf,
+						 "Runtime filter on %s removed " UINT64_FORMAT
+						 " of " UINT64_FORMAT " rows.\n",
+						 NameStr(TupleDescAttr(tupdesc, filter->lattno - 1)->attname),
+						 filter->nfiltered,
+						 filter->nprobed);
+	}
+
+	if (node->ss.ss_currentScanDesc == NULL)
+		return;
+
+	if (RelationIsAoCols(node->ss.ss_currentRelation))
+	{
+		AOCSScanDesc scan = (AOCSScanDesc) node->ss.ss_currentScanDesc;
+
+		zonemapFilter = scan->zonemapFilter;
+		aocs_read_stats(scan, &prefetchBytes, &stallTime);
+	}
+	else if (RelationIsAoRows(node->ss.ss_currentRelation))
+	{
+		AppendOnlyScanDesc scan = (AppendOnlyScanDesc) node->ss.ss_currentScanDesc;
+
+		zonemapFilter = scan->zonemapFilter;
+		appendonly_read_stats(scan, &prefetchBytes, &stallTime);
+	}
+
+	/* Files too small to read ahead of would only add noise. */
+	if (prefetchBytes > 0)
+		appendStringInfo(buf,
+						 "Read ahead " INT64_FORMAT " kB, stalled %.3f ms in reads.\n",
+						 prefetchBytes / 1024,
+						 INSTR_TIME_GET_MILLISEC(stallTime));
+
+	if (zonemapFilter != NULL)
+	{
+		int64		nblocks;
+		int64		nrefuted;
+
+		appendonly_zonemap_filter_stats(zonemapFilter, &nblocks, &nrefuted);
+		appendStringInfo(buf,
+						 "Zone maps ruled out " INT64_FORMAT
+						 " of " INT64_FORMAT " blocks.\n",
+						 nrefuted, nblocks);
+	}
+}								/* ExecSeqScanExplainEnd */
+
 /* ----------------------------------------------------------------
  *						Join Support
  * ----------------------------------------------------------------
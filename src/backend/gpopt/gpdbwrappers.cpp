@@ -36,6 +36,7 @@ extern "C" {
 #include "access/amapi.h"
 #include "access/external.h"
 #include "access/genam.h"
+#include "catalog/partition.h"
 #include "catalog/pg_inherits.h"
 #include "foreign/fdwapi.h"
 #include "nodes/nodeFuncs.h"
@@ -47,6 +48,7 @@ extern "C" {
 #include "partitioning/partdesc.h"
 #include "storage/lmgr.h"
 #include "utils/fmgroids.h"
+#include "utils/guc.h"
 #include "utils/memutils.h"
 #include "utils/partcache.h"
 }
@@ -874,6 +876,22 @@ gpdb::GetRelationPartConstraints(Relation rel)
 	return nullptr;
 }
 
+Node *
+gpdb::GetChildPartConstraints(Relation parent, Oid part_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_class */
+		List *part_quals = get_partition_qual_for_parent(parent, part_oid);
+		if (part_quals)
+		{
+			return (Node *) make_ands_explicit(part_quals);
+		}
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
 bool
 gpdb::GetCastFunc(Oid src_oid, Oid dest_oid, bool *is_binary_coercible,
 				  Oid *cast_fn_oid, CoercionPathType *pathtype)
@@ -2284,16 +2302,28 @@ gpdb::InjectFaultInOptTasks(const char *fault_name)
 #endif
 
 /*
- * To detect changes to catalog tables that require resetting the Metadata
- * Cache, we use the normal PostgreSQL catalog cache invalidation mechanism.
- * We register a callback to a cache on all the catalog tables that contain
- * information that's contained in the ORCA metadata cache.
-
- * There is no fine-grained mechanism in the metadata cache for invalidating
- * individual entries ATM, so we just blow the whole cache whenever anything
- * changes. The callback simply increments a counter. Whenever we start
- * planning a query, we check the counter to see if it has changed since the
- * last planned query, and reset the whole cache if it has.
+ * To detect changes to catalog tables that require invalidating entries in
+ * the Metadata Cache, we use the normal PostgreSQL catalog cache invalidation
+ * mechanism. We register a callback to a cache on all the catalog tables that
+ * contain information that's contained in the ORCA metadata cache.
+ *
+ * The callbacks just remember the invalidations, as the OID of the relation
+ * for relcache invalidations, and the cache id and hash value of the entry
+ * for syscache invalidations. Whenever we start planning a query, the
+ * metadata cache entries built from any of the invalidated catalog entries
+ * are evicted, see the MDCache*Invalidated() functions below. Syscache
+ * invalidations only carry a hash value, so an object may be evicted
+ * because another one hashes to the same value, which is harmless.
+ *
+ * The metadata of a partitioned table is partly derived from its partitions,
+ * such as its storage type and whether its distribution is converted to
+ * random, and a change to a partition doesn't always invalidate its
+ * ancestors. So a relcache invalidation of a partition invalidates its
+ * ancestors too, see mdcache_add_partition_ancestors().
+ *
+ * When we can't tell which entries are affected, or when too many
+ * invalidations pile up between two queries, the whole cache is reset
+ * instead.
  *
  * To make sure we've covered all catalog tables that contain information
  * that's stored in the metadata cache, there are "catalog tables: xxx"
@@ -2302,21 +2332,89 @@ gpdb::InjectFaultInOptTasks(const char *fault_name)
  * anything fetched via the wrapper functions in this file can end up in the
  * metadata cache and hence need to have an invalidation callback registered.
  */
+#define MDCACHE_MAX_PENDING_INVALIDATIONS 1024
+
+typedef struct MDCacheInvalidation
+{
+	int cacheid; /* syscache id, or -1 for a relcache invalidation */
+	uint32 hashvalue; /* syscache hash value, or relation OID */
+} MDCacheInvalidation;
+
 static bool mdcache_invalidation_counter_registered = false;
-static int64 mdcache_invalidation_counter = 0;
-static int64 last_mdcache_invalidation_counter = 0;
+static bool mdcache_reset_pending = false;
+static MDCacheInvalidation
+	mdcache_pending_invalidations[MDCACHE_MAX_PENDING_INVALIDATIONS];
+static int mdcache_num_pending_invalidations = 0;
+
+/*
+ * Number of pending invalidations that the current query start is handling;
+ * invalidations that arrive while the cache is being brought up to date are
+ * left for the next query.
+ */
+static int mdcache_num_checked_invalidations = 0;
+
+static void
+mdcache_add_invalidation(int cacheid, uint32 hashvalue)
+{
+	if (mdcache_num_pending_invalidations == MDCACHE_MAX_PENDING_INVALIDATIONS)
+	{
+		mdcache_reset_pending = true;
+		return;
+	}
+
+	mdcache_pending_invalidations[mdcache_num_pending_invalidations].cacheid =
+		cacheid;
+	mdcache_pending_invalidations[mdcache_num_pending_invalidations].hashvalue =
+		hashvalue;
+	mdcache_num_pending_invalidations++;
+}
 
 static void
 mdsyscache_invalidation_counter_callback(Datum arg, int cacheid,
 										 uint32 hashvalue)
 {
-	mdcache_invalidation_counter++;
+	/*
+	 * A zero hash value means the whole syscache was reset. Changes to
+	 * operator classes and families can't be tied to individual objects.
+	 */
+	if (hashvalue == 0 || cacheid == AMOPOPID || cacheid == OPFAMILYOID)
+		mdcache_reset_pending = true;
+	else
+		mdcache_add_invalidation(cacheid, hashvalue);
 }
 
 static void
 mdrelcache_invalidation_counter_callback(Datum arg, Oid relid)
 {
-	mdcache_invalidation_counter++;
+	if (!OidIsValid(relid))
+		mdcache_reset_pending = true;
+	else
+		mdcache_add_invalidation(-1, relid);
+}
+
+/*
+ * Add relcache invalidations for the ancestors of the invalidated partitions.
+ * This looks up the catalogs, so it's done when the invalidations are checked
+ * rather than in the callback. The ancestors that get added are partitions
+ * themselves if they aren't a root, which only adds the same ones again.
+ */
+static void
+mdcache_add_partition_ancestors(void)
+{
+	for (int i = 0; i < mdcache_num_pending_invalidations; i++)
+	{
+		MDCacheInvalidation *inval = &mdcache_pending_invalidations[i];
+		List *ancestors;
+		ListCell *lc;
+
+		if (inval->cacheid != -1 || !get_rel_relispartition(inval->hashvalue))
+			continue;
+
+		ancestors = get_partition_ancestors(inval->hashvalue);
+		foreach (lc, ancestors)
+			mdcache_add_invalidation(-1, lfirst_oid(lc));
+		list_free(ancestors);
+	}
 }
 
 static void
@@ -2331,6 +2429,8 @@ register_mdcache_invalidation_callbacks(void)
 		OPEROID,		  /* pg_operator */
 		OPFAMILYOID,	  /* pg_opfamily */
 		STATRELATTINH,	  /* pg_statistics */
+		STATEXTOID,		  /* pg_statistic_ext */
+		STATEXTDATASTXOID, /* pg_statistic_ext_data */
 		TYPEOID,		  /* pg_type */
 		PROCOID,		  /* pg_proc */
 
@@ -2384,7 +2484,10 @@ register_mdcache_invalidation_callbacks(void)
 								  (Datum) 0);
 }
 
-// Has there been any catalog changes since last call?
+// Is there a catalog change since the last call that requires resetting the
+// whole metadata cache? Otherwise, the invalidations pending since then are
+// checked by the MDCache*Invalidated() functions, until
+// MDCacheClearInvalidations() is called.
 bool
 gpdb::MDCacheNeedsReset(void)
 {
@@ -2395,14 +2498,19 @@ gpdb::MDCacheNeedsReset(void)
 			register_mdcache_invalidation_callbacks();
 			mdcache_invalidation_counter_registered = true;
 		}
-		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
+
+		if (!mdcache_reset_pending)
+			mdcache_add_partition_ancestors();
+		mdcache_num_checked_invalidations = mdcache_num_pending_invalidations;
+
+		if (mdcache_reset_pending)
 		{
-			return false;
+			mdcache_reset_pending = false;
+			return true;
 		}
 		else
 		{
-			last_mdcache_invalidation_counter = mdcache_invalidation_counter;
-			return true;
+			return false;
 		}
 	}
 	GP_WRAP_END;
@@ -2410,6 +2518,158 @@ gpdb::MDCacheNeedsReset(void)
 	return true;
 }
 
+// Are there invalidations to check the metadata cache entries against?
+bool
+gpdb::MDCacheHasPendingInvalidations(void)
+{
+	return mdcache_num_checked_invalidations > 0;
+}
+
+// Forget the invalidations that the metadata cache was brought up to date with
+void
+gpdb::MDCacheClearInvalidations(void)
+{
+	int remaining = mdcache_num_pending_invalidations -
+					mdcache_num_checked_invalidations;
+
+	memmove(mdcache_pending_invalidations,
+			mdcache_pending_invalidations + mdcache_num_checked_invalidations,
+			remaining * sizeof(MDCacheInvalidation));
+	mdcache_num_pending_invalidations = remaining;
+	mdcache_num_checked_invalidations = 0;
+}
+
+// Has a relcache invalidation for the relation, or a syscache invalidation
+// matching the given keys, been received since the last reset?
+static bool
+mdcache_invalidation_matches(Oid relid, int cacheid, Datum key1, Datum key2,
+							 Datum key3)
+{
+	uint32 hashvalue = 0;
+	bool hashed = false;
+
+	for (int i = 0; i < mdcache_num_checked_invalidations; i++)
+	{
+		MDCacheInvalidation *inval = &mdcache_pending_invalidations[i];
+
+		if (inval->cacheid == -1)
+		{
+			if (OidIsValid(relid) && inval->hashvalue == relid)
+				return true;
+		}
+		else if (inval->cacheid == cacheid)
+		{
+			if (!hashed)
+			{
+				hashvalue =
+					GetSysCacheHashValue(cacheid, key1, key2, key3, 0);
+				hashed = true;
+			}
+			if (inval->hashvalue == hashvalue)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+// Has any syscache invalidation for the given cache been received?
+static bool
+mdcache_invalidation_any(int cacheid)
+{
+	for (int i = 0; i < mdcache_num_checked_invalidations; i++)
+	{
+		if (mdcache_pending_invalidations[i].cacheid == cacheid)
+			return true;
+	}
+
+	return false;
+}
+
+// Has the catalog entry of an object, identified by its OID, been
+// invalidated? The object may be a relation, an index, a type, a function,
+// an aggregate, an operator, a constraint or extended statistics.
+bool
+gpdb::MDCacheObjectInvalidated(Oid oid)
+{
+	bool result = true;
+
+	GP_WRAP_START;
+	{
+		static const int object_caches[] = {AGGFNOID, CONSTROID,  OPEROID,
+											PROCOID,  STATEXTOID, STATEXTDATASTXOID,
+											TYPEOID};
+
+		result = mdcache_invalidation_matches(oid, -1, 0, 0, 0);
+		for (unsigned int i = 0; !result && i < lengthof(object_caches); i++)
+		{
+			result = mdcache_invalidation_matches(InvalidOid, object_caches[i],
+												  ObjectIdGetDatum(oid), 0, 0);
+		}
+	}
+	GP_WRAP_END;
+
+	return result;
+}
+
+// Have the statistics of a column, or the relation, been invalidated?
+bool
+gpdb::MDCacheColStatsInvalidated(Oid relid, AttrNumber attno)
+{
+	bool result = true;
+
+	GP_WRAP_START;
+	{
+		result = mdcache_invalidation_matches(
+					 relid, STATRELATTINH, ObjectIdGetDatum(relid),
+					 Int16GetDatum(attno), BoolGetDatum(false)) ||
+				 mdcache_invalidation_matches(
+					 InvalidOid, STATRELATTINH, ObjectIdGetDatum(relid),
+					 Int16GetDatum(attno), BoolGetDatum(true));
+	}
+	GP_WRAP_END;
+
+	return result;
+}
+
+// Has the cast between two types, or any function, been invalidated?
+bool
+gpdb::MDCacheCastInvalidated(Oid src_type, Oid dest_type)
+{
+	bool result = true;
+
+	GP_WRAP_START;
+	{
+		result = mdcache_invalidation_any(PROCOID) ||
+				 mdcache_invalidation_matches(InvalidOid, CASTSOURCETARGET,
+											  ObjectIdGetDatum(src_type),
+											  ObjectIdGetDatum(dest_type), 0);
+	}
+	GP_WRAP_END;
+
+	return result;
+}
+
+// Has any operator been invalidated? Comparison lookups between two types
+// depend on all of them.
+bool
+gpdb::MDCacheScCmpInvalidated(void)
+{
+	return mdcache_invalidation_any(OPEROID);
+}
+
+// The settings that differ from their defaults, as "name=value" lines
+char *
+gpdb::GetModifiedConfigOptions(void)
+{
+	GP_WRAP_START;
+	{
+		return ::GetModifiedConfigOptions();
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
 // returns true if a query cancel is requested in GPDB
 bool
 gpdb::IsAbortRequested(void)
@@ -2712,6 +2972,18 @@ gpdb::GetRelAmName(Oid reloid)
 	return nullptr;
 }
 
+char
+gpdb::GetRelKind(Oid reloid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_class */
+		return get_rel_relkind(reloid);
+	}
+	GP_WRAP_END;
+	return '\0';
+}
+
 // Get IndexAmRoutine struct for the given access method handler.
 IndexAmRoutine *
 gpdb::GetIndexAmRoutineFromAmHandler(Oid am_handler)
@@ -560,6 +560,7 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 	BOOL is_partitioned = false;
 	IMDRelation *md_rel = nullptr;
 	IMdIdArray *partition_oids = nullptr;
+	CDXLNodeArray *child_part_constraints = nullptr;
 	IMDId *foreign_server_mdid = nullptr;
 
 	// get rel name
@@ -622,14 +623,17 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 			Oid part_oid = part_desc->oids[i];
 			partition_oids->Append(GPOS_NEW(mp)
 									   CMDIdGPDB(IMDId::EmdidRel, part_oid));
-			gpdb::RelationWrapper rel_part = gpdb::GetRelation(part_oid);
-			if (rel_part->rd_rel->relkind == RELKIND_PARTITIONED_TABLE)
+			// look at the relkind only, the partition is not opened here
+			if (gpdb::GetRelKind(part_oid) == RELKIND_PARTITIONED_TABLE)
 			{
 				// Multi-level partitioned tables are unsupported - fall back
 				GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDObjUnsupported,
 						   GPOS_WSZ_LIT("Multi-level partitioned tables"));
 			}
 		}
+
+		child_part_constraints = RetrieveChildPartConstraints(
+			mp, md_accessor, rel.get(), part_desc, mdcol_array);
 	}
 
 	// get key sets
@@ -669,7 +673,7 @@ CTranslatorRelcacheToDXL::RetrieveRel(CMemoryPool *mp, CMDAccessor *md_accessor,
 		mdcol_array, distr_cols, distr_op_families, part_keys, part_types,
 		partition_oids, convert_hash_to_random, keyset_array,
 		md_index_info_array, check_constraint_mdids, mdpart_constraint,
-		foreign_server_mdid, rel->rd_rel->reltuples);
+		child_part_constraints, foreign_server_mdid, rel->rd_rel->reltuples);
 
 	return md_rel;
 }
@@ -1884,11 +1888,14 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	const IMDColumn *md_col = md_rel->GetMdCol(pos);
 	AttrNumber attno = (AttrNumber) md_col->AttrNum();
 
-	// number of rows from pg_class
-	double num_rows;
-
-	num_rows =
-		gpdb::CdbEstimatePartitionedNumTuples(gpdb::GetRelation(rel_oid).get());
+	// number of rows from pg_class, as in the relation stats, which are
+	// retrieved once rather than summed up over the partitions per column
+	mdid_rel->AddRef();
+	CMDIdRelStats *rel_stats_mdid =
+		GPOS_NEW(mp) CMDIdRelStats(CMDIdGPDB::CastMdid(mdid_rel));
+	double num_rows =
+		md_accessor->Pmdrelstats(rel_stats_mdid)->Rows().Get();
+	rel_stats_mdid->Release();
 
 	// extract column name and type
 	CMDName *md_colname =
@@ -2909,6 +2916,71 @@ CTranslatorRelcacheToDXL::RetrievePartConstraintForRel(
 		return nullptr;
 	}
 
+	return TranslatePartConstraintToDXL(mp, md_accessor, node, mdcol_array);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveChildPartConstraints
+//
+//	@doc:
+//		Retrieve the part constraints of the partitions of a partitioned
+//		table in terms of its own columns. These are computed from the
+//		partition bounds, so that ORCA can prune the partitions without
+//		retrieving the metadata of each of them. Return nullptr if a
+//		partition is foreign or has no part constraint, ORCA then looks at
+//		the partitions themselves.
+//
+//---------------------------------------------------------------------------
+CDXLNodeArray *
+CTranslatorRelcacheToDXL::RetrieveChildPartConstraints(
+	CMemoryPool *mp, CMDAccessor *md_accessor, Relation rel,
+	PartitionDesc part_desc, CMDColumnArray *mdcol_array)
+{
+	// the part constraint of a partition of a partition also includes the
+	// bound of its parent, which the partition bounds alone don't
+	if (rel->rd_rel->relispartition)
+	{
+		return nullptr;
+	}
+
+	CDXLNodeArray *child_part_constraints = GPOS_NEW(mp) CDXLNodeArray(mp);
+	for (int i = 0; i < part_desc->nparts; ++i)
+	{
+		Oid part_oid = part_desc->oids[i];
+		Node *node = nullptr;
+		if (gpdb::GetRelKind(part_oid) != RELKIND_FOREIGN_TABLE)
+		{
+			node = gpdb::GetChildPartConstraints(rel, part_oid);
+		}
+
+		if (nullptr == node)
+		{
+			child_part_constraints->Release();
+			return nullptr;
+		}
+
+		child_part_constraints->Append(
+			TranslatePartConstraintToDXL(mp, md_accessor, node, mdcol_array));
+	}
+
+	return child_part_constraints;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::TranslatePartConstraintToDXL
+//
+//	@doc:
+//		Translate a part constraint over the columns of a relation into DXL,
+//		numbering the columns in the order of the non-dropped columns
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CTranslatorRelcacheToDXL::TranslatePartConstraintToDXL(
+	CMemoryPool *mp, CMDAccessor *md_accessor, Node *node,
+	CMDColumnArray *mdcol_array)
+{
 	// create var-colid mapping for translating part constraints
 	CAutoRef<CDXLColDescrArray> dxl_col_descr_array(GPOS_NEW(mp)
 														CDXLColDescrArray(mp));
@@ -2457,6 +2457,13 @@ BOOL
 CTranslatorUtils::RelContainsForeignPartitions(const IMDRelation *rel,
 											   CMDAccessor *md_accessor)
 {
+	// the part constraints of the partitions are only kept on the root if
+	// none of them is foreign
+	if (nullptr != rel->ChildPartConstraints())
+	{
+		return false;
+	}
+
 	IMdIdArray *partition_mdids = rel->ChildPartitionMdids();
 	for (ULONG ul = 0; partition_mdids && ul < partition_mdids->Size(); ++ul)
 	{
@@ -26,6 +26,8 @@ extern "C" {
 #include "gpos/_api.h"
 #include "gpos/base.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CException.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
@@ -48,6 +50,7 @@ extern "C" {
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/optimizer/COptimizer.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/CPlanCache.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
 #include "gpopt/translate/CContextDXLToPlStmt.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
@@ -64,9 +67,13 @@ extern "C" {
 #include "naucrates/dxl/CIdGenerator.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/exception.h"
 #include "naucrates/init.h"
 #include "naucrates/md/CMDIdCast.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDIdScCmp.h"
 #include "naucrates/md/CSystemId.h"
@@ -386,6 +393,8 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model,
 		(ULONG) optimizer_push_group_by_below_setop_threshold;
 	ULONG xform_bind_threshold = (ULONG) optimizer_xform_bind_threshold;
 	ULONG skew_factor = (ULONG) optimizer_skew_factor;
+	ULONG time_budget = (ULONG) optimizer_time_budget;
+	ULONG memory_budget = (ULONG) optimizer_memory_budget;
 
 	return GPOS_NEW(mp) COptimizerConfig(
 		GPOS_NEW(mp)
@@ -401,7 +410,7 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model,
 				  false, /* don't create Assert nodes for constraints, we'll
 								      * enforce them ourselves in the executor */
 				  push_group_by_below_setop_threshold, xform_bind_threshold,
-				  skew_factor),
+				  skew_factor, time_budget, memory_budget),
 		plan_hints,
 		GPOS_NEW(mp) CWindowOids(OID(F_WINDOW_ROW_NUMBER), OID(F_WINDOW_RANK)));
 }
@@ -838,6 +847,208 @@ COptTasks::GetPlanHints(CMemoryPool *mp, Query *query)
 	return plan_hints;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::IsMDCacheObjectInvalidated
+//
+//	@doc:
+//		Has the catalog information of a metadata cache object changed since
+//		the cache was last brought up to date? Objects we can't tell about
+//		are considered changed.
+//
+//---------------------------------------------------------------------------
+BOOL
+COptTasks::IsMDCacheObjectInvalidated(const IMDId *mdid)
+{
+	switch (mdid->MdidType())
+	{
+		case IMDId::EmdidGeneral:
+		case IMDId::EmdidGPDBCtas:
+			// types, functions, aggregates and operators; the entries of
+			// types and operators also refer to other operators
+			return gpdb::MDCacheObjectInvalidated(
+					   CMDIdGPDB::CastMdid(mdid)->Oid()) ||
+				   gpdb::MDCacheScCmpInvalidated();
+
+		case IMDId::EmdidRel:
+		case IMDId::EmdidInd:
+		case IMDId::EmdidCheckConstraint:
+		case IMDId::EmdidExtStats:
+		case IMDId::EmdidExtStatsInfo:
+			return gpdb::MDCacheObjectInvalidated(
+				CMDIdGPDB::CastMdid(mdid)->Oid());
+
+		case IMDId::EmdidRelStats:
+			return gpdb::MDCacheObjectInvalidated(
+				CMDIdGPDB::CastMdid(
+					CMDIdRelStats::CastMdid(mdid)->GetRelMdId())
+					->Oid());
+
+		case IMDId::EmdidColStats:
+		{
+			const CMDIdColStats *mdid_col_stats =
+				CMDIdColStats::CastMdid(mdid);
+
+			// user columns come first, dropped ones included, so their
+			// positions map to attribute numbers; the statistics of system
+			// columns are only invalidated with the relation
+			return gpdb::MDCacheColStatsInvalidated(
+				CMDIdGPDB::CastMdid(mdid_col_stats->GetRelMdId())->Oid(),
+				(AttrNumber) (mdid_col_stats->Position() + 1));
+		}
+
+		case IMDId::EmdidCastFunc:
+		{
+			const CMDIdCast *mdid_cast = CMDIdCast::CastMdid(mdid);
+
+			return gpdb::MDCacheCastInvalidated(
+				CMDIdGPDB::CastMdid(mdid_cast->MdidSrc())->Oid(),
+				CMDIdGPDB::CastMdid(mdid_cast->MdidDest())->Oid());
+		}
+
+		case IMDId::EmdidScCmp:
+			return gpdb::MDCacheScCmpInvalidated();
+
+		default:
+			return true;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::SerializePlanCacheKey
+//
+//	@doc:
+//		Serialize the key of a query in the plan cache: the query DXL and
+//		whatever else the plan depends on, other than metadata. Besides the
+//		optimizer configuration, that is every setting that differs from
+//		its default, since planner settings that ORCA doesn't receive
+//		through the configuration, like the cost GUCs read during
+//		translation, may change the plan too.
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+COptTasks::SerializePlanCacheKey(
+	CMemoryPool *mp, const CDXLNode *query_dxl,
+	const CDXLNodeArray *query_output_dxlnode_array,
+	const CDXLNodeArray *cte_dxlnode_array, COptimizerConfig *optimizer_config,
+	ULONG num_segments)
+{
+	CWStringDynamic *key = GPOS_NEW(mp) CWStringDynamic(mp);
+	COstreamString oss(key);
+
+	CDXLUtils::SerializeQuery(mp, oss, query_dxl, query_output_dxlnode_array,
+							  cte_dxlnode_array,
+							  false /*serialize_header_footer*/,
+							  false /*indentation*/);
+
+	// the configuration, including the trace flags set for this query
+	{
+		CXMLSerializer xml_serializer(mp, oss, false /*indentation*/);
+		CBitSet *trace_flags =
+			CTask::Self()->GetTaskCtxt()->copy_trace_flags(mp);
+		optimizer_config->Serialize(mp, &xml_serializer, trace_flags);
+		trace_flags->Release();
+	}
+
+	char *settings = gpdb::GetModifiedConfigOptions();
+	oss << "<Settings>" << settings << "</Settings>";
+	gpdb::GPDBFree(settings);
+
+	oss << "<Segments " << num_segments << "/>";
+	if (nullptr != optimizer_search_strategy_path)
+	{
+		oss << "<SearchStrategy " << optimizer_search_strategy_path << "/>";
+	}
+
+	return key;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::OptimizeWithPlanCache
+//
+//	@doc:
+//		Optimize a query to physical DXL. If plan caching is enabled, look
+//		up the plan in the plan cache first, and add it there otherwise.
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+COptTasks::OptimizeWithPlanCache(
+	CMemoryPool *mp, CMDAccessor *md_accessor, CDXLNode *query_dxl,
+	CDXLNodeArray *query_output_dxlnode_array, CDXLNodeArray *cte_dxlnode_array,
+	IConstExprEvaluator *expr_evaluator, ULONG num_segments,
+	CSearchStageArray *search_strategy_arr, COptimizerConfig *optimizer_config)
+{
+	// minidumps are taken while optimizing, don't skip that
+	if (!CPlanCache::FInitialized() ||
+		OPTIMIZER_MINIDUMP_ALWAYS == optimizer_minidump)
+	{
+		return COptimizer::PdxlnOptimize(
+			mp, md_accessor, query_dxl, query_output_dxlnode_array,
+			cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
+			gp_command_count, search_strategy_arr, optimizer_config);
+	}
+
+	CAutoP<CWStringDynamic> key(SerializePlanCacheKey(
+		mp, query_dxl, query_output_dxlnode_array, cte_dxlnode_array,
+		optimizer_config, num_segments));
+
+	CDouble optimization_time(0.0);
+	ULONG plan_size = 0;
+	CAutoRg<BYTE> cached_plan(CPlanCache::PbLookup(
+		mp, key.Value(), &plan_size, &optimization_time));
+	if (nullptr != cached_plan.Rgt())
+	{
+		CWallClock parse_clock;
+		ULLONG plan_id = 0;
+		ULLONG plan_space_size = 0;
+		CDXLNode *plan_dxl = CDXLUtils::GetPlanDXLNodeFromBinary(
+			mp, cached_plan.Rgt(), plan_size, &plan_id, &plan_space_size);
+
+		CDouble parse_time(parse_clock.ElapsedUS() /
+						   CDouble(GPOS_USEC_IN_MSEC));
+		CPlanCache::AddSavedTime(
+			CDouble(optimization_time.Get() - parse_time.Get()));
+
+		return plan_dxl;
+	}
+
+	CWallClock optimization_clock;
+	CDXLNode *plan_dxl = COptimizer::PdxlnOptimize(
+		mp, md_accessor, query_dxl, query_output_dxlnode_array,
+		cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
+		gp_command_count, search_strategy_arr, optimizer_config);
+	optimization_time =
+		CDouble(optimization_clock.ElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
+
+	// objects with fixed ids, like CTAS targets, change from query to query
+	// without catalog invalidations: don't cache plans depending on them
+	IMdIdArray *mdids = md_accessor->GetAccessedMDIds(mp);
+	BOOL cacheable = true;
+	for (ULONG ul = 0; cacheable && ul < mdids->Size(); ul++)
+	{
+		cacheable = (IMDId::EmdidGPDBCtas != (*mdids)[ul]->MdidType());
+	}
+
+	// the plan of a search cut short by the budget depends on the load
+	if (cacheable && !optimizer_config->FBudgetExhausted())
+	{
+		// cache the plan in the binary encoding, which is quicker to parse
+		// on a hit than XML
+		CDXLBinaryWriter binary_writer(mp);
+		CDXLUtils::SerializePlan(
+			mp, &binary_writer, plan_dxl,
+			optimizer_config->GetEnumeratorCfg()->GetPlanId(),
+			optimizer_config->GetEnumeratorCfg()->GetPlanSpaceSize());
+		CPlanCache::Insert(key.Value(), mdids, binary_writer.GetData(),
+						   binary_writer.Size(), optimization_time);
+	}
+	mdids->Release();
+
+	return plan_dxl;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::OptimizeTask
@@ -856,7 +1067,10 @@ COptTasks::OptimizeTask(void *ptr)
 	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_dxl);
 	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_stmt);
 
-	AUTO_MEM_POOL(amp);
+	// everything allocated here is released when the optimization ends, so
+	// an arena can serve it
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc,
+						optimizer_use_arena_memory_pool);
 	CMemoryPool *mp = amp.Pmp();
 
 	// Does the metadatacache need to be reset?
@@ -867,6 +1081,41 @@ COptTasks::OptimizeTask(void *ptr)
 	// the invalidation mechanism.
 	bool reset_mdcache = gpdb::MDCacheNeedsReset();
 
+	// the plan cache gets invalidated by the same catalog changes as the
+	// metadata cache, whether the latter is initialized or not
+	if (CPlanCache::FInitialized())
+	{
+		if (reset_mdcache)
+		{
+			CPlanCache::Reset();
+			CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+		}
+		else if (gpdb::MDCacheHasPendingInvalidations())
+		{
+			CPlanCache::Invalidate(IsMDCacheObjectInvalidated);
+		}
+	}
+
+	// initialize plan cache, or drop it if disabled, or change size if
+	// requested
+	if (!optimizer_plan_caching)
+	{
+		if (CPlanCache::FInitialized())
+		{
+			CPlanCache::Shutdown();
+		}
+	}
+	else if (!CPlanCache::FInitialized())
+	{
+		CPlanCache::Init();
+		CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+	}
+	else if (CPlanCache::ULLGetCacheQuota() !=
+			 (ULLONG) optimizer_plan_cache_size * 1024L)
+	{
+		CPlanCache::SetCacheQuota(optimizer_plan_cache_size * 1024L);
+	}
+
 	// initialize metadata cache, or purge if needed, or change size if requested
 	if (!CMDCache::FInitialized())
 	{
@@ -878,11 +1127,21 @@ COptTasks::OptimizeTask(void *ptr)
 		CMDCache::Reset();
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 	}
-	else if (CMDCache::ULLGetCacheQuota() !=
-			 (ULLONG) optimizer_mdcache_size * 1024L)
+	else
 	{
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		// evict the objects whose catalog entries changed
+		if (gpdb::MDCacheHasPendingInvalidations())
+		{
+			CMDCache::Invalidate(IsMDCacheObjectInvalidated);
+		}
+
+		if (CMDCache::ULLGetCacheQuota() !=
+			(ULLONG) optimizer_mdcache_size * 1024L)
+		{
+			CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		}
 	}
+	gpdb::MDCacheClearInvalidations();
 
 
 	// load search strategy
@@ -953,10 +1212,10 @@ COptTasks::OptimizeTask(void *ptr)
 			CAutoTraceFlag atf2(EopttraceUseLegacyOpfamilies,
 								use_legacy_opfamilies);
 
-			plan_dxl = COptimizer::PdxlnOptimize(
+			plan_dxl = OptimizeWithPlanCache(
 				mp, &mda, query_dxl, query_output_dxlnode_array,
-				cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
-				gp_command_count, search_strategy_arr, optimizer_config);
+				cte_dxlnode_array, expr_evaluator, num_segments,
+				search_strategy_arr, optimizer_config);
 
 			if (opt_ctxt->m_should_serialize_plan_dxl)
 			{
@@ -982,6 +1241,15 @@ COptTasks::OptimizeTask(void *ptr)
 						mp, &mda, opt_ctxt->m_query, plan_dxl,
 						opt_ctxt->m_query->canSetTag,
 						query_to_dxl_translator->GetDistributionHashOpsKind()));
+
+				// report a search cut short by the budget in EXPLAIN
+				if (optimizer_config->FBudgetExhausted())
+				{
+					opt_ctxt->m_plan_stmt->optimizerBudgetStage =
+						(int) optimizer_config->UlBudgetExhaustedStage() + 1;
+					opt_ctxt->m_plan_stmt->optimizerSearchStages =
+						(int) optimizer_config->UlSearchStages();
+				}
 			}
 
 			CStatisticsConfig *stats_conf = optimizer_config->GetStatsConf();
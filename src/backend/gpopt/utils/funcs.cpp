@@ -18,7 +18,9 @@
 extern "C" {
 #include "postgres.h"
 
+#include "access/htup_details.h"
 #include "fmgr.h"
+#include "funcapi.h"
 #include "lib/stringinfo.h"
 #include "utils/builtins.h"
 }
@@ -26,6 +28,8 @@ extern "C" {
 #include "gpos/_api.h"
 
 #include "gpopt/gpdbwrappers.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/optimizer/CPlanCache.h"
 #include "gpopt/utils/COptTasks.h"
 #include "gpopt/utils/funcs.h"
 
@@ -117,3 +121,80 @@ LibraryVersion()
 	PG_RETURN_TEXT_P(result);
 }
 }
+
+//---------------------------------------------------------------------------
+//	@function:
+//		MDCacheStats
+//
+//	@doc:
+//		Returns the counters of the metadata cache of this backend
+//
+//---------------------------------------------------------------------------
+extern "C" {
+Datum
+MDCacheStats(PG_FUNCTION_ARGS)
+{
+	TupleDesc tupdesc;
+	Datum values[5];
+	bool nulls[5] = {false, false, false, false, false};
+
+	if (get_call_result_type(fcinfo, nullptr, &tupdesc) != TYPEFUNC_COMPOSITE)
+	{
+		elog(ERROR, "return type must be a row type");
+	}
+
+	values[0] = Int64GetDatum((int64) gpopt::CMDCache::ULLGetCacheHitCounter());
+	values[1] =
+		Int64GetDatum((int64) gpopt::CMDCache::ULLGetCacheMissCounter());
+	values[2] =
+		Int64GetDatum((int64) gpopt::CMDCache::ULLGetCacheEvictionCounter());
+	values[3] = Int64GetDatum(
+		(int64) gpopt::CMDCache::ULLGetCacheInvalidationCounter());
+	values[4] =
+		Int64GetDatum((int64) gpopt::CMDCache::ULLGetCacheResetCounter());
+
+	PG_RETURN_DATUM(
+		HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PlanCacheStats
+//
+//	@doc:
+//		Returns the counters of the plan cache of this backend
+//
+//---------------------------------------------------------------------------
+extern "C" {
+Datum
+PlanCacheStats(PG_FUNCTION_ARGS)
+{
+	TupleDesc tupdesc;
+	Datum values[8];
+	bool nulls[8] = {false, false, false, false, false, false, false, false};
+
+	if (get_call_result_type(fcinfo, nullptr, &tupdesc) != TYPEFUNC_COMPOSITE)
+	{
+		elog(ERROR, "return type must be a row type");
+	}
+
+	values[0] =
+		Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheEntries());
+	values[1] = Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheSize());
+	values[2] =
+		Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheHitCounter());
+	values[3] =
+		Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheMissCounter());
+	values[4] =
+		Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheEvictionCounter());
+	values[5] = Int64GetDatum(
+		(int64) gpopt::CPlanCache::ULLGetCacheInvalidationCounter());
+	values[6] =
+		Int64GetDatum((int64) gpopt::CPlanCache::ULLGetCacheResetCounter());
+	values[7] = Float8GetDatum(gpopt::CPlanCache::DGetSavedTime().Get());
+
+	PG_RETURN_DATUM(
+		HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+}
@@ -12,6 +12,7 @@
 #define GPOPT_CEngine_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CSearchStage.h"
@@ -80,6 +81,24 @@ private:
 	// number of alternatives generated by each xform
 	UlongPtrArray *m_pdrgpulpXformResults;
 
+	// number of xform applications that produced alternatives, and number
+	// of alternatives produced, over all xforms and search stages
+	ULLONG m_ullXformApplications;
+	ULLONG m_ullXformResults;
+
+	// wall-clock time since the optimization started
+	CWallClock m_budget_clock;
+
+	// optimization budget in ms and in bytes; 0 for no limit
+	ULONG m_ulTimeBudget;
+	ULLONG m_ullMemoryBudget;
+
+	// number of budget checks skipped until the budget is checked again
+	ULONG m_ulBudgetCheckCountdown;
+
+	// search stage in which the budget ran out, gpos::ulong_max if it did not
+	ULONG m_ulBudgetExhaustedStage;
+
 #ifdef GPOS_DEBUG
 
 	// a set of internal debugging function used for recursive
@@ -156,6 +175,9 @@ private:
 	// process trace flags after optimization is complete
 	void ProcessTraceFlags();
 
+	// check the optimization budget, record the current stage if it ran out
+	BOOL FCheckBudget();
+
 	// check if search has terminated
 	BOOL
 	FSearchTerminated() const
@@ -226,6 +248,13 @@ public:
 		return m_pmemo->PgroupRoot();
 	}
 
+	// accessor of memo
+	CMemo *
+	Pmemo() const
+	{
+		return m_pmemo;
+	}
+
 	// check if a group is the root one
 	BOOL
 	FRoot(CGroup *pgroup) const
@@ -288,6 +317,32 @@ public:
 	// main driver of optimization engine
 	void Optimize();
 
+	// check if the optimization budget ran out; from then on, no more
+	// alternatives are explored, and the search optimizes the ones found so
+	// far and skips the remaining search stages
+	BOOL
+	FBudgetExhausted()
+	{
+		if (gpos::ulong_max != m_ulBudgetExhaustedStage)
+		{
+			return true;
+		}
+
+		if (0 == m_ulTimeBudget && 0 == m_ullMemoryBudget)
+		{
+			return false;
+		}
+
+		if (0 < m_ulBudgetCheckCountdown)
+		{
+			// reading the clock and the memory pool size is not free
+			m_ulBudgetCheckCountdown--;
+			return false;
+		}
+
+		return FCheckBudget();
+	}
+
 	// print memo to output logger
 	void
 	Trace()
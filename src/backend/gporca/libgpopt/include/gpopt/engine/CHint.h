@@ -20,6 +20,8 @@
 #define PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD ULONG(10)
 #define XFORM_BIND_THRESHOLD ULONG(0)
 #define SKEW_FACTOR ULONG(0)
+#define TIME_BUDGET ULONG(0)
+#define MEMORY_BUDGET ULONG(0)
 
 
 namespace gpopt
@@ -53,6 +55,10 @@ private:
 
 	ULONG m_ulSkewFactor;
 
+	ULONG m_ulTimeBudget;
+
+	ULONG m_ulMemoryBudget;
+
 public:
 	CHint(const CHint &) = delete;
 
@@ -61,7 +67,7 @@ public:
 		  ULONG array_expansion_threshold, ULONG ulJoinOrderDPLimit,
 		  ULONG broadcast_threshold, BOOL enforce_constraint_on_dml,
 		  ULONG push_group_by_below_setop_threshold, ULONG xform_bind_threshold,
-		  ULONG skew_factor)
+		  ULONG skew_factor, ULONG time_budget, ULONG memory_budget)
 		: m_ulJoinArityForAssociativityCommutativity(
 			  join_arity_for_associativity_commutativity),
 		  m_ulArrayExpansionThreshold(array_expansion_threshold),
@@ -71,7 +77,9 @@ public:
 		  m_ulPushGroupByBelowSetopThreshold(
 			  push_group_by_below_setop_threshold),
 		  m_ulXform_bind_threshold(xform_bind_threshold),
-		  m_ulSkewFactor(skew_factor)
+		  m_ulSkewFactor(skew_factor),
+		  m_ulTimeBudget(time_budget),
+		  m_ulMemoryBudget(memory_budget)
 	{
 	}
 
@@ -143,6 +151,22 @@ public:
 		return m_ulSkewFactor;
 	}
 
+	// Wall-clock time in ms after which the search stops exploring new
+	// alternatives and returns the best plan found so far; 0 for no limit
+	ULONG
+	UlTimeBudget() const
+	{
+		return m_ulTimeBudget;
+	}
+
+	// Size in KB of the optimizer memory after which the search stops
+	// exploring new alternatives, like UlTimeBudget(); 0 for no limit
+	ULONG
+	UlMemoryBudget() const
+	{
+		return m_ulMemoryBudget;
+	}
+
 	// generate default hint configurations, which disables sort during insert on
 	// append only row-oriented partitioned tables by default
 	static CHint *
@@ -156,7 +180,9 @@ public:
 			true,								 /* enforce_constraint_on_dml */
 			PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD, /* push_group_by_below_setop_threshold */
 			XFORM_BIND_THRESHOLD,				 /* xform_bind_threshold */
-			SKEW_FACTOR							 /* skew_factor */
+			SKEW_FACTOR,						 /* skew_factor */
+			TIME_BUDGET,						 /* time_budget */
+			MEMORY_BUDGET						 /* memory_budget */
 		);
 	}
 
@@ -372,6 +372,9 @@ public:
 
 	// serialize system ids to passed stream
 	void SerializeSysid(COstream &oos);
+
+	// ids of the objects accessed so far
+	IMdIdArray *GetAccessedMDIds(CMemoryPool *mp);
 };
 }  // namespace gpopt
 
@@ -44,6 +44,15 @@ private:
 	// the maximum size of the cache
 	static ULLONG m_ullCacheQuota;
 
+	// counters of the cache instances destroyed earlier
+	static ULLONG m_ullHitsBeforeReset;
+	static ULLONG m_ullMissesBeforeReset;
+	static ULLONG m_ullEvictionsBeforeReset;
+	static ULLONG m_ullInvalidationsBeforeReset;
+
+	// number of times the cache was reset
+	static ULLONG m_ullResetCounter;
+
 	// private ctor
 	CMDCache() = default;
 
@@ -75,6 +84,22 @@ public:
 	// get the number of times we evicted entries from this cache
 	static ULLONG ULLGetCacheEvictionCounter();
 
+	// get the number of lookups that found an object in this cache
+	static ULLONG ULLGetCacheHitCounter();
+
+	// get the number of lookups that did not find an object in this cache
+	static ULLONG ULLGetCacheMissCounter();
+
+	// get the number of objects evicted because they became stale
+	static ULLONG ULLGetCacheInvalidationCounter();
+
+	// get the number of times the cache was reset
+	static ULLONG ULLGetCacheResetCounter();
+
+	// evict the objects whose metadata ids the given function considers
+	// stale, return the number of objects evicted
+	static ULLONG Invalidate(BOOL (*pfnInvalid)(const IMDId *));
+
 	// reset global instance
 	static void Reset();
 
@@ -215,6 +215,10 @@ private:
 												 CColRefArray *pdrgpcrOutput,
 												 ColRefToUlongMap *col_mapping);
 
+	static CConstraint *PcnstrFromPartConstraint(const CDXLNode *dxlnode,
+												 CColRefArray *pdrgpcrOutput,
+												 ULongPtrArray *colids);
+
 	// swap logical select over logical project
 	static CExpression *PexprTransposeSelectAndProject(CMemoryPool *mp,
 													   CExpression *pexpr);
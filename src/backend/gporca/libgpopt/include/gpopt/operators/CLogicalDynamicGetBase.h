@@ -62,8 +62,9 @@ protected:
 	// Child partitions
 	IMdIdArray *m_partition_mdids = nullptr;
 	// Map of Root colref -> col index in child tabledesc
-	// per child partition in m_partition_mdid
-	ColRefToUlongMapArray *m_root_col_mapping_per_part = nullptr;
+	// per child partition in m_partition_mdid, constructed on first use
+	// so that the partitions pruned before are never retrieved
+	mutable ColRefToUlongMapArray *m_root_col_mapping_per_part = nullptr;
 
 	// Construct a mapping from each column in root table to an index in each
 	// child partition's table descr by matching column names$
@@ -182,6 +183,11 @@ public:
 	ColRefToUlongMapArray *
 	GetRootColMappingPerPart() const
 	{
+		if (nullptr == m_root_col_mapping_per_part)
+		{
+			m_root_col_mapping_per_part = ConstructRootColMappingPerPart(
+				m_mp, m_pdrgpcrOutput, m_partition_mdids);
+		}
 		return m_root_col_mapping_per_part;
 	}
 };	// class CLogicalDynamicGetBase
@@ -69,6 +69,13 @@ private:
 	// default window oids
 	CWindowOids *m_window_oids;
 
+	// search stage in which the optimization budget ran out, if any;
+	// set by the engine, like the plan hints record their use
+	ULONG m_budget_exhausted_stage{gpos::ulong_max};
+
+	// number of search stages of the optimization
+	ULONG m_num_search_stages{0};
+
 public:
 	// ctor
 	COptimizerConfig(CEnumeratorConfig *pec, CStatisticsConfig *stats_config,
@@ -127,6 +134,38 @@ public:
 		return m_plan_hint;
 	}
 
+	// record the search stage in which the optimization budget ran out,
+	// gpos::ulong_max if it did not
+	void
+	SetBudgetExhaustedStage(ULONG stage, ULONG num_search_stages)
+	{
+		GPOS_ASSERT(gpos::ulong_max == stage || stage < num_search_stages);
+
+		m_budget_exhausted_stage = stage;
+		m_num_search_stages = num_search_stages;
+	}
+
+	// did the optimization budget run out?
+	BOOL
+	FBudgetExhausted() const
+	{
+		return gpos::ulong_max != m_budget_exhausted_stage;
+	}
+
+	// search stage in which the optimization budget ran out
+	ULONG
+	UlBudgetExhaustedStage() const
+	{
+		return m_budget_exhausted_stage;
+	}
+
+	// number of search stages of the optimization
+	ULONG
+	UlSearchStages() const
+	{
+		return m_num_search_stages;
+	}
+
 	// generate default optimizer configurations
 	static COptimizerConfig *PoconfDefault(CMemoryPool *mp);
 
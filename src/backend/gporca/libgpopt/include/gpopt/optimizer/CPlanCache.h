@@ -0,0 +1,271 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CPlanCache.h
+//
+//	@doc:
+//		Cache of optimized plans
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CPlanCache_H
+#define GPOPT_CPlanCache_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CRefCount.h"
+#include "gpos/memory/CCache.h"
+#include "gpos/memory/CCacheAccessor.h"
+#include "gpos/string/CWStringConst.h"
+
+#include "naucrates/md/IMDId.h"
+
+namespace gpopt
+{
+using namespace gpos;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCacheKey
+//
+//	@doc:
+//		Key of a cached plan: the serialized query DXL, together with the
+//		optimizer configuration it was optimized under. The key also keeps
+//		the ids of the metadata objects the optimizer looked up, so that
+//		the plan can be invalidated when any of them changes; they are not
+//		part of the key equality. Like CMDKey, the key doesn't own them: they
+//		live in the memory pool of the cache entry.
+//
+//---------------------------------------------------------------------------
+class CPlanCacheKey
+{
+private:
+	// serialized query and configuration
+	const CWStringBase *m_query;
+
+	// hash value of the query
+	ULONG m_hash;
+
+	// metadata objects the plan depends on; nullptr for lookup keys
+	const IMdIdArray *m_mdids;
+
+public:
+	CPlanCacheKey(const CPlanCacheKey &) = delete;
+
+	// ctor
+	CPlanCacheKey(const CWStringBase *query, const IMdIdArray *mdids);
+
+	// dtor
+	~CPlanCacheKey() = default;
+
+	// serialized query and configuration
+	const CWStringBase *
+	Query() const
+	{
+		return m_query;
+	}
+
+	// metadata objects the plan depends on
+	const IMdIdArray *
+	MDIds() const
+	{
+		return m_mdids;
+	}
+
+	// equality function for using plan keys in a cache
+	static BOOL FEqualPlanKey(CPlanCacheKey *const &pkeyLeft,
+							  CPlanCacheKey *const &pkeyRight);
+
+	// hash function for using plan keys in a cache
+	static ULONG UlHashPlanKey(CPlanCacheKey *const &pkey);
+};
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCacheEntry
+//
+//	@doc:
+//		Cached plan: the plan as a binary DXL document, see
+//		CDXLBinaryWriter, and the time it took to optimize it
+//
+//---------------------------------------------------------------------------
+class CPlanCacheEntry : public CRefCount
+{
+private:
+	// serialized plan
+	BYTE *m_plan;
+
+	// size of the serialized plan
+	ULONG m_plan_size;
+
+	// optimization time in msec
+	CDouble m_optimization_time;
+
+public:
+	CPlanCacheEntry(const CPlanCacheEntry &) = delete;
+
+	// ctor; the entry takes ownership of the plan
+	CPlanCacheEntry(BYTE *plan, ULONG plan_size, CDouble optimization_time);
+
+	// dtor
+	~CPlanCacheEntry() override;
+
+	// serialized plan
+	const BYTE *
+	Plan() const
+	{
+		return m_plan;
+	}
+
+	// size of the serialized plan
+	ULONG
+	PlanSize() const
+	{
+		return m_plan_size;
+	}
+
+	// optimization time in msec
+	CDouble
+	OptimizationTime() const
+	{
+		return m_optimization_time;
+	}
+};
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CPlanCache
+//
+//	@doc:
+//		A wrapper for a generic cache holding the plans optimized earlier,
+//		encapsulating a singleton cache object like CMDCache does.
+//
+//		The cache is keyed on the serialized query and optimizer
+//		configuration, so only plans for the very same query and
+//		configuration are reused. The caller is responsible for evicting
+//		the plans whose metadata changed, see Invalidate().
+//
+//---------------------------------------------------------------------------
+class CPlanCache
+{
+public:
+	using PlanCache = CCache<CPlanCacheEntry *, CPlanCacheKey *>;
+
+	using PlanCacheAccessor =
+		CCacheAccessor<CPlanCacheEntry *, CPlanCacheKey *>;
+
+private:
+	// pointer to the underlying cache
+	static PlanCache *m_pcache;
+
+	// the maximum size of the cache
+	static ULLONG m_ullCacheQuota;
+
+	// counters of the cache instances destroyed earlier
+	static ULLONG m_ullHitsBeforeReset;
+	static ULLONG m_ullMissesBeforeReset;
+	static ULLONG m_ullEvictionsBeforeReset;
+	static ULLONG m_ullInvalidationsBeforeReset;
+
+	// number of times the cache was reset
+	static ULLONG m_ullResetCounter;
+
+	// optimization time saved by cache hits, in msec
+	static CDouble m_dSavedTime;
+
+	// private ctor
+	CPlanCache() = default;
+
+	// private dtor
+	~CPlanCache() = default;
+
+public:
+	CPlanCache(const CPlanCache &) = delete;
+
+	// initialize underlying cache
+	static void Init();
+
+	// has cache been initialized?
+	static BOOL
+	FInitialized()
+	{
+		return (nullptr != m_pcache);
+	}
+
+	// destroy global instance
+	static void Shutdown();
+
+	// reset global instance
+	static void Reset();
+
+	// set the maximum size of the cache
+	static void SetCacheQuota(ULLONG ullCacheQuota);
+
+	// get the maximum size of the cache
+	static ULLONG ULLGetCacheQuota();
+
+	// look up the plan of the given query; return a copy of the serialized
+	// plan, its size and its optimization time, or nullptr if there is none
+	static BYTE *PbLookup(CMemoryPool *mp, const CWStringBase *pstrQuery,
+						  ULONG *pulPlanSize, CDouble *pdOptimizationTime);
+
+	// add the serialized plan of the given query, which depends on the
+	// given metadata objects
+	static void Insert(const CWStringBase *pstrQuery, const IMdIdArray *mdids,
+					   const BYTE *pbPlan, ULONG ulPlanSize,
+					   CDouble dOptimizationTime);
+
+	// evict the plans depending on metadata objects that the given function
+	// considers stale, return the number of plans evicted
+	static ULLONG Invalidate(BOOL (*pfnInvalid)(const IMDId *));
+
+	// account for optimization time saved by a cache hit
+	static void
+	AddSavedTime(CDouble dSavedTime)
+	{
+		m_dSavedTime = CDouble(m_dSavedTime.Get() + dSavedTime.Get());
+	}
+
+	// get the number of plans in the cache
+	static ULLONG ULLGetCacheEntries();
+
+	// get the size of the plans in the cache
+	static ULLONG ULLGetCacheSize();
+
+	// get the number of lookups that found a plan in this cache
+	static ULLONG ULLGetCacheHitCounter();
+
+	// get the number of lookups that did not find a plan in this cache
+	static ULLONG ULLGetCacheMissCounter();
+
+	// get the number of times we evicted plans from this cache
+	static ULLONG ULLGetCacheEvictionCounter();
+
+	// get the number of plans evicted because they became stale
+	static ULLONG ULLGetCacheInvalidationCounter();
+
+	// get the number of times the cache was reset
+	static ULLONG ULLGetCacheResetCounter();
+
+	// get the optimization time saved by cache hits, in msec
+	static CDouble
+	DGetSavedTime()
+	{
+		return m_dSavedTime;
+	}
+
+	// global accessor
+	static PlanCache *
+	Pcache()
+	{
+		return m_pcache;
+	}
+
+};	// class CPlanCache
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_CPlanCache_H
+
+// EOF
@@ -95,6 +95,14 @@ private:
 	// operator class
 	COperator *m_pop{nullptr};
 
+	// hash value of the operator, computed once since operators are
+	// immutable once they are in the memo
+	ULONG m_ulOpHash{0};
+
+	// id of the operator in the operator intern table of the memo;
+	// group expressions whose operators match have the same id
+	ULONG m_ulOpId{gpos::ulong_max};
+
 	// array of child groups
 	CGroupArray *m_pdrgpgroup{nullptr};
 
@@ -136,6 +144,9 @@ private:
 	// set group expression id
 	void SetId(ULONG id);
 
+	// combine the hash value of an operator with its child groups
+	static ULONG HashValue(ULONG ulOpHash, CGroupArray *pdrgpgroup);
+
 	// print transformation
 	static void PrintXform(CMemoryPool *mp, CXform *pxform, CExpression *pexpr,
 						   CXformResult *pxfres, ULONG ulNumResults);
@@ -266,6 +277,29 @@ public:
 		return m_pop;
 	}
 
+	// hash value of the operator
+	ULONG
+	UlOpHash() const
+	{
+		return m_ulOpHash;
+	}
+
+	// id of the interned operator
+	ULONG
+	UlOpId() const
+	{
+		return m_ulOpId;
+	}
+
+	// set id of the interned operator
+	void
+	SetOpId(ULONG ulOpId)
+	{
+		GPOS_ASSERT(gpos::ulong_max == m_ulOpId || ulOpId == m_ulOpId);
+
+		m_ulOpId = ulOpId;
+	}
+
 	// accessor for id
 	ULONG
 	Id() const
@@ -326,7 +360,7 @@ public:
 	ULONG
 	HashValue() const
 	{
-		return HashValue(m_pop, m_pdrgpgroup);
+		return HashValue(m_ulOpHash, m_pdrgpgroup);
 	}
 
 	// static hash function for operator and group references
@@ -340,6 +374,10 @@ public:
 				   CXformResult *pxfres, ULONG *pulElapsedTime,
 				   ULONG *pulNumberOfBindings);
 
+	// can one of the given implementation xforms apply to the group
+	// expression, judging by its promise?
+	BOOL FImplementable(CMemoryPool *mp, CXformSet *xform_set);
+
 	// set group expression state
 	void SetState(EState estNewState);
 
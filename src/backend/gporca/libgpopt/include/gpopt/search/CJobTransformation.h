@@ -13,6 +13,7 @@
 
 #include "gpopt/search/CJob.h"
 #include "gpopt/search/CJobStateMachine.h"
+#include "gpopt/xforms/CXform.h"
 
 
 namespace gpopt
@@ -65,6 +66,10 @@ private:
 	// job state machine
 	JSM m_jsm;
 
+	// does the group have a group expression to implement?
+	static BOOL FGroupImplementable(CMemoryPool *mp, CGroup *pgroup,
+									CXformSet *xform_set);
+
 	// apply transformation action
 	static EEvent EevtTransform(CSchedulerContext *psc, CJob *pj);
 
@@ -12,6 +12,7 @@
 #define GPOPT_CMemo_H
 
 #include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/CSyncHashtable.h"
 #include "gpos/common/CSyncList.h"
@@ -55,6 +56,44 @@ private:
 	using ShtAccIter =
 		CSyncHashtableAccessByIter<CGroupExpression, CGroupExpression>;
 
+	// operator in the intern table, together with its hash value
+	struct SInternedOp
+	{
+		// operator
+		COperator *m_pop;
+
+		// hash value of the operator
+		ULONG m_ulHash;
+
+		// hash function
+		static ULONG
+		HashValue(const SInternedOp *pio)
+		{
+			return pio->m_ulHash;
+		}
+
+		// equality function, comparing hash values before operators
+		static BOOL
+		Equals(const SInternedOp *pioFst, const SInternedOp *pioSnd)
+		{
+			return pioFst->m_ulHash == pioSnd->m_ulHash &&
+				   pioFst->m_pop->Matches(pioSnd->m_pop);
+		}
+
+		// release operator and delete entry
+		static void
+		Cleanup(SInternedOp *pio)
+		{
+			pio->m_pop->Release();
+			GPOS_DELETE(pio);
+		}
+	};
+
+	// map of interned operators to their ids
+	using OpIdMap = CHashMap<SInternedOp, ULONG, SInternedOp::HashValue,
+							 SInternedOp::Equals, SInternedOp::Cleanup,
+							 CleanupDelete<ULONG>>;
+
 	// memory pool
 	CMemoryPool *m_mp;
 
@@ -78,12 +117,37 @@ private:
 				   CGroupExpression>
 		m_sht;
 
+	// intern table of the operators of all group expressions
+	OpIdMap *m_popidmap;
+
+	// is timing of duplicate detection enabled?
+	const BOOL m_fStatsTiming;
+
+	// number of hash table lookups of group expressions since the stats
+	// were last printed
+	ULONG m_ulLookups{0};
+
+	// number of duplicate group expressions found by these lookups
+	ULONG m_ulDuplicatesFound{0};
+
+	// number of group expressions re-inserted by rehashing
+	ULONG m_ulRehashed{0};
+
+	// time spent in looking up group expressions and rehashing, in usec
+	ULLONG m_ullDedupTime{0};
+
+	// assign the id of its interned operator to a group expression
+	void InternOperator(CGroupExpression *pgexpr);
+
 	// add new group
 	void Add(CGroup *pgroup, CExpression *pexprOrigin);
 
-	// rehash all group expressions after group merge - not thread-safe
+	// rehash group expressions after group merge - not thread-safe
 	BOOL FRehash();
 
+	// check if any child group of a group expression has a duplicate
+	static BOOL FDuplicateChildGroup(CGroupExpression *pgexpr);
+
 	// helper for inserting group expression in target group
 	CGroup *PgroupInsert(CGroup *pgroupTarget, CGroupExpression *pgexpr,
 						 CExpression *pexprOrigin, BOOL fNewGroup);
@@ -118,9 +182,38 @@ public:
 	// return total number of group expressions
 	ULONG UlGrpExprs();
 
+	// return number of distinct operators of group expressions
+	ULONG
+	UlOperators() const
+	{
+		return m_popidmap->Size();
+	}
+
 	// return number of duplicate groups
 	ULONG UlDuplicateGroups();
 
+	// return number of group expression lookups since the stats were last
+	// printed
+	ULONG
+	UlLookups() const
+	{
+		return m_ulLookups;
+	}
+
+	// return number of duplicate group expressions found by these lookups
+	ULONG
+	UlDuplicatesFound() const
+	{
+		return m_ulDuplicatesFound;
+	}
+
+	// return number of group expressions re-inserted by rehashing
+	ULONG
+	UlRehashed() const
+	{
+		return m_ulRehashed;
+	}
+
 	// mark groups as duplicates
 	static void MarkDuplicates(CGroup *pgroupFst, CGroup *pgroupSnd);
 
@@ -167,6 +260,10 @@ public:
 	// print memo to output logger
 	void Trace();
 
+	// print the cost of duplicate detection since the last call, and
+	// reset it
+	IOstream &OsPrintDedupStats(IOstream &os, ULONG ulSearchStage);
+
 	// get group by id
 	CGroup *Pgroup(ULONG id);
 
@@ -51,6 +51,13 @@ class CSchedulerContext;
 //		complete. At this point, a queued job can be terminated if it does not
 //		have any further dependencies.
 //
+//		All jobs run on the optimizer's single worker: the search calls back
+//		into the backend for metadata, memory and error handling, none of
+//		which may be used from other threads.  PrintStats() reports the
+//		highest number of jobs that were runnable at the same time, and the
+//		time spent in each type of job, which bounds what running them
+//		concurrently could gain.
+//
 //---------------------------------------------------------------------------
 class CScheduler
 {
@@ -109,6 +116,16 @@ private:
 	ULONG_PTR m_ulpStatsCompletedQueued;
 	ULONG_PTR m_ulpStatsResumed;
 
+	// highest number of jobs waiting to run at the same time; this bounds
+	// the number of jobs that could have been run concurrently
+	ULONG_PTR m_ulpStatsMaxQueued;
+
+	// per job type: number of executions and time spent in them (in us);
+	// times are only measured if optimization statistics are printed
+	ULONG_PTR m_rgulpStatsExecuted[CJob::EjtSentinel];
+	ULLONG m_rgullStatsTimeUS[CJob::EjtSentinel];
+	const BOOL m_fStatsTiming;
+
 #ifdef GPOS_DEBUG
 	// list of running jobs
 	CList<CJob> m_listjRunning;
@@ -0,0 +1,376 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CJoinAtomSet.h
+//
+//	@doc:
+//		Fixed-width set of join atoms and a flat hash map keyed by it, used
+//		by the join order enumerators to look up subsets of the join graph
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CJoinAtomSet_H
+#define GPOPT_CJoinAtomSet_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CBitSetIter.h"
+#include "gpos/common/CRefCount.h"
+
+// number of 64-bit words of an atom set
+#define GPOPT_JOIN_ATOM_SET_WORDS 2
+
+// initial number of entries of an atom set map, a power of 2
+#define GPOPT_JOIN_ATOM_SET_MAP_INIT_SIZE 64
+
+namespace gpopt
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CJoinAtomSet
+//
+//	@doc:
+//		Set of the atoms (the logical children) of an NAry join, stored
+//		inline as a fixed number of bit words.
+//
+//		Unlike CBitSet, an atom set is a value: it needs no allocation, and
+//		union, disjointness, hashing and equality are a few word operations.
+//		This makes it cheap enough to probe the subsets of the join graph
+//		for every candidate join of an enumeration. Joins with more than
+//		MaxAtoms atoms don't fit; callers check FFits() and fall back to
+//		CBitSet in that case.
+//
+//---------------------------------------------------------------------------
+class CJoinAtomSet
+{
+private:
+	// bit words
+	ULLONG m_words[GPOPT_JOIN_ATOM_SET_WORDS];
+
+public:
+	// maximum number of atoms in a set
+	static const ULONG MaxAtoms = GPOPT_JOIN_ATOM_SET_WORDS * 64;
+
+	// ctor of an empty set
+	CJoinAtomSet()
+	{
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			m_words[ul] = 0;
+		}
+	}
+
+	// ctor of the set of the bits of the given bit set
+	explicit CJoinAtomSet(const CBitSet *pbs) : CJoinAtomSet()
+	{
+		GPOS_ASSERT(nullptr != pbs);
+
+		CBitSetIter bsi(*pbs);
+		while (bsi.Advance())
+		{
+			Set(bsi.Bit());
+		}
+	}
+
+	// do joins of the given number of atoms fit in an atom set?
+	static BOOL
+	FFits(ULONG num_atoms)
+	{
+		return num_atoms <= MaxAtoms;
+	}
+
+	// add an atom to the set
+	void
+	Set(ULONG atom)
+	{
+		GPOS_ASSERT(atom < MaxAtoms);
+
+		m_words[atom / 64] |= (ULLONG(1) << (atom % 64));
+	}
+
+	// is the given atom in the set?
+	BOOL
+	Get(ULONG atom) const
+	{
+		GPOS_ASSERT(atom < MaxAtoms);
+
+		return 0 != (m_words[atom / 64] & (ULLONG(1) << (atom % 64)));
+	}
+
+	// union of this set and the given one
+	CJoinAtomSet
+	Union(const CJoinAtomSet &other) const
+	{
+		CJoinAtomSet result;
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			result.m_words[ul] = m_words[ul] | other.m_words[ul];
+		}
+
+		return result;
+	}
+
+	// do this set and the given one have no atoms in common?
+	BOOL
+	IsDisjoint(const CJoinAtomSet &other) const
+	{
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			if (0 != (m_words[ul] & other.m_words[ul]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// does this set contain all atoms of the given one?
+	BOOL
+	ContainsAll(const CJoinAtomSet &other) const
+	{
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			if (other.m_words[ul] != (m_words[ul] & other.m_words[ul]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// is the set empty?
+	BOOL
+	IsEmpty() const
+	{
+		return IsDisjoint(*this);
+	}
+
+	// number of atoms in the set
+	ULONG
+	Size() const
+	{
+		ULONG size = 0;
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			// clear the lowest bit until none is left
+			for (ULLONG word = m_words[ul]; 0 != word; word &= word - 1)
+			{
+				size++;
+			}
+		}
+
+		return size;
+	}
+
+	// equality
+	BOOL
+	Equals(const CJoinAtomSet &other) const
+	{
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			if (m_words[ul] != other.m_words[ul])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// hash value; atom sets of a join differ in few low bits, so mix all
+	// words through a multiplicative hash
+	ULONG
+	HashValue() const
+	{
+		ULLONG hash = 0;
+		for (ULONG ul = 0; ul < GPOPT_JOIN_ATOM_SET_WORDS; ul++)
+		{
+			hash = (hash ^ m_words[ul]) * ULLONG(0x9E3779B97F4A7C15);
+			hash ^= hash >> 29;
+		}
+
+		return (ULONG)(hash ^ (hash >> 32));
+	}
+};	// class CJoinAtomSet
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CJoinAtomSetMap
+//
+//	@doc:
+//		Hash map from atom sets to values, with open addressing and linear
+//		probing over a single array of entries.
+//
+//		The interface follows CHashMap: values are not owned by the map
+//		until they are inserted, and are passed to CleanupFn when they are
+//		deleted or when the map is destroyed. Values must not be null.
+//
+//---------------------------------------------------------------------------
+template <class T, void (*CleanupFn)(T *)>
+class CJoinAtomSetMap : public CRefCount
+{
+private:
+	// entry of the map; free entries have a null value
+	struct SEntry
+	{
+		CJoinAtomSet m_key;
+
+		T *m_value{nullptr};
+	};
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// entries, their number is a power of 2
+	SEntry *m_entries;
+
+	// number of entries
+	ULONG m_capacity;
+
+	// number of entries in use
+	ULONG m_size{0};
+
+	// entry holding the given key, or the free entry to insert it into
+	SEntry *
+	PentryLookup(const CJoinAtomSet &key) const
+	{
+		ULONG ul = key.HashValue() & (m_capacity - 1);
+		while (nullptr != m_entries[ul].m_value &&
+			   !m_entries[ul].m_key.Equals(key))
+		{
+			ul = (ul + 1) & (m_capacity - 1);
+		}
+
+		return &m_entries[ul];
+	}
+
+	// double the number of entries
+	void
+	Grow()
+	{
+		SEntry *old_entries = m_entries;
+		const ULONG old_capacity = m_capacity;
+
+		m_capacity = 2 * old_capacity;
+		m_entries = GPOS_NEW_ARRAY(m_mp, SEntry, m_capacity);
+		for (ULONG ul = 0; ul < old_capacity; ul++)
+		{
+			if (nullptr != old_entries[ul].m_value)
+			{
+				*PentryLookup(old_entries[ul].m_key) = old_entries[ul];
+			}
+		}
+
+		GPOS_DELETE_ARRAY(old_entries);
+	}
+
+public:
+	CJoinAtomSetMap(const CJoinAtomSetMap &) = delete;
+
+	// ctor
+	explicit CJoinAtomSetMap(CMemoryPool *mp)
+		: m_mp(mp), m_capacity(GPOPT_JOIN_ATOM_SET_MAP_INIT_SIZE)
+	{
+		m_entries = GPOS_NEW_ARRAY(m_mp, SEntry, m_capacity);
+	}
+
+	// dtor
+	~CJoinAtomSetMap() override
+	{
+		for (ULONG ul = 0; ul < m_capacity; ul++)
+		{
+			if (nullptr != m_entries[ul].m_value)
+			{
+				CleanupFn(m_entries[ul].m_value);
+			}
+		}
+
+		GPOS_DELETE_ARRAY(m_entries);
+	}
+
+	// value of the given key, or nullptr
+	T *
+	Find(const CJoinAtomSet &key) const
+	{
+		return PentryLookup(key)->m_value;
+	}
+
+	// insert a value; return false and leave the value to the caller if
+	// the key exists already
+	BOOL
+	Insert(const CJoinAtomSet &key, T *value)
+	{
+		GPOS_ASSERT(nullptr != value);
+
+		// keep the load factor at or below 1/2, so probe sequences are short
+		if (2 * (m_size + 1) > m_capacity)
+		{
+			Grow();
+		}
+
+		SEntry *entry = PentryLookup(key);
+		if (nullptr != entry->m_value)
+		{
+			return false;
+		}
+
+		entry->m_key = key;
+		entry->m_value = value;
+		m_size++;
+
+		return true;
+	}
+
+	// delete the value of the given key, return false if there is none
+	BOOL
+	Delete(const CJoinAtomSet &key)
+	{
+		SEntry *entry = PentryLookup(key);
+		if (nullptr == entry->m_value)
+		{
+			return false;
+		}
+
+		CleanupFn(entry->m_value);
+		entry->m_value = nullptr;
+		m_size--;
+
+		// shift back the entries of the probe sequence after the deleted
+		// one that would no longer be found past the hole
+		ULONG hole = (ULONG)(entry - m_entries);
+		ULONG ul = (hole + 1) & (m_capacity - 1);
+		while (nullptr != m_entries[ul].m_value)
+		{
+			ULONG home = m_entries[ul].m_key.HashValue() & (m_capacity - 1);
+
+			// is the home entry of this one cyclically outside (hole, ul]?
+			if (((ul - home) & (m_capacity - 1)) >=
+				((ul - hole) & (m_capacity - 1)))
+			{
+				m_entries[hole] = m_entries[ul];
+				m_entries[ul].m_value = nullptr;
+				hole = ul;
+			}
+			ul = (ul + 1) & (m_capacity - 1);
+		}
+
+		return true;
+	}
+
+	// number of values in the map
+	ULONG
+	Size() const
+	{
+		return m_size;
+	}
+};	// class CJoinAtomSetMap
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_CJoinAtomSet_H
+
+// EOF
@@ -19,6 +19,7 @@
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/operators/CExpression.h"
+#include "gpopt/xforms/CJoinAtomSet.h"
 #include "gpopt/xforms/CJoinOrder.h"
 
 
@@ -67,6 +68,29 @@ private:
 						   const SComponentPair *pcomppairSnd);
 	};
 
+	//---------------------------------------------------------------------------
+	//	@struct:
+	//		SSubsetCost
+	//
+	//	@doc:
+	//		Cost of the join order of a subset of the components
+	//
+	//---------------------------------------------------------------------------
+	struct SSubsetCost
+	{
+		// join order the cost was computed for, owned by the DP table or
+		// by the components
+		CExpression *m_pexpr;
+
+		// cost of the join order
+		CDouble m_cost;
+
+		SSubsetCost(CExpression *pexpr, CDouble cost)
+			: m_pexpr(pexpr), m_cost(cost)
+		{
+		}
+	};
+
 	// hashing function
 	static ULONG
 	UlHashBitSet(const CBitSet *pbs)
@@ -102,6 +126,10 @@ private:
 		CHashMap<CExpression, CDouble, CExpression::HashValue, CUtils::Equals,
 				 CleanupRelease<CExpression>, CleanupDelete<CDouble>>;
 
+	// hash map from subset of the components to the cost of its join order
+	using AtomSetToCostMap =
+		CJoinAtomSetMap<SSubsetCost, CleanupDelete<SSubsetCost>>;
+
 	// lookup table for links
 	ComponentPairToExpressionMap *m_phmcomplink;
 
@@ -111,9 +139,17 @@ private:
 	// map of expressions to its cost
 	ExpressionToCostMap *m_phmexprcost;
 
+	// map of subsets to the cost of their join order, so that costing a
+	// candidate join doesn't hash its children; nullptr if the components
+	// don't fit in a CJoinAtomSet
+	AtomSetToCostMap *m_phmsubsetcost;
+
 	// array of top-k join expression
 	CExpressionArray *m_pdrgpexprTopKOrders;
 
+	// costs of the top-k join expressions, in the same order
+	DOUBLE *m_pdTopKCosts;
+
 	// dummy expression to used for non-joinable components
 	CExpression *m_pexprDummy;
 
@@ -154,6 +190,9 @@ private:
 	// compute cost of given join expression
 	CDouble DCost(CExpression *pexpr);
 
+	// compute cost of given join order of given subset
+	CDouble DSubsetCost(CBitSet *pbs, CExpression *pexpr);
+
 	// derive stats on given expression
 	void DeriveStats(CExpression *pexpr) override;
 
@@ -20,6 +20,7 @@
 #include "gpopt/base/CKHeap.h"
 #include "gpopt/base/CUtils.h"
 #include "gpopt/operators/CExpression.h"
+#include "gpopt/xforms/CJoinAtomSet.h"
 #include "gpopt/xforms/CJoinOrder.h"
 
 
@@ -317,14 +318,20 @@ private:
 	{
 		// the set of atoms, this uniquely identifies the group
 		CBitSet *m_atoms;
+		// the same set in fixed width, empty if the join has too many atoms
+		CJoinAtomSet m_atom_set;
 		// infos of the best (lowest cost) expressions (so far, if at the current level)
 		// for each interesting property
 		SExpressionInfoArray *m_best_expr_info_array;
 		CDouble m_cardinality;
 		CDouble m_lowest_expr_cost;
 
-		SGroupInfo(CMemoryPool *mp, CBitSet *atoms)
-			: m_atoms(atoms), m_cardinality(-1.0), m_lowest_expr_cost(-1.0)
+		SGroupInfo(CMemoryPool *mp, CBitSet *atoms,
+				   const CJoinAtomSet &atom_set)
+			: m_atoms(atoms),
+			  m_atom_set(atom_set),
+			  m_cardinality(-1.0),
+			  m_lowest_expr_cost(-1.0)
 		{
 			m_best_expr_info_array = GPOS_NEW(mp) SExpressionInfoArray(mp);
 		}
@@ -403,6 +410,10 @@ private:
 		CHashMapIter<CBitSet, SGroupInfo, UlHashBitSet, FEqualBitSet,
 					 CleanupRelease<CBitSet>, CleanupRelease<SGroupInfo>>;
 
+	// map from the fixed-width atom set of a group to the group
+	using AtomSetToGroupInfoMap =
+		CJoinAtomSetMap<SGroupInfo, CleanupRelease<SGroupInfo>>;
+
 	// dynamic array of SLevelInfos, where each index represents the level
 	using DPv2Levels = CDynamicPtrArray<SLevelInfo, CleanupRelease<SLevelInfo>>;
 
@@ -413,9 +424,19 @@ private:
 	// map to find the associated edge in the join graph from a join predicate
 	ExpressionToEdgeMap *m_expression_to_edge_map;
 
-	// map to check whether a DPv2 group already exists
+	// map to check whether a DPv2 group already exists, used when the atoms
+	// don't fit in a CJoinAtomSet
 	BitSetToGroupInfoMap *m_bitset_to_group_info_map;
 
+	// the same map keyed by fixed-width atom sets, so that looking up the
+	// group of a candidate join needs no allocation; nullptr if the atoms
+	// don't fit in a CJoinAtomSet
+	AtomSetToGroupInfoMap *m_atom_set_to_group_info_map;
+
+	// covers of the edges as fixed-width atom sets, nullptr if the atoms
+	// don't fit in a CJoinAtomSet
+	CJoinAtomSet *m_edge_atom_sets;
+
 	// ON predicates for NIJs (non-inner joins, e.g. LOJs)
 	// currently NIJs are LOJs only, this may change in the future
 	// if/when we add semijoins, anti-semijoins and relatives
@@ -450,7 +471,11 @@ private:
 	}
 
 	// build expression linking given groups
-	CExpression *PexprBuildInnerJoinPred(CBitSet *pbsFst, CBitSet *pbsSnd);
+	CExpression *PexprBuildInnerJoinPred(SGroupInfo *left_group_info,
+										 SGroupInfo *right_group_info);
+
+	// do the given groups have no atoms in common?
+	BOOL AreDisjoint(SGroupInfo *left_group_info, SGroupInfo *right_group_info);
 
 	// compute cost of a join expression in a group
 	void ComputeCost(SExpressionInfo *expr_info, CDouble join_cardinality);
@@ -506,6 +531,12 @@ private:
 	// look up an existing group or create a new one, with an expression to be used for stats
 	SGroupInfo *LookupOrCreateGroupInfo(SLevelInfo *levelInfo, CBitSet *atoms,
 										SExpressionInfo *stats_expr_info);
+
+	// look up or create the group joining two given groups
+	SGroupInfo *LookupOrCreateGroupInfo(SLevelInfo *levelInfo,
+										SGroupInfo *left_group_info,
+										SGroupInfo *right_group_info,
+										SExpressionInfo *stats_expr_info);
 	// add a new expression to a group, unless there already is an existing expression that dominates it
 	void AddExprToGroupIfNecessary(SGroupInfo *group_info,
 								   SExpressionInfo *new_expr_info);
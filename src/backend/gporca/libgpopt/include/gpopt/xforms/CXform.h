@@ -352,6 +352,12 @@ public:
 	// returns a set containing xforms to use for exhaustive2 join order
 	static CBitSet *PbsJoinOrderOnExhaustive2Xforms(CMemoryPool *mp);
 
+	// return true if the operators matched by the given exploration xform
+	// may have no implementation without it, even though an implementation
+	// xform promises one, such as aggregates with several distinct
+	// qualified aggregates
+	static BOOL FRequiredForPlan(EXformId exfid);
+
 	// return true if xform should be applied only once.
 	// for expression of type CPatternTree, in deep trees, the number
 	// of expressions generated for group expression can be significantly
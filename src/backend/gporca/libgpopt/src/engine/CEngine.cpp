@@ -60,6 +60,9 @@
 #define GPOPT_JOBS_PER_GROUP \
 	20	// estimated number of needed optimization jobs per memo group
 
+#define GPOPT_BUDGET_CHECK_INTERVAL \
+	64	// number of optimization budget checks between actual checks
+
 // memory consumption unit in bytes -- currently MB
 #define GPOPT_MEM_UNIT (1024 * 1024)
 #define GPOPT_MEM_UNIT_NAME "MB"
@@ -87,7 +90,13 @@ CEngine::CEngine(CMemoryPool *mp)
 	  m_pdrgpulpXformCalls(nullptr),
 	  m_pdrgpulpXformTimes(nullptr),
 	  m_pdrgpulpXformBindings(nullptr),
-	  m_pdrgpulpXformResults(nullptr)
+	  m_pdrgpulpXformResults(nullptr),
+	  m_ullXformApplications(0),
+	  m_ullXformResults(0),
+	  m_ulTimeBudget(0),
+	  m_ullMemoryBudget(0),
+	  m_ulBudgetCheckCountdown(0),
+	  m_ulBudgetExhaustedStage(gpos::ulong_max)
 {
 	m_pmemo = GPOS_NEW(mp) CMemo(mp);
 	m_pexprEnforcerPattern =
@@ -363,6 +372,12 @@ CEngine::InsertXformResult(
 	GPOS_ASSERT(CXform::ExfInvalid != exfidOrigin);
 	GPOS_ASSERT(nullptr != pgexprOrigin);
 
+	if (0 < pxfres->Pdrgpexpr()->Size())
+	{
+		m_ullXformApplications++;
+		m_ullXformResults += pxfres->Pdrgpexpr()->Size();
+	}
+
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) &&
 		0 < pxfres->Pdrgpexpr()->Size())
 	{
@@ -1639,8 +1654,12 @@ CEngine::ProcessTraceFlags()
 				<< (ULONG)(m_pmemo->UlpGroups()) << " groups"
 				<< ", " << m_pmemo->UlDuplicateGroups() << " duplicate groups"
 				<< ", " << m_pmemo->UlGrpExprs() << " group expressions"
+				<< ", " << m_pmemo->UlOperators() << " distinct operators"
 				<< ", " << m_xforms->Size() << " activated xforms]";
 
+		at.Os() << std::endl;
+		(void) m_pmemo->OsPrintDedupStats(at.Os(), m_ulCurrSearchStage);
+
 		at.Os() << std::endl
 				<< "[OPT]: stage " << m_ulCurrSearchStage << " completed in "
 				<< PssCurrent()->UlElapsedTime() << "ms, ";
@@ -1688,6 +1707,17 @@ CEngine::Optimize()
 	CSchedulerContext sc;
 	sc.Init(m_mp, &jf, &sched, this);
 
+	COptimizerConfig *optimizer_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig();
+	m_ulTimeBudget = optimizer_config->GetHint()->UlTimeBudget();
+	m_ullMemoryBudget =
+		(ULLONG) optimizer_config->GetHint()->UlMemoryBudget() * 1024;
+	// the first exploration checks the budget, in case it ran out before
+	// the search even started
+	m_ulBudgetCheckCountdown = 0;
+	m_ulBudgetExhaustedStage = gpos::ulong_max;
+	m_budget_clock.Restart();
+
 	const ULONG ulSearchStages = m_search_stage_array->Size();
 	for (ULONG ul = 0; !FSearchTerminated() && ul < ulSearchStages; ul++)
 	{
@@ -1718,15 +1748,44 @@ CEngine::Optimize()
 		PssCurrent()->SetBestExpr(pexprPlan);
 
 		FinalizeSearchStage();
+
+		// don't start another stage once the budget ran out, the plan
+		// extracted above is the best one found so far
+		if (ul + 1 < ulSearchStages &&
+			(gpos::ulong_max != m_ulBudgetExhaustedStage || FCheckBudget()))
+		{
+			break;
+		}
 	}
 
+	optimizer_config->SetBudgetExhaustedStage(m_ulBudgetExhaustedStage,
+											  ulSearchStages);
 
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 	{
+		sched.PrintStats();
+
 		CAutoTrace atSearch(m_mp);
 		atSearch.Os() << "[OPT]: Search terminated at stage "
 					  << m_ulCurrSearchStage << "/"
 					  << m_search_stage_array->Size();
+		if (gpos::ulong_max != m_ulBudgetExhaustedStage)
+		{
+			atSearch.Os() << ", optimization budget ran out in stage "
+						  << m_ulBudgetExhaustedStage;
+		}
+	}
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationSummary))
+	{
+		// a single line with fixed fields, for tools tracking the search
+		// effort across builds, see scripts/bench_optimizer.py
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Optimization summary: groups "
+				<< (ULONG)(m_pmemo->UlpGroups()) << ", group expressions "
+				<< m_pmemo->UlGrpExprs() << ", xform applications "
+				<< m_ullXformApplications << ", xform results "
+				<< m_ullXformResults;
 	}
 
 
@@ -1737,6 +1796,37 @@ CEngine::Optimize()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FCheckBudget
+//
+//	@doc:
+//		Check the wall-clock time and memory used so far against the
+//		optimization budget, and record the current search stage if the
+//		budget ran out
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FCheckBudget()
+{
+	GPOS_ASSERT(gpos::ulong_max == m_ulBudgetExhaustedStage);
+
+	m_ulBudgetCheckCountdown = GPOPT_BUDGET_CHECK_INTERVAL;
+
+	BOOL fExhausted =
+		(0 < m_ulTimeBudget && m_budget_clock.ElapsedMS() > m_ulTimeBudget) ||
+		(0 < m_ullMemoryBudget &&
+		 m_mp->TotalAllocatedSize() > m_ullMemoryBudget);
+
+	if (fExhausted)
+	{
+		m_ulBudgetExhaustedStage = m_ulCurrSearchStage;
+	}
+
+	return fExhausted;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::CEngine
@@ -1288,6 +1288,48 @@ CMDAccessor::Serialize(COstream &oos)
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::GetAccessedMDIds
+//
+//	@doc:
+//		Return the ids of the objects accessed so far
+//
+//---------------------------------------------------------------------------
+IMdIdArray *
+CMDAccessor::GetAccessedMDIds(CMemoryPool *mp)
+{
+	ULONG nentries = m_shtCacheAccessors.Size();
+	IMDId **mdids;
+	CAutoRg<IMDId *> aMDIds;
+	ULONG ul;
+
+	// as in Serialize(), don't allocate memory while iterating
+	mdids = GPOS_NEW_ARRAY(m_mp, IMDId *, nentries);
+	aMDIds = mdids;
+	{
+		MDHTIter mdhtit(m_shtCacheAccessors);
+		ul = 0;
+		while (mdhtit.Advance())
+		{
+			MDHTIterAccessor mdhtitacc(mdhtit);
+			SMDAccessorElem *pmdaccelem = mdhtitacc.Value();
+			GPOS_ASSERT(nullptr != pmdaccelem);
+			mdids[ul++] = pmdaccelem->MDId();
+		}
+		GPOS_ASSERT(ul == nentries);
+	}
+
+	IMdIdArray *pdrgpmdid = GPOS_NEW(mp) IMdIdArray(mp, nentries);
+	for (ul = 0; ul < nentries; ul++)
+	{
+		mdids[ul]->AddRef();
+		pdrgpmdid->Append(mdids[ul]);
+	}
+
+	return pdrgpmdid;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::SerializeSysid
@@ -24,6 +24,34 @@ CMDAccessor::MDCache *CMDCache::m_pcache = nullptr;
 // maximum size of the cache
 ULLONG CMDCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
 
+// counters of the cache instances destroyed earlier
+ULLONG CMDCache::m_ullHitsBeforeReset = 0;
+ULLONG CMDCache::m_ullMissesBeforeReset = 0;
+ULLONG CMDCache::m_ullEvictionsBeforeReset = 0;
+ULLONG CMDCache::m_ullInvalidationsBeforeReset = 0;
+
+// number of times the cache was reset
+ULLONG CMDCache::m_ullResetCounter = 0;
+
+// function telling whether a metadata id is stale, used while invalidating
+static BOOL (*pfnMDIdInvalid)(const IMDId *) = nullptr;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FMDKeyInvalid
+//
+//	@doc:
+//		Is the metadata id of the given cache key stale?
+//
+//---------------------------------------------------------------------------
+static BOOL
+FMDKeyInvalid(CMDKey *const &pmdkey)
+{
+	GPOS_ASSERT(nullptr != pfnMDIdInvalid);
+
+	return pfnMDIdInvalid(pmdkey->MDId());
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Init
@@ -54,6 +82,14 @@ CMDCache::Init()
 void
 CMDCache::Shutdown()
 {
+	if (nullptr != m_pcache)
+	{
+		m_ullHitsBeforeReset += m_pcache->GetHitCounter();
+		m_ullMissesBeforeReset += m_pcache->GetMissCounter();
+		m_ullEvictionsBeforeReset += m_pcache->GetEvictionCounter();
+		m_ullInvalidationsBeforeReset += m_pcache->GetInvalidationCounter();
+	}
+
 	GPOS_DELETE(m_pcache);
 	m_pcache = nullptr;
 }
@@ -103,10 +139,105 @@ CMDCache::ULLGetCacheQuota()
 ULLONG
 CMDCache::ULLGetCacheEvictionCounter()
 {
-	// make sure that we already initialized our underlying CCache
-	GPOS_ASSERT(nullptr != m_pcache);
+	if (nullptr == m_pcache)
+	{
+		return m_ullEvictionsBeforeReset;
+	}
+
+	return m_ullEvictionsBeforeReset + m_pcache->GetEvictionCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheHitCounter
+//
+//	@doc:
+// 		Get the number of lookups that found an object in this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheHitCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullHitsBeforeReset;
+	}
+
+	return m_ullHitsBeforeReset + m_pcache->GetHitCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheMissCounter
+//
+//	@doc:
+// 		Get the number of lookups that did not find an object in this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheMissCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullMissesBeforeReset;
+	}
 
-	return m_pcache->GetEvictionCounter();
+	return m_ullMissesBeforeReset + m_pcache->GetMissCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheInvalidationCounter
+//
+//	@doc:
+// 		Get the number of objects evicted because they became stale
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheInvalidationCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullInvalidationsBeforeReset;
+	}
+
+	return m_ullInvalidationsBeforeReset + m_pcache->GetInvalidationCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheResetCounter
+//
+//	@doc:
+// 		Get the number of times the cache was reset
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheResetCounter()
+{
+	return m_ullResetCounter;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::Invalidate
+//
+//	@doc:
+//		Evict the objects whose metadata ids are stale. Objects that are
+//		still in use are evicted once they are released.
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::Invalidate(BOOL (*pfnInvalid)(const IMDId *))
+{
+	GPOS_ASSERT(nullptr != m_pcache && "Metadata cache was not created");
+	GPOS_ASSERT(nullptr != pfnInvalid);
+
+	pfnMDIdInvalid = pfnInvalid;
+	ULLONG ullEvicted = m_pcache->EvictInvalidEntries(FMDKeyInvalid);
+	pfnMDIdInvalid = nullptr;
+
+	return ullEvicted;
 }
 
 //---------------------------------------------------------------------------
@@ -120,6 +251,8 @@ CMDCache::ULLGetCacheEvictionCounter()
 void
 CMDCache::Reset()
 {
+	m_ullResetCounter++;
+
 	Shutdown();
 	Init();
 }
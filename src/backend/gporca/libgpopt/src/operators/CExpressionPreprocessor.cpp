@@ -2854,14 +2854,35 @@ CExpressionPreprocessor::PrunePartitions(CMemoryPool *mp, CExpression *expr)
 
 		IMdIdArray *foreign_server_mdids = GPOS_NEW(mp) IMdIdArray(mp);
 		IMdIdArray *all_partition_mdids = dyn_get->GetPartitionMdids();
+
+		// if the root has the part constraints of all its partitions in
+		// terms of its own columns, use those, so that only the partitions
+		// that survive are ever retrieved
+		const IMDRelation *root_rel =
+			mda->RetrieveRel(dyn_get->Ptabdesc()->MDId());
+		CDXLNodeArray *child_part_constraints = nullptr;
+		if (all_partition_mdids == root_rel->ChildPartitionMdids())
+		{
+			child_part_constraints = root_rel->ChildPartConstraints();
+		}
+
 		for (ULONG ul = 0; ul < all_partition_mdids->Size(); ++ul)
 		{
 			IMDId *part_mdid = (*all_partition_mdids)[ul];
-			const IMDRelation *partrel = mda->RetrieveRel(part_mdid);
 
-			CConstraint *rel_cnstr = PcnstrFromChildPartition(
-				partrel, dyn_get->PdrgpcrOutput(),
-				(*dyn_get->GetRootColMappingPerPart())[ul]);
+			CConstraint *rel_cnstr = nullptr;
+			if (nullptr != child_part_constraints)
+			{
+				rel_cnstr = PcnstrFromPartConstraint(
+					(*child_part_constraints)[ul], dyn_get->PdrgpcrOutput(),
+					nullptr /* colids */);
+			}
+			else
+			{
+				rel_cnstr = PcnstrFromChildPartition(
+					mda->RetrieveRel(part_mdid), dyn_get->PdrgpcrOutput(),
+					(*dyn_get->GetRootColMappingPerPart())[ul]);
+			}
 
 			CConstraint *pcnstr = nullptr;
 			{
@@ -2873,6 +2894,7 @@ CExpressionPreprocessor::PrunePartitions(CMemoryPool *mp, CExpression *expr)
 				}
 				if (rel_cnstr != nullptr)
 				{
+					rel_cnstr->AddRef();
 					preds->Append(rel_cnstr);
 				}
 				pcnstr = CConstraint::PcnstrConjunction(mp, preds);
@@ -2888,14 +2910,13 @@ CExpressionPreprocessor::PrunePartitions(CMemoryPool *mp, CExpression *expr)
 				foreign_server_mdids->Append(foreign_server_mdid);
 				part_mdid->AddRef();
 				selected_partition_mdids->Append(part_mdid);
-				rel_cnstr = PcnstrFromChildPartition(
-					partrel, dyn_get->PdrgpcrOutput(),
-					(*dyn_get->GetRootColMappingPerPart())[ul]);
 				if (rel_cnstr)
 				{
+					rel_cnstr->AddRef();
 					selected_partition_cnstrs->Append(rel_cnstr);
 				}
 			}
+			CRefCount::SafeRelease(rel_cnstr);
 			CRefCount::SafeRelease(pcnstr);
 		}
 		CRefCount::SafeRelease(pred_cnstr);
@@ -2959,11 +2980,8 @@ CExpressionPreprocessor::PcnstrFromChildPartition(
 	const IMDRelation *partrel, CColRefArray *pdrgpcrOutput,
 	ColRefToUlongMap *root_col_mapping)
 {
-	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
 	CMemoryPool *mp = COptCtxt::PoctxtFromTLS()->Pmp();
 
-	CExpression *part_constraint_expr = nullptr;
-
 	CDXLNode *dxlnode = partrel->MDPartConstraint();
 
 	if (nullptr == dxlnode)
@@ -2987,11 +3005,28 @@ CExpressionPreprocessor::PcnstrFromChildPartition(
 		mapped_colids->Append(GPOS_NEW(mp) ULONG(*colid));
 	}
 
-	CTranslatorDXLToExpr dxltr(mp, md_accessor);
-	part_constraint_expr =
-		dxltr.PexprTranslateScalar(dxlnode, pdrgpcrOutput, mapped_colids);
+	CConstraint *cnstr =
+		PcnstrFromPartConstraint(dxlnode, pdrgpcrOutput, mapped_colids);
 	mapped_colids->Release();
 
+	return cnstr;
+}
+
+// Translate a part constraint into a constraint over the given colrefs. The
+// colids of the part constraint index into colids if given, or else directly
+// into the colrefs.
+CConstraint *
+CExpressionPreprocessor::PcnstrFromPartConstraint(const CDXLNode *dxlnode,
+												  CColRefArray *pdrgpcrOutput,
+												  ULongPtrArray *colids)
+{
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+	CMemoryPool *mp = COptCtxt::PoctxtFromTLS()->Pmp();
+
+	CTranslatorDXLToExpr dxltr(mp, md_accessor);
+	CExpression *part_constraint_expr =
+		dxltr.PexprTranslateScalar(dxlnode, pdrgpcrOutput, colids);
+
 	GPOS_ASSERT(CUtils::FPredicate(part_constraint_expr));
 
 	CColRefSetArray *pdrgpcrsChild = nullptr;
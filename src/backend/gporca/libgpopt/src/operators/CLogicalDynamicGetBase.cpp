@@ -82,8 +82,6 @@ CLogicalDynamicGetBase::CLogicalDynamicGetBase(
 	m_ptabdesc->Insert(ptabdesc);
 
 	m_pcrsDist = CLogical::PcrsDist(mp, Ptabdesc(), m_pdrgpcrOutput);
-	m_root_col_mapping_per_part =
-		ConstructRootColMappingPerPart(mp, m_pdrgpcrOutput, m_partition_mdids);
 }
 
 
@@ -119,9 +117,6 @@ CLogicalDynamicGetBase::CLogicalDynamicGetBase(CMemoryPool *mp,
 	m_pdrgpdrgpcrPart = PdrgpdrgpcrCreatePartCols(mp, m_pdrgpcrOutput,
 												  Ptabdesc()->PdrgpulPart());
 	m_pcrsDist = CLogical::PcrsDist(mp, Ptabdesc(), m_pdrgpcrOutput);
-
-	m_root_col_mapping_per_part =
-		ConstructRootColMappingPerPart(mp, m_pdrgpcrOutput, m_partition_mdids);
 }
 
 //---------------------------------------------------------------------------
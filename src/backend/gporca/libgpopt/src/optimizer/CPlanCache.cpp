@@ -0,0 +1,483 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CPlanCache.cpp
+//
+//	@doc:
+//		Function implementation of CPlanCache
+//---------------------------------------------------------------------------
+
+#include "gpopt/optimizer/CPlanCache.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/memory/CCacheFactory.h"
+
+using namespace gpos;
+using namespace gpmd;
+using namespace gpopt;
+
+// global instance of plan cache
+CPlanCache::PlanCache *CPlanCache::m_pcache = nullptr;
+
+// maximum size of the cache
+ULLONG CPlanCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
+
+// counters of the cache instances destroyed earlier
+ULLONG CPlanCache::m_ullHitsBeforeReset = 0;
+ULLONG CPlanCache::m_ullMissesBeforeReset = 0;
+ULLONG CPlanCache::m_ullEvictionsBeforeReset = 0;
+ULLONG CPlanCache::m_ullInvalidationsBeforeReset = 0;
+
+// number of times the cache was reset
+ULLONG CPlanCache::m_ullResetCounter = 0;
+
+// optimization time saved by cache hits
+CDouble CPlanCache::m_dSavedTime(0.0);
+
+// function telling whether a metadata id is stale, used while invalidating
+static BOOL (*pfnMDIdInvalid)(const IMDId *) = nullptr;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FPlanKeyInvalid
+//
+//	@doc:
+//		Does the plan of the given cache key depend on a stale metadata id?
+//
+//---------------------------------------------------------------------------
+static BOOL
+FPlanKeyInvalid(CPlanCacheKey *const &pkey)
+{
+	GPOS_ASSERT(nullptr != pfnMDIdInvalid);
+
+	const IMdIdArray *mdids = pkey->MDIds();
+	GPOS_ASSERT(nullptr != mdids);
+
+	const ULONG size = mdids->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (pfnMDIdInvalid((*mdids)[ul]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheKey::CPlanCacheKey
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CPlanCacheKey::CPlanCacheKey(const CWStringBase *query,
+							 const IMdIdArray *mdids)
+	: m_query(query), m_hash(0), m_mdids(mdids)
+{
+	GPOS_ASSERT(nullptr != query);
+
+	// hash the query the way CWStringConst does
+	const WCHAR *buffer = query->GetBuffer();
+	m_hash = HashByteArray((const BYTE *) buffer,
+						   query->Length() * GPOS_SIZEOF(WCHAR));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheKey::FEqualPlanKey
+//
+//	@doc:
+//		Equality function for using plan keys in a cache
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanCacheKey::FEqualPlanKey(CPlanCacheKey *const &pkeyLeft,
+							 CPlanCacheKey *const &pkeyRight)
+{
+	if (nullptr == pkeyLeft || nullptr == pkeyRight)
+	{
+		return pkeyLeft == pkeyRight;
+	}
+
+	return pkeyLeft->m_hash == pkeyRight->m_hash &&
+		   pkeyLeft->m_query->Equals(pkeyRight->m_query);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheKey::UlHashPlanKey
+//
+//	@doc:
+//		Hash function for using plan keys in a cache
+//
+//---------------------------------------------------------------------------
+ULONG
+CPlanCacheKey::UlHashPlanKey(CPlanCacheKey *const &pkey)
+{
+	return pkey->m_hash;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::CPlanCacheEntry
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CPlanCacheEntry::CPlanCacheEntry(BYTE *plan, ULONG plan_size,
+								 CDouble optimization_time)
+	: m_plan(plan),
+	  m_plan_size(plan_size),
+	  m_optimization_time(optimization_time)
+{
+	GPOS_ASSERT(nullptr != plan);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheEntry::~CPlanCacheEntry
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CPlanCacheEntry::~CPlanCacheEntry()
+{
+	GPOS_DELETE_ARRAY(m_plan);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Init
+//
+//	@doc:
+//		Initializes global instance
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Init()
+{
+	GPOS_ASSERT(nullptr == m_pcache && "Plan cache was already created");
+
+	m_pcache = CCacheFactory::CreateCache<CPlanCacheEntry *, CPlanCacheKey *>(
+		true /*fUnique*/, m_ullCacheQuota, CPlanCacheKey::UlHashPlanKey,
+		CPlanCacheKey::FEqualPlanKey);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Shutdown
+//
+//	@doc:
+//		Cleans up the underlying cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Shutdown()
+{
+	if (nullptr != m_pcache)
+	{
+		m_ullHitsBeforeReset += m_pcache->GetHitCounter();
+		m_ullMissesBeforeReset += m_pcache->GetMissCounter();
+		m_ullEvictionsBeforeReset += m_pcache->GetEvictionCounter();
+		m_ullInvalidationsBeforeReset += m_pcache->GetInvalidationCounter();
+	}
+
+	GPOS_DELETE(m_pcache);
+	m_pcache = nullptr;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Reset
+//
+//	@doc:
+//		Reset plan cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Reset()
+{
+	m_ullResetCounter++;
+
+	Shutdown();
+	Init();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::SetCacheQuota
+//
+//	@doc:
+//		Set the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::SetCacheQuota(ULLONG ullCacheQuota)
+{
+	GPOS_ASSERT(nullptr != m_pcache && "Plan cache was not created");
+	m_ullCacheQuota = ullCacheQuota;
+	m_pcache->SetCacheQuota(ullCacheQuota);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheQuota
+//
+//	@doc:
+//		Get the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheQuota()
+{
+	GPOS_ASSERT_IMP(nullptr != m_pcache,
+					m_pcache->GetCacheQuota() == m_ullCacheQuota);
+	return m_ullCacheQuota;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::PbLookup
+//
+//	@doc:
+//		Look up the plan of the given query. On a hit, return a copy of the
+//		serialized plan allocated in the given pool, its size, and the time
+//		it took to optimize it.
+//
+//---------------------------------------------------------------------------
+BYTE *
+CPlanCache::PbLookup(CMemoryPool *mp, const CWStringBase *pstrQuery,
+					 ULONG *pulPlanSize, CDouble *pdOptimizationTime)
+{
+	GPOS_ASSERT(nullptr != m_pcache && "Plan cache was not created");
+	GPOS_ASSERT(nullptr != pulPlanSize);
+	GPOS_ASSERT(nullptr != pdOptimizationTime);
+
+	BYTE *pbPlan = nullptr;
+	CPlanCacheKey key(pstrQuery, nullptr /*mdids*/);
+
+	PlanCacheAccessor pcacc(m_pcache);
+	pcacc.Lookup(&key);
+
+	CPlanCacheEntry *pentry = pcacc.Val();
+	if (nullptr != pentry)
+	{
+		*pulPlanSize = pentry->PlanSize();
+		pbPlan = GPOS_NEW_ARRAY(mp, BYTE, *pulPlanSize);
+		clib::Memcpy(pbPlan, pentry->Plan(), *pulPlanSize);
+		*pdOptimizationTime = pentry->OptimizationTime();
+	}
+
+	return pbPlan;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Insert
+//
+//	@doc:
+//		Add the plan of the given query to the cache. Keys, plans and
+//		metadata ids are copied into the memory pool of the cache entry.
+//		A plan that was added in the meantime is kept.
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Insert(const CWStringBase *pstrQuery, const IMdIdArray *mdids,
+				   const BYTE *pbPlan, ULONG ulPlanSize,
+				   CDouble dOptimizationTime)
+{
+	GPOS_ASSERT(nullptr != m_pcache && "Plan cache was not created");
+	GPOS_ASSERT(nullptr != mdids);
+	GPOS_ASSERT(nullptr != pbPlan);
+
+	PlanCacheAccessor pcacc(m_pcache);
+	CMemoryPool *mp = pcacc.Pmp();
+
+	IMdIdArray *mdidsCopy = GPOS_NEW(mp) IMdIdArray(mp);
+	const ULONG size = mdids->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		mdidsCopy->Append((*mdids)[ul]->Copy(mp));
+	}
+
+	CAutoP<CPlanCacheKey> a_pkey;
+	a_pkey = GPOS_NEW(mp) CPlanCacheKey(
+		GPOS_NEW(mp) CWStringConst(mp, pstrQuery->GetBuffer()), mdidsCopy);
+
+	BYTE *pbPlanCopy = GPOS_NEW_ARRAY(mp, BYTE, ulPlanSize);
+	clib::Memcpy(pbPlanCopy, pbPlan, ulPlanSize);
+	CPlanCacheEntry *pentry = GPOS_NEW(mp)
+		CPlanCacheEntry(pbPlanCopy, ulPlanSize, dOptimizationTime);
+
+	// the entry gets pinned whether the insertion succeeded or the query was
+	// inserted in the meantime
+	CPlanCacheEntry *pentryInserted GPOS_ASSERTS_ONLY =
+		pcacc.Insert(a_pkey.Value(), pentry);
+	GPOS_ASSERT(nullptr != pentryInserted);
+
+	// the cache keeps its own reference
+	pentry->Release();
+
+	// safely inserted
+	(void) a_pkey.Reset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Invalidate
+//
+//	@doc:
+//		Evict the plans depending on stale metadata objects. Plans that are
+//		still in use are evicted once they are released.
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::Invalidate(BOOL (*pfnInvalid)(const IMDId *))
+{
+	GPOS_ASSERT(nullptr != m_pcache && "Plan cache was not created");
+	GPOS_ASSERT(nullptr != pfnInvalid);
+
+	pfnMDIdInvalid = pfnInvalid;
+	ULLONG ullEvicted = m_pcache->EvictInvalidEntries(FPlanKeyInvalid);
+	pfnMDIdInvalid = nullptr;
+
+	return ullEvicted;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheEntries
+//
+//	@doc:
+// 		Get the number of plans in the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheEntries()
+{
+	if (nullptr == m_pcache)
+	{
+		return 0;
+	}
+
+	return m_pcache->Size();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheSize
+//
+//	@doc:
+// 		Get the size of the plans in the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheSize()
+{
+	if (nullptr == m_pcache)
+	{
+		return 0;
+	}
+
+	return m_pcache->TotalAllocatedSize();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheHitCounter
+//
+//	@doc:
+// 		Get the number of lookups that found a plan in this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheHitCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullHitsBeforeReset;
+	}
+
+	return m_ullHitsBeforeReset + m_pcache->GetHitCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheMissCounter
+//
+//	@doc:
+// 		Get the number of lookups that did not find a plan in this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheMissCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullMissesBeforeReset;
+	}
+
+	return m_ullMissesBeforeReset + m_pcache->GetMissCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheEvictionCounter
+//
+//	@doc:
+// 		Get the number of times we evicted plans from this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheEvictionCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullEvictionsBeforeReset;
+	}
+
+	return m_ullEvictionsBeforeReset + m_pcache->GetEvictionCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheInvalidationCounter
+//
+//	@doc:
+// 		Get the number of plans evicted because they became stale
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheInvalidationCounter()
+{
+	if (nullptr == m_pcache)
+	{
+		return m_ullInvalidationsBeforeReset;
+	}
+
+	return m_ullInvalidationsBeforeReset + m_pcache->GetInvalidationCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheResetCounter
+//
+//	@doc:
+// 		Get the number of times the cache was reset
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheResetCounter()
+{
+	return m_ullResetCounter;
+}
+
+// EOF
@@ -54,6 +54,7 @@ CGroupExpression::CGroupExpression(CMemoryPool *mp, COperator *pop,
 								   BOOL fIntermediate)
 	: m_pgexprDuplicate(nullptr),
 	  m_pop(pop),
+	  m_ulOpHash(pop->HashValue()),
 	  m_pdrgpgroup(pdrgpgroup),
 
 	  m_exfidOrigin(exfid),
@@ -751,6 +752,46 @@ CGroupExpression::PostprocessTransform(CMemoryPool *,  // pmpLocal
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::FImplementable
+//
+//	@doc:
+//		Can one of the given implementation xforms apply to the group
+//		expression, judging by its promise? Physical group expressions are
+//		implemented already
+//
+//---------------------------------------------------------------------------
+BOOL
+CGroupExpression::FImplementable(CMemoryPool *mp, CXformSet *xform_set)
+{
+	if (!m_pop->FLogical())
+	{
+		return true;
+	}
+
+	CXformSet *pxfsCandidates = CLogical::PopConvert(m_pop)->PxfsCandidates(mp);
+	pxfsCandidates->Intersection(CXformFactory::Pxff()->PxfsImplementation());
+	pxfsCandidates->Intersection(xform_set);
+
+	CExpressionHandle exprhdl(mp);
+	exprhdl.Attach(this);
+	exprhdl.DeriveProps(nullptr /*pdpctxt*/);
+
+	BOOL fImplementable = false;
+	CXformSetIter xsi(*pxfsCandidates);
+	while (!fImplementable && xsi.Advance())
+	{
+		CXform *pxform = CXformFactory::Pxff()->Pxf(xsi.TBit());
+		fImplementable = !GPOPT_FDISABLED_XFORM(pxform->Exfid()) &&
+						 CXform::ExfpNone != pxform->Exfp(exprhdl);
+	}
+	pxfsCandidates->Release();
+
+	return fImplementable;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroupExpression::Transform
@@ -899,8 +940,17 @@ CGroupExpression::Matches(const CGroupExpression *pgexpr) const
 		return false;
 	}
 
-	// match operators
-	if (!m_pop->Matches(pgexpr->m_pop))
+	// match operators; operators interned by the memo match if and only if
+	// they have the same id, otherwise fall back to comparing them
+	if (gpos::ulong_max != m_ulOpId && gpos::ulong_max != pgexpr->m_ulOpId)
+	{
+		if (m_ulOpId != pgexpr->m_ulOpId)
+		{
+			return false;
+		}
+	}
+	else if (m_ulOpHash != pgexpr->m_ulOpHash ||
+			 !m_pop->Matches(pgexpr->m_pop))
 	{
 		return false;
 	}
@@ -943,9 +993,25 @@ ULONG
 CGroupExpression::HashValue(COperator *pop, CGroupArray *pdrgpgroup)
 {
 	GPOS_ASSERT(nullptr != pop);
+
+	return HashValue(pop->HashValue(), pdrgpgroup);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::HashValue
+//
+//	@doc:
+//		Combine the hash value of an operator with its child groups
+//
+//---------------------------------------------------------------------------
+ULONG
+CGroupExpression::HashValue(ULONG ulOpHash, CGroupArray *pdrgpgroup)
+{
 	GPOS_ASSERT(nullptr != pdrgpgroup);
 
-	ULONG ulHash = pop->HashValue();
+	ULONG ulHash = ulOpHash;
 
 	ULONG arity = pdrgpgroup->Size();
 	for (ULONG i = 0; i < arity; i++)
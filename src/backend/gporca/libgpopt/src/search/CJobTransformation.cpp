@@ -15,6 +15,7 @@
 #include "gpopt/operators/CLogical.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupExpression.h"
+#include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CJobFactory.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
@@ -111,6 +112,40 @@ CJobTransformation::Init(CGroupExpression *pgexpr, CXform *pxform)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTransformation::FGroupImplementable
+//
+//	@doc:
+//		Does the group have a group expression that an implementation xform
+//		of the given set can apply to?
+//
+//---------------------------------------------------------------------------
+BOOL
+CJobTransformation::FGroupImplementable(CMemoryPool *mp, CGroup *pgroup,
+										CXformSet *xform_set)
+{
+	CGroupExpression *pgexpr = nullptr;
+	{
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprFirst();
+	}
+
+	while (nullptr != pgexpr)
+	{
+		if (pgexpr->FImplementable(mp, xform_set))
+		{
+			return true;
+		}
+
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprNext(pgexpr);
+	}
+
+	return false;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobTransformation::EevtTransform
@@ -129,6 +164,18 @@ CJobTransformation::EevtTransform(CSchedulerContext *psc, CJob *pjOwner)
 	CGroupExpression *pgexpr = pjt->m_pgexpr;
 	CXform *pxform = pjt->m_xform;
 
+	// once the optimization budget ran out, stop exploring and only
+	// implement the alternatives found so far; exploration goes on in the
+	// groups that have no alternative to implement yet, such as n-ary joins
+	// and selects with subqueries
+	if (pxform->FExploration() && psc->Peng()->FBudgetExhausted() &&
+		!CXform::FRequiredForPlan(pxform->Exfid()) &&
+		FGroupImplementable(pmpLocal, pgexpr->Pgroup(),
+							psc->Peng()->PxfsCurrentStage()))
+	{
+		return eevCompleted;
+	}
+
 	// insert transformation results to memo
 	CXformResult *pxfres = GPOS_NEW(pmpGlobal) CXformResult(pmpGlobal);
 	ULONG ulElapsedTime = 0;
@@ -15,6 +15,7 @@
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CSyncHashtableAccessByIter.h"
 #include "gpos/common/CSyncHashtableAccessByKey.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
@@ -34,6 +35,9 @@ using namespace gpopt;
 
 #define GPOPT_MEMO_HT_BUCKETS 50000
 
+// number of hash chains of the operator intern table
+#define GPOPT_MEMO_OP_HT_CHAINS 4099
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::CMemo
@@ -47,7 +51,8 @@ CMemo::CMemo(CMemoryPool *mp)
 	  m_aul(0),
 	  m_pgroupRoot(nullptr),
 	  m_ulpGrps(0),
-	  m_pmemotmap(nullptr)
+	  m_pmemotmap(nullptr),
+	  m_fStatsTiming(GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 {
 	GPOS_ASSERT(nullptr != mp);
 
@@ -58,6 +63,8 @@ CMemo::CMemo(CMemoryPool *mp)
 		CGroupExpression::Equals);
 
 	m_listGroups.Init(GPOS_OFFSET(CGroup, m_link));
+
+	m_popidmap = GPOS_NEW(mp) OpIdMap(mp, GPOPT_MEMO_OP_HT_CHAINS);
 }
 
 
@@ -81,6 +88,7 @@ CMemo::~CMemo()
 	}
 
 	GPOS_DELETE(m_pmemotmap);
+	m_popidmap->Release();
 }
 
 
@@ -153,6 +161,45 @@ CMemo::Add(
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::InternOperator
+//
+//	@doc:
+//		Assign the id of its interned operator to a group expression,
+//		interning the operator if no matching one was seen before;
+//
+//		operators match if and only if their ids are equal, so comparing
+//		group expressions in the memo hash table takes comparing ids and
+//		child groups only. Scalar subtrees are memo groups, so this also
+//		turns comparing scalar children into comparing groups
+//
+//---------------------------------------------------------------------------
+void
+CMemo::InternOperator(CGroupExpression *pgexpr)
+{
+	GPOS_ASSERT(nullptr != pgexpr);
+
+	if (gpos::ulong_max != pgexpr->UlOpId())
+	{
+		return;
+	}
+
+	SInternedOp io = {pgexpr->Pop(), pgexpr->UlOpHash()};
+	ULONG *pulOpId = m_popidmap->Find(&io);
+	if (nullptr == pulOpId)
+	{
+		pulOpId = GPOS_NEW(m_mp) ULONG(m_popidmap->Size());
+		pgexpr->Pop()->AddRef();
+		BOOL fInserted GPOS_ASSERTS_ONLY = m_popidmap->Insert(
+			GPOS_NEW(m_mp) SInternedOp(io), pulOpId);
+		GPOS_ASSERT(fInserted);
+	}
+
+	pgexpr->SetOpId(*pulOpId);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::PgroupInsert
@@ -243,10 +290,25 @@ CMemo::PgroupInsert(CGroup *pgroupTarget, CExpression *pexprOrigin,
 
 	CGroup *pgroupContainer = nullptr;
 	CGroupExpression *pgexprFound = nullptr;
-	// hash table accessor's scope
 	{
-		ShtAcc shta(m_sht, *pgexpr);
-		pgexprFound = shta.Find();
+		CWallClock clock(m_fStatsTiming);
+		InternOperator(pgexpr);
+
+		// hash table accessor's scope
+		{
+			ShtAcc shta(m_sht, *pgexpr);
+			pgexprFound = shta.Find();
+		}
+
+		m_ulLookups++;
+		if (nullptr != pgexprFound)
+		{
+			m_ulDuplicatesFound++;
+		}
+		if (m_fStatsTiming)
+		{
+			m_ullDedupTime += clock.ElapsedUS();
+		}
 	}
 
 	// check if we may need to create a new group
@@ -462,7 +524,7 @@ CMemo::MarkDuplicates(CGroup *pgroupFst, CGroup *pgroupSnd)
 //		CMemo::FRehash
 //
 //	@doc:
-//		Delete then re-insert all group expressions in memo hash table;
+//		Delete then re-insert group expressions in memo hash table;
 //		we do this at the end of exploration phase since identified
 //		duplicate groups during exploration may cause changing hash values
 //		of current group expressions,
@@ -470,6 +532,12 @@ CMemo::MarkDuplicates(CGroup *pgroupFst, CGroup *pgroupSnd)
 //		identifying duplicate group expressions that can be skipped from
 //		further processing;
 //
+//		the hash value of a group expression, and whether it matches
+//		another one, depend on its operator and its child groups only, and
+//		of those only groups with a duplicate change them; hence only the
+//		group expressions having such a child group are re-inserted, the
+//		others stay in the hash table as they are;
+//
 //		the function returns TRUE if rehashing resulted in discovering
 //		new duplicate groups;
 //
@@ -488,6 +556,7 @@ CMemo::FRehash()
 	CList<CGroupExpression> listGExprs;
 	listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkMemo));
 
+	CWallClock clock(m_fStatsTiming);
 	ShtIter shtit(m_sht);
 	CGroupExpression *pgexpr = nullptr;
 	while (nullptr != pgexpr || shtit.Advance())
@@ -495,11 +564,16 @@ CMemo::FRehash()
 		{
 			ShtAccIter shtitacc(shtit);
 			pgexpr = shtitacc.Value();
-			if (nullptr != pgexpr)
+			if (nullptr != pgexpr && FDuplicateChildGroup(pgexpr))
 			{
 				shtitacc.Remove(pgexpr);
 				listGExprs.Append(pgexpr);
 			}
+			else
+			{
+				// keep the group expression, and advance the iterator
+				pgexpr = nullptr;
+			}
 		}
 		GPOS_CHECK_ABORT;
 	}
@@ -511,6 +585,7 @@ CMemo::FRehash()
 	{
 		CGroupExpression *pgexpr = listGExprs.RemoveHead();
 		CGroupExpression *pgexprFound = nullptr;
+		m_ulRehashed++;
 
 		{
 			// hash table accessor scope
@@ -555,10 +630,42 @@ CMemo::FRehash()
 		GPOS_CHECK_ABORT;
 	}
 
+	if (m_fStatsTiming)
+	{
+		m_ullDedupTime += clock.ElapsedUS();
+	}
+
 	return fNewDupGroups;
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::FDuplicateChildGroup
+//
+//	@doc:
+//		Check if any child group of a group expression has a duplicate
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemo::FDuplicateChildGroup(CGroupExpression *pgexpr)
+{
+	GPOS_ASSERT(nullptr != pgexpr);
+
+	CGroupArray *pdrgpgroup = pgexpr->Pdrgpgroup();
+	const ULONG arity = pdrgpgroup->Size();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		if ((*pdrgpgroup)[ul]->FDuplicateGroup())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::GroupMerge
@@ -620,6 +727,32 @@ CMemo::Trace()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::OsPrintDedupStats
+//
+//	@doc:
+//		Print the cost of duplicate detection since the last call, and
+//		reset it
+//
+//---------------------------------------------------------------------------
+IOstream &
+CMemo::OsPrintDedupStats(IOstream &os, ULONG ulSearchStage)
+{
+	os << "[OPT]: Memo dedup (stage " << ulSearchStage << "): ["
+	   << m_ulLookups << " lookups, " << m_ulDuplicatesFound
+	   << " duplicates found, " << m_ulRehashed
+	   << " group expressions rehashed, " << m_ullDedupTime << "us]";
+
+	m_ulLookups = 0;
+	m_ulDuplicatesFound = 0;
+	m_ulRehashed = 0;
+	m_ullDedupTime = 0;
+
+	return os;
+}
+
+
 FORCE_GENERATE_DBGSTR(gpopt::CMemo);
 
 //---------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "gpopt/search/CScheduler.h"
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CAutoTrace.h"
 
 #include "gpopt/search/CJobFactory.h"
@@ -20,6 +21,18 @@
 
 using namespace gpopt;
 
+// job type names, for printing statistics
+static const WCHAR *rgwszJobTypes[] = {
+	GPOS_WSZ_LIT("Test"),
+	GPOS_WSZ_LIT("GroupOptimization"),
+	GPOS_WSZ_LIT("GroupImplementation"),
+	GPOS_WSZ_LIT("GroupExploration"),
+	GPOS_WSZ_LIT("GroupExpressionOptimization"),
+	GPOS_WSZ_LIT("GroupExpressionImplementation"),
+	GPOS_WSZ_LIT("GroupExpressionExploration"),
+	GPOS_WSZ_LIT("Transformation"),
+};
+
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -44,12 +57,20 @@ CScheduler::CScheduler(CMemoryPool *mp, ULONG ulJobs
 	  m_ulpStatsSuspended(0),
 	  m_ulpStatsCompleted(0),
 	  m_ulpStatsCompletedQueued(0),
-	  m_ulpStatsResumed(0)
+	  m_ulpStatsResumed(0),
+	  m_ulpStatsMaxQueued(0),
+	  m_fStatsTiming(GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 #ifdef GPOS_DEBUG
 	  ,
 	  m_fTrackingJobs(fTrackingJobs)
 #endif	// GPOS_DEBUG
 {
+	for (ULONG ul = 0; ul < CJob::EjtSentinel; ul++)
+	{
+		m_rgulpStatsExecuted[ul] = 0;
+		m_rgullStatsTimeUS[ul] = 0;
+	}
+
 	// initialize pool of job links
 	m_spjl.Init(GPOS_OFFSET(SJobLink, m_id));
 
@@ -120,8 +141,16 @@ CScheduler::ExecuteJobs(CSchedulerContext *psc)
 		PreExecute(pj);
 
 		// execute job
+		CJob::EJobType ejt = pj->Ejt();
+		CWallClock clock(m_fStatsTiming);
 		BOOL fCompleted = FExecute(pj, psc);
 
+		m_rgulpStatsExecuted[ejt]++;
+		if (m_fStatsTiming)
+		{
+			m_rgullStatsTimeUS[ejt] += clock.ElapsedUS();
+		}
+
 #ifdef GPOS_DEBUG
 		// restrict parallelism to keep track of jobs
 		if (FTrackingJobs())
@@ -261,6 +290,7 @@ CScheduler::Schedule(CJob *pj)
 
 	// update statistics
 	m_ulpStatsQueued++;
+	m_ulpStatsMaxQueued = std::max(m_ulpStatsMaxQueued, m_ulpQueued);
 }
 
 
@@ -567,9 +597,25 @@ CScheduler::PrintStats() const
 {
 	GPOS_TRACE_FORMAT(
 		"Job statistics: Queued=%d Dequeued=%d Suspended=%d "
-		"Resumed=%d CompletedQueued=%d Completed=%d",
+		"Resumed=%d CompletedQueued=%d Completed=%d MaxQueued=%d",
 		m_ulpStatsQueued, m_ulpStatsDequeued, m_ulpStatsSuspended,
-		m_ulpStatsResumed, m_ulpStatsCompletedQueued, m_ulpStatsCompleted);
+		m_ulpStatsResumed, m_ulpStatsCompletedQueued, m_ulpStatsCompleted,
+		m_ulpStatsMaxQueued);
+
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgwszJobTypes) == CJob::EjtSentinel);
+
+	for (ULONG ul = 0; ul < CJob::EjtSentinel; ul++)
+	{
+		if (0 == m_rgulpStatsExecuted[ul])
+		{
+			continue;
+		}
+
+		GPOS_TRACE_FORMAT("Job statistics: %ls Executed=%d Time=%dms",
+						  rgwszJobTypes[ul],
+						  m_rgulpStatsExecuted[ul],
+						  (ULONG)(m_rgullStatsTimeUS[ul] / 1000));
+	}
 }
 
 
@@ -604,8 +604,20 @@ CTranslatorDXLToExpr::PexprLogicalGet(const CDXLNode *dxlnode)
 
 		IMdIdArray *partition_mdids = pmdrel->ChildPartitionMdids();
 		IMdIdArray *foreign_server_mdids = GPOS_NEW(m_mp) IMdIdArray(m_mp);
+
+		// the root only has the part constraints of its partitions if none
+		// of them is partitioned or foreign, so the partitions need not be
+		// retrieved until they survive partition pruning
+		const BOOL fRetrieveParts = (nullptr == pmdrel->ChildPartConstraints());
 		for (ULONG ul = 0; ul < partition_mdids->Size(); ++ul)
 		{
+			if (!fRetrieveParts)
+			{
+				foreign_server_mdids->Append(
+					GPOS_NEW(m_mp) CMDIdGPDB(CMDIdGPDB::m_mdid_invalid_key));
+				continue;
+			}
+
 			IMDId *part_mdid = (*partition_mdids)[ul];
 			const IMDRelation *partrel = m_pmda->RetrieveRel(part_mdid);
 
@@ -1524,8 +1536,12 @@ CTranslatorDXLToExpr::PexprLogicalUpdate(const CDXLNode *dxlnode)
 	{
 		GPOS_ASSERT(EdxlopLogicalUpdate == pdxlopUpdate->GetDXLOperator());
 
+		// no need to check the partitions if the root has their part
+		// constraints, see PexprLogicalGet
 		IMdIdArray *partition_mdids = pmdrel->ChildPartitionMdids();
-		for (ULONG ul = 0; ul < partition_mdids->Size(); ++ul)
+		for (ULONG ul = 0; nullptr == pmdrel->ChildPartConstraints() &&
+						   ul < partition_mdids->Size();
+			 ++ul)
 		{
 			IMDId *part_mdid = (*partition_mdids)[ul];
 			const IMDRelation *partrel = m_pmda->RetrieveRel(part_mdid);
@@ -116,7 +116,13 @@ CJoinOrderDP::CJoinOrderDP(CMemoryPool *mp,
 	m_phmcomplink = GPOS_NEW(mp) ComponentPairToExpressionMap(mp);
 	m_phmbsexpr = GPOS_NEW(mp) BitSetToExpressionMap(mp);
 	m_phmexprcost = GPOS_NEW(mp) ExpressionToCostMap(mp);
+	m_phmsubsetcost = nullptr;
+	if (CJoinAtomSet::FFits(m_ulComps))
+	{
+		m_phmsubsetcost = GPOS_NEW(mp) AtomSetToCostMap(mp);
+	}
 	m_pdrgpexprTopKOrders = GPOS_NEW(mp) CExpressionArray(mp);
+	m_pdTopKCosts = GPOS_NEW_ARRAY(mp, DOUBLE, GPOPT_DP_JOIN_ORDERING_TOPK);
 	m_pexprDummy = GPOS_NEW(mp) CExpression(mp, GPOS_NEW(mp) CPatternLeaf(mp));
 
 #ifdef GPOS_DEBUG
@@ -145,7 +151,9 @@ CJoinOrderDP::~CJoinOrderDP()
 	m_phmcomplink->Release();
 	m_phmbsexpr->Release();
 	m_phmexprcost->Release();
+	CRefCount::SafeRelease(m_phmsubsetcost);
 	m_pdrgpexprTopKOrders->Release();
+	GPOS_DELETE_ARRAY(m_pdTopKCosts);
 	m_pexprDummy->Release();
 }
 
@@ -179,14 +187,12 @@ CJoinOrderDP::AddJoinOrder(CExpression *pexprJoin, CDouble dCost)
 		// we have stored K expressions, evict worst expression
 		for (INT ul = 0; ul < ulResults; ul++)
 		{
-			CExpression *pexpr = (*m_pdrgpexprTopKOrders)[ul];
-			CDouble *pd = m_phmexprcost->Find(pexpr);
-			GPOS_ASSERT(nullptr != pd);
+			CDouble dCostTopK(m_pdTopKCosts[ul]);
 
-			if (dmaxCost < *pd && dCost < *pd)
+			if (dmaxCost < dCostTopK && dCost < dCostTopK)
 			{
 				// found a worse expression
-				dmaxCost = *pd;
+				dmaxCost = dCostTopK;
 				fAddJoinOrder = true;
 				iReplacePos = ul;
 			}
@@ -199,9 +205,11 @@ CJoinOrderDP::AddJoinOrder(CExpression *pexprJoin, CDouble dCost)
 		if (iReplacePos > -1)
 		{
 			m_pdrgpexprTopKOrders->Replace((ULONG) iReplacePos, pexprJoin);
+			m_pdTopKCosts[iReplacePos] = dCost.Get();
 		}
 		else
 		{
+			m_pdTopKCosts[m_pdrgpexprTopKOrders->Size()] = dCost.Get();
 			m_pdrgpexprTopKOrders->Append(pexprJoin);
 		}
 
@@ -489,25 +497,39 @@ CJoinOrderDP::PexprBestJoinOrderDP(CBitSet *pbs	 // set of elements to be joined
 			if (nullptr != pexprLeft && nullptr != pexprRight)
 			{
 				// we found solutions of left and right subsets, we check if
-				// this gives a better solution for the input set
-				CExpression *pexprJoin = PexprJoin(pbsCurrent, pbsRemaining);
-				CDouble dCost = DCost(pexprJoin);
-
-				if (nullptr == pexprResult || dCost < dMinCost)
+				// this gives a better solution for the input set; the cost
+				// is computed from the costs of the subsets like DCost() does,
+				// so that the join is only built if we keep it
+				CDouble dCost = DSubsetCost(pbsCurrent, pexprLeft);
+				DeriveStats(pexprLeft);
+				dCost = dCost + DSubsetCost(pbsRemaining, pexprRight);
+				DeriveStats(pexprRight);
+				dCost = dCost + (pexprLeft->Pstats()->Rows().Get() +
+								 pexprRight->Pstats()->Rows().Get());
+
+				const BOOL fBetter = (nullptr == pexprResult || dCost < dMinCost);
+				const BOOL fTopLevel = (m_ulComps == pbs->Size());
+				if (fBetter || fTopLevel)
 				{
-					// this is the first solution, or we found a better solution
-					dMinCost = dCost;
-					CRefCount::SafeRelease(pexprResult);
-					pexprJoin->AddRef();
-					pexprResult = pexprJoin;
+					CExpression *pexprJoin =
+						PexprJoin(pbsCurrent, pbsRemaining);
+
+					if (fBetter)
+					{
+						// this is the first solution, or we found a better solution
+						dMinCost = dCost;
+						CRefCount::SafeRelease(pexprResult);
+						pexprJoin->AddRef();
+						pexprResult = pexprJoin;
+					}
+
+					if (fTopLevel)
+					{
+						AddJoinOrder(pexprJoin, dCost);
+					}
+
+					pexprJoin->Release();
 				}
-
-				if (m_ulComps == pbs->Size())
-				{
-					AddJoinOrder(pexprJoin, dCost);
-				}
-
-				pexprJoin->Release();
 			}
 		}
 		pbsRemaining->Release();
@@ -657,6 +679,51 @@ CJoinOrderDP::DCost(CExpression *pexpr)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDP::DSubsetCost
+//
+//	@doc:
+//		Cost of the given join order of the given subset, as computed by
+//		DCost(); the cost is cached by subset, so that it is computed once
+//		however many candidate joins the subset is a child of
+//
+//---------------------------------------------------------------------------
+CDouble
+CJoinOrderDP::DSubsetCost(CBitSet *pbs, CExpression *pexpr)
+{
+	GPOS_ASSERT(nullptr != pbs);
+	GPOS_ASSERT(nullptr != pexpr);
+
+	if (nullptr == m_phmsubsetcost)
+	{
+		return DCost(pexpr);
+	}
+
+	CJoinAtomSet atoms(pbs);
+	SSubsetCost *psc = m_phmsubsetcost->Find(atoms);
+	if (nullptr != psc && psc->m_pexpr == pexpr)
+	{
+		return psc->m_cost;
+	}
+
+	CDouble dCost = DCost(pexpr);
+	if (nullptr == psc)
+	{
+		BOOL fInserted GPOS_ASSERTS_ONLY = m_phmsubsetcost->Insert(
+			atoms, GPOS_NEW(m_mp) SSubsetCost(pexpr, dCost));
+		GPOS_ASSERT(fInserted);
+	}
+	else
+	{
+		psc->m_pexpr = pexpr;
+		psc->m_cost = dCost;
+	}
+
+	return dCost;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJoinOrderDP::PbsCovered
@@ -70,6 +70,9 @@ CJoinOrderDPv2::CJoinOrderDPv2(CMemoryPool *mp,
 	: CJoinOrder(mp, pdrgpexprAtoms, innerJoinConjuncts, onPredConjuncts,
 				 childPredIndexes),
 	  m_expression_to_edge_map(nullptr),
+	  m_bitset_to_group_info_map(nullptr),
+	  m_atom_set_to_group_info_map(nullptr),
+	  m_edge_atom_sets(nullptr),
 	  m_on_pred_conjuncts(onPredConjuncts),
 	  m_child_pred_indexes(childPredIndexes),
 	  m_non_inner_join_dependencies(nullptr),
@@ -86,7 +89,14 @@ CJoinOrderDPv2::CJoinOrderDPv2(CMemoryPool *mp,
 			GPOS_NEW(mp) SLevelInfo(l, GPOS_NEW(mp) SGroupInfoArray(mp)));
 	}
 
-	m_bitset_to_group_info_map = GPOS_NEW(mp) BitSetToGroupInfoMap(mp);
+	if (CJoinAtomSet::FFits(m_ulComps))
+	{
+		m_atom_set_to_group_info_map = GPOS_NEW(mp) AtomSetToGroupInfoMap(mp);
+	}
+	else
+	{
+		m_bitset_to_group_info_map = GPOS_NEW(mp) BitSetToGroupInfoMap(mp);
+	}
 
 	// Contains top k expressions for a general DP algorithm, without considering cost of motions/PS
 	m_top_k_expressions =
@@ -135,6 +145,15 @@ CJoinOrderDPv2::CJoinOrderDPv2(CMemoryPool *mp,
 			}
 		}
 	}
+
+	if (nullptr != m_atom_set_to_group_info_map)
+	{
+		m_edge_atom_sets = GPOS_NEW_ARRAY(mp, CJoinAtomSet, m_ulEdges);
+		for (ULONG ul = 0; ul < m_ulEdges; ul++)
+		{
+			m_edge_atom_sets[ul] = CJoinAtomSet(m_rgpedge[ul]->m_pbs);
+		}
+	}
 	PopulateExpressionToEdgeMapIfNeeded();
 }
 
@@ -154,7 +173,9 @@ CJoinOrderDPv2::~CJoinOrderDPv2()
 	// we still have all de-allocations enabled in debug-build to detect any possible leaks
 	CRefCount::SafeRelease(m_non_inner_join_dependencies);
 	CRefCount::SafeRelease(m_child_pred_indexes);
-	m_bitset_to_group_info_map->Release();
+	CRefCount::SafeRelease(m_bitset_to_group_info_map);
+	CRefCount::SafeRelease(m_atom_set_to_group_info_map);
+	GPOS_DELETE_ARRAY(m_edge_atom_sets);
 	CRefCount::SafeRelease(m_expression_to_edge_map);
 	m_top_k_expressions->Release();
 	m_top_k_part_expressions->Release();
@@ -219,31 +240,58 @@ CJoinOrderDPv2::ComputeCost(SExpressionInfo *expr_info,
 //
 //---------------------------------------------------------------------------
 CExpression *
-CJoinOrderDPv2::PexprBuildInnerJoinPred(CBitSet *pbsFst, CBitSet *pbsSnd)
+CJoinOrderDPv2::PexprBuildInnerJoinPred(SGroupInfo *left_group_info,
+										SGroupInfo *right_group_info)
 {
+	CBitSet *pbsFst = left_group_info->m_atoms;
+	CBitSet *pbsSnd = right_group_info->m_atoms;
+
 	GPOS_ASSERT(pbsFst->IsDisjoint(pbsSnd));
 	// collect edges connecting the given sets
 	CBitSet *pbsEdges = GPOS_NEW(m_mp) CBitSet(m_mp);
-	CBitSet *pbs = GPOS_NEW(m_mp) CBitSet(m_mp, *pbsFst);
-	pbs->Union(pbsSnd);
-
-	for (ULONG ul = 0; ul < m_ulEdges; ul++)
-	{
-		SEdge *pedge = m_rgpedge[ul];
-		if (
-			// edge represents an inner join pred
-			0 == pedge->m_loj_num &&
-			// all columns referenced in the edge pred are provided
-			pbs->ContainsAll(pedge->m_pbs) &&
-			// the edge represents a true join predicate between the two components
-			!pbsFst->IsDisjoint(pedge->m_pbs) &&
-			!pbsSnd->IsDisjoint(pedge->m_pbs))
+
+	if (nullptr != m_edge_atom_sets)
+	{
+		// same test as below, on the fixed-width atom sets
+		const CJoinAtomSet &fst = left_group_info->m_atom_set;
+		const CJoinAtomSet &snd = right_group_info->m_atom_set;
+		CJoinAtomSet atoms = fst.Union(snd);
+
+		for (ULONG ul = 0; ul < m_ulEdges; ul++)
 		{
-			BOOL fSet GPOS_ASSERTS_ONLY = pbsEdges->ExchangeSet(ul);
-			GPOS_ASSERT(!fSet);
+			const CJoinAtomSet &edge_atoms = m_edge_atom_sets[ul];
+			if (0 == m_rgpedge[ul]->m_loj_num &&
+				atoms.ContainsAll(edge_atoms) &&
+				!fst.IsDisjoint(edge_atoms) && !snd.IsDisjoint(edge_atoms))
+			{
+				BOOL fSet GPOS_ASSERTS_ONLY = pbsEdges->ExchangeSet(ul);
+				GPOS_ASSERT(!fSet);
+			}
 		}
 	}
-	pbs->Release();
+	else
+	{
+		CBitSet *pbs = GPOS_NEW(m_mp) CBitSet(m_mp, *pbsFst);
+		pbs->Union(pbsSnd);
+
+		for (ULONG ul = 0; ul < m_ulEdges; ul++)
+		{
+			SEdge *pedge = m_rgpedge[ul];
+			if (
+				// edge represents an inner join pred
+				0 == pedge->m_loj_num &&
+				// all columns referenced in the edge pred are provided
+				pbs->ContainsAll(pedge->m_pbs) &&
+				// the edge represents a true join predicate between the two components
+				!pbsFst->IsDisjoint(pedge->m_pbs) &&
+				!pbsSnd->IsDisjoint(pedge->m_pbs))
+			{
+				BOOL fSet GPOS_ASSERTS_ONLY = pbsEdges->ExchangeSet(ul);
+				GPOS_ASSERT(!fSet);
+			}
+		}
+		pbs->Release();
+	}
 
 	CExpression *pexprPred = nullptr;
 	if (0 < pbsEdges->Size())
@@ -348,8 +396,8 @@ CJoinOrderDPv2::GetJoinExpr(const SGroupAndExpression &left_child_expr,
 	{
 		// inner join, compute the predicate from the join graph
 		GPOS_ASSERT(nullptr == scalar_expr);
-		scalar_expr = PexprBuildInnerJoinPred(left_group_info->m_atoms,
-											  right_group_info->m_atoms);
+		scalar_expr =
+			PexprBuildInnerJoinPred(left_group_info, right_group_info);
 	}
 	else
 	{
@@ -1036,7 +1084,6 @@ CJoinOrderDPv2::SearchJoinOrders(ULONG left_level, ULONG right_level)
 	{
 		SGroupInfo *left_group_info = (*left_group_info_array)[left_ix];
 
-		CBitSet *left_bitset = left_group_info->m_atoms;
 		ULONG right_ix = 0;
 
 		// if pairs from the same level, start from the next
@@ -1053,9 +1100,8 @@ CJoinOrderDPv2::SearchJoinOrders(ULONG left_level, ULONG right_level)
 		for (; right_ix < right_size; right_ix++)
 		{
 			SGroupInfo *right_group_info = (*right_group_info_array)[right_ix];
-			CBitSet *right_bitset = right_group_info->m_atoms;
 
-			if (!left_bitset->IsDisjoint(right_bitset))
+			if (!AreDisjoint(left_group_info, right_group_info))
 			{
 				// not a valid join, left and right tables must not overlap
 				continue;
@@ -1069,15 +1115,11 @@ CJoinOrderDPv2::SearchJoinOrders(ULONG left_level, ULONG right_level)
 			{
 				// we have a valid join
 
-				CBitSet *join_bitset =
-					GPOS_NEW(m_mp) CBitSet(m_mp, *left_bitset);
-
-				join_bitset->Union(right_bitset);
-
 				// Find the best expression for DP and add this to the group
 				// This doesn't consider PS, but we still want to generate these alternatives
-				SGroupInfo *group_info = LookupOrCreateGroupInfo(
-					current_level_info, join_bitset, join_expr_info);
+				SGroupInfo *group_info =
+					LookupOrCreateGroupInfo(current_level_info, left_group_info,
+											right_group_info, join_expr_info);
 				AddExprToGroupIfNecessary(group_info, join_expr_info);
 
 				// This ensures a 2-level bushy tree such that contains partition selectors is a valid candidate.
@@ -1164,7 +1206,7 @@ CJoinOrderDPv2::GreedySearchJoinOrders(ULONG left_level, JoinOrderPropType algo)
 	ULONG right_size = right_group_info_array->Size();
 
 	// pre-existing greedy solution on level left_level
-	CBitSet *left_bitset = nullptr;
+	SGroupInfo *left_group_info = nullptr;
 	SGroupAndExpression left_child_expr_info;
 
 	ULONG left_ix = 0;
@@ -1183,7 +1225,7 @@ CJoinOrderDPv2::GreedySearchJoinOrders(ULONG left_level, JoinOrderPropType algo)
 
 		if (left_child_expr_info.IsValid())
 		{
-			left_bitset = left_child_expr_info.m_group_info->m_atoms;
+			left_group_info = left_child_expr_info.m_group_info;
 			// we found the one solution from the lower level that we will build upon
 			break;
 		}
@@ -1207,9 +1249,8 @@ CJoinOrderDPv2::GreedySearchJoinOrders(ULONG left_level, JoinOrderPropType algo)
 	for (; right_ix < right_size; right_ix++)
 	{
 		SGroupInfo *right_group_info = (*right_group_info_array)[right_ix];
-		CBitSet *right_bitset = right_group_info->m_atoms;
 
-		if (!left_bitset->IsDisjoint(right_bitset))
+		if (!AreDisjoint(left_group_info, right_group_info))
 		{
 			// not a valid join, left and right tables must not overlap
 			continue;
@@ -1228,13 +1269,11 @@ CJoinOrderDPv2::GreedySearchJoinOrders(ULONG left_level, JoinOrderPropType algo)
 		if (nullptr != join_expr_info)
 		{
 			// we have a valid join
-			CBitSet *join_bitset = GPOS_NEW(m_mp) CBitSet(m_mp, *left_bitset);
-
-			join_bitset->Union(right_bitset);
 
 			// look up existing group and stats or create a new group and derive stats
-			SGroupInfo *join_group_info = LookupOrCreateGroupInfo(
-				current_level_info, join_bitset, join_expr_info);
+			SGroupInfo *join_group_info =
+				LookupOrCreateGroupInfo(current_level_info, left_group_info,
+										right_group_info, join_expr_info);
 
 			ComputeCost(join_expr_info, join_group_info->m_cardinality);
 			CDouble join_cost = join_expr_info->GetCost();
@@ -1291,13 +1330,23 @@ CJoinOrderDPv2::SGroupInfo *
 CJoinOrderDPv2::LookupOrCreateGroupInfo(SLevelInfo *levelInfo, CBitSet *atoms,
 										SExpressionInfo *stats_expr_info)
 {
-	SGroupInfo *group_info = m_bitset_to_group_info_map->Find(atoms);
+	CJoinAtomSet atom_set;
+	SGroupInfo *group_info = nullptr;
+	if (nullptr != m_atom_set_to_group_info_map)
+	{
+		atom_set = CJoinAtomSet(atoms);
+		group_info = m_atom_set_to_group_info_map->Find(atom_set);
+	}
+	else
+	{
+		group_info = m_bitset_to_group_info_map->Find(atoms);
+	}
 	SExpressionInfo *real_expr_info_for_stats = stats_expr_info;
 
 	if (nullptr == group_info)
 	{
 		// this is a group we haven't seen yet, create a new group info and derive stats, if needed
-		group_info = GPOS_NEW(m_mp) SGroupInfo(m_mp, atoms);
+		group_info = GPOS_NEW(m_mp) SGroupInfo(m_mp, atoms, atom_set);
 		if (!stats_expr_info->m_properties.Satisfies(EJoinOrderStats))
 		{
 			SExpressionProperties stats_props(EJoinOrderStats);
@@ -1336,9 +1385,17 @@ CJoinOrderDPv2::LookupOrCreateGroupInfo(SLevelInfo *levelInfo, CBitSet *atoms,
 		if (1 < levelInfo->m_level)
 		{
 			// also insert into the bitset to group map
-			group_info->m_atoms->AddRef();
 			group_info->AddRef();
-			m_bitset_to_group_info_map->Insert(group_info->m_atoms, group_info);
+			if (nullptr != m_atom_set_to_group_info_map)
+			{
+				m_atom_set_to_group_info_map->Insert(atom_set, group_info);
+			}
+			else
+			{
+				group_info->m_atoms->AddRef();
+				m_bitset_to_group_info_map->Insert(group_info->m_atoms,
+												   group_info);
+			}
 		}
 	}
 	else
@@ -1350,6 +1407,64 @@ CJoinOrderDPv2::LookupOrCreateGroupInfo(SLevelInfo *levelInfo, CBitSet *atoms,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::LookupOrCreateGroupInfo
+//
+//	@doc:
+//		Look up or create the group joining two given groups. This is
+//		called for every candidate join, and most candidates join into a
+//		group that exists already, so look it up by the union of the
+//		fixed-width atom sets first and allocate the atoms of the group
+//		only when it is new.
+//
+//---------------------------------------------------------------------------
+CJoinOrderDPv2::SGroupInfo *
+CJoinOrderDPv2::LookupOrCreateGroupInfo(SLevelInfo *levelInfo,
+										SGroupInfo *left_group_info,
+										SGroupInfo *right_group_info,
+										SExpressionInfo *stats_expr_info)
+{
+	if (nullptr != m_atom_set_to_group_info_map)
+	{
+		SGroupInfo *group_info = m_atom_set_to_group_info_map->Find(
+			left_group_info->m_atom_set.Union(right_group_info->m_atom_set));
+
+		if (nullptr != group_info)
+		{
+			return group_info;
+		}
+	}
+
+	CBitSet *atoms = GPOS_NEW(m_mp) CBitSet(m_mp, *left_group_info->m_atoms);
+	atoms->Union(right_group_info->m_atoms);
+
+	return LookupOrCreateGroupInfo(levelInfo, atoms, stats_expr_info);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::AreDisjoint
+//
+//	@doc:
+//		Do the given groups have no atoms in common?
+//
+//---------------------------------------------------------------------------
+BOOL
+CJoinOrderDPv2::AreDisjoint(SGroupInfo *left_group_info,
+							SGroupInfo *right_group_info)
+{
+	if (nullptr != m_atom_set_to_group_info_map)
+	{
+		return left_group_info->m_atom_set.IsDisjoint(
+			right_group_info->m_atom_set);
+	}
+
+	return left_group_info->m_atoms->IsDisjoint(right_group_info->m_atoms);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJoinOrderDPv2::FinalizeDPLevel
@@ -1383,7 +1498,14 @@ CJoinOrderDPv2::FinalizeDPLevel(ULONG level)
 		while (nullptr !=
 			   (loser = level_info->m_top_k_groups->RemoveNextElement()))
 		{
-			m_bitset_to_group_info_map->Delete(loser->m_atoms);
+			if (nullptr != m_atom_set_to_group_info_map)
+			{
+				m_atom_set_to_group_info_map->Delete(loser->m_atom_set);
+			}
+			else
+			{
+				m_bitset_to_group_info_map->Delete(loser->m_atoms);
+			}
 			loser->Release();
 		}
 
@@ -286,6 +286,22 @@ CXform::PbsJoinOrderOnExhaustive2Xforms(CMemoryPool *mp)
 	return pbs;
 }
 
+BOOL
+CXform::FRequiredForPlan(EXformId exfid)
+{
+	switch (exfid)
+	{
+		case ExfSplitGbAgg:
+		case ExfSplitGbAggDedup:
+		case ExfSplitDQA:
+		case ExfGbAggWithMDQA2Join:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
 BOOL
 CXform::IsApplyOnce()
 {
@@ -36,6 +36,16 @@ public:
 		Restart();
 	}
 
+	// ctor, only reading the clock if the timer is used, for the hot paths
+	// that time themselves under a trace flag
+	explicit CWallClock(BOOL fStart) : m_time()
+	{
+		if (fStart)
+		{
+			Restart();
+		}
+	}
+
 	// retrieve elapsed wall-clock time in micro-seconds
 	ULONG ElapsedUS() const override;
 
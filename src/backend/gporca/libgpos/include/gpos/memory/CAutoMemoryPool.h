@@ -60,8 +60,8 @@ private:
 public:
 	CAutoMemoryPool(const CAutoMemoryPool &) = delete;
 
-	// ctor
-	CAutoMemoryPool(ELeakCheck leak_check_type = ElcExc);
+	// ctor; an arena pool is created if requested, see CMemoryPoolArena
+	CAutoMemoryPool(ELeakCheck leak_check_type = ElcExc, BOOL arena = false);
 
 	// FIXME: should mark this noexcept in non-assert builds
 	// dtor
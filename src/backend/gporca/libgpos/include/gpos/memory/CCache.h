@@ -61,7 +61,8 @@ class CCacheAccessor;
 //		object's key as member.
 //
 //		Cache API allows client to store, lookup, delete, and iterate over cached
-//		objects.
+//		objects. Objects that became stale can be evicted selectively, using a
+//		predicate on their keys.
 //
 //		Cache can only be accessed through the CCacheAccessor friend class.
 //		The current implementation has a fixed gclock based eviction policy.
@@ -77,6 +78,9 @@ public:
 	using HashFuncPtr = ULONG (*)(const K &);
 	using EqualFuncPtr = BOOL (*)(const K &, const K &);
 
+	// type definition of the predicate telling whether a key is stale
+	using InvalidFuncPtr = BOOL (*)(const K &);
+
 private:
 	using CCacheHashTableEntry = CCacheEntry<T, K>;
 
@@ -109,6 +113,15 @@ private:
 	// number of times cache entries were evicted
 	ULLONG m_eviction_counter;
 
+	// number of lookups that found an entry
+	ULLONG m_hit_counter;
+
+	// number of lookups that did not find an entry
+	ULLONG m_miss_counter;
+
+	// number of entries evicted because they became stale
+	ULLONG m_invalidation_counter;
+
 	// if the gclock hand was already advanced and therefore can serve the next entry
 	BOOL m_clock_hand_advanced;
 
@@ -183,10 +196,20 @@ private:
 		CCacheHashtableAccessor acc(m_hash_table, key);
 
 		// if we allow duplicates, insertion can be directly made;
-		// if we do not allow duplicates, we need to check first
+		// if we do not allow duplicates, we need to check first,
+		// skipping stale entries that are still in use
 		CCacheHashTableEntry *ret = entry;
 		CCacheHashTableEntry *found = nullptr;
-		if (!m_unique || (m_unique && nullptr == (found = acc.Find())))
+		if (m_unique)
+		{
+			found = acc.Find();
+			while (nullptr != found && found->IsMarkedForDeletion())
+			{
+				found = acc.Next(found);
+			}
+		}
+
+		if (nullptr == found)
 		{
 			acc.Insert(entry);
 			m_cache_size += entry->Pmp()->TotalAllocatedSize();
@@ -221,6 +244,11 @@ private:
 			// increase ref count, since CCacheHashtableAccessor points to the obj
 			// ref count will be decreased when CCacheHashtableAccessor will be destroyed
 			entry->IncRefCount();
+			++m_hit_counter;
+		}
+		else
+		{
+			++m_miss_counter;
 		}
 
 		return entry;
@@ -435,6 +463,9 @@ public:
 		  m_gclock_init_counter(g_clock_init_counter),
 		  m_eviction_factor((float) 0.1),
 		  m_eviction_counter(0),
+		  m_hit_counter(0),
+		  m_miss_counter(0),
+		  m_invalidation_counter(0),
 		  m_clock_hand_advanced(false),
 		  m_hash_func(hash_func),
 		  m_equal_func(equal_func)
@@ -495,6 +526,80 @@ public:
 		return m_eviction_counter;
 	}
 
+	// return number of lookups that found an entry
+	ULLONG
+	GetHitCounter()
+	{
+		return m_hit_counter;
+	}
+
+	// return number of lookups that did not find an entry
+	ULLONG
+	GetMissCounter()
+	{
+		return m_miss_counter;
+	}
+
+	// return number of entries evicted because they became stale
+	ULLONG
+	GetInvalidationCounter()
+	{
+		return m_invalidation_counter;
+	}
+
+	// evicts all entries whose keys the given function considers stale;
+	// entries that are in use are marked for deletion, and released once
+	// their last user is done with them; returns the number of entries
+	ULLONG
+	EvictInvalidEntries(InvalidFuncPtr invalid_func)
+	{
+		GPOS_ASSERT(nullptr != invalid_func);
+
+		ULLONG num_evicted = 0;
+		CCacheHashtableIter it(m_hash_table);
+
+		// removing an entry automatically advances the iterator, so the
+		// iterator is only advanced when nothing was removed
+		BOOL removed = false;
+		while (removed || it.Advance())
+		{
+			removed = false;
+			CCacheHashTableEntry *entry = nullptr;
+
+			// scope for CCacheHashtableIterAccessor
+			{
+				CCacheHashtableIterAccessor acc(it);
+
+				entry = acc.Value();
+				if (nullptr != entry && !entry->IsMarkedForDeletion() &&
+					invalid_func(entry->Key()))
+				{
+					m_cache_size -= entry->Pmp()->TotalAllocatedSize();
+					num_evicted++;
+
+					if (EXPECTED_REF_COUNT_FOR_DELETE == entry->RefCount())
+					{
+						acc.Remove(entry);
+						removed = true;
+					}
+					else
+					{
+						entry->MarkForDeletion();
+					}
+				}
+			}
+
+			if (removed)
+			{
+				DestroyCacheEntry(entry);
+			}
+		}
+
+		m_invalidation_counter += num_evicted;
+
+		return num_evicted;
+	}
+
 	// sets the cache quota
 	void
 	SetCacheQuota(ULLONG new_quota)
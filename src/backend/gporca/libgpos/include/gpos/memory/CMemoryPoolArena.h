@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CMemoryPoolArena.h
+//
+//	@doc:
+//		Memory pool that bump-allocates from large chunks and releases
+//		them all at once when the pool is destroyed
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolArena_H
+#define GPOS_CMemoryPoolArena_H
+
+#include "gpos/assert.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/memory/CMemoryPoolStatistics.h"
+#include "gpos/types.h"
+
+// chunks are made of segments of this size, aligned to it
+#define GPOS_MEM_ARENA_SEGMENT_SIZE (64 * 1024)
+
+// size of the first chunk of a pool; each new chunk doubles the size
+#define GPOS_MEM_ARENA_INIT_CHUNK_SIZE GPOS_MEM_ARENA_SEGMENT_SIZE
+
+// size that chunks stop growing at
+#define GPOS_MEM_ARENA_MAX_CHUNK_SIZE (8 * 1024 * 1024)
+
+namespace gpos
+{
+//---------------------------------------------------------------------------
+//	@class:
+//		CMemoryPoolArena
+//
+//	@doc:
+//		Arena (region) memory pool.
+//
+//		Allocations are carved from large chunks, with a small header in
+//		front of each. Freeing an allocation only wipes it, its memory is
+//		not reused: all chunks are released together when the pool is torn
+//		down. This suits pools whose objects mostly live until the pool is
+//		destroyed, e.g. the memo of an optimization session.
+//
+//		The chunks come from an underlying pool of the type that the memory
+//		pool manager creates, so that they are accounted for like any other
+//		optimizer memory. Frees don't carry their pool, so the segments of
+//		all live chunks are registered, and CMemoryPool::DeleteImpl() looks
+//		up pointers there before handing them to the memory pool manager.
+//
+//		Like the rest of the optimizer, the pool is not thread-safe.
+//
+//---------------------------------------------------------------------------
+class CMemoryPoolArena : public CMemoryPool
+{
+private:
+	// header of a chunk
+	struct SChunk
+	{
+		// next chunk of the pool
+		SChunk *m_next;
+
+		// memory the chunk was carved from
+		void *m_raw;
+
+		// size of the chunk, including this header
+		ULONG_PTR m_size;
+	};
+
+	// header in front of each allocation
+	struct SAllocHeader
+	{
+		// user requested size
+		ULONG m_user_size;
+
+		// allocation type (singleton/array)
+		ULONG m_alloc_type;
+	};
+
+	// entry of the segment registry
+	struct SSegment
+	{
+		// segment address divided by the segment size; 0 for free entries
+		ULONG_PTR m_segment;
+
+		// owning pool; nullptr for deleted entries
+		CMemoryPoolArena *m_mp;
+	};
+
+	// pool the chunks are allocated from
+	CMemoryPool *m_underlying_mp;
+
+	// chunks of the pool, the one being carved first
+	SChunk *m_chunks{nullptr};
+
+	// free space of the chunk being carved
+	BYTE *m_free{nullptr};
+	BYTE *m_end{nullptr};
+
+	// size of the next chunk
+	ULONG_PTR m_next_chunk_size{GPOS_MEM_ARENA_INIT_CHUNK_SIZE};
+
+	// number of chunks
+	ULONG m_num_chunks{0};
+
+	// total size of the chunks
+	ULLONG m_chunks_size{0};
+
+	// allocation statistics
+	CMemoryPoolStatistics m_memory_pool_statistics;
+
+	// registry of the segments of all live chunks, open addressing
+	static SSegment *m_segments;
+
+	// number of registry entries, a power of 2
+	static ULONG m_segments_capacity;
+
+	// number of registry entries in use, deleted ones included
+	static ULONG m_segments_used;
+
+	// number of registered segments
+	static ULONG m_segments_live;
+
+	// allocate a chunk of at least the given size, not counting its header
+	SChunk *NewChunk(ULONG_PTR size);
+
+	// register or unregister the segments of a chunk
+	void RegisterChunk(SChunk *chunk);
+	static void UnregisterChunk(SChunk *chunk);
+
+	// registry entry of the given segment, or free entry to insert it into
+	static SSegment *FindSegment(ULONG_PTR segment);
+
+	// grow the registry to take the given number of new segments
+	static void GrowSegments(ULONG num_segments);
+
+	// pool owning the given segment, or nullptr
+	static CMemoryPoolArena *LookupSegment(const void *ptr);
+
+protected:
+	// dtor
+	~CMemoryPoolArena() override;
+
+public:
+	CMemoryPoolArena(CMemoryPoolArena &) = delete;
+
+	// ctor
+	explicit CMemoryPoolArena(CMemoryPool *underlying_mp);
+
+	// prepare the memory pool to be deleted
+	void TearDown() override;
+
+	// allocate memory
+	void *NewImpl(const ULONG bytes, const CHAR *file, const ULONG line,
+				  CMemoryPool::EAllocationType eat) override;
+
+	// free memory allocation
+	void Free(void *ptr, EAllocationType eat);
+
+	// get user requested size of allocation
+	static ULONG UserSizeOfAlloc(const void *ptr);
+
+	// return the arena pool the given allocation belongs to, if any
+	static CMemoryPoolArena *
+	Owner(const void *ptr)
+	{
+		if (0 == m_segments_live)
+		{
+			return nullptr;
+		}
+
+		return LookupSegment(ptr);
+	}
+
+	// return total allocated size, i.e. the size of the chunks
+	ULLONG
+	TotalAllocatedSize() const override
+	{
+		return m_chunks_size;
+	}
+
+	// return number of chunks
+	ULONG
+	NumChunks() const
+	{
+		return m_num_chunks;
+	}
+
+	// return allocation statistics
+	const CMemoryPoolStatistics &
+	GetStatistics() const
+	{
+		return m_memory_pool_statistics;
+	}
+
+#ifdef GPOS_DEBUG
+	// check if the memory pool is empty, i.e. everything allocated was freed
+	void AssertEmpty(IOstream &os) override;
+#endif	// GPOS_DEBUG
+};
+}  // namespace gpos
+
+#endif	// !GPOS_CMemoryPoolArena_H
+
+// EOF
@@ -118,6 +118,9 @@ public:
 	// create new memory pool
 	static CMemoryPool *CreateMemoryPool();
 
+	// create new arena memory pool, see CMemoryPoolArena
+	static CMemoryPool *CreateArenaMemoryPool();
+
 	// release memory pool
 	static void Destroy(CMemoryPool *);
 
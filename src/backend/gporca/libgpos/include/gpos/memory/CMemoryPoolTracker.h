@@ -108,6 +108,13 @@ public:
 		return m_memory_pool_statistics.TotalAllocatedSize();
 	}
 
+	// return allocation statistics
+	const CMemoryPoolStatistics &
+	GetStatistics() const
+	{
+		return m_memory_pool_statistics;
+	}
+
 #ifdef GPOS_DEBUG
 
 	// check if the memory pool keeps track of live objects
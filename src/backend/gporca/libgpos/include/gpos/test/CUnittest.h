@@ -18,6 +18,8 @@
 
 // helper macros
 #define GPOS_UNITTEST_FUNC(x) gpos::CUnittest(#x, CUnittest::EttStandard, x)
+#define GPOS_UNITTEST_FUNC_EXT(x) \
+	gpos::CUnittest(#x, CUnittest::EttExtended, x)
 
 #define GPOS_UNITTEST_STD(x) \
 	gpos::CUnittest(#x, CUnittest::EttStandard, x::EresUnittest)
@@ -50,6 +50,13 @@ private:
 		//key equality function
 		static BOOL FMyEqual(ULONG *const &pvKey, ULONG *const &pvKeySecond);
 
+		// is the key odd? used as invalidation predicate
+		static BOOL
+		FOddKey(ULONG *const &pvKey)
+		{
+			return 1 == *pvKey % 2;
+		}
+
 		// equality for object-based comparison
 		BOOL
 		operator==(const SSimpleObject &obj) const
@@ -157,6 +164,7 @@ public:
 	static GPOS_RESULT EresUnittest_DeepObject();
 	static GPOS_RESULT EresUnittest_Iteration();
 	static GPOS_RESULT EresUnittest_IterativeDeletion();
+	static GPOS_RESULT EresUnittest_Invalidation();
 
 
 };	// class CCacheTest
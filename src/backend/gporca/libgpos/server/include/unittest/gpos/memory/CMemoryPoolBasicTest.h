@@ -25,12 +25,16 @@ namespace gpos
 class CMemoryPoolBasicTest
 {
 private:
+	// create arena pools in the tests
+	static BOOL m_arena;
+
 	static GPOS_RESULT EresTestType();
 	static GPOS_RESULT EresTestExpectedError(GPOS_RESULT (*pfunc)(),
 											 ULONG minor);
 
 	static GPOS_RESULT EresNewDelete();
 	static GPOS_RESULT EresThrowingCtor();
+	static GPOS_RESULT EresArenaChunks();
 #ifdef GPOS_DEBUG
 	static GPOS_RESULT EresLeak();
 	static GPOS_RESULT EresLeakByException();
@@ -45,7 +49,7 @@ public:
 	static GPOS_RESULT EresUnittest_Print();
 #endif	// GPOS_DEBUG
 	static GPOS_RESULT EresUnittest_TestTracker();
-	static GPOS_RESULT EresUnittest_TestSlab();
+	static GPOS_RESULT EresUnittest_TestArena();
 
 };	// class CMemoryPoolBasicTest
 }  // namespace gpos
@@ -47,7 +47,8 @@ CCacheTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Eviction),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Iteration),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeepObject),
-		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion)};
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Invalidation)};
 
 	fUnique = true;
 	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -974,4 +975,84 @@ CCacheTest::EresUnittest_IterativeDeletion()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_Invalidation
+//
+//	@doc:
+//		Evict the entries with stale keys, while one of them is in use
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_Invalidation()
+{
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apcache;
+	apcache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		true /*fUnique*/, UNLIMITED_CACHE_QUOTA, SSimpleObject::UlMyHash,
+		SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pcache = apcache.Value();
+
+	const ULONG ulElements = 10;
+	ULLONG ullOneElemSize = 0;
+	for (ULONG i = 0; i < ulElements; i++)
+	{
+		ullOneElemSize = InsertOneElement(pcache, i);
+	}
+
+	// scope for the accessor holding a stale entry
+	{
+		CSimpleObjectCacheAccessor caHeld(pcache);
+		ULONG ulHeldKey = 1;
+		caHeld.Lookup(&ulHeldKey);
+		SSimpleObject *psoHeld = caHeld.Val();
+		GPOS_UNITTEST_ASSERT(nullptr != psoHeld);
+		psoHeld->Release();
+
+		ULLONG ullEvicted GPOS_ASSERTS_ONLY =
+			pcache->EvictInvalidEntries(SSimpleObject::FOddKey);
+		GPOS_UNITTEST_ASSERT(ulElements / 2 == ullEvicted);
+		GPOS_UNITTEST_ASSERT(ulElements / 2 == pcache->GetInvalidationCounter());
+		GPOS_UNITTEST_ASSERT(ulElements / 2 * ullOneElemSize ==
+							 pcache->TotalAllocatedSize());
+
+		// the held entry stays until it is released
+		GPOS_UNITTEST_ASSERT(ulElements / 2 + 1 == pcache->Size());
+		GPOS_UNITTEST_ASSERT(1 == psoHeld->m_ulValue);
+
+		for (ULONG i = 0; i < ulElements; i++)
+		{
+			CSimpleObjectCacheAccessor ca(pcache);
+			ca.Lookup(&i);
+			SSimpleObject *pso = ca.Val();
+			GPOS_UNITTEST_ASSERT((nullptr == pso) == SSimpleObject::FOddKey(&i));
+
+			if (nullptr != pso)
+			{
+				pso->Release();
+			}
+		}
+
+		// a fresh entry can replace the stale one while it is in use
+		CSimpleObjectCacheAccessor ca(pcache);
+		SSimpleObject *pso = GPOS_NEW(ca.Pmp()) SSimpleObject(1, 10);
+		SSimpleObject *psoReturned GPOS_ASSERTS_ONLY =
+			ca.Insert(&(pso->m_ulKey), pso);
+		pso->Release();
+		GPOS_UNITTEST_ASSERT(psoReturned == pso);
+	}
+
+	GPOS_UNITTEST_ASSERT(ulElements / 2 + 1 == pcache->Size());
+
+	CSimpleObjectCacheAccessor ca(pcache);
+	ULONG ulKey = 1;
+	ca.Lookup(&ulKey);
+	SSimpleObject *pso = ca.Val();
+	GPOS_UNITTEST_ASSERT(nullptr != pso && 10 == pso->m_ulValue);
+	pso->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -18,6 +18,7 @@
 #include "gpos/error/CException.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/memory/CMemoryPoolArena.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/task/CAutoTaskProxy.h"
@@ -30,6 +31,8 @@
 
 using namespace gpos;
 
+BOOL CMemoryPoolBasicTest::m_arena = false;
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresUnittest
@@ -45,7 +48,8 @@ CMemoryPoolBasicTest::EresUnittest()
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_Print),
 #endif	// GPOS_DEBUG
-		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker)};
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestArena)};
 
 	CAutoTraceFlag atf(EtraceTestMemoryPools, true /*value*/);
 
@@ -93,10 +97,35 @@ CMemoryPoolBasicTest::EresUnittest_Print()
 GPOS_RESULT
 CMemoryPoolBasicTest::EresUnittest_TestTracker()
 {
+	m_arena = false;
 	return EresTestType();
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestArena
+//
+//	@doc:
+//		Run tests for arena pool
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestArena()
+{
+	m_arena = true;
+	GPOS_RESULT eres = EresTestType();
+	m_arena = false;
+
+	if (GPOS_OK != eres)
+	{
+		return eres;
+	}
+
+	return EresArenaChunks();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresTestType
@@ -171,7 +200,7 @@ CMemoryPoolBasicTest::EresNewDelete()
 {
 	// create memory pool
 	CAutoTimer at("NewDelete test", true /*fPrint*/);
-	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc);
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, m_arena);
 	CMemoryPool *mp = amp.Pmp();
 
 	WCHAR rgwszText[] = GPOS_WSZ_LIT(
@@ -226,7 +255,7 @@ CMemoryPoolBasicTest::EresThrowingCtor()
 	CAutoTimer at("ThrowingCtor test", true /*fPrint*/);
 
 	// create memory pool
-	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc);
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, m_arena);
 	CMemoryPool *mp = amp.Pmp();
 
 	// malicious test class
@@ -248,6 +277,88 @@ CMemoryPoolBasicTest::EresThrowingCtor()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresArenaChunks
+//
+//	@doc:
+//		Test carving of arena chunks, large allocations and ownership
+//		lookups
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresArenaChunks()
+{
+	CAutoTimer at("ArenaChunks test", true /*fPrint*/);
+
+	const ULONG num_allocs = 20000;
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, true /*arena*/);
+	CMemoryPoolArena *mp = dynamic_cast<CMemoryPoolArena *>(amp.Pmp());
+	GPOS_UNITTEST_ASSERT(nullptr != mp);
+
+	// a second arena, to check that ownership is told apart
+	CAutoMemoryPool amp_other(CAutoMemoryPool::ElcExc, true /*arena*/);
+	CMemoryPool *mp_other = amp_other.Pmp();
+	ULONG *pul_other = GPOS_NEW(mp_other) ULONG(0);
+
+	ULONG **rgpul = GPOS_NEW_ARRAY(mp, ULONG *, num_allocs);
+	for (ULONG ul = 0; ul < num_allocs; ul++)
+	{
+		ULONG size = Size(ul) / GPOS_SIZEOF(ULONG);
+		rgpul[ul] = GPOS_NEW_ARRAY(mp, ULONG, size);
+		rgpul[ul][0] = ul;
+		rgpul[ul][size - 1] = ul;
+	}
+
+	// a large allocation gets a chunk of its own
+	ULONG num_chunks = mp->NumChunks();
+	BYTE *large = GPOS_NEW_ARRAY(mp, BYTE, GPOS_MEM_ARENA_MAX_CHUNK_SIZE);
+	GPOS_UNITTEST_ASSERT(num_chunks + 1 == mp->NumChunks());
+	GPOS_UNITTEST_ASSERT(mp == CMemoryPoolArena::Owner(large));
+	GPOS_UNITTEST_ASSERT(mp == CMemoryPoolArena::Owner(
+								   large + GPOS_MEM_ARENA_MAX_CHUNK_SIZE - 1));
+	GPOS_UNITTEST_ASSERT(GPOS_MEM_ARENA_MAX_CHUNK_SIZE ==
+						 CMemoryPool::UserSizeOfAlloc(large));
+
+	// small allocations were carved from fewer, growing chunks
+	GPOS_UNITTEST_ASSERT(num_chunks < 16);
+
+	for (ULONG ul = 0; ul < num_allocs; ul++)
+	{
+		ULONG size = Size(ul) / GPOS_SIZEOF(ULONG);
+		GPOS_UNITTEST_ASSERT(ul == rgpul[ul][0]);
+		GPOS_UNITTEST_ASSERT(ul == rgpul[ul][size - 1]);
+		GPOS_UNITTEST_ASSERT(mp == CMemoryPoolArena::Owner(rgpul[ul]));
+		GPOS_UNITTEST_ASSERT(Size(ul) == CMemoryPool::UserSizeOfAlloc(rgpul[ul]));
+	}
+	GPOS_UNITTEST_ASSERT(mp_other == CMemoryPoolArena::Owner(pul_other));
+
+	// memory of other pools is not owned by arenas
+	CAutoMemoryPool amp_tracker(CAutoMemoryPool::ElcExc);
+	ULONG *pul_tracker = GPOS_NEW(amp_tracker.Pmp()) ULONG(0);
+	GPOS_UNITTEST_ASSERT(nullptr == CMemoryPoolArena::Owner(pul_tracker));
+	GPOS_DELETE(pul_tracker);
+
+	ULLONG peak = mp->GetStatistics().PeakLiveObjTotalSize();
+	for (ULONG ul = 0; ul < num_allocs; ul++)
+	{
+		GPOS_DELETE_ARRAY(rgpul[ul]);
+	}
+	GPOS_DELETE_ARRAY(rgpul);
+	GPOS_DELETE_ARRAY(large);
+	GPOS_DELETE(pul_other);
+
+	// frees are counted, but the chunks are kept until tear down
+	GPOS_UNITTEST_ASSERT(0 == mp->GetStatistics().GetNumLiveObj());
+	GPOS_UNITTEST_ASSERT(num_allocs + 2 ==
+						 mp->GetStatistics().GetNumSuccessfulAllocations());
+	GPOS_UNITTEST_ASSERT(peak == mp->GetStatistics().PeakLiveObjTotalSize());
+	GPOS_UNITTEST_ASSERT(peak <= mp->TotalAllocatedSize());
+
+	return GPOS_OK;
+}
+
+
 #ifdef GPOS_DEBUG
 
 //---------------------------------------------------------------------------
@@ -267,7 +378,7 @@ CMemoryPoolBasicTest::EresLeak()
 
 	// scope for pool
 	{
-		CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict, m_arena);
 		CMemoryPool *mp = amp.Pmp();
 
 		for (ULONG i = 0; i < 10; i++)
@@ -305,7 +416,7 @@ CMemoryPoolBasicTest::EresLeakByException()
 	// scope for pool
 	{
 		// create memory pool
-		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc);
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, m_arena);
 		CMemoryPool *mp = amp.Pmp();
 
 		for (ULONG i = 0; i < 10; i++)
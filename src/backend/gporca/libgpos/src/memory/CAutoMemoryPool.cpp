@@ -39,12 +39,20 @@ using namespace gpos;
 //  	the CMemoryPoolManager global instance
 //
 //---------------------------------------------------------------------------
-CAutoMemoryPool::CAutoMemoryPool(ELeakCheck leak_check_type GPOS_ASSERTS_ONLY)
+CAutoMemoryPool::CAutoMemoryPool(ELeakCheck leak_check_type GPOS_ASSERTS_ONLY,
+								 BOOL arena)
 #ifdef GPOS_DEBUG
 	: m_leak_check_type(leak_check_type)
 #endif
 {
-	m_mp = CMemoryPoolManager::CreateMemoryPool();
+	if (arena)
+	{
+		m_mp = CMemoryPoolManager::CreateArenaMemoryPool();
+	}
+	else
+	{
+		m_mp = CMemoryPoolManager::CreateMemoryPool();
+	}
 }
 
 
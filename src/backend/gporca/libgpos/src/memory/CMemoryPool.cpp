@@ -14,6 +14,7 @@
 
 #include "gpos/memory/CMemoryPool.h"
 
+#include "gpos/memory/CMemoryPoolArena.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
@@ -31,6 +32,12 @@ CMemoryPool::UserSizeOfAlloc(const void *ptr)
 {
 	GPOS_ASSERT(nullptr != ptr);
 
+	// allocations of arena pools are not known to the manager
+	if (nullptr != CMemoryPoolArena::Owner(ptr))
+	{
+		return CMemoryPoolArena::UserSizeOfAlloc(ptr);
+	}
+
 	return CMemoryPoolManager::GetMemoryPoolMgr()->UserSizeOfAlloc(ptr);
 }
 
@@ -38,6 +45,13 @@ CMemoryPool::UserSizeOfAlloc(const void *ptr)
 void
 CMemoryPool::DeleteImpl(void *ptr, EAllocationType eat)
 {
+	CMemoryPoolArena *arena = CMemoryPoolArena::Owner(ptr);
+	if (nullptr != arena)
+	{
+		arena->Free(ptr, eat);
+		return;
+	}
+
 	CMemoryPoolManager::GetMemoryPoolMgr()->DeleteImpl(ptr, eat);
 }
 
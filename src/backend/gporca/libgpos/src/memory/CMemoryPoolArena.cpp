@@ -0,0 +1,385 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CMemoryPoolArena.cpp
+//
+//	@doc:
+//		Implementation of the arena memory pool
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/memory/CMemoryPoolArena.h"
+
+#include "gpos/assert.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/task/ITask.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+
+using namespace gpos;
+
+#define GPOS_MEM_ARENA_CHUNK_HEADER_SIZE GPOS_MEM_ALIGNED_STRUCT_SIZE(SChunk)
+#define GPOS_MEM_ARENA_ALLOC_HEADER_SIZE \
+	GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader)
+#define GPOS_MEM_ARENA_BYTES_TOTAL(ulNumBytes) \
+	(GPOS_MEM_ARENA_ALLOC_HEADER_SIZE + GPOS_MEM_ALIGNED_SIZE(ulNumBytes))
+
+// allocations larger than this get a chunk of their own
+#define GPOS_MEM_ARENA_MAX_CARVED_SIZE (GPOS_MEM_ARENA_MAX_CHUNK_SIZE / 4)
+
+// initial number of segment registry entries
+#define GPOS_MEM_ARENA_INIT_REGISTRY_SIZE (1024)
+
+// marker of deleted segment registry entries
+#define GPOS_MEM_ARENA_DELETED_SEGMENT (ULONG_PTR_MAX)
+
+// segment registry
+CMemoryPoolArena::SSegment *CMemoryPoolArena::m_segments = nullptr;
+ULONG CMemoryPoolArena::m_segments_capacity = 0;
+ULONG CMemoryPoolArena::m_segments_used = 0;
+ULONG CMemoryPoolArena::m_segments_live = 0;
+
+// ctor
+CMemoryPoolArena::CMemoryPoolArena(CMemoryPool *underlying_mp)
+	: CMemoryPool(), m_underlying_mp(underlying_mp)
+{
+	GPOS_ASSERT(nullptr != underlying_mp);
+}
+
+// dtor
+CMemoryPoolArena::~CMemoryPoolArena()
+{
+	GPOS_ASSERT(nullptr == m_chunks);
+	GPOS_ASSERT(nullptr == m_underlying_mp);
+}
+
+// allocate a chunk of at least the given size, not counting its header;
+// the chunk is aligned to the segment size and made of whole segments
+CMemoryPoolArena::SChunk *
+CMemoryPoolArena::NewChunk(ULONG_PTR size)
+{
+	ULONG_PTR chunk_size = GPOS_MEM_ARENA_CHUNK_HEADER_SIZE + size;
+	chunk_size = (chunk_size + GPOS_MEM_ARENA_SEGMENT_SIZE - 1) &
+				 ~((ULONG_PTR) GPOS_MEM_ARENA_SEGMENT_SIZE - 1);
+
+	// over-allocate so that the chunk can be aligned
+	ULONG_PTR raw_size = chunk_size + GPOS_MEM_ARENA_SEGMENT_SIZE;
+	if (raw_size > GPOS_MEM_ALLOC_MAX)
+	{
+		GPOS_RAISE(CException::ExmaSystem, CException::ExmiOOM);
+	}
+
+	void *raw = GPOS_NEW_ARRAY(m_underlying_mp, BYTE, raw_size);
+	ULONG_PTR start = ((ULONG_PTR) raw + GPOS_MEM_ARENA_SEGMENT_SIZE - 1) &
+					  ~((ULONG_PTR) GPOS_MEM_ARENA_SEGMENT_SIZE - 1);
+
+	SChunk *chunk = reinterpret_cast<SChunk *>(start);
+	chunk->m_next = nullptr;
+	chunk->m_raw = raw;
+	chunk->m_size = chunk_size;
+
+	GPOS_TRY
+	{
+		RegisterChunk(chunk);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		GPOS_DELETE_ARRAY(static_cast<BYTE *>(raw));
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	m_num_chunks++;
+	m_chunks_size += chunk_size;
+
+	return chunk;
+}
+
+// allocate memory
+void *
+CMemoryPoolArena::NewImpl(const ULONG bytes, const CHAR *, const ULONG,
+						  CMemoryPool::EAllocationType eat)
+{
+	GPOS_ASSERT(bytes <= GPOS_MEM_ALLOC_MAX);
+
+	ULONG_PTR alloc_size = GPOS_MEM_ARENA_BYTES_TOTAL((ULONG_PTR) bytes);
+	BYTE *ptr = nullptr;
+
+	if (alloc_size > GPOS_MEM_ARENA_MAX_CARVED_SIZE)
+	{
+		// large allocations get a chunk of their own, linked behind the
+		// chunk being carved
+		SChunk *chunk = NewChunk(alloc_size);
+		if (nullptr == m_chunks)
+		{
+			m_chunks = chunk;
+		}
+		else
+		{
+			chunk->m_next = m_chunks->m_next;
+			m_chunks->m_next = chunk;
+		}
+		ptr = reinterpret_cast<BYTE *>(chunk) +
+			  GPOS_MEM_ARENA_CHUNK_HEADER_SIZE;
+	}
+	else
+	{
+		if (alloc_size > (ULONG_PTR)(m_end - m_free))
+		{
+			// the rest of the current chunk is wasted; grow chunks until they
+			// take the allocation
+			while (m_next_chunk_size <
+				   GPOS_MEM_ARENA_CHUNK_HEADER_SIZE + alloc_size)
+			{
+				m_next_chunk_size *= 2;
+			}
+
+			SChunk *chunk = NewChunk(m_next_chunk_size -
+									 GPOS_MEM_ARENA_CHUNK_HEADER_SIZE);
+			chunk->m_next = m_chunks;
+			m_chunks = chunk;
+
+			m_free = reinterpret_cast<BYTE *>(chunk) +
+					 GPOS_MEM_ARENA_CHUNK_HEADER_SIZE;
+			m_end = reinterpret_cast<BYTE *>(chunk) + chunk->m_size;
+
+			if (m_next_chunk_size < GPOS_MEM_ARENA_MAX_CHUNK_SIZE)
+			{
+				m_next_chunk_size *= 2;
+			}
+		}
+
+		ptr = m_free;
+		m_free += alloc_size;
+	}
+
+	SAllocHeader *header = reinterpret_cast<SAllocHeader *>(ptr);
+	header->m_user_size = bytes;
+	header->m_alloc_type = eat;
+	m_memory_pool_statistics.RecordAllocation(bytes, (ULONG) alloc_size);
+
+	void *ptr_result = ptr + GPOS_MEM_ARENA_ALLOC_HEADER_SIZE;
+
+#ifdef GPOS_DEBUG
+	clib::Memset(ptr_result, GPOS_MEM_INIT_PATTERN_CHAR, bytes);
+#endif	// GPOS_DEBUG
+
+	return ptr_result;
+}
+
+// free memory allocation; the memory is only reclaimed at tear down
+void
+CMemoryPoolArena::Free(void *ptr, EAllocationType eat)
+{
+	SAllocHeader *header = reinterpret_cast<SAllocHeader *>(
+		static_cast<BYTE *>(ptr) - GPOS_MEM_ARENA_ALLOC_HEADER_SIZE);
+	ULONG user_size = header->m_user_size;
+
+	GPOS_RTL_ASSERT(eat == EatUnknown || header->m_alloc_type == (ULONG) eat);
+
+	GPOS_ASSERT(this == Owner(ptr));
+	m_memory_pool_statistics.RecordFree(
+		user_size, (ULONG) GPOS_MEM_ARENA_BYTES_TOTAL((ULONG_PTR) user_size));
+
+#ifdef GPOS_DEBUG
+	// mark user memory as unused in debug mode
+	clib::Memset(ptr, GPOS_MEM_FREED_PATTERN_CHAR, user_size);
+#endif	// GPOS_DEBUG
+}
+
+// get user requested size of allocation
+ULONG
+CMemoryPoolArena::UserSizeOfAlloc(const void *ptr)
+{
+	const SAllocHeader *header = reinterpret_cast<const SAllocHeader *>(
+		static_cast<const BYTE *>(ptr) - GPOS_MEM_ARENA_ALLOC_HEADER_SIZE);
+
+	return header->m_user_size;
+}
+
+// prepare the memory pool to be deleted; releases all chunks at once
+void
+CMemoryPoolArena::TearDown()
+{
+	while (nullptr != m_chunks)
+	{
+		SChunk *chunk = m_chunks;
+		m_chunks = chunk->m_next;
+		UnregisterChunk(chunk);
+	}
+	m_free = nullptr;
+	m_end = nullptr;
+
+	// destroying the underlying pool frees the chunks
+	m_underlying_mp->TearDown();
+	GPOS_DELETE(m_underlying_mp);
+	m_underlying_mp = nullptr;
+}
+
+#ifdef GPOS_DEBUG
+// check if the memory pool is empty; live objects can't be walked, so only
+// their number is reported
+void
+CMemoryPoolArena::AssertEmpty(IOstream &os)
+{
+	ULLONG num_live_obj = m_memory_pool_statistics.GetNumLiveObj();
+	if (0 != num_live_obj && nullptr != ITask::Self() &&
+		!GPOS_FTRACE(EtraceDisablePrintMemoryLeak))
+	{
+		os << "Unfreed memory in memory pool " << (void *) this << ": "
+		   << num_live_obj << " objects leaked" << std::endl;
+
+		GPOS_ASSERT(!"leak detected");
+	}
+}
+#endif	// GPOS_DEBUG
+
+// registry entry of the given segment, or free entry to insert it into
+CMemoryPoolArena::SSegment *
+CMemoryPoolArena::FindSegment(ULONG_PTR segment)
+{
+	GPOS_ASSERT(0 != segment);
+	GPOS_ASSERT(GPOS_MEM_ARENA_DELETED_SEGMENT != segment);
+
+	ULONG mask = m_segments_capacity - 1;
+	ULONG pos = (ULONG)(segment * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+	SSegment *deleted = nullptr;
+
+	while (true)
+	{
+		SSegment *entry = &m_segments[pos];
+		if (entry->m_segment == segment)
+		{
+			return entry;
+		}
+		if (0 == entry->m_segment)
+		{
+			return (nullptr != deleted) ? deleted : entry;
+		}
+		if (GPOS_MEM_ARENA_DELETED_SEGMENT == entry->m_segment &&
+			nullptr == deleted)
+		{
+			deleted = entry;
+		}
+		pos = (pos + 1) & mask;
+	}
+}
+
+// pool owning the given segment, or nullptr
+CMemoryPoolArena *
+CMemoryPoolArena::LookupSegment(const void *ptr)
+{
+	ULONG_PTR segment = (ULONG_PTR) ptr / GPOS_MEM_ARENA_SEGMENT_SIZE;
+	if (0 == segment)
+	{
+		return nullptr;
+	}
+
+	SSegment *entry = FindSegment(segment);
+	if (entry->m_segment != segment)
+	{
+		return nullptr;
+	}
+
+	return entry->m_mp;
+}
+
+// grow the registry to take the given number of new segments, dropping
+// deleted entries
+void
+CMemoryPoolArena::GrowSegments(ULONG num_segments)
+{
+	ULONG old_capacity = m_segments_capacity;
+	SSegment *old_segments = m_segments;
+
+	ULONG capacity = GPOS_MEM_ARENA_INIT_REGISTRY_SIZE;
+	while (capacity < 4 * (m_segments_live + num_segments))
+	{
+		capacity *= 2;
+	}
+
+	SSegment *segments =
+		static_cast<SSegment *>(clib::Malloc(capacity * sizeof(SSegment)));
+	GPOS_OOM_CHECK(segments);
+	(void) clib::Memset(segments, 0, capacity * sizeof(SSegment));
+
+	m_segments = segments;
+	m_segments_capacity = capacity;
+	m_segments_used = 0;
+
+	for (ULONG ul = 0; ul < old_capacity; ul++)
+	{
+		SSegment *old_entry = &old_segments[ul];
+		if (0 != old_entry->m_segment &&
+			GPOS_MEM_ARENA_DELETED_SEGMENT != old_entry->m_segment)
+		{
+			*FindSegment(old_entry->m_segment) = *old_entry;
+			m_segments_used++;
+		}
+	}
+
+	if (nullptr != old_segments)
+	{
+		clib::Free(old_segments);
+	}
+}
+
+// register the segments of a chunk
+void
+CMemoryPoolArena::RegisterChunk(SChunk *chunk)
+{
+	ULONG_PTR first = (ULONG_PTR) chunk / GPOS_MEM_ARENA_SEGMENT_SIZE;
+	ULONG_PTR num_segments = chunk->m_size / GPOS_MEM_ARENA_SEGMENT_SIZE;
+
+	// keep the registry at most half full
+	if (2 * (m_segments_used + num_segments) > m_segments_capacity)
+	{
+		GrowSegments((ULONG) num_segments);
+	}
+
+	for (ULONG_PTR segment = first; segment < first + num_segments; segment++)
+	{
+		SSegment *entry = FindSegment(segment);
+		GPOS_ASSERT(entry->m_segment != segment);
+
+		if (0 == entry->m_segment)
+		{
+			m_segments_used++;
+		}
+		entry->m_segment = segment;
+		entry->m_mp = this;
+	}
+	m_segments_live += (ULONG) num_segments;
+}
+
+// unregister the segments of a chunk
+void
+CMemoryPoolArena::UnregisterChunk(SChunk *chunk)
+{
+	ULONG_PTR first = (ULONG_PTR) chunk / GPOS_MEM_ARENA_SEGMENT_SIZE;
+	ULONG_PTR num_segments = chunk->m_size / GPOS_MEM_ARENA_SEGMENT_SIZE;
+
+	for (ULONG_PTR segment = first; segment < first + num_segments; segment++)
+	{
+		SSegment *entry = FindSegment(segment);
+		GPOS_ASSERT(entry->m_segment == segment);
+
+		entry->m_segment = GPOS_MEM_ARENA_DELETED_SEGMENT;
+		entry->m_mp = nullptr;
+	}
+	m_segments_live -= (ULONG) num_segments;
+
+	// drop the registry with the last chunk
+	if (0 == m_segments_live)
+	{
+		clib::Free(m_segments);
+		m_segments = nullptr;
+		m_segments_capacity = 0;
+		m_segments_used = 0;
+	}
+}
+
+// EOF
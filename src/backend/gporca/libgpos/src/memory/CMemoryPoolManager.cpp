@@ -18,6 +18,7 @@
 #include "gpos/common/clibwrapper.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/memory/CMemoryPool.h"
+#include "gpos/memory/CMemoryPoolArena.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
 #include "gpos/task/CAutoSuspendAbort.h"
@@ -93,6 +94,40 @@ CMemoryPoolManager::CreateMemoryPool()
 }
 
 
+CMemoryPool *
+CMemoryPoolManager::CreateArenaMemoryPool()
+{
+	GPOS_ASSERT(nullptr != m_memory_pool_mgr);
+
+	// the chunks of the arena come from a pool of the usual type, which is
+	// not registered: the arena destroys it when torn down
+	CMemoryPool *underlying_mp = m_memory_pool_mgr->NewMemoryPool();
+	CMemoryPool *mp = nullptr;
+	GPOS_TRY
+	{
+		mp = GPOS_NEW(m_memory_pool_mgr->m_internal_memory_pool)
+			CMemoryPoolArena(underlying_mp);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		underlying_mp->TearDown();
+		GPOS_DELETE(underlying_mp);
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	// accessor scope
+	{
+		// HERE BE DRAGONS
+		// See comment in CCache::InsertEntry
+		const ULONG_PTR hashKey = mp->GetHashKey();
+		MemoryPoolKeyAccessor acc(*m_memory_pool_mgr->m_ht_all_pools, hashKey);
+		acc.Insert(mp);
+	}
+
+	return mp;
+}
+
 // Allocate a new NewMemoryPool
 CMemoryPool *
 CMemoryPoolManager::NewMemoryPool()
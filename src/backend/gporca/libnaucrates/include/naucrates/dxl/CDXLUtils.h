@@ -50,6 +50,7 @@ XERCES_CPP_NAMESPACE_USE
 
 // fwd decl
 class CParseHandlerDXL;
+class CDXLBinaryWriter;
 class CDXLMemoryManager;
 class CQueryToDXLResult;
 
@@ -71,6 +72,23 @@ private:
 		CMemoryPool *, const CWStringBase *dxl_string,
 		const CHAR *xsd_file_path);
 
+	// collect the plan from the given top-level parser and destroy it
+	static CDXLNode *ExtractPlanDXLNode(CParseHandlerDXL *parse_handler_dxl,
+										ULLONG *plan_id,
+										ULLONG *plan_space_size);
+
+	// serialize a plan with the given serializer
+	static void SerializePlan(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+							  const CDXLNode *node, ULLONG plan_id,
+							  ULLONG plan_space_size,
+							  BOOL serialize_document_header_footer);
+
+	// serialize metadata objects with the given serializer
+	static void SerializeMetadata(CMemoryPool *mp,
+								  const IMDCacheObjectArray *imd_obj_array,
+								  CXMLSerializer *xml_serializer,
+								  BOOL serialize_document_header_footer);
+
 
 
 public:
@@ -87,11 +105,21 @@ public:
 	static CParseHandlerDXL *GetParseHandlerForDXLFile(
 		CMemoryPool *, const CHAR *dxl_filename, const CHAR *xsd_file_path);
 
+	// same as above but for a binary DXL document, see CDXLBinaryWriter
+	static CParseHandlerDXL *GetParseHandlerForDXLBinary(CMemoryPool *,
+														 const BYTE *data,
+														 ULONG size);
+
 	// parse a DXL document containing a DXL plan
 	static CDXLNode *GetPlanDXLNode(CMemoryPool *, const CHAR *dxl_string,
 									const CHAR *xsd_file_path, ULLONG *plan_id,
 									ULLONG *plan_space_size);
 
+	// parse a binary DXL document containing a DXL plan
+	static CDXLNode *GetPlanDXLNodeFromBinary(CMemoryPool *, const BYTE *data,
+											  ULONG size, ULLONG *plan_id,
+											  ULLONG *plan_space_size);
+
 	// parse a DXL document representing a query
 	// to return the DXL tree representing the query and
 	// a DXL tree representing the query output
@@ -124,6 +152,10 @@ public:
 		CMemoryPool *, const CWStringBase *dxl_string,
 		const CHAR *xsd_file_path);
 
+	// parse a list of metadata objects from a binary DXL document
+	static IMDCacheObjectArray *ParseDXLBinaryToIMDObjectArray(
+		CMemoryPool *, const BYTE *data, ULONG size);
+
 	// parse mdid from a metadata document
 	static IMDId *ParseDXLToMDId(CMemoryPool *, const CWStringBase *dxl_string,
 								 const CHAR *xsd_file_path);
@@ -170,6 +202,11 @@ public:
 							  BOOL serialize_document_header_footer,
 							  BOOL indentation);
 
+	// serialize a plan into a binary DXL document
+	static void SerializePlan(CMemoryPool *mp, CDXLBinaryWriter *binary_writer,
+							  const CDXLNode *node, ULLONG plan_id,
+							  ULLONG plan_space_size);
+
 	static CWStringDynamic *SerializeStatistics(
 		CMemoryPool *mp, CMDAccessor *md_accessor,
 		const CStatisticsArray *statistics_array, BOOL serialize_header_footer,
@@ -189,6 +226,12 @@ public:
 								  BOOL serialize_document_header_footer,
 								  BOOL indentation);
 
+	// serialize metadata objects, including statistics objects, into a
+	// binary DXL document
+	static void SerializeMetadata(CMemoryPool *mp,
+								  const IMDCacheObjectArray *imd_obj_array,
+								  CDXLBinaryWriter *binary_writer);
+
 	// serialize metadata ids into a MD request message
 	static void SerializeMDRequest(CMemoryPool *mp, CMDRequest *md_request,
 								   IOstream &os,
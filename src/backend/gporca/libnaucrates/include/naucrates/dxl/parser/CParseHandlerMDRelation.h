@@ -75,6 +75,12 @@ protected:
 	// part constraint
 	CDXLNode *m_part_constraint;
 
+	// part constraints of the child partitions
+	CDXLNodeArray *m_child_part_constraints;
+
+	// are we parsing the part constraints of the child partitions
+	BOOL m_parsing_child_part_constraints;
+
 	// distribution opfamilies parse handler
 	CParseHandlerBase *m_opfamilies_parse_handler;
 
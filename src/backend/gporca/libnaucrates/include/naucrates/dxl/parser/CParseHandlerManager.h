@@ -48,7 +48,8 @@ private:
 	// the memory manager used for parsing the current document
 	CDXLMemoryManager *m_dxl_memory_manager;
 
-	// parser object responsible for parsing the current XML document
+	// parser object responsible for parsing the current XML document,
+	// nullptr for binary documents, see CDXLBinaryReader
 	SAX2XMLReader *m_xml_reader;
 
 	// current parse handler
@@ -63,6 +64,9 @@ private:
 	// check for aborts at regular intervals
 	void CheckForAborts();
 
+	// make the XML parser, if any, send its events to the current handler
+	void SetXMLReaderHandler();
+
 
 public:
 	CParseHandlerManager(const CParseHandlerManager &) = delete;
@@ -95,8 +99,8 @@ public:
 	// Deactivates current handler and returns control to the previously active one.
 	void DeactivateHandler();
 
-	// Returns the current parse handler if one exists; used for debugging purposes
-	const CParseHandlerBase *GetCurrentParseHandler();
+	// Returns the current parse handler if one exists
+	CParseHandlerBase *GetCurrentParseHandler();
 };
 }  // namespace gpdxl
 #endif	// !GPDXL_CParseHandlerManager_H
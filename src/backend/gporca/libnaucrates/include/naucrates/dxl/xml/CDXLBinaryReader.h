@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLBinaryReader.h
+//
+//	@doc:
+//		Reader of the compact binary encoding of DXL documents
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLBinaryReader_H
+#define GPDXL_CDXLBinaryReader_H
+
+#include <xercesc/sax2/Attributes.hpp>
+
+#include "gpos/base.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+XERCES_CPP_NAMESPACE_USE
+
+// fwd decl
+class CParseHandlerManager;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryReader
+//
+//	@doc:
+//		Replays a document written by CDXLBinaryWriter to the parse handlers,
+//		as the SAX events Xerces would produce for the same document in XML,
+//		see CDXLBinaryWriter for the encoding.
+//
+//		The reader is the attribute list of the element being started.
+//		Like the one of Xerces, it is only valid during the call of
+//		startElement.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryReader : public Attributes
+{
+private:
+	// name of an element or attribute
+	struct SName
+	{
+		// qualified name
+		XMLCh *m_qname;
+
+		// local part of the name, points into the qualified name
+		const XMLCh *m_local_name;
+
+		// URI of the namespace of the name, empty if it has no prefix
+		const XMLCh *m_uri;
+	};
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// encoded document
+	const BYTE *m_data;
+
+	// size of the encoded document
+	ULONG m_size;
+
+	// position of the next byte to read
+	ULONG m_pos;
+
+	// names read so far, by number
+	SName *m_names;
+
+	// number of names read so far
+	ULONG m_num_names;
+
+	// size of the array of names
+	ULONG m_names_capacity;
+
+	// numbers of the names of the attributes of the current element
+	ULONG *m_attr_names;
+
+	// offsets of the values of the attributes of the current element
+	ULONG *m_attr_values;
+
+	// number of attributes of the current element
+	ULONG m_num_attrs;
+
+	// size of the arrays of attributes
+	ULONG m_attrs_capacity;
+
+	// null-terminated values of the attributes of the current element
+	XMLCh *m_values;
+
+	// size of the values of the attributes of the current element
+	ULONG m_values_size;
+
+	// size of the buffer of values
+	ULONG m_values_capacity;
+
+	// numbers of the names of the open elements
+	ULONG *m_open_elems;
+
+	// number of open elements
+	ULONG m_num_open_elems;
+
+	// size of the array of open elements
+	ULONG m_open_elems_capacity;
+
+	// raise an exception for a malformed document
+	static void RaiseMalformed();
+
+	// read a byte
+	BYTE ReadByte();
+
+	// read an unsigned number
+	ULONG ReadNumber();
+
+	// read a name, return its number
+	ULONG ReadName();
+
+	// read an attribute of the current element
+	void ReadAttribute();
+
+	// name of the attribute at the given index
+	const SName &
+	AttrName(XMLSize_t index) const
+	{
+		GPOS_ASSERT(index < m_num_attrs);
+
+		return m_names[m_attr_names[index]];
+	}
+
+public:
+	CDXLBinaryReader(const CDXLBinaryReader &) = delete;
+
+	// ctor
+	CDXLBinaryReader(CMemoryPool *mp, const BYTE *data, ULONG size);
+
+	// dtor
+	~CDXLBinaryReader() override;
+
+	// replay the document to the parse handlers of the given manager
+	void Parse(CParseHandlerManager *parse_handler_mgr);
+
+	// Xerces attribute list interface
+	XMLSize_t getLength() const override;
+
+	const XMLCh *getURI(const XMLSize_t index) const override;
+
+	const XMLCh *getLocalName(const XMLSize_t index) const override;
+
+	const XMLCh *getQName(const XMLSize_t index) const override;
+
+	const XMLCh *getType(const XMLSize_t index) const override;
+
+	const XMLCh *getValue(const XMLSize_t index) const override;
+
+	bool getIndex(const XMLCh *const uri, const XMLCh *const localPart,
+				  XMLSize_t &index) const override;
+
+	int getIndex(const XMLCh *const uri,
+				 const XMLCh *const localPart) const override;
+
+	bool getIndex(const XMLCh *const qName, XMLSize_t &index) const override;
+
+	int getIndex(const XMLCh *const qName) const override;
+
+	const XMLCh *getType(const XMLCh *const uri,
+						 const XMLCh *const localPart) const override;
+
+	const XMLCh *getType(const XMLCh *const qName) const override;
+
+	const XMLCh *getValue(const XMLCh *const uri,
+						  const XMLCh *const localPart) const override;
+
+	const XMLCh *getValue(const XMLCh *const qName) const override;
+};	// class CDXLBinaryReader
+}  // namespace gpdxl
+
+#endif	// !GPDXL_CDXLBinaryReader_H
+
+// EOF
@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLBinaryWriter.h
+//
+//	@doc:
+//		Writer of the compact binary encoding of DXL documents
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLBinaryWriter_H
+#define GPDXL_CDXLBinaryWriter_H
+
+#include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/string/CWStringConst.h"
+#include "gpos/string/CWStringDynamic.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+// header of a binary DXL document, followed by its records
+#define GPDXL_BINARY_MAGIC "DXB"
+#define GPDXL_BINARY_VERSION 1
+
+// records of a binary DXL document
+enum EDxlBinaryRecord
+{
+	EdxlbinOpen = 1,  // start of an element: name
+	EdxlbinAttr,	  // attribute of the element just started: name, value
+	EdxlbinClose	  // end of the innermost open element
+};
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLBinaryWriter
+//
+//	@doc:
+//		Compact binary encoding of a DXL document, written by a
+//		CXMLSerializer in place of XML and replayed to the parse handlers by
+//		CDXLBinaryReader, without going through Xerces.
+//
+//		The document is a sequence of element and attribute records.
+//		Element and attribute names are numbered in the order they first
+//		occur and spelled out only then, so a large document mostly repeats
+//		small numbers. Strings are sequences of UTF-16 code units, and
+//		numbers, including those code units, are written in 7-bit groups,
+//		least significant first, so values in the ASCII range take a byte.
+//		Attribute values are the strings the XML document would contain,
+//		but unescaped, so the parse handlers see the same input either way.
+//
+//---------------------------------------------------------------------------
+class CDXLBinaryWriter
+{
+private:
+	// map from names to their numbers
+	using NameMap =
+		CHashMap<CWStringConst, ULONG, CWStringConst::HashValue,
+				 CWStringConst::Equals, CleanupDelete<CWStringConst>,
+				 CleanupDelete<ULONG>>;
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// encoded document
+	BYTE *m_data;
+
+	// size of the encoded document
+	ULONG m_size;
+
+	// size of the buffer of the encoded document
+	ULONG m_capacity;
+
+	// numbers of the names written so far
+	NameMap *m_names;
+
+	// scratch buffer for qualified element names
+	CWStringDynamic *m_qname;
+
+	// value of the next attribute, as formatted by the value stream
+	CWStringDynamic *m_value;
+
+	// stream formatting attribute values
+	COstreamString *m_value_os;
+
+	// make room for the given number of bytes
+	void Reserve(ULONG size);
+
+	// write a byte
+	void
+	WriteByte(BYTE byte)
+	{
+		Reserve(1);
+		m_data[m_size++] = byte;
+	}
+
+	// write an unsigned number
+	void WriteNumber(ULONG number);
+
+	// write a string
+	void WriteString(const CWStringBase *str);
+
+	// write the number of a name, followed by the name if it is new
+	void WriteName(const CWStringBase *name);
+
+public:
+	CDXLBinaryWriter(const CDXLBinaryWriter &) = delete;
+
+	// ctor
+	explicit CDXLBinaryWriter(CMemoryPool *mp);
+
+	// dtor
+	~CDXLBinaryWriter();
+
+	// stream to format the value of the next attribute into, see
+	// AddStreamedAttribute
+	IOstream &
+	ValueStream()
+	{
+		return *m_value_os;
+	}
+
+	// start an element
+	void OpenElement(const CWStringBase *pstrNamespace,
+					 const CWStringBase *elem_str);
+
+	// end the innermost open element
+	void CloseElement();
+
+	// add a string-valued attribute to the element just started
+	void AddAttribute(const CWStringBase *pstrAttr,
+					  const CWStringBase *str_value);
+
+	// add an attribute whose value was written to the value stream
+	void AddStreamedAttribute(const CWStringBase *pstrAttr);
+
+	// encoded document
+	const BYTE *
+	GetData() const
+	{
+		return m_data;
+	}
+
+	// size of the encoded document
+	ULONG
+	Size() const
+	{
+		return m_size;
+	}
+};	// class CDXLBinaryWriter
+}  // namespace gpdxl
+
+#endif	// !GPDXL_CDXLBinaryWriter_H
+
+// EOF
@@ -18,6 +18,7 @@
 #include "gpos/io/COstream.h"
 #include "gpos/string/CWStringConst.h"
 
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 
 namespace gpdxl
@@ -29,7 +30,9 @@ using namespace gpos;
 //		CXMLSerializer
 //
 //	@doc:
-//		Class for creating XML documents.
+//		Class for creating XML documents. A serializer constructed with a
+//		binary writer creates the same document in the binary encoding of
+//		CDXLBinaryWriter instead.
 //
 //---------------------------------------------------------------------------
 class CXMLSerializer
@@ -59,6 +62,9 @@ private:
 	// steps since last check for aborts
 	ULONG m_iteration_since_last_abortcheck;
 
+	// writer of the binary document, nullptr for XML documents
+	CDXLBinaryWriter *m_binary_writer;
+
 	// add indentation
 	void Indent();
 
@@ -76,7 +82,23 @@ public:
 		  m_strstackElems(nullptr),
 		  m_fOpenTag(false),
 		  m_ulLevel(0),
-		  m_iteration_since_last_abortcheck(0)
+		  m_iteration_since_last_abortcheck(0),
+		  m_binary_writer(nullptr)
+	{
+		m_strstackElems = GPOS_NEW(m_mp) StrStack(m_mp);
+	}
+
+	// ctor of a serializer writing a binary document; attribute values
+	// are formatted by the value stream of the writer
+	CXMLSerializer(CMemoryPool *mp, CDXLBinaryWriter *binary_writer)
+		: m_mp(mp),
+		  m_os(binary_writer->ValueStream()),
+		  m_indentation(false),
+		  m_strstackElems(nullptr),
+		  m_fOpenTag(false),
+		  m_ulLevel(0),
+		  m_iteration_since_last_abortcheck(0),
+		  m_binary_writer(binary_writer)
 	{
 		m_strstackElems = GPOS_NEW(m_mp) StrStack(m_mp);
 	}
@@ -72,6 +72,8 @@ enum Edxltoken
 	EdxltokenPushGroupByBelowSetopThreshold,
 	EdxltokenXformBindThreshold,
 	EdxltokenSkewFactor,
+	EdxltokenTimeBudget,
+	EdxltokenMemoryBudget,
 	EdxltokenMaxStatsBuckets,
 	EdxltokenWindowOids,
 	EdxltokenOidRowNumber,
@@ -569,6 +571,7 @@ enum Edxltoken
 	EdxltokenCheckConstraints,
 	EdxltokenCheckConstraint,
 	EdxltokenPartConstraint,
+	EdxltokenChildPartConstraints,
 	EdxltokenDefaultPartition,
 	EdxltokenPartConstraintUnbounded,
 
@@ -61,6 +61,9 @@ enum ExMinor
 	// exceptions related to constant expression evaluation
 	ExmiConstExprEvalNonConst,
 
+	// binary DXL parsing errors
+	ExmiDXLBinaryParseError,
+
 	ExmiDXLSentinel
 };
 
@@ -103,6 +103,9 @@ private:
 	// partition constraint
 	CDXLNode *m_mdpart_constraint;
 
+	// part constraints of the child partitions
+	CDXLNodeArray *m_child_part_constraints;
+
 	// number of system columns
 	ULONG m_system_columns;
 
@@ -138,7 +141,8 @@ public:
 		IMdIdArray *partition_oids, BOOL convert_hash_to_random,
 		ULongPtr2dArray *keyset_array, CMDIndexInfoArray *md_index_info_array,
 		IMdIdArray *mdid_check_constraint_array, CDXLNode *mdpart_constraint,
-		IMDId *foreign_server, CDouble rows);
+		CDXLNodeArray *child_part_constraints, IMDId *foreign_server,
+		CDouble rows);
 
 	// dtor
 	~CMDRelationGPDB() override;
@@ -244,6 +248,9 @@ public:
 	// child partition oids
 	IMdIdArray *ChildPartitionMdids() const override;
 
+	// part constraints of the child partitions
+	CDXLNodeArray *ChildPartConstraints() const override;
+
 	IMDId *ForeignServer() const override;
 
 	CDouble Rows() const override;
@@ -14,6 +14,7 @@
 
 #include "gpos/base.h"
 
+#include "naucrates/dxl/operators/CDXLNode.h"
 #include "naucrates/md/CMDIndexInfo.h"
 #include "naucrates/md/IMDCacheObject.h"
 #include "naucrates/md/IMDColumn.h"
@@ -65,6 +66,7 @@ public:
 		AORelationVersion_None,
 		AORelationVersion_GP6,
 		AORelationVersion_GP7,
+		AORelationVersion_BlkdirZoneMap,
 		MaxAORelationVersion
 	};
 
@@ -202,6 +204,15 @@ public:
 		return nullptr;
 	}
 
+	// part constraints of the child partitions in terms of the columns of
+	// this relation, in the order of ChildPartitionMdids, or nullptr if they
+	// are not available, in particular if a child partition is foreign
+	virtual CDXLNodeArray *
+	ChildPartConstraints() const
+	{
+		return nullptr;
+	}
+
 	// relation distribution policy as a string value
 	static const CWStringConst *GetDistrPolicyStr(
 		Ereldistrpolicy rel_distr_policy);
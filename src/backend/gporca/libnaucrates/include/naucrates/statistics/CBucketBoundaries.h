@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CBucketBoundaries.h
+//
+//	@doc:
+//		Columnar copy of the bucket boundaries of a histogram
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CBucketBoundaries_H
+#define GPNAUCRATES_CBucketBoundaries_H
+
+#include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
+
+#include "naucrates/statistics/CBucket.h"
+
+namespace gpnaucrates
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CBucketBoundaries
+//
+//	@doc:
+//		The lower and upper bounds of the buckets of a histogram, stored in
+//		flat arrays as the LINT or double values that statistics compare
+//		datums by (see IDatum::StatsAreLessThan).
+//
+//		Comparing two values of the arrays takes no virtual calls, and since
+//		the buckets of a valid histogram are ordered, the bucket containing
+//		a point can be found by binary search rather than by a linear scan
+//		over the buckets. Histograms whose bounds can't be represented this
+//		way, because a bound is null or not mappable to a single kind of
+//		value, or whose buckets are not strictly ordered, have none.
+//
+//---------------------------------------------------------------------------
+class CBucketBoundaries : public CRefCount
+{
+public:
+	// value of a point, as mapped for statistics; only the member of the
+	// kind of the boundaries is set
+	struct SValue
+	{
+		LINT m_lint;
+
+		DOUBLE m_double;
+	};
+
+private:
+	// kinds of values
+	enum EValueKind
+	{
+		EvkLint,   // datums mapped to LINT, compared exactly
+		EvkDouble  // datums mapped to double, compared up to epsilon
+	};
+
+	// kind of the values
+	EValueKind m_kind;
+
+	// number of buckets
+	ULONG m_size;
+
+	// lower bounds of the buckets
+	SValue *m_lower;
+
+	// upper bounds of the buckets
+	SValue *m_upper;
+
+	// are the upper bounds of the buckets closed?
+	BOOL *m_is_upper_closed;
+
+	// ctor
+	CBucketBoundaries(CMemoryPool *mp, EValueKind kind, ULONG size);
+
+	// value of a datum of the given kind
+	static SValue Value(const IDatum *datum, EValueKind kind);
+
+	// compare two values, return -1, 0 or 1
+	INT Compare(const SValue &value1, const SValue &value2) const;
+
+	// is the point with the given value after the bucket at the given
+	// index, see CBucket::IsAfter
+	BOOL IsAfter(ULONG index, const SValue &value) const;
+
+	// are two values equal, or apart with the first one less than the
+	// second one?
+	BOOL FEqualOrApart(const SValue &value1, const SValue &value2,
+					   BOOL *is_equal) const;
+
+	// do the boundaries allow binary search over the buckets?
+	BOOL IsOrdered(const CBucketArray *buckets) const;
+
+public:
+	CBucketBoundaries(const CBucketBoundaries &) = delete;
+
+	// dtor
+	~CBucketBoundaries() override;
+
+	// boundaries of the given buckets, nullptr if they have none
+	static CBucketBoundaries *Pbb(CMemoryPool *mp, const CBucketArray *buckets);
+
+	// number of buckets
+	ULONG
+	Size() const
+	{
+		return m_size;
+	}
+
+	// get the value of a point comparable to the boundaries, return false
+	// if the point must be compared to the buckets instead
+	BOOL FValue(const CPoint *point, SValue *value) const;
+
+	// index of the first bucket that the point with the given value is not
+	// after, i.e. that contains the point or comes after it; the number of
+	// buckets if there is none
+	ULONG UlFindPoint(const SValue &value) const;
+
+	// index of the first bucket at or after the given index whose upper
+	// bound is not less than the given value; the buckets skipped end
+	// before a bucket with the given lower bound starts
+	ULONG UlFirstUpperNotBelow(ULONG begin, const SValue &value) const;
+};	// class CBucketBoundaries
+
+}  // namespace gpnaucrates
+
+#endif	// !GPNAUCRATES_CBucketBoundaries_H
+
+// EOF
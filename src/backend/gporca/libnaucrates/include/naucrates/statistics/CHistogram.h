@@ -16,6 +16,7 @@
 
 #include "gpopt/base/CKHeap.h"
 #include "naucrates/statistics/CBucket.h"
+#include "naucrates/statistics/CBucketBoundaries.h"
 #include "naucrates/statistics/CStatsPred.h"
 
 namespace gpopt
@@ -95,6 +96,24 @@ private:
 	// is column statistics missing in the database
 	BOOL m_is_col_stats_missing;
 
+	// columnar copy of the bucket boundaries, built on first use and shared
+	// by the copies of the histogram like the buckets are; nullptr if the
+	// buckets have none
+	mutable CBucketBoundaries *m_bucket_boundaries;
+
+	// have the bucket boundaries been built?
+	mutable BOOL m_bucket_boundaries_built;
+
+	// bucket boundaries, nullptr if the buckets have none
+	const CBucketBoundaries *GetBucketBoundaries() const;
+
+	// index of the first bucket that may contain the given point
+	ULONG FindPoint(const CPoint *point) const;
+
+	// index of the first bucket at or after the given index that may not
+	// end before the given bucket starts
+	ULONG SkipBucketsBefore(ULONG begin, const CBucket *bucket) const;
+
 	// return an array buckets after applying equality filter on the histogram buckets
 	CBucketArray *MakeBucketsWithEqualityFilter(CPoint *point) const;
 
@@ -363,6 +382,7 @@ public:
 	virtual ~CHistogram()
 	{
 		m_histogram_buckets->Release();
+		CRefCount::SafeRelease(m_bucket_boundaries);
 	}
 
 	// normalize histogram and return scaling factor
@@ -80,6 +80,9 @@ enum EOptTraceFlag
 	// log results of hint parsing
 	EopttracePrintPgHintPlanLog = 101018,
 
+	// print a one-line summary of the memo and the xforms applied
+	EopttracePrintOptimizationSummary = 101019,
+
 	///////////////////////////////////////////////////////
 	////////////////// transformations flags //////////////
 	///////////////////////////////////////////////////////
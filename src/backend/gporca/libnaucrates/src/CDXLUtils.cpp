@@ -39,6 +39,8 @@
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 #include "naucrates/dxl/parser/CParseHandlerPlan.h"
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/md/CDXLStatsDerivedRelation.h"
@@ -257,6 +259,39 @@ CDXLUtils::GetParseHandlerForDXLString(CMemoryPool *mp,
 
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::GetParseHandlerForDXLBinary
+//
+//	@doc:
+//		Parse the given binary DXL document, written by a CDXLBinaryWriter,
+//		and return the top-level parser. The document is replayed to the
+//		same parse handlers as XML documents, without Xerces.
+//
+//---------------------------------------------------------------------------
+CParseHandlerDXL *
+CDXLUtils::GetParseHandlerForDXLBinary(CMemoryPool *mp, const BYTE *data,
+									   ULONG size)
+{
+	GPOS_ASSERT(nullptr != mp);
+	GPOS_ASSERT(nullptr != data);
+
+	// the parse handlers transcode attribute values with the memory manager
+	CDXLMemoryManager mm(mp);
+	CParseHandlerManager parse_handler_mgr(&mm, nullptr /*sax_2_xml_reader*/);
+
+	CAutoP<CParseHandlerDXL> parse_handler_dxl(
+		CParseHandlerFactory::GetParseHandlerDXL(mp, &parse_handler_mgr));
+	parse_handler_mgr.ActivateParseHandler(parse_handler_dxl.Value());
+
+	CDXLBinaryReader binary_reader(mp, data, size);
+	binary_reader.Parse(&parse_handler_mgr);
+
+	GPOS_CHECK_ABORT;
+
+	return parse_handler_dxl.Reset();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::GetPlanDXLNode
@@ -279,6 +314,49 @@ CDXLUtils::GetPlanDXLNode(CMemoryPool *mp, const CHAR *dxl_string,
 	// create and install a parse handler for the DXL document
 	CParseHandlerDXL *parse_handler_dxl =
 		GetParseHandlerForDXLString(mp, dxl_string, xsd_file_path);
+
+	return ExtractPlanDXLNode(parse_handler_dxl, plan_id, plan_space_size);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::GetPlanDXLNodeFromBinary
+//
+//	@doc:
+//		Parse a binary DXL document into a DXL plan tree
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CDXLUtils::GetPlanDXLNodeFromBinary(CMemoryPool *mp, const BYTE *data,
+									ULONG size, ULLONG *plan_id,
+									ULLONG *plan_space_size)
+{
+	GPOS_ASSERT(nullptr != mp);
+	GPOS_ASSERT(nullptr != plan_id);
+	GPOS_ASSERT(nullptr != plan_space_size);
+
+	CAutoTimer at("\n[OPT]: Binary DXL Plan Parsing Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
+
+	CParseHandlerDXL *parse_handler_dxl =
+		GetParseHandlerForDXLBinary(mp, data, size);
+
+	return ExtractPlanDXLNode(parse_handler_dxl, plan_id, plan_space_size);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::ExtractPlanDXLNode
+//
+//	@doc:
+//		Collect the plan tree, plan id and plan space size from the given
+//		top-level parser, and destroy it
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CDXLUtils::ExtractPlanDXLNode(CParseHandlerDXL *parse_handler_dxl,
+							  ULLONG *plan_id, ULLONG *plan_space_size)
+{
 	CAutoP<CParseHandlerDXL> parse_handler_dxl_wrapper(parse_handler_dxl);
 
 	GPOS_ASSERT(nullptr != parse_handler_dxl_wrapper.Value());
@@ -406,6 +484,31 @@ CDXLUtils::ParseDXLToIMDObjectArray(CMemoryPool *mp, const CHAR *dxl_string,
 	return imd_obj_array;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::ParseDXLBinaryToIMDObjectArray
+//
+//	@doc:
+//		Parse a list of metadata objects from the given binary DXL document
+//
+//---------------------------------------------------------------------------
+IMDCacheObjectArray *
+CDXLUtils::ParseDXLBinaryToIMDObjectArray(CMemoryPool *mp, const BYTE *data,
+										  ULONG size)
+{
+	GPOS_ASSERT(nullptr != mp);
+
+	CAutoP<CParseHandlerDXL> parse_handler_dxl(
+		GetParseHandlerForDXLBinary(mp, data, size));
+
+	// collect metadata objects from dxl parse handler
+	IMDCacheObjectArray *imd_obj_array =
+		parse_handler_dxl->GetMdIdCachedObjArray();
+	imd_obj_array->AddRef();
+
+	return imd_obj_array;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::ParseDXLToMDId
@@ -892,32 +995,73 @@ CDXLUtils::SerializePlan(CMemoryPool *mp, IOstream &os, const CDXLNode *node,
 				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
 	CXMLSerializer xml_serializer(mp, os, indentation);
+	SerializePlan(mp, &xml_serializer, node, plan_id, plan_space_size,
+				  serialize_header_footer);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlan
+//
+//	@doc:
+//		Serialize a DXL tree into a binary DXL document
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializePlan(CMemoryPool *mp, CDXLBinaryWriter *binary_writer,
+						 const CDXLNode *node, ULLONG plan_id,
+						 ULLONG plan_space_size)
+{
+	GPOS_ASSERT(nullptr != mp);
+	GPOS_ASSERT(nullptr != binary_writer);
+	GPOS_ASSERT(nullptr != node);
+
+	CAutoTimer at("\n[OPT]: Binary DXL Plan Serialization Time",
+				  GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
+	CXMLSerializer xml_serializer(mp, binary_writer);
+	SerializePlan(mp, &xml_serializer, node, plan_id, plan_space_size,
+				  true /*serialize_header_footer*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlan
+//
+//	@doc:
+//		Serialize a DXL tree with the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializePlan(CMemoryPool *mp, CXMLSerializer *xml_serializer,
+						 const CDXLNode *node, ULLONG plan_id,
+						 ULLONG plan_space_size, BOOL serialize_header_footer)
+{
 	if (serialize_header_footer)
 	{
-		SerializeHeader(mp, &xml_serializer);
+		SerializeHeader(mp, xml_serializer);
 	}
 
-	xml_serializer.OpenElement(
+	xml_serializer->OpenElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlan));
 
 	// serialize plan id and space size attributes
 
-	xml_serializer.AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenPlanId),
-								plan_id);
-	xml_serializer.AddAttribute(
+	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenPlanId),
+								 plan_id);
+	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlanSpaceSize), plan_space_size);
 
-	node->SerializeToDXL(&xml_serializer);
+	node->SerializeToDXL(xml_serializer);
 
-	xml_serializer.CloseElement(
+	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenPlan));
 
 	if (serialize_header_footer)
 	{
-		SerializeFooter(&xml_serializer);
+		SerializeFooter(xml_serializer);
 	}
 }
 
@@ -940,13 +1084,53 @@ CDXLUtils::SerializeMetadata(CMemoryPool *mp,
 	GPOS_ASSERT(nullptr != imd_obj_array);
 
 	CXMLSerializer xml_serializer(mp, os, indentation);
+	SerializeMetadata(mp, imd_obj_array, &xml_serializer,
+					  serialize_header_footer);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeMetadata
+//
+//	@doc:
+//		Serialize a list of MD objects, including relation and column
+//		statistics, into a binary DXL document
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializeMetadata(CMemoryPool *mp,
+							 const IMDCacheObjectArray *imd_obj_array,
+							 CDXLBinaryWriter *binary_writer)
+{
+	GPOS_ASSERT(nullptr != mp);
+	GPOS_ASSERT(nullptr != imd_obj_array);
+	GPOS_ASSERT(nullptr != binary_writer);
 
+	CXMLSerializer xml_serializer(mp, binary_writer);
+	SerializeMetadata(mp, imd_obj_array, &xml_serializer,
+					  true /*serialize_header_footer*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeMetadata
+//
+//	@doc:
+//		Serialize a list of MD objects with the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializeMetadata(CMemoryPool *mp,
+							 const IMDCacheObjectArray *imd_obj_array,
+							 CXMLSerializer *xml_serializer,
+							 BOOL serialize_header_footer)
+{
 	if (serialize_header_footer)
 	{
-		SerializeHeader(mp, &xml_serializer);
+		SerializeHeader(mp, xml_serializer);
 	}
 
-	xml_serializer.OpenElement(
+	xml_serializer->OpenElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenMetadata));
 
@@ -954,19 +1138,17 @@ CDXLUtils::SerializeMetadata(CMemoryPool *mp,
 	for (ULONG ul = 0; ul < imd_obj_array->Size(); ul++)
 	{
 		IMDCacheObject *imd_cache_obj = (*imd_obj_array)[ul];
-		imd_cache_obj->Serialize(&xml_serializer);
+		imd_cache_obj->Serialize(xml_serializer);
 	}
 
-	xml_serializer.CloseElement(
+	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenMetadata));
 
 	if (serialize_header_footer)
 	{
-		SerializeFooter(&xml_serializer);
+		SerializeFooter(xml_serializer);
 	}
-
-	return;
 }
 
 //---------------------------------------------------------------------------
@@ -205,6 +205,12 @@ gpdxl::EresExceptionInit(CMemoryPool *mp)
 			GPOS_WSZ_WSZLEN(
 				"DXL-to-Expr Translation: Attribute number not found in project list")),
 
+		CMessage(CException(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError),
+				 CException::ExsevError,
+				 GPOS_WSZ_WSZLEN("Malformed binary DXL document"),
+				 0,	 //
+				 GPOS_WSZ_WSZLEN("Malformed binary DXL document")),
+
 	};
 
 	// copy exception array into heap
@@ -38,7 +38,8 @@ CMDRelationGPDB::CMDRelationGPDB(
 	IMdIdArray *partition_oids, BOOL convert_hash_to_random,
 	ULongPtr2dArray *keyset_array, CMDIndexInfoArray *md_index_info_array,
 	IMdIdArray *mdid_check_constraint_array, CDXLNode *mdpart_constraint,
-	IMDId *foreign_server, CDouble rows)
+	CDXLNodeArray *child_part_constraints, IMDId *foreign_server,
+	CDouble rows)
 	: m_mp(mp),
 	  m_mdid(mdid),
 	  m_mdname(mdname),
@@ -58,6 +59,7 @@ CMDRelationGPDB::CMDRelationGPDB(
 	  m_mdindex_info_array(md_index_info_array),
 	  m_mdid_check_constraint_array(mdid_check_constraint_array),
 	  m_mdpart_constraint(mdpart_constraint),
+	  m_child_part_constraints(child_part_constraints),
 	  m_system_columns(0),
 	  m_foreign_server(foreign_server),
 	  m_colpos_nondrop_colpos_map(nullptr),
@@ -75,6 +77,9 @@ CMDRelationGPDB::CMDRelationGPDB(
 			"Converting hash distributed table to random only possible for hash distributed tables");
 	GPOS_ASSERT(nullptr == distr_opfamilies ||
 				distr_opfamilies->Size() == m_distr_col_array->Size());
+	GPOS_ASSERT(nullptr == child_part_constraints ||
+				(nullptr != partition_oids &&
+				 child_part_constraints->Size() == partition_oids->Size()));
 
 	m_colpos_nondrop_colpos_map = GPOS_NEW(m_mp) UlongToUlongMap(m_mp);
 	m_attrno_nondrop_col_pos_map = GPOS_NEW(m_mp) IntToUlongMap(m_mp);
@@ -143,6 +148,7 @@ CMDRelationGPDB::~CMDRelationGPDB()
 	m_col_width_array->Release();
 	CRefCount::SafeRelease(m_foreign_server);
 	CRefCount::SafeRelease(m_mdpart_constraint);
+	CRefCount::SafeRelease(m_child_part_constraints);
 	CRefCount::SafeRelease(m_colpos_nondrop_colpos_map);
 	CRefCount::SafeRelease(m_attrno_nondrop_col_pos_map);
 	CRefCount::SafeRelease(m_nondrop_col_pos_array);
@@ -783,6 +789,32 @@ CMDRelationGPDB::Serialize(CXMLSerializer *xml_serializer) const
 						  CDXLTokens::GetDXLTokenStr(EdxltokenPartition));
 	}
 
+	// serialize the part constraints of the child partitions
+	if (nullptr != m_child_part_constraints)
+	{
+		xml_serializer->OpenElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenChildPartConstraints));
+
+		const ULONG size = m_child_part_constraints->Size();
+		for (ULONG ul = 0; ul < size; ul++)
+		{
+			xml_serializer->OpenElement(
+				CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+				CDXLTokens::GetDXLTokenStr(EdxltokenPartConstraint));
+			(*m_child_part_constraints)[ul]->SerializeToDXL(xml_serializer);
+			xml_serializer->CloseElement(
+				CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+				CDXLTokens::GetDXLTokenStr(EdxltokenPartConstraint));
+		}
+
+		xml_serializer->CloseElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenChildPartConstraints));
+
+		GPOS_CHECK_ABORT;
+	}
+
 	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenRelation));
@@ -796,6 +828,12 @@ CMDRelationGPDB::ChildPartitionMdids() const
 	return m_partition_oids;
 }
 
+CDXLNodeArray *
+CMDRelationGPDB::ChildPartConstraints() const
+{
+	return m_child_part_constraints;
+}
+
 #ifdef GPOS_DEBUG
 //---------------------------------------------------------------------------
 //	@function:
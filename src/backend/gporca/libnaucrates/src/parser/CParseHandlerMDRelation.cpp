@@ -49,6 +49,8 @@ CParseHandlerMDRelation::CParseHandlerMDRelation(
 	  m_str_part_types_array(nullptr),
 	  m_key_sets_arrays(nullptr),
 	  m_part_constraint(nullptr),
+	  m_child_part_constraints(nullptr),
+	  m_parsing_child_part_constraints(false),
 	  m_opfamilies_parse_handler(nullptr),
 	  m_child_partitions_parse_handler(nullptr),
 	  m_foreign_server(nullptr),
@@ -74,7 +76,8 @@ CParseHandlerMDRelation::StartElement(const XMLCh *const element_uri,
 				 CDXLTokens::XmlstrToken(EdxltokenPartConstraint),
 				 element_local_name))
 	{
-		GPOS_ASSERT(nullptr == m_part_constraint);
+		GPOS_ASSERT_IMP(!m_parsing_child_part_constraints,
+						nullptr == m_part_constraint);
 
 		// parse handler for part constraints
 		CParseHandlerBase *pphPartConstraint =
@@ -87,6 +90,19 @@ CParseHandlerMDRelation::StartElement(const XMLCh *const element_uri,
 		return;
 	}
 
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenChildPartConstraints),
+				 element_local_name))
+	{
+		GPOS_ASSERT(nullptr == m_child_part_constraints);
+
+		// the part constraints of the children follow, one per child
+		m_child_part_constraints = GPOS_NEW(m_mp) CDXLNodeArray(m_mp);
+		m_parsing_child_part_constraints = true;
+
+		return;
+	}
+
 	if (0 == XMLString::compareString(
 				 CDXLTokens::XmlstrToken(EdxltokenRelDistrOpfamilies),
 				 element_local_name))
@@ -232,8 +248,24 @@ CParseHandlerMDRelation::EndElement(const XMLCh *const,	 // element_uri,
 	{
 		CParseHandlerScalarOp *pphPartCnstr =
 			dynamic_cast<CParseHandlerScalarOp *>((*this)[Length() - 1]);
-		m_part_constraint = pphPartCnstr->CreateDXLNode();
-		m_part_constraint->AddRef();
+		CDXLNode *part_constraint = pphPartCnstr->CreateDXLNode();
+		part_constraint->AddRef();
+		if (m_parsing_child_part_constraints)
+		{
+			m_child_part_constraints->Append(part_constraint);
+		}
+		else
+		{
+			m_part_constraint = part_constraint;
+		}
+		return;
+	}
+
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenChildPartConstraints),
+				 element_local_name))
+	{
+		m_parsing_child_part_constraints = false;
 		return;
 	}
 
@@ -293,7 +325,7 @@ CParseHandlerMDRelation::EndElement(const XMLCh *const,	 // element_uri,
 		distr_opfamilies, m_partition_cols_array, m_str_part_types_array,
 		child_partitions, m_convert_hash_to_random, m_key_sets_arrays,
 		md_index_info_array, mdid_check_constraint_array, m_part_constraint,
-		m_foreign_server, m_rows);
+		m_child_part_constraints, m_foreign_server, m_rows);
 
 	// deactivate handler
 	m_parse_handler_mgr->DeactivateHandler();
@@ -75,8 +75,7 @@ CParseHandlerManager::ActivateParseHandler(
 	GPOS_ASSERT(nullptr != parse_handler_base);
 
 	m_curr_parse_handler = parse_handler_base;
-	m_xml_reader->setContentHandler(parse_handler_base);
-	m_xml_reader->setErrorHandler(parse_handler_base);
+	SetXMLReaderHandler();
 }
 
 //---------------------------------------------------------------------------
@@ -103,8 +102,7 @@ CParseHandlerManager::ReplaceHandler(CParseHandlerBase *parse_handler_base,
 	}
 
 	m_curr_parse_handler = parse_handler_base;
-	m_xml_reader->setContentHandler(parse_handler_base);
-	m_xml_reader->setErrorHandler(parse_handler_base);
+	SetXMLReaderHandler();
 }
 
 
@@ -133,8 +131,7 @@ CParseHandlerManager::DeactivateHandler()
 		m_curr_parse_handler = nullptr;
 	}
 
-	m_xml_reader->setContentHandler(m_curr_parse_handler);
-	m_xml_reader->setErrorHandler(m_curr_parse_handler);
+	SetXMLReaderHandler();
 }
 
 //---------------------------------------------------------------------------
@@ -145,12 +142,32 @@ CParseHandlerManager::DeactivateHandler()
 //		Returns the current handler
 //
 //---------------------------------------------------------------------------
-const CParseHandlerBase *
+CParseHandlerBase *
 CParseHandlerManager::GetCurrentParseHandler()
 {
 	return m_curr_parse_handler;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::SetXMLReaderHandler
+//
+//	@doc:
+//		Make the XML parser send its events to the current handler. Binary
+//		documents have no XML parser, their reader sends its events to the
+//		current handler directly.
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerManager::SetXMLReaderHandler()
+{
+	if (nullptr != m_xml_reader)
+	{
+		m_xml_reader->setContentHandler(m_curr_parse_handler);
+		m_xml_reader->setErrorHandler(m_curr_parse_handler);
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerManager::CheckForAborts
@@ -0,0 +1,297 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CBucketBoundaries.cpp
+//
+//	@doc:
+//		Implementation of the columnar bucket boundaries of a histogram
+//---------------------------------------------------------------------------
+
+#include "naucrates/statistics/CBucketBoundaries.h"
+
+#include "naucrates/base/IDatum.h"
+#include "naucrates/statistics/CStatistics.h"
+
+using namespace gpnaucrates;
+
+// ctor
+CBucketBoundaries::CBucketBoundaries(CMemoryPool *mp, EValueKind kind,
+									 ULONG size)
+	: m_kind(kind), m_size(size)
+{
+	m_lower = GPOS_NEW_ARRAY(mp, SValue, size);
+	m_upper = GPOS_NEW_ARRAY(mp, SValue, size);
+	m_is_upper_closed = GPOS_NEW_ARRAY(mp, BOOL, size);
+}
+
+// dtor
+CBucketBoundaries::~CBucketBoundaries()
+{
+	GPOS_DELETE_ARRAY(m_lower);
+	GPOS_DELETE_ARRAY(m_upper);
+	GPOS_DELETE_ARRAY(m_is_upper_closed);
+}
+
+// boundaries of the given buckets, nullptr if they have none
+CBucketBoundaries *
+CBucketBoundaries::Pbb(CMemoryPool *mp, const CBucketArray *buckets)
+{
+	GPOS_ASSERT(nullptr != buckets);
+
+	const ULONG size = buckets->Size();
+	if (0 == size)
+	{
+		return nullptr;
+	}
+
+	// statistics compare two datums as LINTs if both map to LINT, and as
+	// doubles otherwise, so use LINTs if all bounds map to LINT, and
+	// doubles if none does
+	BOOL all_lint = true;
+	BOOL all_double_only = true;
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CBucket *bucket = (*buckets)[ul];
+		const IDatum *bounds[] = {bucket->GetLowerBound()->GetDatum(),
+								  bucket->GetUpperBound()->GetDatum()};
+		for (const IDatum *datum : bounds)
+		{
+			if (datum->IsNull())
+			{
+				return nullptr;
+			}
+
+			BOOL is_lint = datum->IsDatumMappableToLINT();
+			all_lint = all_lint && is_lint;
+			all_double_only = all_double_only && !is_lint &&
+							  datum->IsDatumMappableToDouble();
+		}
+	}
+
+	if (!all_lint && !all_double_only)
+	{
+		return nullptr;
+	}
+
+	EValueKind kind = all_lint ? EvkLint : EvkDouble;
+	CBucketBoundaries *bucket_boundaries =
+		GPOS_NEW(mp) CBucketBoundaries(mp, kind, size);
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CBucket *bucket = (*buckets)[ul];
+		bucket_boundaries->m_lower[ul] =
+			Value(bucket->GetLowerBound()->GetDatum(), kind);
+		bucket_boundaries->m_upper[ul] =
+			Value(bucket->GetUpperBound()->GetDatum(), kind);
+		bucket_boundaries->m_is_upper_closed[ul] = bucket->IsUpperClosed();
+	}
+
+	if (!bucket_boundaries->IsOrdered(buckets))
+	{
+		bucket_boundaries->Release();
+		return nullptr;
+	}
+
+	return bucket_boundaries;
+}
+
+// value of a datum of the given kind
+CBucketBoundaries::SValue
+CBucketBoundaries::Value(const IDatum *datum, EValueKind kind)
+{
+	SValue value = {0, 0.0};
+	if (EvkLint == kind)
+	{
+		value.m_lint = datum->GetLINTMapping();
+	}
+	else
+	{
+		value.m_double = datum->GetDoubleMapping().Get();
+	}
+
+	return value;
+}
+
+// compare two values, return -1, 0 or 1
+INT
+CBucketBoundaries::Compare(const SValue &value1, const SValue &value2) const
+{
+	if (EvkLint == m_kind)
+	{
+		if (value1.m_lint == value2.m_lint)
+		{
+			return 0;
+		}
+
+		return value1.m_lint < value2.m_lint ? -1 : 1;
+	}
+
+	// same as IDatum::StatsAreEqual and IDatum::StatsAreLessThan
+	CDouble diff = CDouble(value1.m_double) - CDouble(value2.m_double);
+	if (diff.Absolute() <= CStatistics::Epsilon)
+	{
+		return 0;
+	}
+
+	return diff < CDouble(0.0) ? -1 : 1;
+}
+
+// is the point with the given value after the bucket at the given index
+BOOL
+CBucketBoundaries::IsAfter(ULONG index, const SValue &value) const
+{
+	GPOS_ASSERT(index < m_size);
+
+	INT cmp = Compare(m_upper[index], value);
+
+	return 0 > cmp || (0 == cmp && !m_is_upper_closed[index]);
+}
+
+// are two values equal, or apart by more than twice the epsilon of
+// statistics comparisons, with the first one less than the second one?
+BOOL
+CBucketBoundaries::FEqualOrApart(const SValue &value1, const SValue &value2,
+								 BOOL *is_equal) const
+{
+	if (EvkLint == m_kind)
+	{
+		*is_equal = value1.m_lint == value2.m_lint;
+
+		return value1.m_lint <= value2.m_lint;
+	}
+
+	*is_equal = value1.m_double == value2.m_double;
+
+	return *is_equal ||
+		   value2.m_double - value1.m_double > 2 * CStatistics::Epsilon.Get();
+}
+
+// do the boundaries allow binary search over the buckets?
+//
+// a point is after a prefix of the buckets only, and contained in at most
+// the first bucket it is not after and the buckets starting at the upper
+// bound of that one, if the buckets are non-empty, don't overlap and have
+// increasing upper bounds. Comparing doubles up to an epsilon is not
+// transitive though, so for doubles, also require distinct bounds to be
+// apart by more than twice the epsilon: then a point equals at most one of
+// them, and comparisons are consistent with the order of the bounds
+BOOL
+CBucketBoundaries::IsOrdered(const CBucketArray *buckets) const
+{
+	for (ULONG ul = 0; ul < m_size; ul++)
+	{
+		CBucket *bucket = (*buckets)[ul];
+		BOOL is_equal = false;
+		if (!FEqualOrApart(m_lower[ul], m_upper[ul], &is_equal) ||
+			(is_equal && !(bucket->IsLowerClosed() && bucket->IsUpperClosed())))
+		{
+			return false;
+		}
+
+		if (0 < ul &&
+			(!FEqualOrApart(m_upper[ul - 1], m_lower[ul], &is_equal) ||
+			 !FEqualOrApart(m_upper[ul - 1], m_upper[ul], &is_equal) ||
+			 is_equal))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// get the value of a point comparable to the boundaries
+BOOL
+CBucketBoundaries::FValue(const CPoint *point, SValue *value) const
+{
+	GPOS_ASSERT(nullptr != point);
+	GPOS_ASSERT(nullptr != value);
+
+	const IDatum *datum = point->GetDatum();
+	if (datum->IsNull())
+	{
+		return false;
+	}
+
+	// the point must be compared the same way as the bounds are compared
+	// to each other
+	if ((EvkLint == m_kind && !datum->IsDatumMappableToLINT()) ||
+		(EvkDouble == m_kind && !datum->IsDatumMappableToDouble()))
+	{
+		return false;
+	}
+
+	*value = Value(datum, m_kind);
+
+	return true;
+}
+
+// index of the first bucket that the point with the given value is not
+// after
+ULONG
+CBucketBoundaries::UlFindPoint(const SValue &value) const
+{
+	// the buckets the point is after form a prefix
+	ULONG low = 0;
+	ULONG high = m_size;
+	while (low < high)
+	{
+		ULONG mid = low + (high - low) / 2;
+		if (IsAfter(mid, value))
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+// index of the first bucket at or after the given index whose upper bound
+// is not less than the given value
+ULONG
+CBucketBoundaries::UlFirstUpperNotBelow(ULONG begin, const SValue &value) const
+{
+	GPOS_ASSERT(begin <= m_size);
+
+	// merges mostly skip few buckets, so gallop ahead from the given index
+	// before searching in the range found
+	ULONG low = begin;
+	ULONG step = 1;
+	while (low < m_size && 0 > Compare(m_upper[low], value))
+	{
+		ULONG next = low + step;
+		if (next >= m_size || 0 <= Compare(m_upper[next], value))
+		{
+			// the first bucket is in (low, next]
+			ULONG high = std::min(next, m_size);
+			low++;
+			while (low < high)
+			{
+				ULONG mid = low + (high - low) / 2;
+				if (0 > Compare(m_upper[mid], value))
+				{
+					low = mid + 1;
+				}
+				else
+				{
+					high = mid;
+				}
+			}
+
+			return low;
+		}
+
+		low = next;
+		step *= 2;
+	}
+
+	return low;
+}
+
+// EOF
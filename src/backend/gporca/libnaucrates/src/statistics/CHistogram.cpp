@@ -62,7 +62,9 @@ CHistogram::CHistogram(CMemoryPool *mp, CBucketArray *histogram_buckets,
 	  m_skew_was_measured(false),
 	  m_skew(1.0),
 	  m_NDVs_were_scaled(false),
-	  m_is_col_stats_missing(false)
+	  m_is_col_stats_missing(false),
+	  m_bucket_boundaries(nullptr),
+	  m_bucket_boundaries_built(false)
 {
 	GPOS_ASSERT(nullptr != histogram_buckets);
 }
@@ -78,7 +80,9 @@ CHistogram::CHistogram(CMemoryPool *mp, BOOL is_well_defined)
 	  m_skew_was_measured(false),
 	  m_skew(1.0),
 	  m_NDVs_were_scaled(false),
-	  m_is_col_stats_missing(false)
+	  m_is_col_stats_missing(false),
+	  m_bucket_boundaries(nullptr),
+	  m_bucket_boundaries_built(false)
 {
 	m_histogram_buckets = GPOS_NEW(m_mp) CBucketArray(m_mp);
 }
@@ -97,7 +101,9 @@ CHistogram::CHistogram(CMemoryPool *mp, CBucketArray *histogram_buckets,
 	  m_skew_was_measured(false),
 	  m_skew(1.0),
 	  m_NDVs_were_scaled(false),
-	  m_is_col_stats_missing(is_col_stats_missing)
+	  m_is_col_stats_missing(is_col_stats_missing),
+	  m_bucket_boundaries(nullptr),
+	  m_bucket_boundaries_built(false)
 {
 	GPOS_ASSERT(m_histogram_buckets);
 	// FIXME: These assertions are sometimes hit and is indicitive of a bug, but
@@ -180,7 +186,17 @@ CHistogram::MakeHistogramLessThanOrLessThanEqualFilter(
 	CBucketArray *new_buckets = GPOS_NEW(m_mp) CBucketArray(m_mp);
 	const ULONG num_buckets = m_histogram_buckets->Size();
 
-	for (ULONG bucket_index = 0; bucket_index < num_buckets; bucket_index++)
+	// copy the buckets the point is after
+	const ULONG first_bucket_index = FindPoint(point);
+	for (ULONG bucket_index = 0; bucket_index < first_bucket_index;
+		 bucket_index++)
+	{
+		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
+		new_buckets->Append(bucket->MakeBucketCopy(m_mp));
+	}
+
+	for (ULONG bucket_index = first_bucket_index; bucket_index < num_buckets;
+		 bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 		if (bucket->IsBefore(point))
@@ -228,11 +244,16 @@ CHistogram::MakeBucketsWithInequalityFilter(CPoint *point) const
 	const ULONG num_buckets = m_histogram_buckets->Size();
 	bool point_is_null = point->GetDatum()->IsNull();
 
+	// the buckets the point is after don't contain it
+	const ULONG first_bucket_index =
+		point_is_null ? num_buckets : FindPoint(point);
+
 	for (ULONG bucket_index = 0; bucket_index < num_buckets; bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 
-		if (bucket->Contains(point) && !point_is_null)
+		if (bucket_index >= first_bucket_index && bucket->Contains(point) &&
+			!point_is_null)
 		{
 			CBucket *less_than_bucket = bucket->MakeBucketScaleUpper(
 				m_mp, point, false /*include_upper */);
@@ -305,7 +326,8 @@ CHistogram::MakeBucketsWithEqualityFilter(CPoint *point) const
 	const ULONG num_buckets = m_histogram_buckets->Size();
 	ULONG bucket_index = 0;
 
-	for (bucket_index = 0; bucket_index < num_buckets; bucket_index++)
+	for (bucket_index = FindPoint(point); bucket_index < num_buckets;
+		 bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 
@@ -407,7 +429,8 @@ CHistogram::MakeHistogramGreaterThanOrGreaterThanEqualFilter(
 
 	// find first bucket that contains point
 	ULONG bucket_index = 0;
-	for (bucket_index = 0; bucket_index < num_buckets; bucket_index++)
+	for (bucket_index = FindPoint(point); bucket_index < num_buckets;
+		 bucket_index++)
 	{
 		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
 		if (bucket->IsBefore(point))
@@ -1026,9 +1049,74 @@ CHistogram::CopyHistogram() const
 		histogram_copy->SetNDVScaled();
 	}
 
+	// the copy shares the buckets, so it shares their boundaries too
+	if (m_bucket_boundaries_built)
+	{
+		if (nullptr != m_bucket_boundaries)
+		{
+			m_bucket_boundaries->AddRef();
+		}
+		histogram_copy->m_bucket_boundaries = m_bucket_boundaries;
+		histogram_copy->m_bucket_boundaries_built = true;
+	}
+
 	return histogram_copy;
 }
 
+// bucket boundaries, nullptr if the buckets have none
+const CBucketBoundaries *
+CHistogram::GetBucketBoundaries() const
+{
+	if (!m_bucket_boundaries_built)
+	{
+		m_bucket_boundaries =
+			CBucketBoundaries::Pbb(m_mp, m_histogram_buckets);
+		m_bucket_boundaries_built = true;
+	}
+
+	return m_bucket_boundaries;
+}
+
+// index of the first bucket that the given point is not after; the buckets
+// before it end before the point, and no bucket after it contains the point
+// unless it does too. Without bucket boundaries, this is the first bucket,
+// and the caller compares the point with all buckets
+ULONG
+CHistogram::FindPoint(const CPoint *point) const
+{
+	GPOS_ASSERT(nullptr != point);
+
+	const CBucketBoundaries *bucket_boundaries = GetBucketBoundaries();
+	CBucketBoundaries::SValue value;
+	if (nullptr != bucket_boundaries &&
+		bucket_boundaries->FValue(point, &value))
+	{
+		return bucket_boundaries->UlFindPoint(value);
+	}
+
+	return 0;
+}
+
+// index of the first bucket at or after the given index that does not end
+// before the given bucket starts; the buckets skipped are all before the
+// given bucket, without intersecting it
+ULONG
+CHistogram::SkipBucketsBefore(ULONG begin, const CBucket *bucket) const
+{
+	GPOS_ASSERT(nullptr != bucket);
+
+	const CBucketBoundaries *bucket_boundaries = GetBucketBoundaries();
+	CBucketBoundaries::SValue value;
+	if (nullptr != bucket_boundaries &&
+		bucket_boundaries->FValue(bucket->GetLowerBound(), &value))
+	{
+		return bucket_boundaries->UlFirstUpperNotBelow(begin, value);
+	}
+
+	// leave it to the caller to compare the buckets
+	return begin;
+}
+
 BOOL
 CHistogram::IsOpSupportedForTextFilter(CStatsPred::EStatsCmpType stats_cmp_type)
 {
@@ -1148,12 +1236,12 @@ CHistogram::MakeJoinHistogramEqualityFilter(const CHistogram *histogram) const
 		else if (bucket1->IsBefore(bucket2))
 		{
 			// buckets do not intersect there one bucket is before the other
-			idx1++;
+			idx1 = SkipBucketsBefore(idx1 + 1, bucket2);
 		}
 		else
 		{
 			GPOS_ASSERT(bucket2->IsBefore(bucket1));
-			idx2++;
+			idx2 = histogram->SkipBucketsBefore(idx2 + 1, bucket1);
 		}
 	}
 
@@ -1454,6 +1542,12 @@ CHistogram::MakeUnionAllHistogramNormalize(CDouble rows,
 				bucket1->MakeBucketUpdateFrequency(m_mp, rows, rows_new));
 			CleanupResidualBucket(bucket1, bucket1_is_residual);
 			idx1++;
+
+			// add the following buckets before bucket2 as well
+			ULONG idx1_end = SkipBucketsBefore(idx1, bucket2);
+			AddBuckets(m_mp, m_histogram_buckets, new_buckets, rows, rows_new,
+					   idx1, idx1_end);
+			idx1 = idx1_end;
 			bucket1 = (*this)[idx1];
 			bucket1_is_residual = false;
 		}
@@ -1463,6 +1557,12 @@ CHistogram::MakeUnionAllHistogramNormalize(CDouble rows,
 				bucket2->MakeBucketUpdateFrequency(m_mp, rows_other, rows_new));
 			CleanupResidualBucket(bucket2, bucket2_is_residual);
 			idx2++;
+
+			// add the following buckets before bucket1 as well
+			ULONG idx2_end = histogram->SkipBucketsBefore(idx2, bucket1);
+			AddBuckets(m_mp, histogram->m_histogram_buckets, new_buckets,
+					   rows_other, rows_new, idx2, idx2_end);
+			idx2 = idx2_end;
 			bucket2 = (*histogram)[idx2];
 			bucket2_is_residual = false;
 		}
@@ -1845,6 +1945,12 @@ CHistogram::MakeUnionHistogramNormalize(CDouble rows,
 				GPOS_NEW(m_mp) CDouble(bucket1->GetFrequency() * rows));
 			CleanupResidualBucket(bucket1, bucket1_is_residual);
 			idx1++;
+
+			// add the following buckets before bucket2 as well
+			ULONG idx1_end = SkipBucketsBefore(idx1, bucket2);
+			AddBuckets(m_mp, m_histogram_buckets, histogram_buckets, rows,
+					   num_tuples_per_bucket, idx1, idx1_end);
+			idx1 = idx1_end;
 			bucket1 = (*this)[idx1];
 			bucket1_is_residual = false;
 		}
@@ -1855,6 +1961,13 @@ CHistogram::MakeUnionHistogramNormalize(CDouble rows,
 				GPOS_NEW(m_mp) CDouble(bucket2->GetFrequency() * rows_other));
 			CleanupResidualBucket(bucket2, bucket2_is_residual);
 			idx2++;
+
+			// add the following buckets before bucket1 as well
+			ULONG idx2_end = other_histogram->SkipBucketsBefore(idx2, bucket1);
+			AddBuckets(m_mp, other_histogram->m_histogram_buckets,
+					   histogram_buckets, rows_other, num_tuples_per_bucket,
+					   idx2, idx2_end);
+			idx2 = idx2_end;
 			bucket2 = (*other_histogram)[idx2];
 			bucket2_is_residual = false;
 		}
@@ -0,0 +1,639 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLBinaryReader.cpp
+//
+//	@doc:
+//		Implementation of the reader of binary DXL documents
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+
+#include <xercesc/util/XMLString.hpp>
+
+#include "gpos/common/CAutoRg.h"
+
+#include "naucrates/dxl/parser/CParseHandlerBase.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
+#include "naucrates/dxl/xml/dxltokens.h"
+#include "naucrates/exception.h"
+
+using namespace gpdxl;
+
+// initial sizes of the arrays of the reader
+#define GPDXL_BINARY_INIT_NAMES 64
+#define GPDXL_BINARY_INIT_ATTRS 16
+#define GPDXL_BINARY_INIT_VALUES 256
+#define GPDXL_BINARY_INIT_OPEN_ELEMS 32
+
+// empty namespace URI of unprefixed names
+static const XMLCh wszEmpty[] = {0};
+
+// type of all attributes, as reported by Xerces without a DTD
+static const XMLCh wszCDATA[] = {'C', 'D', 'A', 'T', 'A', 0};
+
+//---------------------------------------------------------------------------
+//	@function:
+//		Grow
+//
+//	@doc:
+//		Grow an array with the given number of elements in use to hold at
+//		least the required number of elements
+//
+//---------------------------------------------------------------------------
+template <class T>
+static void
+Grow(CMemoryPool *mp, T **array, ULONG size, ULONG *capacity, ULONG required)
+{
+	if (required <= *capacity)
+	{
+		return;
+	}
+
+	ULONG new_capacity = std::max(2 * *capacity, required);
+	T *new_array = GPOS_NEW_ARRAY(mp, T, new_capacity);
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		new_array[ul] = (*array)[ul];
+	}
+
+	GPOS_DELETE_ARRAY(*array);
+	*array = new_array;
+	*capacity = new_capacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CDXLBinaryReader
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::CDXLBinaryReader(CMemoryPool *mp, const BYTE *data,
+								   ULONG size)
+	: m_mp(mp),
+	  m_data(data),
+	  m_size(size),
+	  m_pos(0),
+	  m_num_names(0),
+	  m_names_capacity(GPDXL_BINARY_INIT_NAMES),
+	  m_num_attrs(0),
+	  m_attrs_capacity(GPDXL_BINARY_INIT_ATTRS),
+	  m_values_size(0),
+	  m_values_capacity(GPDXL_BINARY_INIT_VALUES),
+	  m_num_open_elems(0),
+	  m_open_elems_capacity(GPDXL_BINARY_INIT_OPEN_ELEMS)
+{
+	GPOS_ASSERT(nullptr != data);
+
+	m_names = GPOS_NEW_ARRAY(m_mp, SName, m_names_capacity);
+	m_attr_names = GPOS_NEW_ARRAY(m_mp, ULONG, m_attrs_capacity);
+	m_attr_values = GPOS_NEW_ARRAY(m_mp, ULONG, m_attrs_capacity);
+	m_values = GPOS_NEW_ARRAY(m_mp, XMLCh, m_values_capacity);
+	m_open_elems = GPOS_NEW_ARRAY(m_mp, ULONG, m_open_elems_capacity);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::~CDXLBinaryReader
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::~CDXLBinaryReader()
+{
+	for (ULONG ul = 0; ul < m_num_names; ul++)
+	{
+		GPOS_DELETE_ARRAY(m_names[ul].m_qname);
+	}
+
+	GPOS_DELETE_ARRAY(m_names);
+	GPOS_DELETE_ARRAY(m_attr_names);
+	GPOS_DELETE_ARRAY(m_attr_values);
+	GPOS_DELETE_ARRAY(m_values);
+	GPOS_DELETE_ARRAY(m_open_elems);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::RaiseMalformed
+//
+//	@doc:
+//		Raise an exception for a malformed document
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::RaiseMalformed()
+{
+	GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadByte
+//
+//	@doc:
+//		Read a byte
+//
+//---------------------------------------------------------------------------
+BYTE
+CDXLBinaryReader::ReadByte()
+{
+	if (m_pos >= m_size)
+	{
+		RaiseMalformed();
+	}
+
+	return m_data[m_pos++];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadNumber
+//
+//	@doc:
+//		Read an unsigned number written in 7-bit groups
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::ReadNumber()
+{
+	ULONG number = 0;
+	for (ULONG shift = 0; shift < 32; shift += 7)
+	{
+		BYTE byte = ReadByte();
+		number |= ((ULONG)(byte & 0x7f)) << shift;
+		if (0 == (byte & 0x80))
+		{
+			return number;
+		}
+	}
+
+	RaiseMalformed();
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadName
+//
+//	@doc:
+//		Read the number of a name, and the name itself if it is new. A
+//		prefixed name is in the DXL namespace, the only one DXL documents
+//		declare.
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::ReadName()
+{
+	const ULONG number = ReadNumber();
+	if (number < m_num_names)
+	{
+		return number;
+	}
+
+	const ULONG length = ReadNumber();
+	if (number != m_num_names || length > m_size - m_pos)
+	{
+		RaiseMalformed();
+	}
+
+	CAutoRg<XMLCh> a_qname(GPOS_NEW_ARRAY(m_mp, XMLCh, length + 1));
+	ULONG colon = length;
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		ULONG unit = ReadNumber();
+		if (0xffff < unit)
+		{
+			RaiseMalformed();
+		}
+
+		a_qname[ul] = (XMLCh) unit;
+		if (':' == unit && length == colon)
+		{
+			colon = ul;
+		}
+	}
+	a_qname[length] = 0;
+
+	Grow(m_mp, &m_names, m_num_names, &m_names_capacity, m_num_names + 1);
+	XMLCh *qname = a_qname.RgtReset();
+	SName &name = m_names[m_num_names++];
+	name.m_qname = qname;
+	if (length == colon)
+	{
+		name.m_local_name = qname;
+		name.m_uri = wszEmpty;
+	}
+	else
+	{
+		name.m_local_name = qname + colon + 1;
+		name.m_uri = CDXLTokens::XmlstrToken(EdxltokenNamespaceURI);
+	}
+
+	return number;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadAttribute
+//
+//	@doc:
+//		Read an attribute of the current element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::ReadAttribute()
+{
+	const ULONG name = ReadName();
+	const ULONG length = ReadNumber();
+	if (length > m_size - m_pos)
+	{
+		RaiseMalformed();
+	}
+
+	// both arrays of attributes have the same size
+	ULONG attrs_capacity = m_attrs_capacity;
+	Grow(m_mp, &m_attr_names, m_num_attrs, &attrs_capacity, m_num_attrs + 1);
+	Grow(m_mp, &m_attr_values, m_num_attrs, &m_attrs_capacity,
+		 m_num_attrs + 1);
+	Grow(m_mp, &m_values, m_values_size, &m_values_capacity,
+		 m_values_size + length + 1);
+
+	m_attr_names[m_num_attrs] = name;
+	m_attr_values[m_num_attrs] = m_values_size;
+	m_num_attrs++;
+
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		ULONG unit = ReadNumber();
+		if (0xffff < unit)
+		{
+			RaiseMalformed();
+		}
+
+		m_values[m_values_size++] = (XMLCh) unit;
+	}
+	m_values[m_values_size++] = 0;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::Parse
+//
+//	@doc:
+//		Replay the document to the parse handlers of the given manager,
+//		starting with its current one, the handler of the root element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::Parse(CParseHandlerManager *parse_handler_mgr)
+{
+	GPOS_ASSERT(nullptr != parse_handler_mgr);
+
+	for (const CHAR *sz = GPDXL_BINARY_MAGIC; '\0' != *sz; sz++)
+	{
+		if ((BYTE) *sz != ReadByte())
+		{
+			RaiseMalformed();
+		}
+	}
+
+	if (GPDXL_BINARY_VERSION != ReadByte())
+	{
+		RaiseMalformed();
+	}
+
+	while (m_pos < m_size)
+	{
+		const BYTE record = ReadByte();
+		if (EdxlbinOpen != record && EdxlbinClose != record)
+		{
+			RaiseMalformed();
+		}
+
+		ULONG name = 0;
+		if (EdxlbinOpen == record)
+		{
+			name = ReadName();
+
+			m_num_attrs = 0;
+			m_values_size = 0;
+			while (m_pos < m_size && EdxlbinAttr == m_data[m_pos])
+			{
+				m_pos++;
+				ReadAttribute();
+			}
+
+			Grow(m_mp, &m_open_elems, m_num_open_elems, &m_open_elems_capacity,
+				 m_num_open_elems + 1);
+			m_open_elems[m_num_open_elems++] = name;
+		}
+		else
+		{
+			if (0 == m_num_open_elems)
+			{
+				RaiseMalformed();
+			}
+
+			name = m_open_elems[--m_num_open_elems];
+		}
+
+		CParseHandlerBase *parse_handler =
+			parse_handler_mgr->GetCurrentParseHandler();
+		if (nullptr == parse_handler)
+		{
+			RaiseMalformed();
+		}
+
+		const SName &elem = m_names[name];
+		if (EdxlbinOpen == record)
+		{
+			parse_handler->startElement(elem.m_uri, elem.m_local_name,
+										elem.m_qname, *this);
+		}
+		else
+		{
+			parse_handler->endElement(elem.m_uri, elem.m_local_name,
+									  elem.m_qname);
+		}
+	}
+
+	CParseHandlerBase *parse_handler =
+		parse_handler_mgr->GetCurrentParseHandler();
+	if (0 != m_num_open_elems || nullptr == parse_handler)
+	{
+		RaiseMalformed();
+	}
+
+	// the root handler collects the parsed objects at the end
+	parse_handler->endDocument();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getLength
+//
+//	@doc:
+//		Number of attributes of the current element
+//
+//---------------------------------------------------------------------------
+XMLSize_t
+CDXLBinaryReader::getLength() const
+{
+	return m_num_attrs;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getURI
+//
+//	@doc:
+//		Namespace URI of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getURI(const XMLSize_t index) const
+{
+	if (index >= m_num_attrs)
+	{
+		return nullptr;
+	}
+
+	return AttrName(index).m_uri;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getLocalName
+//
+//	@doc:
+//		Local name of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getLocalName(const XMLSize_t index) const
+{
+	if (index >= m_num_attrs)
+	{
+		return nullptr;
+	}
+
+	return AttrName(index).m_local_name;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getQName
+//
+//	@doc:
+//		Qualified name of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getQName(const XMLSize_t index) const
+{
+	if (index >= m_num_attrs)
+	{
+		return nullptr;
+	}
+
+	return AttrName(index).m_qname;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getType
+//
+//	@doc:
+//		Type of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getType(const XMLSize_t index) const
+{
+	if (index >= m_num_attrs)
+	{
+		return nullptr;
+	}
+
+	return wszCDATA;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getValue
+//
+//	@doc:
+//		Value of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getValue(const XMLSize_t index) const
+{
+	if (index >= m_num_attrs)
+	{
+		return nullptr;
+	}
+
+	return m_values + m_attr_values[index];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given namespace URI and local name
+//
+//---------------------------------------------------------------------------
+bool
+CDXLBinaryReader::getIndex(const XMLCh *const uri,
+						   const XMLCh *const localPart,
+						   XMLSize_t &index) const
+{
+	for (ULONG ul = 0; ul < m_num_attrs; ul++)
+	{
+		const SName &name = AttrName(ul);
+		if (XMLString::equals(uri, name.m_uri) &&
+			XMLString::equals(localPart, name.m_local_name))
+		{
+			index = ul;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given namespace URI and local name,
+//		-1 if there is none
+//
+//---------------------------------------------------------------------------
+int
+CDXLBinaryReader::getIndex(const XMLCh *const uri,
+						   const XMLCh *const localPart) const
+{
+	XMLSize_t index = 0;
+	if (!getIndex(uri, localPart, index))
+	{
+		return -1;
+	}
+
+	return (int) index;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given qualified name
+//
+//---------------------------------------------------------------------------
+bool
+CDXLBinaryReader::getIndex(const XMLCh *const qName, XMLSize_t &index) const
+{
+	for (ULONG ul = 0; ul < m_num_attrs; ul++)
+	{
+		if (XMLString::equals(qName, AttrName(ul).m_qname))
+		{
+			index = ul;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given qualified name, -1 if there is
+//		none
+//
+//---------------------------------------------------------------------------
+int
+CDXLBinaryReader::getIndex(const XMLCh *const qName) const
+{
+	XMLSize_t index = 0;
+	if (!getIndex(qName, index))
+	{
+		return -1;
+	}
+
+	return (int) index;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getType
+//
+//	@doc:
+//		Type of the attribute with the given namespace URI and local name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getType(const XMLCh *const uri,
+						  const XMLCh *const localPart) const
+{
+	return getType((XMLSize_t) getIndex(uri, localPart));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getType
+//
+//	@doc:
+//		Type of the attribute with the given qualified name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getType(const XMLCh *const qName) const
+{
+	return getType((XMLSize_t) getIndex(qName));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getValue
+//
+//	@doc:
+//		Value of the attribute with the given namespace URI and local name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getValue(const XMLCh *const uri,
+						   const XMLCh *const localPart) const
+{
+	return getValue((XMLSize_t) getIndex(uri, localPart));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::getValue
+//
+//	@doc:
+//		Value of the attribute with the given qualified name, the way the
+//		parse handlers look up attributes
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::getValue(const XMLCh *const qName) const
+{
+	return getValue((XMLSize_t) getIndex(qName));
+}
+
+// EOF
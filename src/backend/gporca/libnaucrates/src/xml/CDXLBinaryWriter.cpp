@@ -0,0 +1,278 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2024 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLBinaryWriter.cpp
+//
+//	@doc:
+//		Implementation of the writer of binary DXL documents
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
+
+#include "gpos/common/clibwrapper.h"
+
+#include "naucrates/dxl/xml/dxltokens.h"
+
+using namespace gpdxl;
+
+// initial size of the buffer of a document
+#define GPDXL_BINARY_INIT_SIZE 1024
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CDXLBinaryWriter
+//
+//	@doc:
+//		Ctor, writes the header of the document
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::CDXLBinaryWriter(CMemoryPool *mp)
+	: m_mp(mp), m_data(nullptr), m_size(0), m_capacity(GPDXL_BINARY_INIT_SIZE)
+{
+	m_data = GPOS_NEW_ARRAY(m_mp, BYTE, m_capacity);
+	m_names = GPOS_NEW(m_mp) NameMap(m_mp);
+	m_qname = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+	m_value = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+	m_value_os = GPOS_NEW(m_mp) COstreamString(m_value);
+
+	for (const CHAR *sz = GPDXL_BINARY_MAGIC; '\0' != *sz; sz++)
+	{
+		WriteByte((BYTE) *sz);
+	}
+	WriteByte(GPDXL_BINARY_VERSION);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::~CDXLBinaryWriter
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryWriter::~CDXLBinaryWriter()
+{
+	GPOS_DELETE(m_value_os);
+	GPOS_DELETE(m_value);
+	GPOS_DELETE(m_qname);
+	m_names->Release();
+	GPOS_DELETE_ARRAY(m_data);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::Reserve
+//
+//	@doc:
+//		Make room for the given number of bytes, doubling the buffer as
+//		needed
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::Reserve(ULONG size)
+{
+	if (m_size + size <= m_capacity)
+	{
+		return;
+	}
+
+	ULONG capacity = m_capacity;
+	while (m_size + size > capacity)
+	{
+		capacity *= 2;
+	}
+
+	BYTE *data = GPOS_NEW_ARRAY(m_mp, BYTE, capacity);
+	clib::Memcpy(data, m_data, m_size);
+	GPOS_DELETE_ARRAY(m_data);
+	m_data = data;
+	m_capacity = capacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::WriteNumber
+//
+//	@doc:
+//		Write an unsigned number in 7-bit groups, least significant first,
+//		with the high bit set on all bytes but the last one
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::WriteNumber(ULONG number)
+{
+	while (0x80 <= number)
+	{
+		WriteByte((BYTE)(0x80 | (number & 0x7f)));
+		number >>= 7;
+	}
+	WriteByte((BYTE) number);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::WriteString
+//
+//	@doc:
+//		Write a string as its number of UTF-16 code units followed by the
+//		code units, which is what Xerces hands to the parse handlers
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::WriteString(const CWStringBase *str)
+{
+	GPOS_ASSERT(nullptr != str);
+
+	const WCHAR *wsz = str->GetBuffer();
+	const ULONG length = str->Length();
+
+	ULONG num_units = length;
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		if (0xffff < (ULONG) wsz[ul])
+		{
+			// surrogate pair
+			num_units++;
+		}
+	}
+
+	WriteNumber(num_units);
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		ULONG code_point = (ULONG) wsz[ul];
+		if (0xffff < code_point)
+		{
+			code_point -= 0x10000;
+			WriteNumber(0xd800 + (code_point >> 10));
+			WriteNumber(0xdc00 + (code_point & 0x3ff));
+		}
+		else
+		{
+			WriteNumber(code_point);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::WriteName
+//
+//	@doc:
+//		Write the number of a name. The first time a name occurs, it gets the
+//		next number, and the name itself follows the number.
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::WriteName(const CWStringBase *name)
+{
+	GPOS_ASSERT(nullptr != name);
+
+	CWStringConst key(name->GetBuffer());
+	const ULONG *number = m_names->Find(&key);
+	if (nullptr != number)
+	{
+		WriteNumber(*number);
+		return;
+	}
+
+	const ULONG new_number = m_names->Size();
+	BOOL fInserted GPOS_ASSERTS_ONLY =
+		m_names->Insert(GPOS_NEW(m_mp) CWStringConst(m_mp, name->GetBuffer()),
+						GPOS_NEW(m_mp) ULONG(new_number));
+	GPOS_ASSERT(fInserted);
+
+	WriteNumber(new_number);
+	WriteString(name);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::OpenElement
+//
+//	@doc:
+//		Start an element, named by its qualified name
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::OpenElement(const CWStringBase *pstrNamespace,
+							  const CWStringBase *elem_str)
+{
+	GPOS_ASSERT(nullptr != elem_str);
+
+	WriteByte(EdxlbinOpen);
+	if (nullptr == pstrNamespace)
+	{
+		WriteName(elem_str);
+		return;
+	}
+
+	m_qname->Reset();
+	m_qname->Append(pstrNamespace);
+	m_qname->Append(CDXLTokens::GetDXLTokenStr(EdxltokenColon));
+	m_qname->Append(elem_str);
+	WriteName(m_qname);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::CloseElement
+//
+//	@doc:
+//		End the innermost open element
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::CloseElement()
+{
+	WriteByte(EdxlbinClose);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::AddAttribute
+//
+//	@doc:
+//		Add a string-valued attribute to the element just started
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::AddAttribute(const CWStringBase *pstrAttr,
+							   const CWStringBase *str_value)
+{
+	GPOS_ASSERT(nullptr != pstrAttr);
+	GPOS_ASSERT(nullptr != str_value);
+
+	// like the SAX parser, leave out namespace declarations: the namespace
+	// of the elements is implied by their prefix
+	const CWStringConst *xmlns =
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespaceAttr);
+	if (0 == clib::Wcsncmp(pstrAttr->GetBuffer(), xmlns->GetBuffer(),
+						   xmlns->Length()))
+	{
+		return;
+	}
+
+	WriteByte(EdxlbinAttr);
+	WriteName(pstrAttr);
+	WriteString(str_value);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryWriter::AddStreamedAttribute
+//
+//	@doc:
+//		Add an attribute whose value was formatted by the value stream, so
+//		that numbers are spelled exactly as in the XML document
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryWriter::AddStreamedAttribute(const CWStringBase *pstrAttr)
+{
+	AddAttribute(pstrAttr, m_value);
+	m_value->Reset();
+}
+
+// EOF
@@ -45,6 +45,12 @@ void
 CXMLSerializer::StartDocument()
 {
 	GPOS_ASSERT(m_strstackElems->IsEmpty());
+	if (nullptr != m_binary_writer)
+	{
+		// binary documents have no XML declaration
+		return;
+	}
+
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenXMLDocHeader)->GetBuffer();
 	if (m_indentation)
 	{
@@ -77,6 +83,13 @@ CXMLSerializer::OpenElement(const CWStringBase *pstrNamespace,
 	// put element on the stack
 	m_strstackElems->Push(elem_str);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_binary_writer->OpenElement(pstrNamespace, elem_str);
+		m_ulLevel++;
+		return;
+	}
+
 	// write the closing bracket for the previous element if necessary and add indentation
 	if (m_fOpenTag)
 	{
@@ -131,7 +144,11 @@ CXMLSerializer::CloseElement(const CWStringBase *pstrNamespace,
 
 	GPOS_ASSERT(strOpenElem->Equals(elem_str));
 
-	if (m_fOpenTag)
+	if (nullptr != m_binary_writer)
+	{
+		m_binary_writer->CloseElement();
+	}
+	else if (m_fOpenTag)
 	{
 		// singleton element with no children - close the element with "/>"
 		m_os << CDXLTokens::GetDXLTokenStr(EdxltokenBracketCloseSingletonTag)
@@ -184,6 +201,12 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr,
 	GPOS_ASSERT(nullptr != pstrAttr);
 	GPOS_ASSERT(nullptr != str_value);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_binary_writer->AddAttribute(pstrAttr, str_value);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -207,6 +230,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, const CHAR *szValue)
 	GPOS_ASSERT(nullptr != pstrAttr);
 	GPOS_ASSERT(nullptr != szValue);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << szValue;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -230,6 +260,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, ULONG ulValue)
 {
 	GPOS_ASSERT(nullptr != pstrAttr);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << ulValue;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -253,6 +290,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, ULLONG ullValue)
 {
 	GPOS_ASSERT(nullptr != pstrAttr);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << ullValue;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -276,6 +320,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, INT iValue)
 {
 	GPOS_ASSERT(nullptr != pstrAttr);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << iValue;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -299,6 +350,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, LINT value)
 {
 	GPOS_ASSERT(nullptr != pstrAttr);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << value;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
@@ -322,6 +380,13 @@ CXMLSerializer::AddAttribute(const CWStringBase *pstrAttr, CDouble value)
 {
 	GPOS_ASSERT(nullptr != pstrAttr);
 
+	if (nullptr != m_binary_writer)
+	{
+		m_os << value;
+		m_binary_writer->AddStreamedAttribute(pstrAttr);
+		return;
+	}
+
 	GPOS_ASSERT(m_fOpenTag);
 	m_os << CDXLTokens::GetDXLTokenStr(EdxltokenSpace)->GetBuffer()
 		 << pstrAttr->GetBuffer()
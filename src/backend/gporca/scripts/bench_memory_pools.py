@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+
+# Memory benchmark of the optimizer over the minidump suite
+#
+# This program optimizes each minidump twice with gporca_test, once in the
+# default memory pool and once in an arena pool (option -a), and reports
+# per minidump:
+#
+# - the number of allocations and frees made in the pool
+# - the peak size of the live allocations, and the size the pool allocated
+# - the peak RSS of the gporca_test process
+# - the elapsed time
+#
+# followed by the totals of both runs. The output is CSV, one row per
+# minidump and pool type.
+#
+# Example, from the build directory of ORCA:
+#
+#   ../scripts/bench_memory_pools.py --gporca-test ./server/gporca_test \
+#       ../data/dxl/minidump/TPCH*.mdp
+#
+# Run this program with the -h or --help option to see argument syntax
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+import time
+
+_stats_re = re.compile(r'Memory statistics: pool (\w+), allocations (\d+), '
+                       r'frees (\d+), peak live bytes (\d+), '
+                       r'allocated bytes (\d+)')
+
+_columns = ['minidump', 'pool', 'allocations', 'frees', 'peak_live_bytes',
+            'allocated_bytes', 'peak_rss_kb', 'elapsed_ms']
+
+
+def run_minidump(gporca_test, minidump, arena):
+    """Optimize a minidump, return its row of results or None on failure"""
+    args = [gporca_test, '-m', '-d', minidump]
+    if arena:
+        args.insert(1, '-a')
+
+    start = time.time()
+    proc = subprocess.Popen(args, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT)
+    output = proc.stdout.read().decode('utf-8', 'replace')
+    proc.stdout.close()
+    # wait4 reports the resource usage of this child only
+    _, status, rusage = os.wait4(proc.pid, 0)
+    elapsed_ms = (time.time() - start) * 1000
+    if os.WIFSIGNALED(status):
+        proc.returncode = -os.WTERMSIG(status)
+    else:
+        proc.returncode = os.WEXITSTATUS(status)
+
+    match = _stats_re.search(output)
+    if proc.returncode != 0 or match is None:
+        sys.stderr.write('failed to optimize %s%s\n' %
+                         (minidump, ' in an arena' if arena else ''))
+        return None
+
+    return [os.path.basename(minidump), match.group(1),
+            int(match.group(2)), int(match.group(3)), int(match.group(4)),
+            int(match.group(5)), rusage.ru_maxrss, int(elapsed_ms)]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare the memory use of the optimizer in the default '
+                    'and in arena memory pools over a set of minidumps')
+    parser.add_argument('--gporca-test', default='./server/gporca_test',
+                        help='path of the gporca_test binary')
+    parser.add_argument('minidumps', nargs='*',
+                        help='minidumps to optimize, default all of '
+                             '../data/dxl/minidump')
+    args = parser.parse_args()
+
+    minidumps = args.minidumps
+    if not minidumps:
+        here = os.path.dirname(os.path.abspath(__file__))
+        minidumps = sorted(glob.glob(
+            os.path.join(here, '..', 'data', 'dxl', 'minidump', '*.mdp')))
+
+    totals = {}
+    print(','.join(_columns))
+    for minidump in minidumps:
+        for arena in (False, True):
+            row = run_minidump(args.gporca_test, minidump, arena)
+            if row is None:
+                continue
+            print(','.join(str(value) for value in row))
+
+            total = totals.setdefault(row[1], [0] * len(row))
+            for i in range(2, len(row)):
+                # RSS and peak sizes don't add up, keep their maximum
+                if _columns[i] in ('peak_live_bytes', 'peak_rss_kb'):
+                    total[i] = max(total[i], row[i])
+                else:
+                    total[i] += row[i]
+
+    for pool, total in sorted(totals.items()):
+        total[0] = 'TOTAL'
+        total[1] = pool
+        print(','.join(str(value) for value in total))
+
+
+if __name__ == '__main__':
+    main()
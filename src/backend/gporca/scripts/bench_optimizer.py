@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+
+# Optimization time benchmark of the optimizer over the minidump suite
+#
+# This program optimizes each minidump a number of times with gporca_test
+# (options -b and -m) and records per minidump:
+#
+# - the optimization time, the median over the runs
+# - the peak size of the live allocations in the memory pool
+# - the number of groups and group expressions in the memo
+# - the number of xform applications and of alternatives they produced
+#
+# The results are written as JSON. Given the results of a previous run as a
+# baseline, the program compares both and exits with status 1 if a minidump
+# got slower, used more memory, or searched more than the thresholds allow,
+# or if it no longer optimizes.
+#
+# Example, from the build directory of ORCA, to record a baseline on the
+# old build and check the new build against it:
+#
+#   ../scripts/bench_optimizer.py --gporca-test old/server/gporca_test \
+#       --output baseline.json
+#   ../scripts/bench_optimizer.py --gporca-test ./server/gporca_test \
+#       --baseline baseline.json --output results.json
+#
+# Run this program with the -h or --help option to see argument syntax
+
+import argparse
+import glob
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+_time_re = re.compile(r'Optimization time: (\d+) us')
+_memory_re = re.compile(r'Memory statistics: pool \w+, allocations \d+, '
+                        r'frees \d+, peak live bytes (\d+)')
+_summary_re = re.compile(r'Optimization summary: groups (\d+), '
+                         r'group expressions (\d+), '
+                         r'xform applications (\d+), xform results (\d+)')
+
+# measures of a minidump, and the threshold option of each
+_metrics = ['time_us', 'peak_bytes', 'groups', 'group_exprs',
+            'xform_applications', 'xform_results']
+_thresholds = {'time_us': 'time_threshold',
+               'peak_bytes': 'memory_threshold',
+               'groups': 'search_threshold',
+               'group_exprs': 'search_threshold',
+               'xform_applications': 'search_threshold',
+               'xform_results': 'search_threshold'}
+
+
+def run_minidump(gporca_test, minidump):
+    """Optimize a minidump once, return its measures or None on failure"""
+    proc = subprocess.run([gporca_test, '-b', '-m', '-d', minidump],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = proc.stdout.decode('utf-8', 'replace')
+
+    time_match = _time_re.search(output)
+    memory_match = _memory_re.search(output)
+    summary_match = _summary_re.search(output)
+    if (proc.returncode != 0 or time_match is None or memory_match is None
+            or summary_match is None):
+        return None
+
+    return {'time_us': int(time_match.group(1)),
+            'peak_bytes': int(memory_match.group(1)),
+            'groups': int(summary_match.group(1)),
+            'group_exprs': int(summary_match.group(2)),
+            'xform_applications': int(summary_match.group(3)),
+            'xform_results': int(summary_match.group(4))}
+
+
+def bench_minidump(gporca_test, minidump, runs):
+    """Optimize a minidump the given number of times, return the median of
+    each measure, or None if a run failed"""
+    samples = []
+    for _ in range(runs):
+        sample = run_minidump(gporca_test, minidump)
+        if sample is None:
+            return None
+        samples.append(sample)
+
+    return {metric: int(statistics.median(s[metric] for s in samples))
+            for metric in _metrics}
+
+
+def compare(baseline, results, thresholds, min_time_us):
+    """Compare the results to the baseline, return a list of regressions as
+    (minidump, metric, baseline value, new value) tuples
+
+    A measure regresses when it grew by more than its threshold, a fraction
+    of the baseline value. Times below min_time_us in both runs are too
+    noisy to compare. A minidump of the baseline that failed to optimize
+    is a regression with no new value."""
+    regressions = []
+    for minidump, old in sorted(baseline.items()):
+        if minidump not in results:
+            continue
+        new = results[minidump]
+        if new is None:
+            if old is not None:
+                regressions.append((minidump, 'optimization', None, None))
+            continue
+        if old is None:
+            continue
+
+        for metric in _metrics:
+            if metric not in old:
+                continue
+            if (metric == 'time_us' and old[metric] < min_time_us
+                    and new[metric] < min_time_us):
+                continue
+            if new[metric] > old[metric] * (1 + thresholds[metric]):
+                regressions.append((minidump, metric, old[metric],
+                                    new[metric]))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure the optimization time, memory and search effort '
+                    'of the optimizer over a set of minidumps, and check them '
+                    'against a baseline')
+    parser.add_argument('--gporca-test', default='./server/gporca_test',
+                        help='path of the gporca_test binary')
+    parser.add_argument('--runs', type=int, default=3,
+                        help='number of times to optimize each minidump, '
+                             'default 3')
+    parser.add_argument('--output',
+                        help='file to write the results to as JSON, default '
+                             'standard output')
+    parser.add_argument('--baseline',
+                        help='results of a previous run to compare against')
+    parser.add_argument('--time-threshold', type=float, default=0.2,
+                        help='allowed growth of the optimization time, as a '
+                             'fraction, default 0.2')
+    parser.add_argument('--memory-threshold', type=float, default=0.1,
+                        help='allowed growth of the peak memory, as a '
+                             'fraction, default 0.1')
+    parser.add_argument('--search-threshold', type=float, default=0.0,
+                        help='allowed growth of the memo and xform counts, '
+                             'as a fraction, default 0')
+    parser.add_argument('--min-time-us', type=int, default=10000,
+                        help='don\'t compare times below this many '
+                             'microseconds, default 10000')
+    parser.add_argument('minidumps', nargs='*',
+                        help='minidumps to optimize, default all of '
+                             '../data/dxl/minidump')
+    args = parser.parse_args()
+
+    minidumps = args.minidumps
+    if not minidumps:
+        here = os.path.dirname(os.path.abspath(__file__))
+        minidumps = sorted(glob.glob(
+            os.path.join(here, '..', 'data', 'dxl', 'minidump', '*.mdp')))
+
+    results = {}
+    for minidump in minidumps:
+        result = bench_minidump(args.gporca_test, minidump, args.runs)
+        if result is None:
+            sys.stderr.write('failed to optimize %s\n' % minidump)
+        results[os.path.basename(minidump)] = result
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+
+    if not args.baseline:
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    thresholds = {metric: getattr(args, option)
+                  for metric, option in _thresholds.items()}
+    regressions = compare(baseline, results, thresholds, args.min_time_us)
+    for minidump, metric, old, new in regressions:
+        if old is None:
+            sys.stderr.write('%s: no longer optimizes\n' % minidump)
+        else:
+            sys.stderr.write('%s: %s regressed from %d to %d\n' %
+                             (minidump, metric, old, new))
+
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
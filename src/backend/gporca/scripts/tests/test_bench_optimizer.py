@@ -0,0 +1,53 @@
+import unittest
+
+from bench_optimizer import compare
+
+
+def measures(time_us, peak_bytes=1000, groups=10):
+    return {'time_us': time_us, 'peak_bytes': peak_bytes, 'groups': groups,
+            'group_exprs': 20, 'xform_applications': 30,
+            'xform_results': 40}
+
+
+THRESHOLDS = {'time_us': 0.2, 'peak_bytes': 0.1, 'groups': 0.0,
+              'group_exprs': 0.0, 'xform_applications': 0.0,
+              'xform_results': 0.0}
+
+
+class TestCompare(unittest.TestCase):
+
+    def test_within_thresholds(self):
+        baseline = {'a.mdp': measures(100000)}
+        results = {'a.mdp': measures(119000, peak_bytes=1090)}
+        self.assertEqual(compare(baseline, results, THRESHOLDS, 10000), [])
+
+    def test_slower(self):
+        baseline = {'a.mdp': measures(100000)}
+        results = {'a.mdp': measures(130000)}
+        self.assertEqual(compare(baseline, results, THRESHOLDS, 10000),
+                         [('a.mdp', 'time_us', 100000, 130000)])
+
+    def test_short_times_ignored(self):
+        baseline = {'a.mdp': measures(1000)}
+        results = {'a.mdp': measures(5000)}
+        self.assertEqual(compare(baseline, results, THRESHOLDS, 10000), [])
+
+    def test_larger_memo(self):
+        baseline = {'a.mdp': measures(100000)}
+        results = {'a.mdp': measures(100000, groups=11)}
+        self.assertEqual(compare(baseline, results, THRESHOLDS, 10000),
+                         [('a.mdp', 'groups', 10, 11)])
+
+    def test_failure(self):
+        baseline = {'a.mdp': measures(100000), 'b.mdp': None}
+        results = {'a.mdp': None, 'b.mdp': None}
+        self.assertEqual(compare(baseline, results, THRESHOLDS, 10000),
+                         [('a.mdp', 'optimization', None, None)])
+
+    def test_minidump_not_run(self):
+        baseline = {'a.mdp': measures(100000)}
+        self.assertEqual(compare(baseline, {}, THRESHOLDS, 10000), [])
+
+
+if __name__ == '__main__':
+    unittest.main()
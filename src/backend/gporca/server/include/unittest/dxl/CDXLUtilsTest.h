@@ -35,6 +35,8 @@ public:
 	static GPOS_RESULT EresUnittest();
 	static GPOS_RESULT EresUnittest_SerializeQuery();
 	static GPOS_RESULT EresUnittest_SerializePlan();
+	static GPOS_RESULT EresUnittest_SerializePlanBinary();
+	static GPOS_RESULT EresUnittest_SerializeMetadataBinary();
 	static GPOS_RESULT EresUnittest_Encoding();
 
 };	// class CDXLUtilsTest
@@ -51,6 +51,9 @@ public:
 
 	// merge union test with double values differing by less than epsilon
 	static GPOS_RESULT EresUnittest_MergeUnionDoubleLessThanEpsilon();
+
+	// searching bucket boundaries
+	static GPOS_RESULT EresUnittest_BucketBoundaries();
 };	// class CHistogramTest
 }  // namespace gpnaucrates
 
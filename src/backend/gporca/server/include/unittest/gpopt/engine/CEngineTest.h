@@ -48,6 +48,11 @@ private:
 	// counter used to mark last successful test in subquery test
 	static ULONG m_ulTestCounterSubq;
 
+	// optimize the generated expression with a budget that runs out before
+	// the search starts, and check that a plan is found
+	static void OptimizeWithExhaustedBudget(
+		CMemoryPool *mp, CExpression *(*pfnGenerator)(CMemoryPool *mp));
+
 public:
 	// type definition of optimizer test function
 	using FnOptimize = void(CMemoryPool *, CExpression *, CSearchStageArray *);
@@ -58,6 +63,12 @@ public:
 	// basic unittest
 	static GPOS_RESULT EresUnittest_Basic();
 
+	// test of the duplicate detection statistics of the memo
+	static GPOS_RESULT EresUnittest_MemoDedupStats();
+
+	// test of a search whose optimization budget ran out
+	static GPOS_RESULT EresUnittest_BudgetExhausted();
+
 	// helper function for optimizing deep join trees
 	static GPOS_RESULT EresOptimize(
 		FnOptimize *pfopt,	 // optimization function
@@ -35,6 +35,7 @@ public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
 	static GPOS_RESULT EresUnittest_ExpandMinCard();
+	static GPOS_RESULT EresUnittest_EnumerationBenchmark();
 	static GPOS_RESULT EresUnittest_RunTests();
 
 };	// class CJoinOrderTest
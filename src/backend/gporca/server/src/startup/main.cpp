@@ -11,7 +11,10 @@
 
 #include "gpos/_api.h"
 #include "gpos/common/CMainArgs.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/memory/CMemoryPoolArena.h"
+#include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/test/CUnittest.h"
 #include "gpos/types.h"
 
@@ -182,6 +185,9 @@ static gpos::CUnittest rgut[] = {
 	GPOS_UNITTEST_STD(CConstExprEvaluatorDefaultTest),
 	GPOS_UNITTEST_STD(CConstExprEvaluatorDXLTest),
 
+	// benchmarks only report, they run with -x
+	GPOS_UNITTEST_FUNC_EXT(CJoinOrderTest::EresUnittest_EnumerationBenchmark),
+
 	// disable CEnumeratorTest until it is fixed
 	//	GPOS_UNITTEST_STD(CEnumeratorTest),
 };
@@ -235,6 +241,45 @@ Cleanup()
 	CTestUtils::DestroyMDProvider();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		PrintMemoryStatistics
+//
+//	@doc:
+//		Print allocation statistics of the pool a minidump ran in
+//
+//---------------------------------------------------------------------------
+static void
+PrintMemoryStatistics(CMemoryPool *mp)
+{
+	const CMemoryPoolStatistics *stats = nullptr;
+	CMemoryPoolArena *arena = dynamic_cast<CMemoryPoolArena *>(mp);
+	CMemoryPoolTracker *tracker = dynamic_cast<CMemoryPoolTracker *>(mp);
+	if (nullptr != arena)
+	{
+		stats = &arena->GetStatistics();
+	}
+	else if (nullptr != tracker)
+	{
+		stats = &tracker->GetStatistics();
+	}
+
+	if (nullptr == stats)
+	{
+		GPOS_TRACE(GPOS_WSZ_LIT("Memory statistics unavailable"));
+		return;
+	}
+
+	// trace from the task's pool, not to count the trace itself
+	CAutoTrace at(ITask::Self()->Pmp());
+	at.Os() << "Memory statistics: pool "
+			<< (nullptr != arena ? "arena" : "tracker") << ", allocations "
+			<< stats->GetNumSuccessfulAllocations() << ", frees "
+			<< stats->GetNumFree() << ", peak live bytes "
+			<< stats->PeakLiveObjTotalSize() << ", allocated bytes "
+			<< mp->TotalAllocatedSize();
+}
+
 // static variable counting the number of failed tests; PvExec overwrites with
 // the actual count of failed tests
 static ULONG tests_failed = 0;
@@ -259,6 +304,9 @@ PvExec(void *pv)
 	BOOL fMinidump = false;
 	BOOL fUnittest = false;
 	BOOL fPrintDXLPlan = false;
+	BOOL fArena = false;
+	BOOL fMemoryStats = false;
+	BOOL fBenchmark = false;
 	ULLONG ullPlanId = 0;
 
 	while (pma->Getopt(&ch))
@@ -299,6 +347,19 @@ PvExec(void *pv)
 				fPrintDXLPlan = true;
 				break;
 
+			case 'a':
+				fArena = true;
+				break;
+
+			case 'm':
+				fMemoryStats = true;
+				break;
+
+			case 'b':
+				fBenchmark = true;
+				GPOS_SET_TRACE(EopttracePrintOptimizationSummary);
+				break;
+
 			default:
 				// ignore other parameters
 				break;
@@ -319,7 +380,7 @@ PvExec(void *pv)
 
 		CMDCache::Init();
 
-		CAutoMemoryPool amp;
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, fArena);
 		CMemoryPool *mp = amp.Pmp();
 
 		// load dump file
@@ -344,10 +405,20 @@ PvExec(void *pv)
 
 		ULONG ulSegments = CTestUtils::UlSegments(optimizer_config);
 
+		// optimize the minidump loaded above rather than loading it again,
+		// so that the time measured is the time spent optimizing
+		CWallClock clock;
 		CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump(
-			mp, file_name, ulSegments, 1 /*ulSessionId*/, 1 /*ulCmdId*/,
-			optimizer_config, nullptr /*pceeval*/
+			mp, pdxlmd, file_name, ulSegments, 1 /*ulSessionId*/,
+			1 /*ulCmdId*/, optimizer_config, nullptr /*pceeval*/
 		);
+		const ULONG ulOptimizationTimeUS = clock.ElapsedUS();
+
+		if (fBenchmark)
+		{
+			GPOS_TRACE_FORMAT("Optimization time: %u us",
+							  ulOptimizationTimeUS);
+		}
 
 		if (fPrintDXLPlan)
 		{
@@ -364,6 +435,11 @@ PvExec(void *pv)
 		optimizer_config->Release();
 		pdxlnPlan->Release();
 		CMDCache::Shutdown();
+
+		if (fMemoryStats)
+		{
+			PrintMemoryStatistics(mp);
+		}
 	}
 	else
 	{
@@ -404,7 +480,7 @@ main(INT iArgs, const CHAR **rgszArgs)
 	GPOS_ASSERT(iArgs >= 0);
 
 	// setup args for unittest params
-	CMainArgs ma(iArgs, rgszArgs, "uU:d:xT:i:p");
+	CMainArgs ma(iArgs, rgszArgs, "uU:d:xT:i:pamb");
 
 	// initialize unittest framework
 	CUnittest::Init(rgut, GPOS_ARRAY_SIZE(rgut), ConfigureTests, Cleanup);
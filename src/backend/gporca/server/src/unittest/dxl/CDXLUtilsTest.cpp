@@ -23,6 +23,7 @@
 
 #include "naucrates/base/CQueryToDXLResult.h"
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CDXLBinaryWriter.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 
@@ -34,6 +35,7 @@ using namespace gpdxl;
 static const char *szQueryFile =
 	"../data/dxl/expressiontests/TableScanQuery.xml";
 static const char *szPlanFile = "../data/dxl/expressiontests/TableScanPlan.xml";
+static const char *szMetadataFile = "../data/dxl/parse_tests/q26-Metadata.xml";
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -49,6 +51,8 @@ CDXLUtilsTest::EresUnittest()
 	CUnittest rgut[] = {
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeQuery),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlan),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlanBinary),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeMetadataBinary),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_Encoding),
 	};
 
@@ -166,6 +170,123 @@ CDXLUtilsTest::EresUnittest_SerializePlan()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_SerializePlanBinary
+//
+//	@doc:
+//		Testing the round trip of plans through binary DXL: the plan parsed
+//		back from its binary encoding must serialize to the same XML
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_SerializePlanBinary()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CHAR *dxl_string = CDXLUtils::Read(mp, szPlanFile);
+
+	ULLONG plan_id = gpos::ullong_max;
+	ULLONG plan_space_size = gpos::ullong_max;
+	CDXLNode *node = CDXLUtils::GetPlanDXLNode(
+		mp, dxl_string, nullptr /*xsd_file_path*/, &plan_id, &plan_space_size);
+
+	CWStringDynamic str(mp);
+	COstreamString oss(&str);
+	CDXLUtils::SerializePlan(mp, oss, node, plan_id, plan_space_size,
+							 true /*serialize_header_footer*/,
+							 false /*indentation*/);
+
+	CDXLBinaryWriter binary_writer(mp);
+	CDXLUtils::SerializePlan(mp, &binary_writer, node, plan_id,
+							 plan_space_size);
+
+	ULLONG plan_id_binary = gpos::ullong_max;
+	ULLONG plan_space_size_binary = gpos::ullong_max;
+	CDXLNode *node_binary = CDXLUtils::GetPlanDXLNodeFromBinary(
+		mp, binary_writer.GetData(), binary_writer.Size(), &plan_id_binary,
+		&plan_space_size_binary);
+
+	CWStringDynamic str_binary(mp);
+	COstreamString oss_binary(&str_binary);
+	CDXLUtils::SerializePlan(mp, oss_binary, node_binary, plan_id_binary,
+							 plan_space_size_binary,
+							 true /*serialize_header_footer*/,
+							 false /*indentation*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (plan_id != plan_id_binary ||
+		plan_space_size != plan_space_size_binary ||
+		!str.Equals(&str_binary) || binary_writer.Size() >= str.Length())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// cleanup
+	node_binary->Release();
+	node->Release();
+	GPOS_DELETE_ARRAY(dxl_string);
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_SerializeMetadataBinary
+//
+//	@doc:
+//		Testing the round trip of metadata objects through binary DXL: the
+//		objects parsed back from their binary encoding must serialize to the
+//		same XML
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_SerializeMetadataBinary()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CHAR *dxl_string = CDXLUtils::Read(mp, szMetadataFile);
+
+	IMDCacheObjectArray *mdcache_obj_array = CDXLUtils::ParseDXLToIMDObjectArray(
+		mp, dxl_string, nullptr /*xsd_file_path*/);
+
+	CWStringDynamic *metadata_str = CDXLUtils::SerializeMetadata(
+		mp, mdcache_obj_array, true /*serialize_header_footer*/,
+		false /*indentation*/);
+
+	CDXLBinaryWriter binary_writer(mp);
+	CDXLUtils::SerializeMetadata(mp, mdcache_obj_array, &binary_writer);
+
+	IMDCacheObjectArray *mdcache_obj_array_binary =
+		CDXLUtils::ParseDXLBinaryToIMDObjectArray(mp, binary_writer.GetData(),
+												  binary_writer.Size());
+
+	CWStringDynamic *metadata_str_binary = CDXLUtils::SerializeMetadata(
+		mp, mdcache_obj_array_binary, true /*serialize_header_footer*/,
+		false /*indentation*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (mdcache_obj_array->Size() != mdcache_obj_array_binary->Size() ||
+		!metadata_str->Equals(metadata_str_binary) ||
+		binary_writer.Size() >= metadata_str->Length())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// cleanup
+	GPOS_DELETE(metadata_str_binary);
+	GPOS_DELETE(metadata_str);
+	mdcache_obj_array_binary->Release();
+	mdcache_obj_array->Release();
+	GPOS_DELETE_ARRAY(dxl_string);
+
+	return eres;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtilsTest::EresUnittest_Encoding
@@ -21,6 +21,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "naucrates/statistics/CBucketBoundaries.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CPoint.h"
 
@@ -42,7 +43,8 @@ CHistogramTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MergeUnion),
 		GPOS_UNITTEST_FUNC(
-			CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon)};
+			CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon),
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_BucketBoundaries)};
 
 
 	CAutoMemoryPool amp;
@@ -431,4 +433,102 @@ CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon()
 
 	return GPOS_OK;
 }
+// searching the bucket boundaries finds the same buckets as comparing
+// points with the buckets one by one
+GPOS_RESULT
+CHistogramTest::EresUnittest_BucketBoundaries()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// generate histogram of the form [0, 10), [10, 15], [20, 20], [30, 40),
+	// [40, 45], [50, 50] ... with gaps, singletons and touching buckets
+	CBucketArray *histogram_buckets = GPOS_NEW(mp) CBucketArray(mp);
+	const INT num_buckets = 300;
+	for (INT idx = 0; idx < num_buckets; idx++)
+	{
+		INT iLower = idx * 10;
+		INT iUpper = iLower;
+		BOOL is_upper_closed = true;
+		if (0 == idx % 3)
+		{
+			iUpper = iLower + 10;
+			is_upper_closed = false;
+		}
+		else if (1 == idx % 3)
+		{
+			iUpper = iLower + 5;
+		}
+		histogram_buckets->Append(CCardinalityTestUtils::PbucketInteger(
+			mp, iLower, iUpper, true /* is_lower_closed */, is_upper_closed,
+			CDouble(1.0 / num_buckets), CDouble(1.0)));
+	}
+	CHistogram *histogram = GPOS_NEW(mp) CHistogram(mp, histogram_buckets);
+
+	CBucketBoundaries *bucket_boundaries =
+		CBucketBoundaries::Pbb(mp, histogram_buckets);
+	GPOS_UNITTEST_ASSERT(nullptr != bucket_boundaries);
+
+	for (INT i = -5; i < num_buckets * 10 + 5; i++)
+	{
+		CPoint *point = CTestUtils::PpointInt4(mp, i);
+		CBucketBoundaries::SValue value;
+		GPOS_UNITTEST_ASSERT(bucket_boundaries->FValue(point, &value));
+
+		// first bucket the point is not after
+		ULONG first = 0;
+		while (first < histogram_buckets->Size() &&
+			   (*histogram_buckets)[first]->IsAfter(point))
+		{
+			first++;
+		}
+		GPOS_UNITTEST_ASSERT(first == bucket_boundaries->UlFindPoint(value));
+
+		// first bucket from a given one that does not end before the point
+		for (ULONG begin = 0; begin <= first; begin += 7)
+		{
+			ULONG first_not_below = begin;
+			while (first_not_below < histogram_buckets->Size() &&
+				   (*histogram_buckets)[first_not_below]
+					   ->GetUpperBound()
+					   ->IsLessThan(point))
+			{
+				first_not_below++;
+			}
+			GPOS_UNITTEST_ASSERT(
+				first_not_below ==
+				bucket_boundaries->UlFirstUpperNotBelow(begin, value));
+		}
+
+		// equality filter finds the bucket containing the point
+		CHistogram *histogram_eq =
+			histogram->MakeHistogramFilter(CStatsPred::EstatscmptEq, point);
+		BOOL is_contained = first < histogram_buckets->Size() &&
+							(*histogram_buckets)[first]->Contains(point);
+		GPOS_UNITTEST_ASSERT((is_contained ? 1 : 0) ==
+							 histogram_eq->GetNumBuckets());
+
+		point->Release();
+		GPOS_DELETE(histogram_eq);
+	}
+
+	// overlapping buckets have no boundaries
+	CBucketArray *overlapping_buckets = GPOS_NEW(mp) CBucketArray(mp);
+	overlapping_buckets->Append(
+		CCardinalityTestUtils::PbucketIntegerClosedLowerBound(mp, 0, 10, 0.5,
+															  5.0));
+	overlapping_buckets->Append(
+		CCardinalityTestUtils::PbucketIntegerClosedLowerBound(mp, 9, 20, 0.5,
+															  5.0));
+	GPOS_UNITTEST_ASSERT(nullptr ==
+						 CBucketBoundaries::Pbb(mp, overlapping_buckets));
+
+	bucket_boundaries->Release();
+	overlapping_buckets->Release();
+	GPOS_DELETE(histogram);
+
+	return GPOS_OK;
+}
+
 // EOF
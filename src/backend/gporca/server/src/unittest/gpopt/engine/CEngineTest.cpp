@@ -19,6 +19,7 @@
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupProxy.h"
 
@@ -41,6 +42,8 @@ CEngineTest::EresUnittest()
 {
 	CUnittest rgut[] = {
 		GPOS_UNITTEST_FUNC(EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(EresUnittest_MemoDedupStats),
+		GPOS_UNITTEST_FUNC(EresUnittest_BudgetExhausted),
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemo),
 		GPOS_UNITTEST_FUNC(EresUnittest_AppendStats),
@@ -117,6 +120,65 @@ CEngineTest::EresUnittest_Basic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_MemoDedupStats
+//
+//	@doc:
+//		Test of the lookup, duplicate and rehash counts of the memo
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_MemoDedupStats()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, nullptr, /* pceeval */
+					 CTestUtils::GetCostModel(mp));
+
+	CEngine eng(mp);
+
+	// generate a three-way join, whose join orders are found more than once
+	CExpression *pexpr = CTestUtils::PexprLogicalNAryJoin(mp);
+	CQueryContext *pqc = CTestUtils::PqcGenerate(mp, pexpr);
+
+	eng.Init(pqc, nullptr /*search_stage_array*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_UNITTEST_ASSERT(nullptr != pexprPlan);
+
+	// the stats are kept, and reset only when printed, without the trace
+	// flag; every group expression of the memo went through a lookup, and
+	// the commutations of the joins give back join orders already in it
+	CMemo *pmemo = eng.Pmemo();
+	GPOS_UNITTEST_ASSERT(pmemo->UlLookups() >= pmemo->UlGrpExprs());
+	GPOS_UNITTEST_ASSERT(0 < pmemo->UlDuplicatesFound());
+	GPOS_UNITTEST_ASSERT(pmemo->UlDuplicatesFound() < pmemo->UlLookups());
+
+	// only group expressions with a merged child group are rehashed
+	GPOS_UNITTEST_ASSERT(pmemo->UlRehashed() <= pmemo->UlGrpExprs());
+	if (0 == pmemo->UlDuplicateGroups())
+	{
+		GPOS_UNITTEST_ASSERT(0 == pmemo->UlRehashed());
+	}
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngineTest::EresOptimize
@@ -195,6 +257,104 @@ CEngineTest::EresOptimize(
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::OptimizeWithExhaustedBudget
+//
+//	@doc:
+//		Optimize an expression with a memory budget that runs out before
+//		the search starts, and check that a plan is still found
+//
+//---------------------------------------------------------------------------
+void
+CEngineTest::OptimizeWithExhaustedBudget(
+	CMemoryPool *mp, CExpression *(*pfnGenerator)(CMemoryPool *mp))
+{
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// a memory budget of 1KB is used up by the memo alone
+	CHint *phint = GPOS_NEW(mp) CHint(
+		gpos::int_max, /* join_arity_for_associativity_commutativity */
+		gpos::int_max, /* array_expansion_threshold */
+		JOIN_ORDER_DP_THRESHOLD,			 /*ulJoinOrderDPLimit*/
+		BROADCAST_THRESHOLD,				 /*broadcast_threshold*/
+		true,								 /* enforce_constraint_on_dml */
+		PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD, /* push_group_by_below_setop_threshold */
+		XFORM_BIND_THRESHOLD,				 /* xform_bind_threshold */
+		SKEW_FACTOR,						 /* skew_factor */
+		TIME_BUDGET,						 /* time_budget */
+		1									 /* memory_budget */
+	);
+	COptimizerConfig *optimizer_config = GPOS_NEW(mp) COptimizerConfig(
+		GPOS_NEW(mp) CEnumeratorConfig(mp, 0 /*plan_id*/, 0 /*ullSamples*/),
+		CStatisticsConfig::PstatsconfDefault(mp),
+		CCTEConfig::PcteconfDefault(mp), CTestUtils::GetCostModel(mp), phint,
+		nullptr /* pplanhint */, CWindowOids::GetWindowOids(mp));
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(mp, &mda, nullptr /* pceeval */, optimizer_config);
+
+	CEngine eng(mp);
+
+	// generate the expression
+	CExpression *pexpr = pfnGenerator(mp);
+
+	// generate query context
+	CQueryContext *pqc = CTestUtils::PqcGenerate(mp, pexpr);
+
+	// Initialize engine
+	eng.Init(pqc, nullptr /*search_stage_array*/);
+
+	// optimize query
+	eng.Optimize();
+
+	GPOS_UNITTEST_ASSERT(optimizer_config->FBudgetExhausted());
+	GPOS_UNITTEST_ASSERT(0 == optimizer_config->UlBudgetExhaustedStage());
+
+	// extract plan
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_UNITTEST_ASSERT(nullptr != pexprPlan);
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+}
+
+// a select with a correlated EXISTS subquery
+static CExpression *
+PexprSelectWithCorrelatedExists(CMemoryPool *mp)
+{
+	return CSubqueryTestUtils::PexprSelectWithExistsSubquery(
+		mp, true /*fCorrelated*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_BudgetExhausted
+//
+//	@doc:
+//		Optimize expressions with a budget that runs out before the search
+//		starts: an n-ary join is still expanded into binary joins, and a
+//		correlated subquery is still unnested, so that a plan is found
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_BudgetExhausted()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	OptimizeWithExhaustedBudget(mp, CTestUtils::PexprLogicalNAryJoin);
+	OptimizeWithExhaustedBudget(mp, PexprSelectWithCorrelatedExists);
+
+	return GPOS_OK;
+}
+
+
 #ifdef GPOS_DEBUG
 //---------------------------------------------------------------------------
 //	@function:
@@ -10,6 +10,7 @@
 //---------------------------------------------------------------------------
 #include "unittest/gpopt/xforms/CJoinOrderTest.h"
 
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/test/CUnittest.h"
@@ -20,6 +21,9 @@
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/xforms/CJoinOrder.h"
+#include "gpopt/xforms/CJoinOrderDP.h"
+#include "gpopt/xforms/CJoinOrderDPv2.h"
+#include "gpopt/xforms/CJoinOrderGreedy.h"
 #include "gpopt/xforms/CJoinOrderMinCard.h"
 
 #include "unittest/base.h"
@@ -135,6 +139,189 @@ CJoinOrderTest::EresUnittest_ExpandMinCard()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		PexprJoinGraph
+//
+//	@doc:
+//		Generate an n-ary join of the given relations, joining each relation
+//		but the first one with its parent relation
+//
+//---------------------------------------------------------------------------
+static CExpression *
+PexprJoinGraph(CMemoryPool *mp, CWStringConst *rgscRel, ULONG *rgulRel,
+			   const ULONG *rgulParent, ULONG ulRels)
+{
+	CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < ulRels; ul++)
+	{
+		pdrgpexpr->Append(CTestUtils::PexprLogicalGet(mp, &rgscRel[ul],
+													  &rgscRel[ul], rgulRel[ul]));
+	}
+
+	CExpressionArray *pdrgpexprPred = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 1; ul < ulRels; ul++)
+	{
+		GPOS_ASSERT(rgulParent[ul] < ul);
+
+		// get any two columns; one from each side
+		CColRef *pcrParent =
+			(*pdrgpexpr)[rgulParent[ul]]->DeriveOutputColumns()->PcrAny();
+		CColRef *pcrChild = (*pdrgpexpr)[ul]->DeriveOutputColumns()->PcrAny();
+		pdrgpexprPred->Append(CUtils::PexprScalarEqCmp(mp, pcrParent, pcrChild));
+	}
+	pdrgpexpr->Append(CPredicateUtils::PexprConjunction(mp, pdrgpexprPred));
+
+	return CTestUtils::PexprLogicalNAryJoin(mp, pdrgpexpr);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		EnumerateJoinOrders
+//
+//	@doc:
+//		Expand the given n-ary join with each of the join order algorithms
+//		that enumerate subsets of the join graph, and report the time each
+//		one takes
+//
+//---------------------------------------------------------------------------
+static void
+EnumerateJoinOrders(CMemoryPool *mp, CExpression *pexprNAryJoin,
+					const CHAR *szGraph)
+{
+	// derive stats on input expression
+	CExpressionHandle exprhdl(mp);
+	exprhdl.Attach(pexprNAryJoin);
+	exprhdl.DeriveStats(mp, mp, nullptr /*prprel*/, nullptr /*stats_ctxt*/);
+
+	const ULONG ulRels = pexprNAryJoin->Arity() - 1;
+	const CHAR *rgszAlgorithm[] = {"DP", "DPv2", "Greedy"};
+
+	for (ULONG ulAlgorithm = 0; ulAlgorithm < GPOS_ARRAY_SIZE(rgszAlgorithm);
+		 ulAlgorithm++)
+	{
+		CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+		for (ULONG ul = 0; ul < ulRels; ul++)
+		{
+			CExpression *pexprChild = (*pexprNAryJoin)[ul];
+			pexprChild->AddRef();
+			pdrgpexpr->Append(pexprChild);
+		}
+		CExpressionArray *pdrgpexprPred =
+			CPredicateUtils::PdrgpexprConjuncts(mp, (*pexprNAryJoin)[ulRels]);
+
+		CWallClock clock;
+		CExpression *pexprResult = nullptr;
+		switch (ulAlgorithm)
+		{
+			case 0:
+			{
+				CJoinOrderDP jodp(mp, pdrgpexpr, pdrgpexprPred);
+				pexprResult = jodp.PexprExpand();
+				break;
+			}
+			case 1:
+			{
+				CJoinOrderDPv2 jodp(mp, pdrgpexpr, pdrgpexprPred,
+									GPOS_NEW(mp) CExpressionArray(mp),
+									nullptr /*childPredIndexes*/,
+									GPOS_NEW(mp) CColRefSet(mp));
+				jodp.PexprExpand();
+				pexprResult = jodp.GetNextOfTopK();
+				CExpression *pexprNext = nullptr;
+				while (nullptr != (pexprNext = jodp.GetNextOfTopK()))
+				{
+					pexprNext->Release();
+				}
+				break;
+			}
+			default:
+			{
+				CJoinOrderGreedy jog(mp, pdrgpexpr, pdrgpexprPred);
+				pexprResult = jog.PexprExpand();
+				break;
+			}
+		}
+		ULONG ulElapsedMS = clock.ElapsedMS();
+
+		GPOS_UNITTEST_ASSERT(nullptr != pexprResult);
+		{
+			CAutoTrace at(mp);
+			at.Os() << szGraph << " join of " << ulRels << " relations, "
+					<< rgszAlgorithm[ulAlgorithm] << ": " << ulElapsedMS
+					<< " ms";
+		}
+		pexprResult->Release();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_EnumerationBenchmark
+//
+//	@doc:
+//		Time the join order enumeration of star and snowflake joins; this
+//		only reports, so it is an extended test, run by "gporca_test -x"
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_EnumerationBenchmark()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// array of relation names
+	CWStringConst rgscRel[] = {
+		GPOS_WSZ_LIT("Rel10"), GPOS_WSZ_LIT("Rel3"), GPOS_WSZ_LIT("Rel4"),
+		GPOS_WSZ_LIT("Rel6"),  GPOS_WSZ_LIT("Rel7"), GPOS_WSZ_LIT("Rel8"),
+		GPOS_WSZ_LIT("Rel12"), GPOS_WSZ_LIT("Rel13"), GPOS_WSZ_LIT("Rel5"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] = {
+		GPOPT_TEST_REL_OID10, GPOPT_TEST_REL_OID3,	GPOPT_TEST_REL_OID4,
+		GPOPT_TEST_REL_OID6,  GPOPT_TEST_REL_OID7,	GPOPT_TEST_REL_OID8,
+		GPOPT_TEST_REL_OID12, GPOPT_TEST_REL_OID13, GPOPT_TEST_REL_OID5,
+	};
+
+	// parent of each relation: a fact table joined with all the other
+	// relations, and a fact table joined with three dimensions that are
+	// joined with two, two and one further dimensions
+	const ULONG rgulStar[] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+	const ULONG rgulSnowflake[] = {0, 0, 0, 0, 1, 1, 2, 2, 3};
+
+	const ULONG ulRels = GPOS_ARRAY_SIZE(rgscRel);
+	GPOS_UNITTEST_ASSERT(GPOS_ARRAY_SIZE(rgulRel) == ulRels);
+	GPOS_UNITTEST_ASSERT(GPOS_ARRAY_SIZE(rgulStar) == ulRels);
+	GPOS_UNITTEST_ASSERT(GPOS_ARRAY_SIZE(rgulSnowflake) == ulRels);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	{
+		// install opt context in TLS
+		CAutoOptCtxt aoc(mp, &mda, nullptr, /* pceeval */
+						 CTestUtils::GetCostModel(mp));
+
+		CExpression *pexprStar =
+			PexprJoinGraph(mp, rgscRel, rgulRel, rgulStar, ulRels);
+		EnumerateJoinOrders(mp, pexprStar, "star");
+		pexprStar->Release();
+
+		CExpression *pexprSnowflake =
+			PexprJoinGraph(mp, rgscRel, rgulRel, rgulSnowflake, ulRels);
+		EnumerateJoinOrders(mp, pexprSnowflake, "snowflake");
+		pexprSnowflake->Release();
+	}
+
+	return GPOS_OK;
+}
+
 //	run all Minidump-based tests with plan matching
 GPOS_RESULT
 CJoinOrderTest::EresUnittest_RunTests()
@@ -0,0 +1,227 @@
+/*-------------------------------------------------------------------------
+ *
+ * losertree.c
+ *	  A tournament tree of losers, for merging sorted streams
+ *
+ * The streams are numbered from 0 to size - 1, and the caller keeps their
+ * heads.  The tree is a complete binary tree, with the streams as leaves:
+ * stream s is leaf size + s, and the children of node i are 2i and 2i + 1.
+ * Each internal node remembers the loser of the match between the winners
+ * of its two subtrees, and node 0 the overall winner.
+ *
+ * When the head of the winner changes, only the matches on the path from
+ * its leaf to the root are played again, against the losers stored along
+ * it.  That takes one comparison per level, where a binary heap needs up
+ * to two to sift a new head down.
+ *
+ * Portions Copyright (c) 2024-Present VMware, Inc. or its affiliates.
+ *
+ * IDENTIFICATION
+ *	  src/backend/lib/losertree.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "lib/losertree.h"
+
+static void replay(losertree *tree);
+
+/*
+ * Does the head of stream a come before the head of stream b?  Exhausted
+ * streams come after all the others.
+ */
+static inline bool
+comes_before(losertree *tree, int a, int b)
+{
+	if (tree->lt_exhausted[a])
+		return false;
+	if (tree->lt_exhausted[b])
+		return true;
+	return tree->lt_compare(a, b, tree->lt_arg) < 0;
+}
+
+/*
+ * losertree_allocate
+ *
+ * Returns a pointer to a newly-allocated tree merging the given number of
+ * streams, whose heads are compared by the given comparator function, which
+ * will be invoked with the additional argument specified by 'arg'.
+ */
+losertree *
+losertree_allocate(int size, losertree_comparator compare, void *arg)
+{
+	Size		sz;
+	losertree  *tree;
+
+	Assert(size > 0);
+
+	sz = MAXALIGN(offsetof(losertree, lt_nodes) + sizeof(int) * size);
+	tree = (losertree *) palloc(sz + sizeof(bool) * size);
+	tree->lt_size = size;
+	tree->lt_compare = compare;
+	tree->lt_arg = arg;
+	tree->lt_exhausted = (bool *) ((char *) tree + sz);
+
+	losertree_reset(tree);
+
+	return tree;
+}
+
+/*
+ * losertree_reset
+ *
+ * Resets the tree to have all its streams exhausted, losing its data
+ * content but not the parameters passed at allocation.
+ */
+void
+losertree_reset(losertree *tree)
+{
+	tree->lt_nactive = 0;
+	for (int i = 0; i < tree->lt_size; i++)
+		tree->lt_exhausted[i] = true;
+}
+
+/*
+ * losertree_free
+ *
+ * Releases memory used by the given losertree.
+ */
+void
+losertree_free(losertree *tree)
+{
+	pfree(tree);
+}
+
+/*
+ * losertree_add_unordered
+ *
+ * Marks the given stream as having a head.  The tree has to be built
+ * before the winner can be asked for.
+ */
+void
+losertree_add_unordered(losertree *tree, int stream)
+{
+	Assert(stream >= 0 && stream < tree->lt_size);
+	Assert(tree->lt_exhausted[stream]);
+
+	tree->lt_exhausted[stream] = false;
+	tree->lt_nactive++;
+}
+
+/*
+ * losertree_build
+ *
+ * Plays all the matches of the tree, in O(n) comparisons.
+ *
+ * The streams enter the tree one at a time.  The winner coming up from a
+ * leaf waits at the first node whose match isn't played yet for the winner
+ * of the other subtree of that node, and the one that comes second plays
+ * the match and goes on up with the winner.
+ */
+void
+losertree_build(losertree *tree)
+{
+	int			size = tree->lt_size;
+	int		   *nodes = tree->lt_nodes;
+
+	for (int i = 0; i < size; i++)
+		nodes[i] = -1;
+
+	for (int stream = 0; stream < size; stream++)
+	{
+		int			winner = stream;
+		int			node;
+
+		for (node = (size + stream) / 2; node > 0; node /= 2)
+		{
+			if (nodes[node] < 0)
+			{
+				nodes[node] = winner;
+				break;
+			}
+			if (comes_before(tree, nodes[node], winner))
+			{
+				int			loser = winner;
+
+				winner = nodes[node];
+				nodes[node] = loser;
+			}
+		}
+
+		/* only the stream that won the match at the root gets here */
+		if (node == 0)
+			nodes[0] = winner;
+	}
+}
+
+/*
+ * losertree_first
+ *
+ * Returns the stream whose head comes first, without modifying the tree.
+ * The tree must not be empty.
+ */
+int
+losertree_first(losertree *tree)
+{
+	Assert(!losertree_empty(tree));
+
+	return tree->lt_nodes[0];
+}
+
+/*
+ * losertree_replace_first
+ *
+ * Finds the new winner after the head of the previous winner has been
+ * replaced, in O(log n) comparisons.
+ */
+void
+losertree_replace_first(losertree *tree)
+{
+	Assert(!losertree_empty(tree));
+
+	replay(tree);
+}
+
+/*
+ * losertree_remove_first
+ *
+ * Marks the previous winner as exhausted, and finds the new winner in
+ * O(log n) comparisons.
+ */
+void
+losertree_remove_first(losertree *tree)
+{
+	Assert(!losertree_empty(tree));
+
+	tree->lt_exhausted[tree->lt_nodes[0]] = true;
+	tree->lt_nactive--;
+
+	if (!losertree_empty(tree))
+		replay(tree);
+}
+
+/*
+ * Play the matches on the path from the leaf of the previous winner to the
+ * root again.
+ */
+static void
+replay(losertree *tree)
+{
+	int		   *nodes = tree->lt_nodes;
+	int			winner = nodes[0];
+
+	for (int node = (tree->lt_size + winner) / 2; node > 0; node /= 2)
+	{
+		if (comes_before(tree, nodes[node], winner))
+		{
+			int			loser = winner;
+
+			winner = nodes[node];
+			nodes[node] = loser;
+		}
+	}
+
+	nodes[0] = winner;
+}
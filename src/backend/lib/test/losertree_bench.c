@@ -0,0 +1,187 @@
+/*
+ * Micro-benchmark of losertree.c: merge throughput and comparisons per value
+ * of a loser tree versus a binary heap, by number of streams, as for a
+ * sorted Gather Motion with that many senders.
+ *
+ * This only reports, it checks nothing; losertree_test.c does.  Run it with
+ * "make bench" in this directory.
+ */
+#include "../losertree.c"
+
+#include "lib/binaryheap.h"
+#include "portability/instr_time.h"
+#include "utils/memutils.h"
+
+/*
+ * Sorted streams of integers, the position of the head of each, and the
+ * number of comparisons made so far.
+ */
+typedef struct BenchStreams
+{
+	int			nstreams;
+	int		  **values;
+	int		   *lengths;
+	int		   *heads;
+	long		ncompares;
+} BenchStreams;
+
+static void
+bench_make_streams(BenchStreams *bs, int nstreams, int maxLength)
+{
+	srandom(42);
+
+	bs->nstreams = nstreams;
+	bs->values = palloc(nstreams * sizeof(int *));
+	bs->lengths = palloc(nstreams * sizeof(int));
+	bs->heads = palloc0(nstreams * sizeof(int));
+	bs->ncompares = 0;
+
+	for (int s = 0; s < nstreams; s++)
+	{
+		int			value = random() % 100;
+
+		bs->lengths[s] = random() % (maxLength + 1);
+		bs->values[s] = palloc((bs->lengths[s] + 1) * sizeof(int));
+		for (int i = 0; i < bs->lengths[s]; i++)
+		{
+			value += random() % 3;
+			bs->values[s][i] = value;
+		}
+	}
+}
+
+static void
+bench_free_streams(BenchStreams *bs)
+{
+	for (int s = 0; s < bs->nstreams; s++)
+		pfree(bs->values[s]);
+	pfree(bs->values);
+	pfree(bs->lengths);
+	pfree(bs->heads);
+}
+
+static int
+bench_compare(int a, int b, void *arg)
+{
+	BenchStreams *bs = (BenchStreams *) arg;
+	int			va = bs->values[a][bs->heads[a]];
+	int			vb = bs->values[b][bs->heads[b]];
+
+	bs->ncompares++;
+	return (va > vb) - (va < vb);
+}
+
+/* Same, for a max-heap of stream numbers, as the Motion used to have */
+static int
+bench_heap_compare(Datum a, Datum b, void *arg)
+{
+	return -bench_compare(DatumGetInt32(a), DatumGetInt32(b), arg);
+}
+
+/* Merge the streams with a loser tree, and return the number of values */
+static long
+bench_merge(BenchStreams *bs, losertree *lt)
+{
+	long		nvalues = 0;
+
+	losertree_reset(lt);
+	for (int s = 0; s < bs->nstreams; s++)
+	{
+		bs->heads[s] = 0;
+		if (bs->lengths[s] > 0)
+			losertree_add_unordered(lt, s);
+	}
+	losertree_build(lt);
+
+	while (!losertree_empty(lt))
+	{
+		int			s = losertree_first(lt);
+
+		nvalues++;
+
+		if (++bs->heads[s] < bs->lengths[s])
+			losertree_replace_first(lt);
+		else
+			losertree_remove_first(lt);
+	}
+
+	return nvalues;
+}
+
+/* Same, with a binary heap */
+static void
+bench_merge_heap(BenchStreams *bs, binaryheap *hp)
+{
+	binaryheap_reset(hp);
+	for (int s = 0; s < bs->nstreams; s++)
+	{
+		bs->heads[s] = 0;
+		if (bs->lengths[s] > 0)
+			binaryheap_add_unordered(hp, Int32GetDatum(s));
+	}
+	binaryheap_build(hp);
+
+	while (!binaryheap_empty(hp))
+	{
+		int			s = DatumGetInt32(binaryheap_first(hp));
+
+		if (++bs->heads[s] < bs->lengths[s])
+			binaryheap_replace_first(hp, Int32GetDatum(s));
+		else
+			binaryheap_remove_first(hp);
+	}
+}
+
+int
+main(int argc, char* argv[])
+{
+	int			sizes[] = {8, 64, 256, 1024};
+	long		totalValues = 1000000;
+
+	MemoryContextInit();
+
+	for (int i = 0; i < lengthof(sizes); i++)
+	{
+		int			nstreams = sizes[i];
+		BenchStreams bs;
+		losertree  *lt;
+		binaryheap *hp;
+		long		nvalues;
+		long		treeCompares;
+		long		heapCompares;
+		instr_time	start;
+		instr_time	treeTime;
+		instr_time	heapTime;
+
+		bench_make_streams(&bs, nstreams, 2 * totalValues / nstreams);
+		lt = losertree_allocate(nstreams, bench_compare, &bs);
+		hp = binaryheap_allocate(nstreams, bench_heap_compare, &bs);
+
+		INSTR_TIME_SET_CURRENT(start);
+		nvalues = bench_merge(&bs, lt);
+		INSTR_TIME_SET_CURRENT(treeTime);
+		INSTR_TIME_SUBTRACT(treeTime, start);
+		treeCompares = bs.ncompares;
+
+		bs.ncompares = 0;
+		INSTR_TIME_SET_CURRENT(start);
+		bench_merge_heap(&bs, hp);
+		INSTR_TIME_SET_CURRENT(heapTime);
+		INSTR_TIME_SUBTRACT(heapTime, start);
+		heapCompares = bs.ncompares;
+
+		printf("%5d streams: loser tree %.2f ns/value %.2f compares/value, "
+			   "binary heap %.2f ns/value %.2f compares/value\n",
+			   nstreams,
+			   INSTR_TIME_GET_DOUBLE(treeTime) * 1e9 / nvalues,
+			   (double) treeCompares / nvalues,
+			   INSTR_TIME_GET_DOUBLE(heapTime) * 1e9 / nvalues,
+			   (double) heapCompares / nvalues);
+
+		binaryheap_free(hp);
+		losertree_free(lt);
+		bench_free_streams(&bs);
+	}
+
+	return 0;
+}
@@ -0,0 +1,177 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../losertree.c"
+
+#include "utils/memutils.h"
+
+/*
+ * Sorted streams of integers, and the position of the head of each.
+ */
+typedef struct TestStreams
+{
+	int			nstreams;
+	int		  **values;
+	int		   *lengths;
+	int		   *heads;
+} TestStreams;
+
+static void
+test_make_streams(TestStreams *ts, int nstreams, int maxLength, unsigned int seed)
+{
+	srandom(seed);
+
+	ts->nstreams = nstreams;
+	ts->values = palloc(nstreams * sizeof(int *));
+	ts->lengths = palloc(nstreams * sizeof(int));
+	ts->heads = palloc0(nstreams * sizeof(int));
+
+	for (int s = 0; s < nstreams; s++)
+	{
+		int			value = random() % 100;
+
+		/* some streams are empty */
+		ts->lengths[s] = random() % (maxLength + 1);
+		ts->values[s] = palloc((ts->lengths[s] + 1) * sizeof(int));
+		for (int i = 0; i < ts->lengths[s]; i++)
+		{
+			/* with duplicates, within a stream and across them */
+			value += random() % 3;
+			ts->values[s][i] = value;
+		}
+	}
+}
+
+static void
+test_free_streams(TestStreams *ts)
+{
+	for (int s = 0; s < ts->nstreams; s++)
+		pfree(ts->values[s]);
+	pfree(ts->values);
+	pfree(ts->lengths);
+	pfree(ts->heads);
+}
+
+static int
+test_compare(int a, int b, void *arg)
+{
+	TestStreams *ts = (TestStreams *) arg;
+	int			va = ts->values[a][ts->heads[a]];
+	int			vb = ts->values[b][ts->heads[b]];
+
+	return (va > vb) - (va < vb);
+}
+
+/*
+ * Merge the streams with a loser tree, and check that the output is sorted
+ * and complete.
+ */
+static void
+test_merge(TestStreams *ts, losertree *lt)
+{
+	long		nvalues = 0;
+	long		total = 0;
+	int			last = PG_INT32_MIN;
+
+	losertree_reset(lt);
+	for (int s = 0; s < ts->nstreams; s++)
+	{
+		ts->heads[s] = 0;
+		total += ts->lengths[s];
+		if (ts->lengths[s] > 0)
+			losertree_add_unordered(lt, s);
+	}
+	losertree_build(lt);
+
+	while (!losertree_empty(lt))
+	{
+		int			s = losertree_first(lt);
+		int			value = ts->values[s][ts->heads[s]];
+
+		assert_true(value >= last);
+		last = value;
+		nvalues++;
+
+		if (++ts->heads[s] < ts->lengths[s])
+			losertree_replace_first(lt);
+		else
+			losertree_remove_first(lt);
+	}
+
+	assert_int_equal(nvalues, total);
+	for (int s = 0; s < ts->nstreams; s++)
+		assert_int_equal(ts->heads[s], ts->lengths[s]);
+}
+
+/*
+ * Merge streams of various counts, powers of two or not, with empty ones
+ * among them.
+ */
+static void
+test__losertree__Merge(void **state)
+{
+	int			sizes[] = {1, 2, 3, 5, 7, 8, 13, 64, 100, 257};
+
+	for (int i = 0; i < lengthof(sizes); i++)
+	{
+		TestStreams ts;
+		losertree  *lt;
+
+		test_make_streams(&ts, sizes[i], 50, i + 1);
+		lt = losertree_allocate(sizes[i], test_compare, &ts);
+
+		test_merge(&ts, lt);
+
+		/* merging again after a reset gives the same result */
+		test_merge(&ts, lt);
+
+		losertree_free(lt);
+		test_free_streams(&ts);
+	}
+}
+
+/*
+ * All the streams empty, or all of them but one.
+ */
+static void
+test__losertree__Empty(void **state)
+{
+	TestStreams ts;
+	losertree  *lt;
+
+	test_make_streams(&ts, 10, 0, 1);
+	lt = losertree_allocate(10, test_compare, &ts);
+
+	losertree_build(lt);
+	assert_true(losertree_empty(lt));
+
+	ts.lengths[7] = 1;
+	ts.values[7][0] = 42;
+	losertree_add_unordered(lt, 7);
+	losertree_build(lt);
+	assert_false(losertree_empty(lt));
+	assert_int_equal(losertree_first(lt), 7);
+
+	losertree_remove_first(lt);
+	assert_true(losertree_empty(lt));
+
+	losertree_free(lt);
+	test_free_streams(&ts);
+}
+
+int
+main(int argc, char* argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const UnitTest tests[] = {
+			unit_test(test__losertree__Merge),
+			unit_test(test__losertree__Empty)
+	};
+
+	MemoryContextInit();
+
+	return run_tests(tests);
+}
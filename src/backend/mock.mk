@@ -124,6 +124,12 @@ WRAP_FUNCS=$(addprefix $(WRAP_FLAGS), \
 %.t: $(OBJFILES) $(CMOCKERY_OBJS) $(MOCK_OBJS) %_test.o
 	$(CXX) $(CFLAGS) $(LDFLAGS) $(call WRAP_FUNCS, $(top_srcdir)/$(subdir)/test/$*_test.c) $(call BACKEND_OBJS, $(top_srcdir)/$(subdir)/$*.o $(patsubst $(MOCK_DIR)/%_mock.o,$(top_builddir)/src/%.o, $^)) $(filter-out %/objfiles.txt, $^) $(MOCK_LIBS) -o $@
 
+# A benchmark program is linked the same way, from <name>_bench.c.  It only
+# reports timings, so it is built and run by "make bench", and not by
+# "make check".
+%.bench: $(OBJFILES) $(CMOCKERY_OBJS) $(MOCK_OBJS) %_bench.o
+	$(CXX) $(CFLAGS) $(LDFLAGS) $(call BACKEND_OBJS, $(top_srcdir)/$(subdir)/$*.o $(patsubst $(MOCK_DIR)/%_mock.o,$(top_builddir)/src/%.o, $^)) $(filter-out %/objfiles.txt, $^) $(MOCK_LIBS) -o $@
+
 # We'd like to call only src/backend, but it seems we should build src/port and
 # src/timezone before src/backend.  This is not the case when main build has finished,
 # but this makes sure a simple make works fine in this directory any time.
@@ -151,6 +151,8 @@ _copyPlannedStmt(const PlannedStmt *from)
 	COPY_NODE_FIELD(copyIntoClause);
 	COPY_NODE_FIELD(refreshClause);
 	COPY_SCALAR_FIELD(metricsQueryType);
+	COPY_SCALAR_FIELD(optimizerBudgetStage);
+	COPY_SCALAR_FIELD(optimizerSearchStages);
 
 	return newnode;
 }
@@ -393,6 +393,8 @@ _outPlannedStmt(StringInfo str, const PlannedStmt *node)
 	WRITE_NODE_FIELD(copyIntoClause);
 	WRITE_NODE_FIELD(refreshClause);
 	WRITE_INT_FIELD(metricsQueryType);
+	WRITE_INT_FIELD(optimizerBudgetStage);
+	WRITE_INT_FIELD(optimizerSearchStages);
 }
 
 
@@ -2461,6 +2461,8 @@ _readPlannedStmt(void)
 	READ_NODE_FIELD(copyIntoClause);
 	READ_NODE_FIELD(refreshClause);
 	READ_INT_FIELD(metricsQueryType);
+	READ_INT_FIELD(optimizerBudgetStage);
+	READ_INT_FIELD(optimizerSearchStages);
 
 	READ_DONE();
 }
@@ -662,6 +662,11 @@ cdb_estimate_rel_size(RelOptInfo   *relOptInfo,
  * inheritance), this sums up the estimates from the child tables. Also, if
  * gp_enable_relsize_collection is off, and none of the partitions have been
  * analyzed, this returns 0 rather than the default constant estimate.
+ *
+ * Once the root has been analyzed, its own estimate stands for the whole
+ * table and the partitions are not looked at. Until then, this reads the
+ * pg_class row of every partition: cheaper than opening them, but still
+ * linear in the number of partitions.
  */
 double
 cdb_estimate_partitioned_numtuples(Relation rel)
@@ -684,46 +689,62 @@ cdb_estimate_partitioned_numtuples(Relation rel)
 	foreach(lc, inheritors)
 	{
 		Oid			childid = lfirst_oid(lc);
-		Relation	childrel;
+		HeapTuple	tuple;
 		double		childtuples;
 
+		/*
+		 * Read the estimate of the child from its pg_class row rather than
+		 * from its relcache entry, which would have to be built for every
+		 * partition of the table.
+		 */
 		if (childid != RelationGetRelid(rel))
-			childrel = RelationIdGetRelation(childid);
-		else
-			childrel = rel;
+		{
+			tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(childid));
 
-		// If childrel is NULL, continue by assuming the child relation
-		// has 0 tuples.
-		if (childrel == NULL)
-			continue;
+			// If the child is gone, continue by assuming it has 0 tuples.
+			if (!HeapTupleIsValid(tuple))
+				continue;
 
-		childtuples = childrel->rd_rel->reltuples;
+			childtuples = ((Form_pg_class) GETSTRUCT(tuple))->reltuples;
+			ReleaseSysCache(tuple);
+		}
+		else
+			childtuples = rel->rd_rel->reltuples;
 
 		if (gp_enable_relsize_collection && childtuples == 0)
 		{
+			Relation	childrel;
 			RelOptInfo *dummy_reloptinfo;
 			BlockNumber	numpages;
 			double		allvisfrac;
 
-			dummy_reloptinfo = makeNode(RelOptInfo);
-			dummy_reloptinfo->cdbpolicy = rel->rd_cdbpolicy;
+			if (childid != RelationGetRelid(rel))
+				childrel = RelationIdGetRelation(childid);
+			else
+				childrel = rel;
 
-			cdb_estimate_rel_size(dummy_reloptinfo,
-								  childrel,
-								  NULL,
-								  &numpages,
-								  &childtuples,
-								  &allvisfrac);
-			pfree(dummy_reloptinfo);
+			if (childrel != NULL)
+			{
+				dummy_reloptinfo = makeNode(RelOptInfo);
+				dummy_reloptinfo->cdbpolicy = rel->rd_cdbpolicy;
+
+				cdb_estimate_rel_size(dummy_reloptinfo,
+									  childrel,
+									  NULL,
+									  &numpages,
+									  &childtuples,
+									  &allvisfrac);
+				pfree(dummy_reloptinfo);
+
+				if (childrel != rel)
+					heap_close(childrel, NoLock);
+			}
 		}
-		if (childtuples == 0 && rel_is_external_table(RelationGetRelid(childrel)))
+		if (childtuples == 0 && rel_is_external_table(childid))
 		{
 			childtuples = DEFAULT_EXTERNAL_TABLE_TUPLES;
 		}
 		totaltuples += childtuples;
-
-		if (childrel != rel)
-			heap_close(childrel, NoLock);
 	}
 	return totaltuples;
 }
@@ -758,23 +779,24 @@ cdb_estimate_partitioned_numpages(Relation rel)
 	foreach(lc, inheritors)
 	{
 		Oid			childid = lfirst_oid(lc);
-		Relation	childrel;
+		HeapTuple	tuple;
+		Form_pg_class childform;
 
-		if (childid != RelationGetRelid(rel))
-			childrel = RelationIdGetRelation(childid);
-		else
-			childrel = rel;
+		if (childid == RelationGetRelid(rel))
+			continue;
+
+		/* as above, read the pg_class row instead of opening the child */
+		tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(childid));
 
-		// If childrel is NULL, continue by assuming the child relation
-		// has 0 pages.
-		if (childrel == NULL)
+		// If the child is gone, continue by assuming it has 0 pages.
+		if (!HeapTupleIsValid(tuple))
 			continue;
 
-		estimate.totalpages += childrel->rd_rel->relpages;
-		estimate.totalallvisiblepages += childrel->rd_rel->relallvisible;
+		childform = (Form_pg_class) GETSTRUCT(tuple);
+		estimate.totalpages += childform->relpages;
+		estimate.totalallvisiblepages += childform->relallvisible;
 
-		if (childrel != rel)
-			heap_close(childrel, NoLock);
+		ReleaseSysCache(tuple);
 	}
 	return estimate;
 }
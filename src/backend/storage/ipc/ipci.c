@@ -71,6 +71,8 @@
 #include "cdb/cdbendpoint.h"
 #include "replication/gp_replication.h"
 #include "cdb/ic_proxy_bgworker.h"
+#include "cdb/ic_shm.h"
+#include "cdb/ml_ipc.h"
 
 /* GUCs */
 int			shared_memory_type = DEFAULT_SHARED_MEMORY_TYPE;
@@ -233,6 +235,12 @@ CreateSharedMemoryAndSemaphores(int port)
 		/* size of parallel cursor count */
 		size = add_size(size, ParallelCursorCountSize());
 
+		/* size of the registry of interconnect shared memory queues */
+		size = add_size(size, ICShmShmemSize());
+
+		/* size of the interconnect connection statistics */
+		size = add_size(size, ICConnStatsShmemSize());
+
 		elog(DEBUG3, "invoking IpcMemoryCreate(size=%zu)", size);
 
 		/*
@@ -408,6 +416,9 @@ CreateSharedMemoryAndSemaphores(int port)
 	if (Gp_role == GP_ROLE_DISPATCH)
 		ParallelCursorCountInit();
 
+	ICShmShmemInit();
+	ICConnStatsShmemInit();
+
 	/*
 	 * Now give loadable modules a chance to set up their shmem allocations
 	 */
@@ -8,6 +8,10 @@
  *
  * gp_opt_version: This function wraps LibraryVersion. 
  *
+ * gp_opt_mdcache_stats: This function wraps MDCacheStats.
+ *
+ * gp_opt_plan_cache_stats: This function wraps PlanCacheStats.
+ *
  * Copyright(c) 2012 - present, EMC/Greenplum
  */
 
@@ -60,3 +64,39 @@ gp_opt_version(PG_FUNCTION_ARGS pg_attribute_unused())
 	return CStringGetTextDatum("Server has been compiled without ORCA");
 #endif
 }
+
+extern Datum MDCacheStats(PG_FUNCTION_ARGS);
+
+/*
+* Returns the counters of the optimizer's metadata cache in this backend.
+*/
+Datum
+gp_opt_mdcache_stats(PG_FUNCTION_ARGS)
+{
+#ifdef USE_ORCA
+	return MDCacheStats(fcinfo);
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+			 errmsg("server has been compiled without ORCA")));
+	PG_RETURN_NULL();
+#endif
+}
+
+extern Datum PlanCacheStats(PG_FUNCTION_ARGS);
+
+/*
+* Returns the counters of the optimizer's plan cache in this backend.
+*/
+Datum
+gp_opt_plan_cache_stats(PG_FUNCTION_ARGS)
+{
+#ifdef USE_ORCA
+	return PlanCacheStats(fcinfo);
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+			 errmsg("server has been compiled without ORCA")));
+	PG_RETURN_NULL();
+#endif
+}
@@ -330,6 +330,49 @@ get_partition_qual_relid(Oid relid)
 	return result;
 }
 
+/*
+ * get_partition_qual_for_parent
+ *
+ * GPDB: Returns the partition constraint of the given partition of 'parent',
+ * in implicit-AND list format, with Vars bearing the parent's attnos. Only
+ * the bound of the partition is read, from the syscache, so the partition
+ * itself is not opened; ORCA uses this to prune the partitions of a table
+ * without building relcache entries for all of them.
+ *
+ * Unlike generate_partition_qual(), the result does not include the quals
+ * of the parent, if it is a partition too, and it is not cached.
+ */
+List *
+get_partition_qual_for_parent(Relation parent, Oid partoid)
+{
+	HeapTuple	tuple;
+	Datum		boundDatum;
+	bool		isnull;
+	List	   *result = NIL;
+
+	tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(partoid));
+	if (!HeapTupleIsValid(tuple))
+		elog(ERROR, "cache lookup failed for relation %u", partoid);
+
+	boundDatum = SysCacheGetAttr(RELOID, tuple,
+								 Anum_pg_class_relpartbound,
+								 &isnull);
+	if (!isnull)
+	{
+		PartitionBoundSpec *bound;
+
+		bound = castNode(PartitionBoundSpec,
+						 stringToNode(TextDatumGetCString(boundDatum)));
+
+		/* the bound is all get_qual_from_partbound() needs of the partition */
+		result = get_qual_from_partbound(NULL, parent, bound);
+	}
+
+	ReleaseSysCache(tuple);
+
+	return result;
+}
+
 /*
  * generate_partition_qual
  *
@@ -33,6 +33,7 @@
 #include "utils/guc.h"
 #include "catalog/pg_compression.h"
 #include "utils/faultinjector.h"
+#include "utils/typcache.h"
 
 typedef enum AOCSBK
 {
@@ -303,7 +304,52 @@ datumstreamwrite_put(
 					 bool null,
 					 void **toFree)
 {
-	return DatumStreamBlockWrite_Put(&acc->blockWrite, d, null, toFree);
+	int			result;
+
+	result = DatumStreamBlockWrite_Put(&acc->blockWrite, d, null, toFree);
+
+	/* A negative result means the datum didn't fit, and wasn't added */
+	if (acc->track_zonemap && result >= 0)
+		minipage_zonemap_add(&acc->zonemap, d, null, &acc->zonemap_ssup);
+
+	return result;
+}
+
+/*
+ * Record the minimum and maximum value of each block written from now on
+ * in the block directory, so that scans can skip blocks that can't satisfy
+ * their quals.
+ *
+ * Only fixed-length, pass-by-value types with a default btree opclass are
+ * supported, since the zone map keeps the values as plain Datums.  This is a
+ * no-op for other types, and dropped columns.  Must be called before anything
+ * is put into the stream.
+ */
+void
+datumstreamwrite_track_zonemap(DatumStreamWrite * acc)
+{
+	TypeCacheEntry *typentry;
+
+	if (acc->track_zonemap)
+		return;
+
+	Assert(DatumStreamBlockWrite_Nth(&acc->blockWrite) == 0);
+
+	if (!OidIsValid(acc->typeInfo.typid) ||
+		!acc->typeInfo.byval || acc->typeInfo.datumlen <= 0)
+		return;
+
+	typentry = lookup_type_cache(acc->typeInfo.typid, TYPECACHE_LT_OPR);
+	if (!OidIsValid(typentry->lt_opr))
+		return;
+
+	MemSet(&acc->zonemap_ssup, 0, sizeof(SortSupportData));
+	acc->zonemap_ssup.ssup_cxt = CurrentMemoryContext;
+	acc->zonemap_ssup.ssup_collation = InvalidOid;
+	PrepareSortSupportFromOrderingOp(typentry->lt_opr, &acc->zonemap_ssup);
+
+	MemSet(&acc->zonemap, 0, sizeof(MinipageZoneMap));
+	acc->track_zonemap = true;
 }
 
 int
@@ -1011,12 +1057,24 @@ datumstreamwrite_block(DatumStreamWrite *acc,
 	}
 
 	/* Insert an entry to the block directory */
-	AppendOnlyBlockDirectory_InsertEntry(
-		blockDirectory,
-		columnGroupNo,
-		acc->blockFirstRowNum,
-		AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
-		itemCount);
+	if (acc->track_zonemap)
+	{
+		AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+			blockDirectory,
+			columnGroupNo,
+			acc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
+			itemCount,
+			&acc->zonemap);
+		MemSet(&acc->zonemap, 0, sizeof(MinipageZoneMap));
+	}
+	else
+		AppendOnlyBlockDirectory_InsertEntry(
+			blockDirectory,
+			columnGroupNo,
+			acc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
+			itemCount);
 
 	return writesz;
 }
@@ -1429,6 +1487,47 @@ datumstreamread_find(DatumStreamRead * datumStream,
 	Assert(rowNumInBlock == DatumStreamBlockRead_Nth(&datumStream->blockRead));
 }
 
+/*
+ * Skip ahead to the given row number, so that the next
+ * datumstreamread_advance() returns the first row at or after rowNum.  The
+ * blocks in between are passed over without reading their content.  rowNum
+ * must not be before the current row.
+ *
+ * Returns false if the segment file ends before rowNum.
+ */
+bool
+datumstreamread_skip_to(DatumStreamRead * datumStream, int64 rowNum)
+{
+	Assert(rowNum > 0);
+
+	/* Is the row still in the current block? */
+	if (rowNum >= datumStream->blockFirstRowNum + datumStream->blockRowCount)
+	{
+		while (true)
+		{
+			if (!datumstreamread_block_info(datumStream))
+				return false;
+
+			/* Pre-4.0 blocks don't know their first row, so we can't skip them */
+			if (datumStream->getBlockInfo.firstRow < 0 ||
+				rowNum < datumStream->blockFirstRowNum + datumStream->blockRowCount)
+				break;
+
+			AppendOnlyStorageRead_SkipCurrentBlock(&datumStream->ao_read);
+		}
+
+		datumstreamread_block_content(datumStream);
+	}
+
+	/* datumstreamread_find() positions on a row, we want the one before it */
+	if (rowNum > datumStream->blockFirstRowNum &&
+		datumStream->getBlockInfo.firstRow >= 0)
+		datumstreamread_find(datumStream,
+							 rowNum - datumStream->blockFirstRowNum - 1);
+
+	return true;
+}
+
 /*
  * Find the block that contains the given row.
  */
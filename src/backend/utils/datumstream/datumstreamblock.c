@@ -945,6 +945,196 @@ DatumStreamBlockRead_GetReadyDense(
 	dsr->datump = dsr->datum_beginp;
 }
 
+/*
+ * Bulk decoding.
+ *
+ * The loops in DatumStreamBlockRead_FillRepeated() and
+ * DatumStreamBlockRead_ExpandFixed() are kept free of any block state so
+ * that the compiler can vectorize them; this file is built with
+ * CFLAGS_VECTOR for that reason.
+ */
+
+/*
+ * Value of the current item of a Dense block of a fixed-length, by-value
+ * type.  Same as DatumStreamBlockRead_Get() for a non-NULL item, without the
+ * checks.
+ */
+static inline Datum
+DatumStreamBlockRead_FixedValue(DatumStreamBlockRead * dsr)
+{
+	if (dsr->delta_item)
+	{
+		if (dsr->typeInfo.datumlen == 4)
+			return (Datum) (uint32) dsr->delta_datum_p;
+		return dsr->delta_datum_p;
+	}
+
+	switch (dsr->typeInfo.datumlen)
+	{
+		case 1:
+			return *(uint8 *) dsr->datump;
+		case 2:
+			return *(uint16 *) dsr->datump;
+		case 4:
+			return *(uint32 *) dsr->datump;
+		default:
+			Assert(dsr->typeInfo.datumlen == 8);
+			return *(Datum *) dsr->datump;
+	}
+}
+
+static void
+DatumStreamBlockRead_FillRepeated(Datum *values, bool *isnull,
+								  Datum value, int32 count)
+{
+	for (int32 i = 0; i < count; i++)
+		values[i] = value;
+	memset(isnull, false, count * sizeof(bool));
+}
+
+static void
+DatumStreamBlockRead_ExpandFixed(Datum *values, bool *isnull,
+								 uint8 *p, int32 datumlen, int32 count)
+{
+	switch (datumlen)
+	{
+		case 1:
+			for (int32 i = 0; i < count; i++)
+				values[i] = ((uint8 *) p)[i];
+			break;
+		case 2:
+			for (int32 i = 0; i < count; i++)
+				values[i] = ((uint16 *) p)[i];
+			break;
+		case 4:
+			for (int32 i = 0; i < count; i++)
+				values[i] = ((uint32 *) p)[i];
+			break;
+		default:
+			/* 8-byte items may be only 4-byte aligned. */
+			Assert(datumlen == 8);
+			memcpy(values, p, count * sizeof(Datum));
+			break;
+	}
+	memset(isnull, false, count * sizeof(bool));
+}
+
+/*
+ * Decode up to 'maxrows' rows following the current position into 'values'
+ * and 'isnull', and return how many were decoded.
+ *
+ * This is equivalent to calling DatumStreamBlockRead_Advance() and
+ * DatumStreamBlockRead_Get() once per row, and leaves the reader positioned
+ * on the last row returned, so the two interfaces can be mixed freely.
+ *
+ * For fixed-length, by-value types in Dense blocks, the rest of a RLE_TYPE
+ * repeated item is expanded with a single fill, and a block without NULLs,
+ * RLE_TYPE or delta compression is expanded with a single copy.  Delta items
+ * are a running sum over variable-length deltas, and NULLs and the start of
+ * every RLE_TYPE item need the bit-maps, so those still go through the dense
+ * advance path one row at a time.  By-reference values point into the block,
+ * as with DatumStreamBlockRead_Get().
+ */
+int32
+DatumStreamBlockRead_GetBatch(DatumStreamBlockRead * dsr,
+							  Datum *values,
+							  bool *isnull,
+							  int32 maxrows)
+{
+	int32		nrows;
+	int32		r;
+
+	nrows = Min(maxrows, dsr->logical_row_count - (dsr->nth + 1));
+	if (nrows <= 0)
+		return 0;
+
+	if (dsr->datumStreamVersion == DatumStreamVersion_Original ||
+		!dsr->typeInfo.byval ||
+		dsr->typeInfo.datumlen <= 0)
+	{
+		for (r = 0; r < nrows; r++)
+		{
+			if (DatumStreamBlockRead_Advance(dsr) == 0)
+				break;
+			DatumStreamBlockRead_Get(dsr, &values[r], &isnull[r]);
+		}
+		return r;
+	}
+
+#ifdef USE_ASSERT_CHECKING
+	if (strncmp(dsr->eyecatcher, DatumStreamBlockRead_Eyecatcher, DatumStreamBlockRead_EyecatcherLen) != 0)
+		elog(FATAL, "DatumStreamBlockRead data structure not valid (eyecatcher)");
+#endif
+
+	r = 0;
+	while (r < nrows)
+	{
+		int32		count;
+
+		if (dsr->rle_in_repeated_item)
+		{
+			/*
+			 * We are positioned on a repeated item; hand out the remaining
+			 * copies in one go.
+			 */
+			Assert(dsr->rle_block_was_compressed);
+			Assert(dsr->rle_repeated_item_count > 0);
+
+			count = Min(dsr->rle_repeated_item_count, nrows - r);
+			DatumStreamBlockRead_FillRepeated(&values[r], &isnull[r],
+											  DatumStreamBlockRead_FixedValue(dsr),
+											  count);
+
+			dsr->nth += count;
+			dsr->rle_repeated_item_count -= count;
+			dsr->rle_total_repeat_items_read += count;
+			if (dsr->rle_repeated_item_count <= 0)
+				dsr->rle_in_repeated_item = false;
+			r += count;
+			continue;
+		}
+
+		(void) DatumStreamBlockRead_AdvanceDense(dsr);
+		if (dsr->has_null && DatumStreamBitMapRead_CurrentIsOn(&dsr->null_bitmap))
+		{
+			values[r] = (Datum) 0;
+			isnull[r] = true;
+		}
+		else
+		{
+			values[r] = DatumStreamBlockRead_FixedValue(dsr);
+			isnull[r] = false;
+		}
+		r++;
+
+		if (!dsr->rle_block_was_compressed &&
+			!dsr->delta_block_was_compressed &&
+			!dsr->has_null &&
+			r < nrows)
+		{
+			/*
+			 * Nothing but plain items from here on.  The reader is on a
+			 * physical item now, so the next ones follow it directly.
+			 */
+			count = nrows - r;
+			Assert(dsr->datump + (count + 1) * dsr->typeInfo.datumlen <= dsr->datum_afterp);
+
+			DatumStreamBlockRead_ExpandFixed(&values[r], &isnull[r],
+											 dsr->datump + dsr->typeInfo.datumlen,
+											 dsr->typeInfo.datumlen,
+											 count);
+
+			dsr->datump += count * dsr->typeInfo.datumlen;
+			dsr->physical_datum_index += count;
+			dsr->nth += count;
+			r += count;
+		}
+	}
+
+	Assert(r == nrows);
+	return nrows;
+}
+
 static int
 errdetail_datumstreamblockwrite(
 								DatumStreamBlockWrite * dsw)
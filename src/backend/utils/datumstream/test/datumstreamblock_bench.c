@@ -0,0 +1,72 @@
+/*
+ * Micro-benchmark of datumstreamblock.c: per-value cost of decoding a whole
+ * Dense block of int4 with Advance/Get versus GetBatch.
+ *
+ * This only reports, it checks nothing; datumstreamblock_test.c does.  Run
+ * it with "make bench" in this directory.
+ */
+#include "../datumstreamblock.c"
+#include "datumstreamblock_fixture.h"
+
+#include "portability/instr_time.h"
+#include "utils/memutils.h"
+
+static void
+bench_decode(const char *name, FixturePattern pattern, bool rle, bool delta)
+{
+	DatumStreamTypeInfo typeInfo;
+	DatumStreamBlockRead dsr;
+	uint8	   *buffer = palloc0(FIXTURE_BLOCK_SIZE);
+	Datum		values[FIXTURE_MAX_ROWS];
+	bool		isnull[FIXTURE_MAX_ROWS];
+	int32		blockSize;
+	int			rowCount;
+	int			loops = 2000;
+	instr_time	start;
+	instr_time	rowTime;
+	instr_time	batchTime;
+
+	fixture_init_int4(&typeInfo);
+	rowCount = fixture_write_block(pattern, rle, delta, &typeInfo, buffer, &blockSize);
+
+	INSTR_TIME_SET_CURRENT(start);
+	for (int l = 0; l < loops; l++)
+	{
+		(void) fixture_read_ready(&dsr, &typeInfo, buffer, blockSize, rowCount);
+		for (int r = 0; r < rowCount; r++)
+		{
+			DatumStreamBlockRead_Advance(&dsr);
+			DatumStreamBlockRead_Get(&dsr, &values[r], &isnull[r]);
+		}
+	}
+	INSTR_TIME_SET_CURRENT(rowTime);
+	INSTR_TIME_SUBTRACT(rowTime, start);
+
+	INSTR_TIME_SET_CURRENT(start);
+	for (int l = 0; l < loops; l++)
+	{
+		(void) fixture_read_ready(&dsr, &typeInfo, buffer, blockSize, rowCount);
+		DatumStreamBlockRead_GetBatch(&dsr, values, isnull, rowCount);
+	}
+	INSTR_TIME_SET_CURRENT(batchTime);
+	INSTR_TIME_SUBTRACT(batchTime, start);
+
+	printf("%-24s %5d rows/block: Advance/Get %.2f ns/value, GetBatch %.2f ns/value\n",
+		   name, rowCount,
+		   INSTR_TIME_GET_DOUBLE(rowTime) * 1e9 / ((double) loops * rowCount),
+		   INSTR_TIME_GET_DOUBLE(batchTime) * 1e9 / ((double) loops * rowCount));
+
+	pfree(buffer);
+}
+
+int
+main(int argc, char* argv[])
+{
+	MemoryContextInit();
+
+	bench_decode("int4 plain", FIXTURE_PATTERN_PLAIN, false, false);
+	bench_decode("int4 rle_type runs", FIXTURE_PATTERN_RUNS, true, false);
+	bench_decode("int4 rle_type+delta", FIXTURE_PATTERN_MIXED, true, true);
+
+	return 0;
+}
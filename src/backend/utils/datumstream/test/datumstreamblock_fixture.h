@@ -0,0 +1,114 @@
+/*
+ * Dense blocks of int4 for datumstreamblock_test.c and
+ * datumstreamblock_bench.c.  Include it after "../datumstreamblock.c".
+ */
+#ifndef DATUMSTREAMBLOCK_FIXTURE_H
+#define DATUMSTREAMBLOCK_FIXTURE_H
+
+#define FIXTURE_BLOCK_SIZE		32768
+#define FIXTURE_MAX_ROWS		4000
+
+typedef enum FixturePattern
+{
+	FIXTURE_PATTERN_PLAIN,		/* no repeats, no NULLs */
+	FIXTURE_PATTERN_RUNS,		/* long runs of repeated values */
+	FIXTURE_PATTERN_MIXED		/* runs, small steps, big jumps and NULLs */
+} FixturePattern;
+
+static void
+fixture_value(FixturePattern pattern, int i, Datum *d, bool *null)
+{
+	*null = false;
+	switch (pattern)
+	{
+		case FIXTURE_PATTERN_PLAIN:
+			*d = Int32GetDatum(i * 7919);
+			break;
+		case FIXTURE_PATTERN_RUNS:
+			*d = Int32GetDatum(i / 100);
+			break;
+		case FIXTURE_PATTERN_MIXED:
+			if (i % 37 == 0)
+				*null = true;
+			else if (i % 50 == 0)
+				*d = Int32GetDatum(-i * 100003);
+			else
+				*d = Int32GetDatum(i / 5 + (i % 3));
+			break;
+	}
+}
+
+static void
+fixture_init_int4(DatumStreamTypeInfo *typeInfo)
+{
+	memset(typeInfo, 0, sizeof(*typeInfo));
+	typeInfo->datumlen = 4;
+	typeInfo->typid = INT4OID;
+	typeInfo->typstorage = 'p';
+	typeInfo->align = 'i';
+	typeInfo->byval = true;
+}
+
+/*
+ * Write a Dense block of int4 values following 'pattern' into 'buffer', and
+ * return its row count.  The block size is returned in *blockSize.
+ */
+static int
+fixture_write_block(FixturePattern pattern, bool rle, bool delta,
+					DatumStreamTypeInfo *typeInfo, uint8 *buffer,
+					int32 *blockSize)
+{
+	DatumStreamBlockWrite dsw;
+	void	   *toFree;
+	int			i;
+
+	memset(&dsw, 0, sizeof(dsw));
+	DatumStreamBlockWrite_Init(&dsw, typeInfo,
+							   DatumStreamVersion_Dense_Enhanced,
+							   rle, delta,
+							   FIXTURE_MAX_ROWS, FIXTURE_MAX_ROWS,
+							   FIXTURE_BLOCK_SIZE,
+							   NULL, NULL, NULL, NULL);
+	DatumStreamBlockWrite_GetReady(&dsw);
+
+	for (i = 0; i < FIXTURE_MAX_ROWS; i++)
+	{
+		Datum		d;
+		bool		null;
+
+		fixture_value(pattern, i, &d, &null);
+		if (DatumStreamBlockWrite_Put(&dsw, d, null, &toFree) < 0)
+			break;
+	}
+
+	*blockSize = (int32) DatumStreamBlockWrite_Block(&dsw, buffer);
+	DatumStreamBlockWrite_Finish(&dsw);
+
+	return i;
+}
+
+/*
+ * Get 'dsr' ready to read the block written by fixture_write_block().
+ * Returns whether the reader had to adjust the row count, which it should
+ * not.
+ */
+static bool
+fixture_read_ready(DatumStreamBlockRead *dsr, DatumStreamTypeInfo *typeInfo,
+				   uint8 *buffer, int32 blockSize, int rowCount)
+{
+	bool		hadToAdjustRowCount;
+	int32		adjustedRowCount;
+
+	memset(dsr, 0, sizeof(*dsr));
+	DatumStreamBlockRead_Init(dsr, typeInfo,
+							  DatumStreamVersion_Dense_Enhanced,
+							  true,
+							  NULL, NULL, NULL, NULL);
+	DatumStreamBlockRead_GetReady(dsr, buffer, blockSize,
+								  1, rowCount,
+								  &hadToAdjustRowCount, &adjustedRowCount);
+
+	return hadToAdjustRowCount;
+}
+
+#endif							/* DATUMSTREAMBLOCK_FIXTURE_H */
@@ -4,6 +4,9 @@
 #include "cmockery.h"
 
 #include "../datumstreamblock.c"
+#include "datumstreamblock_fixture.h"
+
+#include "utils/memutils.h"
 
 /* 
  * Unit test function to test the routines added for
@@ -167,13 +170,110 @@ test__DeltaCompression__Core(void **state)
 	free(dsw);
 }
 
+/*
+ * DatumStreamBlockRead_GetBatch() must return exactly what Advance/Get
+ * return, whatever the batch sizes, and leave the reader where Advance/Get
+ * would.
+ */
+static void
+test_GetBatch_matches(FixturePattern pattern, bool rle, bool delta)
+{
+	DatumStreamTypeInfo typeInfo;
+	DatumStreamBlockRead dsr;
+	uint8	   *buffer = palloc0(FIXTURE_BLOCK_SIZE);
+	Datum		expected[FIXTURE_MAX_ROWS];
+	bool		expectedNull[FIXTURE_MAX_ROWS];
+	Datum		values[FIXTURE_MAX_ROWS];
+	bool		isnull[FIXTURE_MAX_ROWS];
+	int32		blockSize;
+	int			rowCount;
+	int			r;
+	int			batchSize;
+
+	fixture_init_int4(&typeInfo);
+	rowCount = fixture_write_block(pattern, rle, delta, &typeInfo, buffer, &blockSize);
+	assert_true(rowCount > 0);
+
+	assert_false(fixture_read_ready(&dsr, &typeInfo, buffer, blockSize, rowCount));
+	for (r = 0; r < rowCount; r++)
+	{
+		assert_int_equal(DatumStreamBlockRead_Advance(&dsr), 1);
+		DatumStreamBlockRead_Get(&dsr, &expected[r], &expectedNull[r]);
+	}
+	assert_int_equal(DatumStreamBlockRead_Advance(&dsr), 0);
+
+	for (batchSize = 1; batchSize <= rowCount; batchSize = batchSize * 3 + 1)
+	{
+		assert_false(fixture_read_ready(&dsr, &typeInfo, buffer, blockSize, rowCount));
+
+		r = 0;
+		while (r < rowCount)
+		{
+			int			n;
+
+			/* Interleave single rows, to check the reader position. */
+			if (r % 2 == 1)
+			{
+				assert_int_equal(DatumStreamBlockRead_Advance(&dsr), 1);
+				DatumStreamBlockRead_Get(&dsr, &values[r], &isnull[r]);
+				n = 1;
+			}
+			else
+			{
+				n = DatumStreamBlockRead_GetBatch(&dsr, &values[r], &isnull[r], batchSize);
+				assert_int_equal(n, Min(batchSize, rowCount - r));
+			}
+			assert_int_equal(DatumStreamBlockRead_Nth(&dsr), r + n - 1);
+			r += n;
+		}
+		assert_int_equal(DatumStreamBlockRead_GetBatch(&dsr, values, isnull, batchSize), 0);
+
+		for (r = 0; r < rowCount; r++)
+		{
+			assert_int_equal(isnull[r], expectedNull[r]);
+			if (!isnull[r])
+				assert_int_equal(values[r], expected[r]);
+		}
+	}
+
+	pfree(buffer);
+}
+
+static void
+test__GetBatch__Plain(void **state)
+{
+	test_GetBatch_matches(FIXTURE_PATTERN_PLAIN, false, false);
+	test_GetBatch_matches(FIXTURE_PATTERN_PLAIN, true, true);
+}
+
+static void
+test__GetBatch__Rle(void **state)
+{
+	test_GetBatch_matches(FIXTURE_PATTERN_RUNS, true, false);
+	test_GetBatch_matches(FIXTURE_PATTERN_RUNS, true, true);
+}
+
+static void
+test__GetBatch__Mixed(void **state)
+{
+	test_GetBatch_matches(FIXTURE_PATTERN_MIXED, false, false);
+	test_GetBatch_matches(FIXTURE_PATTERN_MIXED, true, false);
+	test_GetBatch_matches(FIXTURE_PATTERN_MIXED, true, true);
+}
+
 int 
 main(int argc, char* argv[]) 
 {
 	cmockery_parse_arguments(argc, argv);
 
 	const UnitTest tests[] = {
-			unit_test(test__DeltaCompression__Core)
+			unit_test(test__DeltaCompression__Core),
+			unit_test(test__GetBatch__Plain),
+			unit_test(test__GetBatch__Rle),
+			unit_test(test__GetBatch__Mixed)
 	};
+
+	MemoryContextInit();
+
 	return run_tests(tests);
 }
@@ -9471,6 +9471,37 @@ get_explain_guc_options(int *num)
 	return result;
 }
 
+/*
+ * Return the "name=value" lines of all the options that differ from their
+ * built-in defaults, other than internal ones, in a palloc'd string.
+ *
+ * GPDB: ORCA's plan cache keys plans on these, since a plan may depend on any
+ * option, not only on the ones passed to the optimizer.  Internal options,
+ * like gp_command_count, can't change plans, and some change every query.
+ */
+char *
+GetModifiedConfigOptions(void)
+{
+	StringInfoData buf;
+
+	initStringInfo(&buf);
+
+	for (int i = 0; i < num_guc_variables; i++)
+	{
+		struct config_generic *conf = guc_variables[i];
+		char	   *value;
+
+		if (conf->context == PGC_INTERNAL || !is_guc_modified(conf))
+			continue;
+
+		value = _ShowOption(conf, false);
+		appendStringInfo(&buf, "%s=%s\n", conf->name, value);
+		pfree(value);
+	}
+
+	return buf.data;
+}
+
 /*
  * Return GUC variable value by name; optionally return canonical form of
  * name.  If the GUC is unset, then throw an error unless missing_ok is true,
@@ -82,6 +82,7 @@ static bool check_optimizer(bool *newval, void **extra, GucSource source);
 static bool check_verify_gpfdists_cert(bool *newval, void **extra, GucSource source);
 static bool check_dispatch_log_stats(bool *newval, void **extra, GucSource source);
 static bool check_gp_workfile_compression(bool *newval, void **extra, GucSource source);
+static bool check_gp_interconnect_compression(int *newval, void **extra, GucSource source);
 
 /* Helper function for guc setter */
 bool gpvars_check_gp_resqueue_priority_default_value(char **newval,
@@ -143,6 +144,7 @@ bool		gp_appendonly_verify_block_checksums = true;
 bool		gp_appendonly_verify_write_block = false;
 bool		gp_appendonly_compaction = true;
 int			gp_appendonly_compaction_threshold = 0;
+int			gp_appendonly_prefetch_size = 1024;
 bool		gp_heap_require_relhasoids_match = true;
 bool		gp_local_distributed_cache_stats = false;
 bool		debug_xlog_record_read = false;
@@ -284,6 +286,9 @@ int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
 bool		optimizer_use_gpdb_allocators;
+bool		optimizer_use_arena_memory_pool;
+bool		optimizer_plan_caching;
+int			optimizer_plan_cache_size;
 
 /* Optimizer debugging GUCs */
 bool		optimizer_print_query;
@@ -382,6 +387,8 @@ int			optimizer_cte_inlining_bound;
 int			optimizer_push_group_by_below_setop_threshold;
 int			optimizer_xform_bind_threshold;
 int			optimizer_skew_factor;
+int			optimizer_time_budget;
+int			optimizer_memory_budget;
 bool		optimizer_force_multistage_agg;
 bool		optimizer_force_three_stage_scalar_dqa;
 bool		optimizer_force_expanded_distinct_aggs;
@@ -456,6 +463,15 @@ double		optimizer_jit_optimize_above_cost;
 /* Switch to toggle block-directory based sampling for AO/CO tables */
 bool		gp_enable_blkdir_sampling;
 
+/* Record zone maps of AO blocks in the block directory, and skip by them */
+bool		gp_enable_blkdir_zonemap = false;
+
+/* Decode AO_COLUMN sequential scans in batches of rows */
+bool		gp_enable_aocs_batch_scan = true;
+
+/* Build runtime filters in Hash and push them down to the outer SeqScan */
+bool		gp_enable_runtime_filter_pushdown = false;
+
 /* GUC to set interval for streaming archival status */
 int wal_sender_archiving_status_interval;
 
@@ -536,10 +552,20 @@ static const struct config_enum_entry gp_autostats_modes[] = {
 
 static const struct config_enum_entry gp_interconnect_fc_methods[] = {
 	{"loss", INTERCONNECT_FC_METHOD_LOSS},
+	{"delay", INTERCONNECT_FC_METHOD_DELAY},
 	{"capacity", INTERCONNECT_FC_METHOD_CAPACITY},
 	{NULL, 0}
 };
 
+static const struct config_enum_entry gp_interconnect_compressions[] = {
+	{"off", INTERCONNECT_COMPRESSION_OFF},
+	{"on", INTERCONNECT_COMPRESSION_ON},
+	{"auto", INTERCONNECT_COMPRESSION_AUTO},
+	{"false", INTERCONNECT_COMPRESSION_OFF, true},
+	{"true", INTERCONNECT_COMPRESSION_ON, true},
+	{NULL, 0}
+};
+
 static const struct config_enum_entry gp_interconnect_types[] = {
 	{"udpifc", INTERCONNECT_TYPE_UDPIFC},
 	{"tcp", INTERCONNECT_TYPE_TCP},
@@ -680,6 +706,40 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"gp_enable_blkdir_zonemap", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables recording zone maps of the blocks of append-optimized "
+						 "tables in their block directory, and skipping blocks using them."),
+			gettext_noop("Zone maps are only recorded for tables that have an index, "
+						 "and were created or last rewritten with pg_appendonly.version 3 "
+						 "or later.")
+		},
+		&gp_enable_blkdir_zonemap,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"gp_enable_aocs_batch_scan", PGC_USERSET, DEVELOPER_OPTIONS,
+		 gettext_noop("Enables decoding append-optimized column oriented "
+					  "tables in batches of rows during sequential scans."),
+		 NULL,
+		 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&gp_enable_aocs_batch_scan,
+		true,
+		NULL, NULL, NULL
+	},
+	{
+		{"gp_enable_runtime_filter_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables building bloom and min/max filters on hash join "
+						 "keys and pushing them down to the outer sequential scan."),
+			gettext_noop("Only applies to inner, semi and right hash joins whose "
+						 "outer child is a sequential scan in the same slice.")
+		},
+		&gp_enable_runtime_filter_pushdown,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"gp_enable_hashjoin_size_heuristic", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("In hash join plans, the smaller of the two inputs "
@@ -1097,6 +1157,29 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_explain_bytes", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Report the bytes sent by Motion nodes over the interconnect in EXPLAIN ANALYZE."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_interconnect_explain_bytes,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_interconnect_shm", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Sends Motion tuples between processes of the same segment through shared memory."),
+			gettext_noop("Only used with the UDPIFC interconnect type. Connections between "
+						 "different segments use the network, even on the same host."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_interconnect_shm,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_cache_future_packets", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Control whether future packets are cached."),
@@ -1968,6 +2051,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_plan_caching", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("This guc enables the optimizer to cache and reuse the plans of identical queries."),
+			NULL
+		},
+		&optimizer_plan_caching,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_print_missing_stats", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Print columns with missing statistics."),
@@ -2787,6 +2880,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_use_arena_memory_pool", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Allocate the memory of each ORCA optimization from an arena that is released at once."),
+			gettext_noop("Allocations are cheaper, but memory freed during "
+						 "the optimization is not reused until it ends."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_use_arena_memory_pool,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"vmem_process_interrupt", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Checks for interrupts before reserving VMEM"),
@@ -3296,6 +3401,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_appendonly_prefetch_size", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Sets how far ahead of a sequential read of an append-optimized segment file the kernel is asked to read."),
+			gettext_noop("Use 0 to disable read-ahead hints."),
+			GUC_UNIT_KB
+		},
+		&gp_appendonly_prefetch_size,
+		1024, 0, 1024 * 1024,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_workfile_max_entries", PGC_POSTMASTER, RESOURCES,
 			gettext_noop("Sets the maximum number of entries that can be stored in the workfile directory"),
@@ -4204,6 +4320,28 @@ struct config_int ConfigureNamesInt_gp[] =
             NULL, NULL, NULL
     },
 
+	{
+		{"optimizer_time_budget", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the optimization time after which GPORCA stops exploring and returns the best plan found so far."),
+			gettext_noop("A value of 0 disables the limit."),
+			GUC_UNIT_MS
+		},
+		&optimizer_time_budget,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_memory_budget", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the optimizer memory after which GPORCA stops exploring and returns the best plan found so far."),
+			gettext_noop("A value of 0 disables the limit."),
+			GUC_UNIT_KB
+		},
+		&optimizer_memory_budget,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_join_order_threshold", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Maximum number of join children to use dynamic programming based join ordering algorithm."),
@@ -4247,6 +4385,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_plan_cache_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the size of the optimizer plan cache."),
+			NULL,
+			GUC_UNIT_KB
+		},
+		&optimizer_plan_cache_size,
+		16384, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4943,13 +5092,24 @@ struct config_enum ConfigureNamesEnum_gp[] =
 	{
 		{"gp_interconnect_fc_method", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Sets the flow control method used for UDP interconnect."),
-			gettext_noop("Valid values are \"capacity\" and \"loss\".")
+			gettext_noop("Valid values are \"capacity\", \"loss\" and \"delay\".")
 		},
 		&Gp_interconnect_fc_method,
 		INTERCONNECT_FC_METHOD_LOSS, gp_interconnect_fc_methods,
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_compression", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Compresses the data sent by Motion nodes over the interconnect."),
+			gettext_noop("Valid values are \"off\", \"on\" and \"auto\". With \"auto\", "
+						 "a connection whose data doesn't compress well stops compressing for a while.")
+		},
+		&Gp_interconnect_compression,
+		INTERCONNECT_COMPRESSION_OFF, gp_interconnect_compressions,
+		check_gp_interconnect_compression, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_type", PGC_BACKEND, GP_ARRAY_TUNING,
 			gettext_noop("Sets the protocol used for inter-node communication."),
@@ -5402,6 +5562,19 @@ check_gp_workfile_compression(bool *newval, void **extra, GucSource source)
 	return true;
 }
 
+static bool
+check_gp_interconnect_compression(int *newval, void **extra, GucSource source)
+{
+#ifndef USE_ZSTD
+	if (*newval != INTERCONNECT_COMPRESSION_OFF)
+	{
+		GUC_check_errmsg("interconnect compression is not supported by this build");
+		return false;
+	}
+#endif
+	return true;
+}
+
 void
 DispatchSyncPGVariable(struct config_generic * gconfig)
 {
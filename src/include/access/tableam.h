@@ -237,7 +237,7 @@ typedef struct TableAmRoutine
 	/*
 	 * GPDB: Extract columns for scan from either a projection array
 	 * or a targetlist and quals. This is currently used for AOCO
-	 * tables.
+	 * tables, and by AO_ROW tables for the quals.
 	 */
 	TableScanDesc	(*scan_begin_extractcolumns) (Relation rel,
 												  Snapshot snapshot,
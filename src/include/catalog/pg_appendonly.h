@@ -59,10 +59,12 @@ typedef enum AORelationVersion
 	AORelationVersion_None = 0,
 	AORelationVersion_GP6 = 1,
 	AORelationVersion_GP7 = 2,
+	AORelationVersion_BlkdirZoneMap = 3,	/* block directory minipages may
+											 * have zone maps */
 	MaxAORelationVersion
 } AORelationVersion;
 
-#define AORelationVersion_GetLatest() AORelationVersion_GP7
+#define AORelationVersion_GetLatest() AORelationVersion_BlkdirZoneMap
 #define AORelationVersion_Get(relation) (relation)->rd_appendonly->version
 #define AORelationVersion_Validate(relation, version) \
 	(AORelationVersion_Get((relation)) >= (version))
@@ -305,10 +305,58 @@ typedef struct AOCSScanDescData
 	 * CO table, starting at a certain logical heap block and ending in another.
 	 */
 	bool 		partialScan;
+
+	/*
+	 * Rows decoded ahead, column-at-a-time, by aocs_getnext_batch(). If set,
+	 * aocs_getnext() hands out rows from here instead of stepping every
+	 * datum stream once per row.
+	 */
+	struct AOCSBatchData *batch;
+
+	/*
+	 * Zone map filter built from the scan's quals, or NULL.  Rows in the
+	 * ranges it refutes are skipped without being decoded.  zonemapNextRow is
+	 * the lowest row number the next row of the current segfile can have, or
+	 * InvalidAORowNum if we don't know yet.
+	 */
+	struct AppendOnlyZoneMapFilterData *zonemapFilter;
+	int64		zonemapNextRow;
+
+	/*
+	 * Bytes prefetched and time stalled in reads by the data streams that
+	 * rescans have closed.  See aocs_read_stats().
+	 */
+	int64		prefetchBytes;
+	instr_time	stallTime;
 } AOCSScanDescData;
 
 typedef AOCSScanDescData *AOCSScanDesc;
 
+/*
+ * AOCSBatchData holds up to 'maxrows' visible rows of an AOCS scan, as one
+ * vector per projected column.  values[attno] and isnull[attno] (attno is
+ * zero based) are only allocated for the projected columns.
+ *
+ * By-reference values point into the datum stream block buffers.  A batch
+ * never spans a block boundary of any column, so they stay valid until the
+ * next call to aocs_getnext_batch().
+ */
+typedef struct AOCSBatchData
+{
+	int			maxrows;		/* capacity of each vector */
+	int			nrows;			/* number of rows currently held */
+	int			nextrow;		/* next row to return from aocs_getnext() */
+	AttrNumber	natts;			/* length of values and isnull */
+	Datum	  **values;
+	bool	  **isnull;
+	ItemPointerData *tids;		/* fake ctid of each row */
+	int64	   *rownums;		/* scratch: row number of each row */
+} AOCSBatchData;
+
+typedef AOCSBatchData *AOCSBatch;
+
+#define AOCS_BATCH_MAX_ROWS 1024
+
 /*
  * AOCSDeleteDescData is used for delete data from AOCS relations.
  * It serves an equivalent purpose as AppendOnlyScanDescData
@@ -427,6 +475,11 @@ extern void aocs_rescan(AOCSScanDesc scan);
 extern void aocs_endscan(AOCSScanDesc scan);
 
 extern bool aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot);
+extern AOCSBatch aocs_batch_create(AOCSScanDesc scan, int maxrows);
+extern int	aocs_getnext_batch(AOCSScanDesc scan, AOCSBatch batch);
+extern void aocs_read_stats(AOCSScanDesc scan, int64 *prefetchBytes,
+							instr_time *stallTime);
+
 extern AOCSInsertDesc aocs_insert_init(Relation rel, int segno, int64 num_rows);
 extern void aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupleId);
 static inline void aocs_insert(AOCSInsertDesc idesc, TupleTableSlot *slot)
@@ -122,6 +122,16 @@ typedef struct AppendOnlyInsertDescData
 	/* The block directory for the appendonly relation. */
 	AppendOnlyBlockDirectory blockDirectory;
 	Oid segrelid;
+
+	/*
+	 * Zone maps of the current block, when the block directory records them,
+	 * or NULL.  Zone map i is of column zonemapAttnums[i], or of no column if
+	 * that is InvalidAttrNumber.
+	 */
+	int				nzonemaps;
+	MinipageZoneMap *zonemaps;
+	AttrNumber		*zonemapAttnums;
+	SortSupportData	*zonemapSsup;
 } AppendOnlyInsertDescData;
 
 typedef AppendOnlyInsertDescData *AppendOnlyInsertDesc;
@@ -272,6 +282,19 @@ typedef struct AppendOnlyScanDescData
 
 	AOBlkDirScan		blkdirscan;
 
+	/*
+	 * Zone map filter built from the scan's quals, or NULL.  Blocks whose
+	 * rows it all refutes are skipped without being read.
+	 */
+	struct AppendOnlyZoneMapFilterData *zonemapFilter;
+
+	/*
+	 * Bytes prefetched and time stalled in reads by the storage reads that
+	 * rescans have finished.  See appendonly_read_stats().
+	 */
+	int64		prefetchBytes;
+	instr_time	stallTime;
+
 	/* For Bitmap scan */
 	int			rs_cindex;		/* current tuple's index in tbmres->offsets */
 	struct AppendOnlyFetchDescData *aofetch;
@@ -525,6 +548,9 @@ extern void appendonly_delete_finish(AppendOnlyDeleteDesc aoDeleteDesc);
 extern bool appendonly_positionscan(AppendOnlyScanDesc aoscan,
 									AppendOnlyBlockDirectoryEntry *dirEntry,
 									int fsInfoIdx);
+extern void appendonly_read_stats(AppendOnlyScanDesc aoscan,
+								  int64 *prefetchBytes,
+								  instr_time *stallTime);
 /*
  * Update total bytes read for the entire scan. If the block was compressed,
  * update it with the compressed length. If the block was not compressed, update
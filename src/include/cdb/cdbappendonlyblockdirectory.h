@@ -19,6 +19,8 @@
 #include "access/appendonlytid.h"
 #include "access/skey.h"
 #include "catalog/indexing.h"
+#include "nodes/pg_list.h"
+#include "utils/sortsupport.h"
 
 extern int gp_blockdirectory_entry_min_range;
 extern int gp_blockdirectory_minipage_size;
@@ -60,6 +62,36 @@ typedef struct MinipageEntry
 	int64 rowCount;
 } MinipageEntry;
 
+/*
+ * Zone map of a column in the block behind a minipage entry: the smallest and
+ * largest value in it.  Only recorded for fixed-length, pass-by-value column
+ * types with a btree comparison function, and only for tables whose
+ * pg_appendonly.version is AORelationVersion_BlkdirZoneMap or later.  min and
+ * max are only meaningful with MINIPAGE_ZONEMAP_HAS_VALUES set.
+ *
+ * An AO_COLUMN minipage entry has one zone map, for the column of its column
+ * group.  An AO_ROW one has a zone map per slot, see
+ * AppendOnlyBlockDirectory_ZoneMapSlot().
+ */
+typedef struct MinipageZoneMap
+{
+	Datum min;
+	Datum max;
+	uint32 flags;
+} MinipageZoneMap;
+
+#define MINIPAGE_ZONEMAP_VALID			0x01	/* zone map was recorded */
+#define MINIPAGE_ZONEMAP_HAS_VALUES		0x02	/* block has non-NULL values */
+#define MINIPAGE_ZONEMAP_HAS_NULLS		0x04	/* block has NULLs */
+
+/*
+ * Minipage versions.  A MINIPAGE_VERSION_ZONEMAP minipage has the zone maps of
+ * its entries right after its entry array, the same number of them for every
+ * entry, entry by entry.  That number follows from the size of the minipage.
+ */
+#define MINIPAGE_VERSION_BASIC			0
+#define MINIPAGE_VERSION_ZONEMAP		1
+
 /*
  * Define a varlena type for a minipage.
  */
@@ -85,6 +117,12 @@ typedef struct MinipagePerColumnGroup
 	ItemPointerData tupleTid;
 	/* cached entry number from last call to find_minipage_entry() */
 	int cached_entry_no;
+	/*
+	 * Zone maps of the entries, nzonemaps per entry, or NULL if the relation
+	 * can't have them or the caller doesn't want them.
+	 */
+	MinipageZoneMap *zonemaps;
+	uint32 nzonemaps;
 } MinipagePerColumnGroup;
 
 /*
@@ -94,8 +132,20 @@ typedef struct MinipagePerColumnGroup
 #define NUM_MINIPAGE_ENTRIES (((MaxHeapTupleSize)/8 - sizeof(HeapTupleHeaderData) - 64 * 3)\
 							  / sizeof(MinipageEntry))
 
+/*
+ * A minipage is stored untoasted, in a single block directory row, so it may
+ * be no larger than this, zone maps included.
+ */
+#define MINIPAGE_MAX_SIZE \
+	(offsetof(Minipage, entry) + \
+	 (sizeof(MinipageEntry) + sizeof(MinipageZoneMap)) * NUM_MINIPAGE_ENTRIES)
+
+/* The most zone map slots an AO_ROW table has */
+#define MINIPAGE_MAX_ROW_ZONEMAPS		32
+
 #define IsMinipageFull(minipagePerColumnGroup) \
-	((minipagePerColumnGroup)->numMinipageEntries == (uint32) gp_blockdirectory_minipage_size)
+	((minipagePerColumnGroup)->numMinipageEntries >= \
+	 minipage_max_entries((minipagePerColumnGroup)->nzonemaps))
 
 #define InvalidEntryNum (-1)
 
@@ -268,6 +318,17 @@ AppendOnlyBlockDirectory_InsertEntry(AppendOnlyBlockDirectory *blockDirectory,
 									 int64 firstRowNum,
 									 int64 fileOffset,
 									 int64 rowCount);
+extern bool
+AppendOnlyBlockDirectory_InsertEntryWithZoneMap(AppendOnlyBlockDirectory *blockDirectory,
+												int columnGroupNo,
+												int64 firstRowNum,
+												int64 fileOffset,
+												int64 rowCount,
+												const MinipageZoneMap *zonemaps);
+extern int AppendOnlyBlockDirectory_ZoneMapWidth(Relation aoRel);
+extern int AppendOnlyBlockDirectory_ZoneMapSlot(Relation aoRel, int attno);
+extern bool AppendOnlyBlockDirectory_RecordsZoneMaps(
+	AppendOnlyBlockDirectory *blockDirectory);
 extern void
 AppendOnlyBlockDirectory_DeleteSegmentFile(AppendOnlyBlockDirectory *blockDirectory,
 										   int columnGroupNo,
@@ -294,6 +355,20 @@ extern void AppendOnlyBlockDirectory_InsertPlaceholder(AppendOnlyBlockDirectory
 												  int64 firstRowNum,
 												  int64 fileOffset,
 												  int columnGroupNo);
+
+/* in appendonly_zonemap.c */
+typedef struct AppendOnlyZoneMapFilterData *AppendOnlyZoneMapFilter;
+extern AppendOnlyZoneMapFilter appendonly_zonemap_filter_create(Relation rel,
+																List *qual);
+extern void appendonly_zonemap_filter_load(AppendOnlyZoneMapFilter filter,
+										   Snapshot snapshot, int segno);
+extern void appendonly_zonemap_filter_clear(AppendOnlyZoneMapFilter filter);
+extern int64 appendonly_zonemap_filter_skip(AppendOnlyZoneMapFilter filter,
+											int64 rowNum);
+extern void appendonly_zonemap_filter_stats(AppendOnlyZoneMapFilter filter,
+											int64 *nblocks, int64 *nrefuted);
+extern void appendonly_zonemap_filter_free(AppendOnlyZoneMapFilter filter);
+
 /*
  * AppendOnlyBlockDirectory_UniqueCheck
  *
@@ -338,6 +413,72 @@ minipage_size(uint32 nEntry)
 	return offsetof(Minipage, entry) + sizeof(MinipageEntry) * nEntry;
 }
 
+/* Size of a MINIPAGE_VERSION_ZONEMAP minipage */
+static inline uint32
+minipage_zonemap_size(uint32 nEntry, uint32 nzonemaps)
+{
+	return minipage_size(nEntry) + sizeof(MinipageZoneMap) * nEntry * nzonemaps;
+}
+
+/*
+ * The most entries a minipage with nzonemaps zone maps per entry may have.
+ */
+static inline uint32
+minipage_max_entries(uint32 nzonemaps)
+{
+	uint32		room;
+
+	room = (MINIPAGE_MAX_SIZE - offsetof(Minipage, entry)) /
+		(sizeof(MinipageEntry) + sizeof(MinipageZoneMap) * nzonemaps);
+
+	return Min(room, (uint32) gp_blockdirectory_minipage_size);
+}
+
+/*
+ * The zone maps of an on-disk minipage, or NULL if it doesn't have any.  The
+ * number of zone maps per entry is returned in *nzonemaps.
+ */
+static inline MinipageZoneMap *
+minipage_get_zonemaps(Minipage *minipage, uint32 *nzonemaps)
+{
+	if (minipage->version != MINIPAGE_VERSION_ZONEMAP)
+	{
+		*nzonemaps = 0;
+		return NULL;
+	}
+
+	Assert(minipage->nEntry > 0);
+	*nzonemaps = (VARSIZE(minipage) - minipage_size(minipage->nEntry)) /
+		(sizeof(MinipageZoneMap) * minipage->nEntry);
+	Assert(VARSIZE(minipage) == minipage_zonemap_size(minipage->nEntry, *nzonemaps));
+
+	return (MinipageZoneMap *) &minipage->entry[minipage->nEntry];
+}
+
+/*
+ * Fold a value that went into a block into the block's zone map of its
+ * column.  ssup compares two values of the column.
+ */
+static inline void
+minipage_zonemap_add(MinipageZoneMap *zonemap, Datum d, bool null,
+					 SortSupport ssup)
+{
+	zonemap->flags |= MINIPAGE_ZONEMAP_VALID;
+
+	if (null)
+		zonemap->flags |= MINIPAGE_ZONEMAP_HAS_NULLS;
+	else if ((zonemap->flags & MINIPAGE_ZONEMAP_HAS_VALUES) == 0)
+	{
+		zonemap->min = d;
+		zonemap->max = d;
+		zonemap->flags |= MINIPAGE_ZONEMAP_HAS_VALUES;
+	}
+	else if (ApplySortComparator(d, false, zonemap->min, false, ssup) < 0)
+		zonemap->min = d;
+	else if (ApplySortComparator(d, false, zonemap->max, false, ssup) > 0)
+		zonemap->max = d;
+}
+
 /*
  * copy_out_minipage
  *
@@ -349,17 +490,42 @@ copy_out_minipage(MinipagePerColumnGroup *minipageInfo,
 				  bool minipage_isnull)
 {
 	struct varlena *value;
-	struct varlena *detoast_value;
+	Minipage   *detoast_value;
+	MinipageZoneMap *zonemaps;
+	uint32		nzonemaps;
 
 	Assert(!minipage_isnull);
 
 	value = (struct varlena *)
 		DatumGetPointer(minipage_value);
-	detoast_value = pg_detoast_datum(value);
-	Assert(VARSIZE(detoast_value) <= minipage_size(NUM_MINIPAGE_ENTRIES));
+	detoast_value = (Minipage *) pg_detoast_datum(value);
+	Assert(detoast_value->nEntry <= NUM_MINIPAGE_ENTRIES);
+	Assert(VARSIZE(detoast_value) <= MINIPAGE_MAX_SIZE);
+
+	/* The zone maps, if any, are kept apart from the entries in memory */
+	memcpy(minipageInfo->minipage, detoast_value,
+		   minipage_size(detoast_value->nEntry));
+	SET_VARSIZE(minipageInfo->minipage, minipage_size(detoast_value->nEntry));
+
+	if (minipageInfo->zonemaps != NULL)
+	{
+		/*
+		 * The minipage may have been written with fewer zone maps per entry
+		 * than we keep, if columns were added since.  Those of the columns
+		 * it has no zone maps for are left invalid.
+		 */
+		zonemaps = minipage_get_zonemaps(detoast_value, &nzonemaps);
+		memset(minipageInfo->zonemaps, 0,
+			   sizeof(MinipageZoneMap) * detoast_value->nEntry *
+			   minipageInfo->nzonemaps);
+		for (uint32 i = 0; i < detoast_value->nEntry && nzonemaps > 0; i++)
+			memcpy(&minipageInfo->zonemaps[i * minipageInfo->nzonemaps],
+				   &zonemaps[i * nzonemaps],
+				   sizeof(MinipageZoneMap) *
+				   Min(nzonemaps, minipageInfo->nzonemaps));
+	}
 
-	memcpy(minipageInfo->minipage, detoast_value, VARSIZE(detoast_value));
-	if (detoast_value != value)
+	if ((struct varlena *) detoast_value != value)
 		pfree(detoast_value);
 
 	Assert(minipageInfo->minipage->nEntry <= NUM_MINIPAGE_ENTRIES);
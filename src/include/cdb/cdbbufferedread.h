@@ -18,6 +18,7 @@
 #ifndef CDBBUFFEREDREAD_H
 #define CDBBUFFEREDREAD_H
 
+#include "portability/instr_time.h"
 #include "storage/fd.h"
 
 typedef struct BufferedRead
@@ -79,6 +80,20 @@ typedef struct BufferedRead
 	bool				haveTemporaryLimitInEffect;
 	int64				temporaryLimitFileLen;
 
+	/*
+	 * Read-ahead.  The file up to prefetchPosition has been handed to the
+	 * kernel with FilePrefetch(), so that it is read while we work on the
+	 * current large read.  See gp_appendonly_prefetch_size.
+	 */
+	int64				prefetchPosition;
+
+	/*
+	 * Statistics, accumulated over all the files read.
+	 */
+	int64				readBytes;		/* bytes read with FileRead() */
+	int64				prefetchBytes;	/* bytes passed to FilePrefetch() */
+	instr_time			stallTime;		/* time spent waiting in FileRead() */
+
 } BufferedRead;
 
 /*
@@ -180,6 +195,14 @@ int64 BufferedReadCurrentPosition(
 extern void BufferedReadCompleteFile(
     BufferedRead       *bufferedRead);
 
+/*
+ * Add the read statistics so far to the caller's totals.
+ */
+extern void BufferedReadAddStats(
+    BufferedRead       *bufferedRead,
+    int64              *prefetchBytes,
+    instr_time         *stallTime);
+
 /*
  * Finish with reading all together.
  */
@@ -30,6 +30,20 @@ typedef enum
 	REDUCE_JUMP_HASH
 } CdbHashReduce;
 
+/*
+ * Hash functions of distribution key columns that cdbhash() computes inline
+ * rather than through the function manager.  They give the same results as
+ * the functions they stand for.
+ */
+typedef enum
+{
+	CDBHASH_KERNEL_FMGR = 0,	/* call the hash function */
+	CDBHASH_KERNEL_INT2,		/* hashint2 */
+	CDBHASH_KERNEL_INT4,		/* hashint4, for int4 and date */
+	CDBHASH_KERNEL_INT8,		/* hashint8 and timestamp_hash */
+	CDBHASH_KERNEL_TEXT			/* hashtext, with the default collation */
+} CdbHashKernel;
+
 /*
  * Structure that holds Greenplum Database hashing information.
  */
@@ -43,6 +57,7 @@ typedef struct CdbHash
 
 	int			natts;
 	FmgrInfo   *hashfuncs;
+	CdbHashKernel *kernels;		/* inline kernel of each hash function */
 } CdbHash;
 
 /*
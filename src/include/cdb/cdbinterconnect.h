@@ -33,6 +33,8 @@ struct SliceTable;                          /* #include "nodes/execnodes.h" */
 struct EState;                              /* #include "nodes/execnodes.h" */
 /* TODO: move "src/backend/cdb/motion/ic_proxy_backend.h" into public include folder*/
 struct ICProxyBackendContext;
+struct dsm_segment;
+struct shm_mq_handle;
 
 typedef struct icpkthdr
 {
@@ -291,6 +293,30 @@ struct MotionConn
 	uint64 stat_max_resent;
 	uint64 stat_count_dropped;
 
+	/*
+	 * Interconnect compression, see compressMotionBuffer().
+	 *
+	 * sender: bytes handed to compression and bytes actually sent for them,
+	 * and the number of buffers still to be sent raw before compression is
+	 * tried again.
+	 *
+	 * receiver: whether the message being parsed is compressed, and the
+	 * bytes received compressed and decompressed from them.
+	 */
+	bool		msgCompressed;
+	int			compressSkip;
+	uint64		stat_compress_raw_bytes;
+	uint64		stat_compress_wire_bytes;
+
+	/*
+	 * sender: bytes handed to the network, headers included and resends
+	 * excluded, for EXPLAIN ANALYZE.
+	 */
+	uint64		stat_bytes_sent;
+
+	/* sender, UDPIFC: when the connection was set up */
+	uint64		stat_setup_time;
+
 	/*
 	 * used by the sender.
 	 *
@@ -306,6 +332,15 @@ struct MotionConn
 	 * all the remap information.
 	 */
 	TupleRemapper	*remapper;
+
+	/*
+	 * UDPIFC: the peer runs under the same postmaster, and the packets of
+	 * the connection go through a shared-memory queue instead of the
+	 * network, see ic_shm.c.  shmLocal stays set once the queue is gone.
+	 */
+	bool		shmLocal;
+	struct dsm_segment *shmSeg;
+	struct shm_mq_handle *shmQueue;
 };
 
 /*
@@ -344,6 +379,20 @@ typedef struct ChunkTransportStateEntry
 
 	bool		sendingEos;
 
+	/*
+	 * Broadcast buffer, see broadcastChunk() in ic_common.c.  The chunks a
+	 * Broadcast Motion sends are the same for every receiver, so they are
+	 * packed here once, after room for the packet header of the transport,
+	 * and the full buffer is then sent to every receiver, instead of each
+	 * chunk being copied into the buffer of each connection.  It is freed
+	 * by removeChunkTransportState().
+	 * bcastCompressSkip is compressSkip of MotionConn for this buffer.
+	 */
+	uint8	   *bcastBuff;
+	int32		bcastSize;
+	int			bcastTupleCount;
+	int			bcastCompressSkip;
+
 	/* Statistics info for this motion on the interconnect level */
 	uint64 stat_total_ack_time;
 	uint64 stat_count_acks;
@@ -445,10 +494,14 @@ typedef struct MotionNodeEntry
 	uint64          stat_total_chunks_sent; /* Tuple-chunks sent. */
 	uint64          stat_total_bytes_sent;  /* Bytes sent, including headers. */
 	uint64          stat_tuple_bytes_sent;  /* Bytes of pure tuple-data sent. */
+	uint64          stat_tuple_bytes_sent_zerocopy; /* Of those, written straight
+		* from the slot into the send buffer. */
 
 	uint64          stat_total_chunks_recvd;                /* Tuple-chunks received. */
 	uint64          stat_total_bytes_recvd; /* Bytes received, including headers. */
 	uint64          stat_tuple_bytes_recvd; /* Bytes of pure tuple-data received. */
+	uint64          stat_tuple_bytes_recvd_whole; /* Of those, in tuples
+		* that came in a single chunk. */
 
 	uint64          stat_total_sends;               /* Total calls to SendTuple. */
 
@@ -528,6 +581,21 @@ typedef struct ChunkTransportState
 	void (*doSendStopMessage)(struct ChunkTransportState *transportStates, int16 motNodeID);
 	void (*SendEos)(struct ChunkTransportState *transportStates, int motNodeID, TupleChunkListItem tcItem);
 
+	/*
+	 * Send the broadcast buffer of a Motion node to all its receivers, and
+	 * the size of the packet header the buffer leaves room for.  NULL if
+	 * the transport sends broadcast chunks to each connection separately.
+	 */
+	void (*SendBroadcast)(struct ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry);
+	int			broadcastHdrLen;
+
+	/*
+	 * Like RecvTupleChunkFrom, but returns NULL instead of waiting if no
+	 * packet has arrived from the route yet.  NULL if the transport can't
+	 * tell without waiting.
+	 */
+	TupleChunkListItem (*PollTupleChunkFrom)(struct ChunkTransportState *transportStates, int16 motNodeID, int16 srcRoute);
+
 	/* ic_proxy backend context */
 	struct ICProxyBackendContext *proxyContext;
 } ChunkTransportState;
@@ -118,6 +118,30 @@ extern MinimalTuple RecvTupleFrom(MotionLayerState *mlStates,
 								  int16 motNodeID,
 								  int16 srcRoute);
 
+/*
+ * Receive a batch of tuples from the corresponding motion-node on any
+ * query-executor in the process-group, for an unordered receive.
+ *
+ * Stores up to maxTuples tuples in tuples[], all those that are ready if
+ * there are fewer, and returns how many.  Waits for some to arrive if none
+ * are ready.  Returns 0 if end-of-stream was reached.
+ */
+extern int	RecvTuplesFrom(MotionLayerState *mlStates,
+						   ChunkTransportState *transportStates,
+						   int16 motNodeID,
+						   MinimalTuple *tuples,
+						   int maxTuples);
+
+/*
+ * Decode the next packet from the given sender of an ordered receive, if
+ * it is there already and the tuples of the previous one have all been
+ * received.  Never waits.
+ */
+extern void PrefetchTuplesFrom(MotionLayerState *mlStates,
+							   ChunkTransportState *transportStates,
+							   int16 motNodeID,
+							   int16 srcRoute);
+
 extern void SendStopMessage(MotionLayerState *mlStates,
 							ChunkTransportState *transportStates,
 							int16 motNodeID);
@@ -328,10 +328,29 @@ typedef enum GpVars_Interconnect_Method
 {
 	INTERCONNECT_FC_METHOD_CAPACITY = 0,
 	INTERCONNECT_FC_METHOD_LOSS = 2,
+	INTERCONNECT_FC_METHOD_DELAY = 3,
 } GpVars_Interconnect_Method;
 
 extern int Gp_interconnect_fc_method;
 
+/*
+ * Parameter Gp_interconnect_compression
+ *
+ * Compress the transport buffers of Motion connections with zstd before
+ * they are sent.  With "auto", a connection whose data doesn't compress well
+ * goes back to sending raw buffers for a while before trying again.
+ *
+ * Not used with the proxy interconnect.
+ */
+typedef enum GpVars_Interconnect_Compression
+{
+	INTERCONNECT_COMPRESSION_OFF = 0,
+	INTERCONNECT_COMPRESSION_ON,
+	INTERCONNECT_COMPRESSION_AUTO,
+} GpVars_Interconnect_Compression;
+
+extern int Gp_interconnect_compression;
+
 /*
  * Parameter Gp_interconnect_queue_depth
  *
@@ -398,6 +417,23 @@ extern bool gp_interconnect_full_crc;
  */
 extern bool gp_interconnect_log_stats;
 
+/*
+ * Parameter gp_interconnect_explain_bytes
+ *
+ * Report the bytes each Motion node sent over the interconnect in EXPLAIN
+ * ANALYZE.
+ */
+extern bool gp_interconnect_explain_bytes;
+
+/*
+ * Parameter gp_interconnect_shm
+ *
+ * Send the tuples of a Motion connection between two processes of the same
+ * segment through shared memory instead of the network (UDPIFC only).  The
+ * peers are told apart by dbid, so the segments of a host don't share.
+ */
+extern bool gp_interconnect_shm;
+
 extern bool gp_interconnect_cache_future_packets;
 
 #define UNDEF_SEGMENT -2
@@ -53,5 +53,8 @@ extern void htfifo_destroy(htup_fifo htf);
 
 extern void htfifo_addtuple(htup_fifo htf, MinimalTuple htup);
 extern MinimalTuple htfifo_gettuple(htup_fifo htf);
+extern int	htfifo_gettuples(htup_fifo htf, MinimalTuple *tups, int maxTuples);
+
+#define htfifo_empty(htf)	((htf)->p_first == NULL)
 
 #endif   /* HTUPFIFO_H */
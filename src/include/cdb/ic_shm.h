@@ -0,0 +1,37 @@
+/*-------------------------------------------------------------------------
+ *
+ * ic_shm.h
+ *	  Shared-memory queues for Motion connections between two processes of
+ *	  the same segment.
+ *
+ *
+ * Copyright (c) 2024-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/cdb/ic_shm.h
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef IC_SHM_H
+#define IC_SHM_H
+
+#include "storage/shm_mq.h"
+
+#include "cdb/tupser.h"
+
+struct CdbProcess;
+
+extern Size ICShmShmemSize(void);
+extern void ICShmShmemInit(void);
+
+extern bool icShmPeerIsLocal(struct CdbProcess *cdbProc);
+extern bool icShmAttach(MotionConn *conn, uint32 icId, int16 motNodeId,
+						bool isSender);
+extern bool icShmSend(MotionConn *conn, const void *data, Size size);
+extern shm_mq_result icShmReceive(MotionConn *conn, void **data, Size *size);
+extern void icShmDetach(MotionConn *conn, bool isSender, bool hasErrors);
+extern void icShmReleaseSlots(uint32 icId);
+
+#endif   /* IC_SHM_H */
@@ -52,6 +52,12 @@ typedef struct RegisterMessage
  */
 #define PACKET_HEADER_SIZE 4
 
+/*
+ * Set in the size word of a TCP packet whose payload is compressed, see
+ * compressMotionBuffer().
+ */
+#define PACKET_COMPRESSED_FLAG 0x80000000
+
 /* Performs initialization of the MotionLayerIPC.  This should be called before
  * any work is performed through functions here.  Generally, this should only
  * need to be called only once during process startup.
@@ -306,6 +312,26 @@ extern ChunkTransportStateEntry *removeChunkTransportState(ChunkTransportState *
 
 extern TupleChunkListItem RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates);
 
+/*
+ * Send what a Broadcast Motion put in its broadcast buffer to all
+ * receivers.  Transports call this before they send end-of-stream.
+ */
+extern void flushBroadcastBuffer(ChunkTransportState *transportStates,
+								 ChunkTransportStateEntry *pEntry);
+
+extern bool compressMotionData(uint8 *buf, int32 *size, int hdrlen, int *skip,
+							   uint64 *rawBytes, uint64 *wireBytes);
+extern bool compressMotionBuffer(MotionConn *conn, int hdrlen);
+extern void getMotionCompressionStats(ChunkTransportState *transportStates,
+									  int16 motNodeID,
+									  uint64 *rawBytes,
+									  uint64 *wireBytes);
+extern void getMotionSendStats(ChunkTransportState *transportStates,
+							   int16 motNodeID,
+							   uint64 *bytesSent,
+							   uint64 *localBytes,
+							   int *numReceivers);
+
 extern void InitMotionTCP(int *listenerSocketFd, uint16 *listenerPort);
 extern void InitMotionUDPIFC(int *listenerSocketFd, uint16 *listenerPort);
 extern void markUDPConnInactiveIFC(MotionConn *conn);
@@ -321,6 +347,9 @@ extern void TeardownUDPIFCInterconnect(ChunkTransportState *transportStates,
 
 extern uint32 getActiveMotionConns(void);
 
+extern Size ICConnStatsShmemSize(void);
+extern void ICConnStatsShmemInit(void);
+
 extern char *format_sockaddr(struct sockaddr_storage *sa, char *buf, size_t len);
 
 #endif   /* ML_IPC_H */
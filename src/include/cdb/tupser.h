@@ -41,6 +41,8 @@ typedef struct SerAttrInfo
 	Oid			atttypid;		/* Oid of the attribute's data-type. */
 	int16		typlen;
 	bool		typbyval;
+	int			fixed_offset;	/* offset of the attr in a fixed-layout tuple's
+								 * data, see below */
 }	SerAttrInfo;
 
 /* The information for sending and receiving tuples that match a particular
@@ -60,6 +62,17 @@ typedef struct SerTupInfo
 
 	/* true if tupdesc contains record types */
 	bool		has_record_types;
+
+	/*
+	 * If all the attributes are fixed-width, a tuple without nulls always
+	 * has the same layout, and can be serialized straight from the slot's
+	 * values into the transport buffer.  fixed_header holds the MinimalTuple
+	 * header fields of such a tuple, as they go on the wire.
+	 */
+	bool		fixed_layout;
+	char	   *fixed_header;
+	int			fixed_header_len;
+	int			fixed_data_len;
 }	SerTupInfo;
 
 /*
@@ -82,7 +95,7 @@ extern void SerializeRecordCacheIntoChunks(SerTupInfo *pSerInfo,
 										   MotionConn *conn);
 
 /* Convert a tuple into chunks directly in a set of transport buffers */
-extern int SerializeTuple(TupleTableSlot *tuple, SerTupInfo *pSerInfo, struct directTransportBuffer *b, TupleChunkList tcList, int16 targetRoute);
+extern int SerializeTuple(TupleTableSlot *tuple, SerTupInfo *pSerInfo, struct directTransportBuffer *b, TupleChunkList tcList, int16 targetRoute, bool *zerocopy);
 
 /* Convert a sequence of chunks containing serialized tuple data into a
  * MinimalTuple.
@@ -89,6 +89,9 @@ extern void ExecHashTableExplainInit(HashState *hashState, HashJoinState *hjstat
                                      HashJoinTable  hashtable);
 extern void ExecHashTableExplainBatchEnd(HashState *hashState, HashJoinTable hashtable);
 
+extern void ExecHashInitRuntimeFilters(HashState *node, HashJoinState *hjstate);
+extern void ExecHashResetRuntimeFilters(HashState *node);
+
 static inline int
 ExecHashRowSize(int tupwidth)
 {
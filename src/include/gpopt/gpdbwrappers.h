@@ -248,6 +248,10 @@ List *GetCheckConstraintOids(Oid rel_oid);
 // part constraint expression tree
 Node *GetRelationPartConstraints(Relation rel);
 
+// part constraint expression tree of a partition of the given partitioned
+// table, in terms of the columns of the partitioned table
+Node *GetChildPartConstraints(Relation parent, Oid part_oid);
+
 // get the cast function for the specified source and destination types
 bool GetCastFunc(Oid src_oid, Oid dest_oid, bool *is_binary_coercible,
 				 Oid *cast_fn_oid, CoercionPathType *pathtype);
@@ -615,6 +619,27 @@ FaultInjectorType_e InjectFaultInOptTasks(const char *fault_name);
 // table has been changed?)
 bool MDCacheNeedsReset(void);
 
+// are there catalog invalidations to evict metadata cache entries for?
+bool MDCacheHasPendingInvalidations(void);
+
+// forget the catalog invalidations the metadata cache was updated with
+void MDCacheClearInvalidations(void);
+
+// has the catalog entry of the object with the given OID been invalidated?
+bool MDCacheObjectInvalidated(Oid oid);
+
+// have the statistics of the given column been invalidated?
+bool MDCacheColStatsInvalidated(Oid relid, AttrNumber attno);
+
+// has the cast between the given types been invalidated?
+bool MDCacheCastInvalidated(Oid src_type, Oid dest_type);
+
+// have the comparison operators between types been invalidated?
+bool MDCacheScCmpInvalidated(void);
+
+// the settings that differ from their defaults, as "name=value" lines
+char *GetModifiedConfigOptions(void);
+
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
@@ -668,6 +693,9 @@ bool IsTypeRange(Oid typid);
 
 char *GetRelAmName(Oid reloid);
 
+// relkind of a relation, read from the catalog without opening it
+char GetRelKind(Oid reloid);
+
 IndexAmRoutine *GetIndexAmRoutineFromAmHandler(Oid am_handler);
 
 PartitionDesc GPDBRelationRetrievePartitionDesc(Relation rel);
@@ -26,6 +26,7 @@ extern "C" {
 #include "access/tupdesc.h"
 #include "catalog/gp_distribution_policy.h"
 #include "foreign/foreign.h"
+#include "partitioning/partdefs.h"
 }
 
 #include "naucrates/dxl/gpdb_types.h"
@@ -244,6 +245,18 @@ private:
 												  Relation rel,
 												  CMDColumnArray *mdcol_array);
 
+	// retrieve the part constraints of the partitions of a partitioned
+	// table in terms of its columns
+	static CDXLNodeArray *RetrieveChildPartConstraints(
+		CMemoryPool *mp, CMDAccessor *md_accessor, Relation rel,
+		PartitionDesc part_desc, CMDColumnArray *mdcol_array);
+
+	// translate a part constraint over the columns of a relation
+	static CDXLNode *TranslatePartConstraintToDXL(CMemoryPool *mp,
+												  CMDAccessor *md_accessor,
+												  Node *node,
+												  CMDColumnArray *mdcol_array);
+
 	// return relation name
 	static CMDName *GetRelName(CMemoryPool *mp, Relation rel);
 
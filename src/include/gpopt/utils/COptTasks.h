@@ -28,6 +28,7 @@ namespace gpos
 {
 class CMemoryPool;
 class CBitSet;
+class CWStringDynamic;
 }  // namespace gpos
 
 namespace gpdxl
@@ -43,6 +44,7 @@ class CQueryContext;
 class COptimizerConfig;
 class ICostModel;
 class CPlanHint;
+class IConstExprEvaluator;
 }  // namespace gpopt
 
 struct PlannedStmt;
@@ -127,6 +129,24 @@ private:
 	// optimize a query to a physical DXL
 	static void *OptimizeTask(void *ptr);
 
+	// has a metadata cache object been invalidated by catalog changes?
+	static BOOL IsMDCacheObjectInvalidated(const IMDId *mdid);
+
+	// serialize the key of a query in the plan cache
+	static CWStringDynamic *SerializePlanCacheKey(
+		CMemoryPool *mp, const CDXLNode *query_dxl,
+		const CDXLNodeArray *query_output_dxlnode_array,
+		const CDXLNodeArray *cte_dxlnode_array,
+		COptimizerConfig *optimizer_config, ULONG num_segments);
+
+	// optimize a query, using the plan cache if enabled
+	static CDXLNode *OptimizeWithPlanCache(
+		CMemoryPool *mp, CMDAccessor *md_accessor, CDXLNode *query_dxl,
+		CDXLNodeArray *query_output_dxlnode_array,
+		CDXLNodeArray *cte_dxlnode_array, IConstExprEvaluator *expr_evaluator,
+		ULONG num_segments, CSearchStageArray *search_strategy_arr,
+		COptimizerConfig *optimizer_config);
+
 	// translate a DXL tree into a planned statement
 	static PlannedStmt *ConvertToPlanStmtFromDXL(
 		CMemoryPool *mp, CMDAccessor *md_accessor, const Query *orig_query,
@@ -21,6 +21,8 @@ extern "C" {
 extern Datum DisableXform(PG_FUNCTION_ARGS);
 extern Datum EnableXform(PG_FUNCTION_ARGS);
 extern Datum LibraryVersion();
+extern Datum MDCacheStats(PG_FUNCTION_ARGS);
+extern Datum PlanCacheStats(PG_FUNCTION_ARGS);
 }
 
 #endif	// GPOPT_funcs_H
@@ -0,0 +1,55 @@
+/*
+ * losertree.h
+ *
+ * A tournament tree of losers, for merging sorted streams
+ *
+ * Portions Copyright (c) 2024-Present VMware, Inc. or its affiliates.
+ *
+ * src/include/lib/losertree.h
+ */
+
+#ifndef LOSERTREE_H
+#define LOSERTREE_H
+
+/*
+ * Compares the heads of streams a and b.  Must return <0 if the head of a
+ * comes first, 0 if it doesn't matter, and >0 if the head of b comes first.
+ */
+typedef int (*losertree_comparator) (int a, int b, void *arg);
+
+/*
+ * losertree
+ *
+ *		lt_size			number of streams
+ *		lt_nactive		how many of them are not exhausted
+ *		lt_compare		comparison function of the heads of two streams
+ *		lt_arg			user data for comparison function
+ *		lt_exhausted	for each stream, true if it has no head
+ *		lt_nodes		the winner in lt_nodes[0], and the loser of the
+ *						match played at each internal node in lt_nodes[1]
+ *						to lt_nodes[size - 1]
+ */
+typedef struct losertree
+{
+	int			lt_size;
+	int			lt_nactive;
+	losertree_comparator lt_compare;
+	void	   *lt_arg;
+	bool	   *lt_exhausted;
+	int			lt_nodes[FLEXIBLE_ARRAY_MEMBER];
+} losertree;
+
+extern losertree *losertree_allocate(int size,
+									 losertree_comparator compare,
+									 void *arg);
+extern void losertree_reset(losertree *tree);
+extern void losertree_free(losertree *tree);
+extern void losertree_add_unordered(losertree *tree, int stream);
+extern void losertree_build(losertree *tree);
+extern int	losertree_first(losertree *tree);
+extern void losertree_replace_first(losertree *tree);
+extern void losertree_remove_first(losertree *tree);
+
+#define losertree_empty(t)			((t)->lt_nactive == 0)
+
+#endif							/* LOSERTREE_H */
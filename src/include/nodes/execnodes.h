@@ -1492,6 +1492,12 @@ typedef struct SeqScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
 	Size		pscan_len;		/* size of parallel heap scan descriptor */
+
+	/*
+	 * GPDB: runtime filters pushed down from a Hash node in the same slice,
+	 * see ExecHashInitRuntimeFilters().  List of AttrFilter.
+	 */
+	List	   *filters;
 } SeqScanState;
 
 /* ----------------
@@ -2796,6 +2802,40 @@ typedef struct SharedHashInfo
  *	 HashState information
  * ----------------
  */
+/* ----------------
+ *	 AttrFilter information
+ *
+ *		A runtime filter on one hash join key.  It is filled in by the Hash
+ *		node while it loads the inner side, and probed by the SeqScan on the
+ *		outer side of the same slice, so that outer rows which cannot find a
+ *		join partner are dropped before they are projected or passed up.
+ *
+ *		The bloom filter is keyed on the key's hash value, computed with the
+ *		join's own hash functions, so it works for cross-type hash operators.
+ *		The min/max range is only kept for pass-by-value keys whose join
+ *		operator is the type's default btree equality.
+ * ----------------
+ */
+typedef struct AttrFilter
+{
+	bool		ready;			/* build side fully loaded, usable */
+	bool		has_range;		/* track min/max using cmpfn? */
+	bool		empty;			/* no non-null key seen on the build side */
+	int			keyno;			/* index into the Hash node's hashkeys */
+	AttrNumber	lattno;			/* key attno in the target's scan tuple */
+	PlanState  *target;			/* SeqScanState probing this filter */
+	Oid			collation;		/* collation of the join operator */
+	FmgrInfo	inner_hashfn;	/* hash function for build side values */
+	FmgrInfo	outer_hashfn;	/* hash function for probe side values */
+	FmgrInfo	cmpfn;			/* btree comparison, if has_range */
+	int64		nelems;			/* estimated build rows, sizes the bloom */
+	struct bloom_filter *blm_filter;
+	Datum		min;			/* valid if has_range and !empty */
+	Datum		max;
+	uint64		nprobed;		/* EXPLAIN ANALYZE: rows probed */
+	uint64		nfiltered;		/* EXPLAIN ANALYZE: rows removed */
+} AttrFilter;
+
 typedef struct HashState
 {
 	PlanState	ps;				/* its first field is NodeTag */
@@ -2806,6 +2846,8 @@ typedef struct HashState
 	bool		hs_hashkeys_null;	/* found an instance wherein hashkeys are all null */
 	/* hashkeys is same as parent's hj_InnerHashKeys */
 
+	List	   *filters;		/* AttrFilters pushed to the outer side */
+
 	SharedHashInfo *shared_info;	/* one entry per worker * Greenplum: per QE */
 	HashInstrumentation *hinstrument;	/* this worker's entry */
 
@@ -2959,14 +3001,25 @@ typedef struct MotionState
 	/* For Motion recv */
 	int			routeIdNext;	/* for a sorted motion node, the routeId to get next (same as
 								 * the routeId last returned ) */
-	bool		tupleheapReady; /* for a sorted motion node, false until we have a tuple from
+	bool		mergetreeReady; /* for a sorted motion node, false until we have a tuple from
 								 * each source segindex */
 
+	/* For unsorted Motion recv */
+	MinimalTuple *recvTuples;	/* tuples received from the AMS as a batch */
+	int			numRecvTuples;	/* number of tuples in the batch */
+	int			nextRecvTuple;	/* index of the next tuple of the batch to return */
+
 	/* For sorted Motion recv */
 	int			numSortCols;
 	SortSupport sortKeys;
 	TupleTableSlot **slots;
-	struct binaryheap *tupleheap; /* binary heap of slot indices */
+	Datum	   *headKeys;		/* leading sort key of the tuple in each slot,
+								 * abbreviated if the type allows */
+	bool	   *headIsnull;
+	int64		abbrevCount;	/* number of leading keys abbreviated */
+	int64		abbrevNext;		/* abbrevCount at which to next consider
+								 * aborting abbreviation */
+	struct losertree *mergetree; /* loser tree of slot indices */
 	int			lastSortColIdx;
 
 	/* The following can be used for debugging, usage stats, etc.  */
@@ -156,6 +156,14 @@ typedef struct PlannedStmt
  	 * GPDB: whether a query is a SPI inner query for extension usage 
  	 */
 	int8		metricsQueryType;
+
+	/*
+	 * GPDB: 1-based search stage of GPORCA in which optimizer_time_budget or
+	 * optimizer_memory_budget ran out, 0 if they did not, and the number of
+	 * search stages
+	 */
+	int			optimizerBudgetStage;
+	int			optimizerSearchStages;
 } PlannedStmt;
 
 /*
@@ -16,7 +16,9 @@
 #define DATUMSTREAM_H
 
 #include "catalog/pg_attribute.h"
+#include "cdb/cdbappendonlyblockdirectory.h"
 #include "utils/datumstreamblock.h"
+#include "utils/sortsupport.h"
 
 /*
  * Magic number.  Max number of datum in on block.
@@ -70,6 +72,14 @@ typedef struct DatumStreamWrite
 	 */
 	int64		eof;
 	int64		eofUncompress;
+
+	/*
+	 * Zone map of the current block, recorded in the block directory along
+	 * with it.  See datumstreamwrite_track_zonemap().
+	 */
+	bool		track_zonemap;
+	SortSupportData zonemap_ssup;
+	MinipageZoneMap zonemap;
 }	DatumStreamWrite;
 
 typedef enum DatumStreamLargeObjectState
@@ -226,6 +236,30 @@ datumstreamread_advance(DatumStreamRead * acc)
 	}
 }
 
+/*
+ * Decode up to 'maxrows' rows of the current block into 'values' and
+ * 'isnull'; see DatumStreamBlockRead_GetBatch().  Returns the number of rows
+ * decoded, and leaves the stream positioned on the last of them.
+ */
+inline static int
+datumstreamread_get_batch(DatumStreamRead * acc, Datum *values, bool *isnull, int maxrows)
+{
+	if (acc->largeObjectState == DatumStreamLargeObjectState_None)
+	{
+		return DatumStreamBlockRead_GetBatch(&acc->blockRead, values, isnull, maxrows);
+	}
+	else
+	{
+		/*
+		 * A large object is a block of its own, holding a single row.
+		 */
+		if (maxrows <= 0 || datumstreamread_advancelarge(acc) == 0)
+			return 0;
+		datumstreamread_getlarge(acc, values, isnull);
+		return 1;
+	}
+}
+
 extern int	datumstreamread_nthlarge(DatumStreamRead * ds);
 inline static int
 datumstreamread_nth(DatumStreamRead * acc)
@@ -251,6 +285,7 @@ extern int datumstreamwrite_put(
 					 bool null,
 					 void **toFree);
 extern int	datumstreamwrite_nth(DatumStreamWrite * ds);
+extern void datumstreamwrite_track_zonemap(DatumStreamWrite * ds);
 
 /* ctor and dtor */
 extern DatumStreamWrite *create_datumstreamwrite(
@@ -314,6 +349,8 @@ extern void datumstreamread_rewind_block(DatumStreamRead * datumStream);
 extern bool datumstreamread_find_block(DatumStreamRead * datumStream,
 						   DatumStreamFetchDesc datumStreamFetchDesc,
 						   int64 rowNum);
+extern bool datumstreamread_skip_to(DatumStreamRead * datumStream,
+									int64 rowNum);
 extern void *datumstreamread_get_upgrade_space(DatumStreamRead *datumStream,
 											   size_t len);
 
@@ -298,6 +298,12 @@ extern bool gp_appendonly_compaction;
  * 10% of the tuples are hidden.
  */
 extern int  gp_appendonly_compaction_threshold;
+
+/*
+ * Read-ahead window, in kB, that sequential reads of append-optimized
+ * segment files ask the kernel to prefetch.  0 disables it.
+ */
+extern int  gp_appendonly_prefetch_size;
 extern bool gp_heap_require_relhasoids_match;
 extern bool	debug_xlog_record_read;
 extern bool Debug_cancel_print;
@@ -452,6 +458,8 @@ extern int optimizer_minidump;
 extern int  optimizer_cost_model;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern bool optimizer_plan_caching;
+extern int	optimizer_plan_cache_size;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -557,6 +565,8 @@ extern int optimizer_cte_inlining_bound;
 extern int optimizer_push_group_by_below_setop_threshold;
 extern int optimizer_xform_bind_threshold;
 extern int optimizer_skew_factor;
+extern int optimizer_time_budget;
+extern int optimizer_memory_budget;
 extern bool optimizer_force_multistage_agg;
 extern bool optimizer_force_three_stage_scalar_dqa;
 extern bool optimizer_force_expanded_distinct_aggs;
@@ -582,6 +592,7 @@ extern bool optimizer_analyze_root_partition;
 extern bool optimizer_analyze_midlevel_partition;
 
 extern bool optimizer_use_gpdb_allocators;
+extern bool optimizer_use_arena_memory_pool;
 
 /* optimizer GUCs for replicated table */
 extern bool optimizer_replicated_table_insert;
@@ -625,6 +636,12 @@ extern bool gp_allow_date_field_width_5digits;
 
 extern bool gp_enable_blkdir_sampling;
 
+extern bool gp_enable_blkdir_zonemap;
+
+extern bool gp_enable_aocs_batch_scan;
+
+extern bool gp_enable_runtime_filter_pushdown;
+
 typedef enum
 {
 	INDEX_CHECK_NONE,
@@ -732,6 +749,7 @@ extern int	set_config_option(const char *name, const char *value,
 							  GucAction action, bool changeVal, int elevel,
 							  bool is_reload);
 extern void AlterSystemSetConfigFile(AlterSystemStmt *setstmt);
+extern char *GetModifiedConfigOptions(void);
 extern char *GetConfigOptionByName(const char *name, const char **varname,
 								   bool missing_ok);
 extern void GetConfigOptionByNum(int varnum, const char **values, bool *noshow);
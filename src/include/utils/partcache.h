@@ -50,6 +50,7 @@ extern PartitionKey RelationRetrievePartitionKey(Relation rel);
 extern void RelationBuildPartitionKey(Relation relation);
 extern List *RelationGetPartitionQual(Relation rel);
 extern Expr *get_partition_qual_relid(Oid relid);
+extern List *get_partition_qual_for_parent(Relation parent, Oid partoid);
 
 /*
  * PartitionKey inquiry functions
@@ -39,6 +39,7 @@
 		"gp_allow_date_field_width_5digits",
 		"gp_appendonly_compaction",
 		"gp_appendonly_compaction_threshold",
+		"gp_appendonly_prefetch_size",
 		"gp_appendonly_verify_block_checksums",
 		"gp_appendonly_verify_write_block",
 		"gp_blockdirectory_entry_min_range",
@@ -48,8 +49,11 @@
 		"gp_default_storage_options",
 		"gp_detect_data_correctness",
 		"gp_disable_tuple_hints",
+		"gp_enable_aocs_batch_scan",
 		"gp_enable_blkdir_sampling",
+		"gp_enable_blkdir_zonemap",
 		"gp_enable_interconnect_aggressive_retry",
+		"gp_enable_runtime_filter_pushdown",
 		"gp_enable_segment_copy_checking",
 		"gp_external_enable_filter_pushdown",
 		"gp_hashjoin_tuples_per_bucket",
@@ -58,9 +62,11 @@
 		"gp_initial_bad_row_limit",
 		"gp_interconnect_address_type",
 		"gp_interconnect_cache_future_packets",
+		"gp_interconnect_compression",
 		"gp_interconnect_cursor_ic_table_size",
 		"gp_interconnect_debug_retry_interval",
 		"gp_interconnect_default_rtt",
+		"gp_interconnect_explain_bytes",
 		"gp_interconnect_fc_method",
 		"gp_interconnect_full_crc",
 		"gp_interconnect_log_stats",
@@ -69,6 +75,7 @@
 		"gp_interconnect_proxy_addresses",
 		"gp_interconnect_queue_depth",
 		"gp_interconnect_setup_timeout",
+		"gp_interconnect_shm",
 		"gp_interconnect_snd_queue_depth",
 		"gp_interconnect_tcp_listener_backlog",
 		"gp_interconnect_timer_checking_period",
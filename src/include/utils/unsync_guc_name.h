@@ -413,6 +413,7 @@
 		"optimizer_log",
 		"optimizer_log_failure",
 		"optimizer_mdcache_size",
+		"optimizer_memory_budget",
 		"optimizer_metadata_caching",
 		"optimizer_minidump",
 		"optimizer_multilevel_partitioning",
@@ -421,6 +422,8 @@
 		"optimizer_partition_selection_log",
 		"optimizer_penalize_broadcast_threshold",
 		"optimizer_penalize_skew",
+		"optimizer_plan_cache_size",
+		"optimizer_plan_caching",
 		"optimizer_plan_id",
 		"optimizer_print_expression_properties",
 		"optimizer_print_group_properties",
@@ -446,7 +449,9 @@
 		"optimizer_segments",
 		"optimizer_skew_factor",
 		"optimizer_sort_factor",
+		"optimizer_time_budget",
 		"optimizer_trace_fallback",
+		"optimizer_use_arena_memory_pool",
 		"optimizer_use_external_constant_expression_evaluation_for_ints",
 		"optimizer_use_gpdb_allocators",
 		"optimizer_xform_bind_threshold",
@@ -0,0 +1,122 @@
+--
+-- Zone maps in the block directory of AO_ROW tables
+-- (gp_enable_blkdir_zonemap).  Each block gets a zone map per fixed-length,
+-- pass-by-value column, and sequential scans with range quals skip the
+-- blocks whose rows they all rule out.  Check that the skipping scans return
+-- the same rows as the full ones.  See also aocs_zonemap.
+--
+create schema ao_zonemap;
+set search_path to ao_zonemap;
+-- zone maps are only recorded with the GUC on
+set gp_enable_blkdir_zonemap to on;
+
+-- the index creates the block directory before any data is loaded
+create table zm (a int, b int8, c text, d date)
+  with (appendonly = true, blocksize = 8192)
+  distributed by (a);
+create index zm_a on zm (a);
+insert into zm select i, i, 'x' || i, date '2020-01-01' + i
+  from generate_series(1, 100000) i;
+insert into zm select i, null, null, null from generate_series(1, 10) i;
+
+-- the data is only clustered on b and d, the index on a is no use
+set enable_indexscan to off;
+set enable_bitmapscan to off;
+
+select count(*) from zm where b < 1000;
+select count(*) from zm where b >= 50000 and b < 51000;
+select count(*) from zm where b = 77777;
+select count(*) from zm where b > 99000;
+select count(*) from zm where 1000 > b;
+select count(*) from zm where b = -1;
+select count(*) from zm where d >= date '2020-01-01' + 90000;
+select count(*) from zm where b < 1000 and c like 'x1%';
+select count(*) from zm where b is null;
+
+-- EXPLAIN ANALYZE reports the blocks the zone maps ruled out, as for
+-- AO_COLUMN tables.
+create function zm_explain_stats(query text)
+returns table (refuted bigint, blocks bigint) as
+$$
+declare
+  explainrow text;
+  m text[];
+begin
+  for explainrow in execute
+    'explain (analyze, costs off, timing off, summary off) ' || query
+  loop
+    m := regexp_match(explainrow, 'Zone maps ruled out (\d+) of (\d+) blocks');
+    if m is not null then
+      refuted := m[1]::bigint;
+      blocks := m[2]::bigint;
+      return next;
+    end if;
+  end loop;
+end;
+$$ language plpgsql;
+
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats('select count(*) from zm where b < 1000');
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats('select count(*) from zm where 30000::int2 < b');
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats($$select count(*) from zm where d >= date '2020-01-01' + 90000$$);
+
+-- no filter without the GUC, or without a qual it can check
+set gp_enable_blkdir_zonemap to off;
+select count(*) from zm_explain_stats('select count(*) from zm where b < 1000');
+set gp_enable_blkdir_zonemap to on;
+select count(*) from zm_explain_stats($$select count(*) from zm where c = 'x1'$$);
+
+-- deleted rows
+delete from zm where b between 500 and 599;
+select count(*) from zm where b < 1000;
+
+-- a dropped column keeps its zone map slot, so the other columns' zone maps
+-- still line up, before and after it is dropped
+create table zm2 (a int, x int, b int8)
+  with (appendonly = true, blocksize = 8192)
+  distributed by (a);
+create index zm2_a on zm2 (a);
+insert into zm2 select i, -i, i from generate_series(1, 50000) i;
+alter table zm2 drop column x;
+insert into zm2 select i, i from generate_series(50001, 100000) i;
+select count(*) from zm2 where b < 1000;
+select count(*) from zm2 where b > 99000;
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats('select count(*) from zm2 where b > 99000');
+
+-- the blocks written before a column was added have no zone map for it
+alter table zm2 add column e int default 5;
+insert into zm2 select i, i, 7 from generate_series(100001, 101000) i;
+select count(*) from zm2 where b < 1000 and e = 5;
+select count(*) from zm2 where e > 5;
+select count(*) from zm2 where e < 5;
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats('select count(*) from zm2 where e < 5');
+
+-- blocks written before the block directory existed have no zone maps
+create table zm3 (a int, b int8)
+  with (appendonly = true, blocksize = 8192)
+  distributed by (a);
+insert into zm3 select i, i from generate_series(1, 50000) i;
+create index zm3_a on zm3 (a);
+insert into zm3 select i, i from generate_series(50001, 100000) i;
+select count(*) from zm3 where b < 1000;
+select count(*) from zm3 where b > 99000;
+
+-- compressed blocks
+create table zm4 (a int, b int8)
+  with (appendonly = true, compresstype = zlib, blocksize = 8192)
+  distributed by (a);
+create index zm4_a on zm4 (a);
+insert into zm4 select i, i / 100 from generate_series(1, 100000) i;
+select count(*) from zm4 where b = 500;
+select count(*) from zm4 where b < 10;
+select refuted > 0 as refuted_some, refuted < blocks as kept_some
+  from zm_explain_stats('select count(*) from zm4 where b = 500');
+
+reset gp_enable_blkdir_zonemap;
+reset enable_bitmapscan;
+reset enable_indexscan;
+drop schema ao_zonemap cascade;
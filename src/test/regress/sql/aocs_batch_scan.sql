@@ -0,0 +1,55 @@
+--
+-- Sequential scans of AO_COLUMN tables decode the rows of each column a
+-- block at a time (gp_enable_aocs_batch_scan).  Check that they return the
+-- same rows as the row at a time scans, across block boundaries, deleted
+-- rows, columns added without a rewrite, and rescans.
+--
+create schema aocs_batch_scan;
+set search_path to aocs_batch_scan;
+
+-- c varies in width, so the blocks of the columns end at different rows,
+-- and the runs of d put many more rows in its blocks
+create table t (a int, b int, c text, d int encoding (compresstype = rle_type))
+  with (appendonly = true, orientation = column, blocksize = 8192)
+  distributed by (a);
+insert into t select i, i % 1000, repeat('x', i % 97), i / 5000
+  from generate_series(1, 100000) i;
+
+-- scattered deletes, and a range that spans blocks
+delete from t where a % 7 = 0;
+delete from t where a between 20000 and 30000;
+
+-- e is missing in the rows that were there before it was added
+alter table t add column e int default 42;
+insert into t select i, i % 1000, repeat('y', i % 89), i / 5000, i
+  from generate_series(100001, 120000) i;
+
+set gp_enable_aocs_batch_scan to off;
+create temp table t_rows as select * from t distributed by (a);
+set gp_enable_aocs_batch_scan to on;
+
+select count(*), sum(b), sum(length(c)), sum(d), sum(e) from t;
+select count(*), sum(b), sum(length(c)), sum(d), sum(e) from t_rows;
+
+-- all the columns, and projections with and without the missing one
+select count(*) from (select * from t except all select * from t_rows) x;
+select count(*) from (select * from t_rows except all select * from t) x;
+select count(*) from (select a, e from t except all select a, e from t_rows) x;
+select count(*) from (select c, d from t except all select c, d from t_rows) x;
+select count(*) from (select e from t except all select e from t_rows) x;
+
+-- the inner scans of nested loops are rescanned for every outer row, and
+-- the semi join stops them before they reach the end
+create table s (a int) distributed by (a);
+insert into s values (1), (7), (25000), (100001), (119999);
+set enable_hashjoin to off;
+set enable_mergejoin to off;
+set enable_material to off;
+select count(*), sum(t.e) from s join t on t.a = s.a;
+select count(*) from s where exists (select 1 from t where t.a = s.a);
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_material;
+
+reset gp_enable_aocs_batch_scan;
+drop schema aocs_batch_scan cascade;
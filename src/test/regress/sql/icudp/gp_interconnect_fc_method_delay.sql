@@ -0,0 +1,61 @@
+-- 
+-- @description Interconnect flow control test case: delay-based flow control
+-- under synthetic packet loss and contention
+-- @tags executor
+-- @gpdb_version [7.0.0,main]
+
+-- Create a table
+CREATE TEMP TABLE small_table(dkey INT, jkey INT, rval REAL, tval TEXT default 'abcdefghijklmnopqrstuvwxyz') DISTRIBUTED BY (dkey);
+
+-- Generate some data
+INSERT INTO small_table VALUES(generate_series(1, 5000), generate_series(5001, 10000), sqrt(generate_series(5001, 10000)));
+
+SET gp_interconnect_fc_method = "delay";
+
+-- Keep all the connections on the network, where packets get dropped
+SET gp_interconnect_shm = off;
+
+SHOW gp_interconnect_fc_method;
+
+-- Skew with gather+redistribute
+SELECT ROUND(foo.rval * foo.rval)::INT % 30 AS rval2, COUNT(*) AS count, SUM(length(foo.tval)) AS sum_len_tval
+  FROM (SELECT 5001 AS jkey, rval, tval FROM small_table ORDER BY dkey LIMIT 3000) foo
+    JOIN small_table USING(jkey)
+  GROUP BY rval2
+  ORDER BY rval2;
+
+-- The statistics count since the segments started, note where they are
+CREATE TEMP TABLE stats_before AS
+  SELECT sum(packets) AS packets, sum(bytes) AS bytes, sum(retransmits) AS retransmits
+  FROM gp_interconnect_stats DISTRIBUTED RANDOMLY;
+
+-- Drop data packets and acks, so that the window has to back off and
+-- recover.
+SET gp_udpic_dropacks_percent = 10;
+SET gp_udpic_dropxmit_percent = 10;
+
+SELECT ROUND(foo.rval * foo.rval)::INT % 30 AS rval2, COUNT(*) AS count, SUM(length(foo.tval)) AS sum_len_tval
+  FROM (SELECT 5001 AS jkey, rval, tval FROM small_table ORDER BY dkey LIMIT 3000) foo
+    JOIN small_table USING(jkey)
+  GROUP BY rval2
+  ORDER BY rval2;
+
+-- Several redistributions at once, competing for the same links
+SELECT COUNT(*)
+  FROM small_table a
+    JOIN small_table b ON a.jkey = b.dkey + 5000
+    JOIN small_table c ON b.rval = c.rval
+    JOIN small_table d ON c.jkey - 5000 = d.dkey;
+
+RESET gp_udpic_dropacks_percent;
+RESET gp_udpic_dropxmit_percent;
+
+-- The senders of every slice counted what they sent, and the dropped
+-- packets were sent again
+SELECT s.packets > b.packets AS sent, s.bytes > b.bytes AS bytes_counted,
+       s.retransmits > b.retransmits AS retransmitted
+  FROM (SELECT sum(packets) AS packets, sum(bytes) AS bytes, sum(retransmits) AS retransmits
+          FROM gp_interconnect_stats) s, stats_before b;
+
+RESET gp_interconnect_shm;
+RESET gp_interconnect_fc_method;
@@ -0,0 +1,37 @@
+-- 
+-- @description Interconnect test case: Motion connections between processes
+-- of the same segment go through shared memory
+-- @tags executor
+-- @gpdb_version [7.0.0,main]
+
+-- Create a table
+CREATE TEMP TABLE shm_table(dkey INT, jkey INT, tval TEXT default 'abcdefghijklmnopqrstuvwxyz') DISTRIBUTED BY (dkey);
+
+-- Generate some data
+INSERT INTO shm_table SELECT i, 10001 - i FROM generate_series(1, 10000) i;
+
+-- Off by default, as it only helps the connections within a segment
+SHOW gp_interconnect_shm;
+SET gp_interconnect_shm = on;
+
+-- Redistribute, to the same segment and to the others
+SELECT COUNT(*), SUM(a.dkey), SUM(length(b.tval))
+  FROM shm_table a JOIN shm_table b ON a.jkey = b.dkey;
+
+-- The receivers stop reading before the end of the streams
+SELECT COUNT(*)
+  FROM (SELECT a.dkey FROM shm_table a JOIN shm_table b ON a.jkey = b.dkey LIMIT 10) foo;
+
+-- The same over the network
+SET gp_interconnect_shm = off;
+
+SELECT COUNT(*), SUM(a.dkey), SUM(length(b.tval))
+  FROM shm_table a JOIN shm_table b ON a.jkey = b.dkey;
+
+-- Only the connections within a segment went through shared memory
+SELECT bool_or(local_bytes > 0) AS local_sent,
+       bool_and(local_bytes = 0 OR receiver = segid) AS only_local,
+       bool_and(local_bytes <= bytes) AS bytes_counted
+  FROM gp_interconnect_stats;
+
+RESET gp_interconnect_shm;
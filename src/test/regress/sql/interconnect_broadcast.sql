@@ -0,0 +1,69 @@
+--
+-- Broadcast Motions pack their chunks once into a buffer shared by all the
+-- receivers.  The rows must come through unchanged, with and without
+-- compression, across many buffers, and EXPLAIN ANALYZE reports the bytes
+-- sent with gp_interconnect_explain_bytes.
+--
+create schema interconnect_broadcast;
+set search_path to interconnect_broadcast;
+
+-- Returns the numbers of the "Interconnect bytes sent" lines of EXPLAIN
+-- ANALYZE, with the kind of the Motion they belong to.  They come from one
+-- segment, so check them rather than print them.
+create function ic_bytes_sent(query text)
+returns table (motion text, bytes bigint, receivers int) as
+$$
+declare
+  explainrow text;
+  m text[];
+begin
+  for explainrow in execute
+    'explain (analyze, costs off, timing off, summary off) ' || query
+  loop
+    m := regexp_match(explainrow, '(\w+) Motion');
+    if m is not null then
+      motion := m[1];
+    end if;
+    m := regexp_match(explainrow,
+                      'Interconnect bytes sent: (\d+) bytes to (\d+) receivers');
+    if m is not null then
+      bytes := m[1]::bigint;
+      receivers := m[2]::int;
+      return next;
+    end if;
+  end loop;
+end;
+$$ language plpgsql;
+
+-- Joining on a column the big table isn't distributed by, broadcasting the
+-- small one is cheaper than redistributing the big one.  Every row of the
+-- small table joins 5 rows of the big one.
+create table ic_bcast_big (a int, b int) distributed by (a);
+create table ic_bcast_small (a int, c text) distributed by (a);
+insert into ic_bcast_big select i, i % 40000 from generate_series(1, 200000) i;
+insert into ic_bcast_small
+  select i, repeat('broadcast ', 10) || i from generate_series(1, 20000) i;
+analyze ic_bcast_big;
+analyze ic_bcast_small;
+
+select count(*), sum(s.a), count(distinct s.c)
+  from ic_bcast_big b join ic_bcast_small s on b.b = s.a;
+
+set gp_interconnect_compression to on;
+select count(*), sum(s.a), count(distinct s.c)
+  from ic_bcast_big b join ic_bcast_small s on b.b = s.a;
+reset gp_interconnect_compression;
+
+set gp_interconnect_explain_bytes to on;
+select motion, bytes > 0 as sent, receivers > 1 as to_all
+  from ic_bytes_sent($$
+    select count(*) from ic_bcast_big b join ic_bcast_small s on b.b = s.a
+  $$) where motion = 'Broadcast';
+
+-- no line without the GUC
+reset gp_interconnect_explain_bytes;
+select count(*) from ic_bytes_sent($$
+    select count(*) from ic_bcast_big b join ic_bcast_small s on b.b = s.a
+  $$);
+
+drop schema interconnect_broadcast cascade;
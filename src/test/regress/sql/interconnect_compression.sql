@@ -0,0 +1,77 @@
+--
+-- Compression of Motion traffic (gp_interconnect_compression).  The rows
+-- must come through unchanged, and EXPLAIN ANALYZE reports the bytes before
+-- and after compression on the Motion.
+--
+create schema interconnect_compression;
+set search_path to interconnect_compression;
+
+-- Returns the numbers of the "Interconnect compression" lines of EXPLAIN
+-- ANALYZE.  They come from one segment, so check them rather than print
+-- them.  Each must be a line of its own.
+create function ic_compression_stats(query text)
+returns table (direction text, raw_bytes bigint, wire_bytes bigint) as
+$$
+declare
+  explainrow text;
+  m text[];
+begin
+  for explainrow in execute
+    'explain (analyze, costs off, timing off, summary off) ' || query
+  loop
+    m := regexp_match(explainrow,
+                      'Interconnect compression: (\d+) bytes (\w+) as (\d+) bytes$');
+    if m is not null then
+      direction := m[2];
+      raw_bytes := m[1]::bigint;
+      wire_bytes := m[3]::bigint;
+      return next;
+    end if;
+  end loop;
+end;
+$$ language plpgsql;
+
+create table ic_compress (a int, b text) distributed by (a);
+insert into ic_compress
+  select i, repeat('compressible ', 20) || (i % 10) from generate_series(1, 20000) i;
+analyze ic_compress;
+
+-- The same rows, gathered and redistributed without compression.  An
+-- ordered string_agg() can't be computed in two stages, so all the rows go
+-- through the Motions.
+create table ic_reference (k int, s text) distributed by (k);
+insert into ic_reference
+  select -1, string_agg(b, ',' order by a) from ic_compress;
+insert into ic_reference
+  select a % 7, string_agg(b, ',' order by a) from ic_compress group by 1;
+
+set gp_interconnect_compression to on;
+
+select string_agg(b, ',' order by a) = (select s from ic_reference where k = -1) as same
+  from ic_compress;
+select count(*) from (
+  select a % 7, string_agg(b, ',' order by a) from ic_compress group by 1
+  except
+  select k, s from ic_reference where k >= 0) d;
+
+select bool_and(raw_bytes > wire_bytes) as compressed,
+       bool_and(direction in ('sent', 'received')) as direction_ok
+  from ic_compression_stats($$ select * from ic_compress $$);
+
+-- the line ends before the bytes sent that follow it
+set gp_interconnect_explain_bytes to on;
+select bool_and(raw_bytes > wire_bytes) as compressed
+  from ic_compression_stats($$ select * from ic_compress $$);
+reset gp_interconnect_explain_bytes;
+
+-- "auto" keeps compressing data that shrinks
+set gp_interconnect_compression to auto;
+select bool_and(raw_bytes > wire_bytes) as compressed
+  from ic_compression_stats($$ select * from ic_compress $$);
+
+-- no line without compression
+set gp_interconnect_compression to off;
+select count(*) from ic_compression_stats($$ select * from ic_compress $$);
+
+reset gp_interconnect_compression;
+drop schema interconnect_compression cascade;
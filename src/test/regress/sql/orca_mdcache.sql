@@ -0,0 +1,47 @@
+--
+-- ORCA metadata cache (optimizer_metadata_caching).  A catalog change evicts
+-- the cached metadata of the objects it touched.  The metadata of a
+-- partitioned table is partly derived from its partitions, so a change to a
+-- partition evicts the metadata of its ancestors too.
+--
+create schema orca_mdcache;
+set search_path to orca_mdcache;
+
+-- Does ORCA plan the query with a Dynamic Index Scan?  ORCA doesn't use
+-- one when a partition is append-optimized.
+create function mc_dynamic_index_scan(query text) returns bool as
+$$
+declare
+  line text;
+begin
+  set local optimizer to on;
+  set local optimizer_enable_tablescan to off;
+  set local optimizer_enable_bitmapscan to off;
+  for line in execute 'explain (costs off) ' || query loop
+    if line ~ 'Dynamic Index Scan' then
+      return true;
+    end if;
+  end loop;
+  return false;
+end;
+$$ language plpgsql;
+
+create table mc_r (a int, b int) distributed by (a)
+  partition by range (b) (start (0) end (20) every (10));
+create index mc_r_b on mc_r (b);
+insert into mc_r select i, i % 20 from generate_series(1, 100) i;
+analyze mc_r;
+
+set optimizer_metadata_caching to on;
+
+select mc_dynamic_index_scan('select * from mc_r where b = 5');
+
+-- changing the access method of a partition only invalidates the partition
+alter table mc_r_1_prt_2 set access method ao_row;
+select mc_dynamic_index_scan('select * from mc_r where b = 5');
+
+alter table mc_r_1_prt_2 set access method heap;
+select mc_dynamic_index_scan('select * from mc_r where b = 5');
+
+reset optimizer_metadata_caching;
+drop schema orca_mdcache cascade;
@@ -0,0 +1,78 @@
+--
+-- ORCA plan cache (optimizer_plan_caching).  A query hits the cache when it
+-- is optimized again with the same settings and metadata, and misses it
+-- after any setting changed, or after the metadata it depends on was
+-- invalidated.  The cache evicts plans to stay under
+-- optimizer_plan_cache_size.
+--
+create schema orca_plan_cache;
+set search_path to orca_plan_cache;
+
+-- Optimizes a query with ORCA, and returns what that did to the counters
+-- of the plan cache.  The counters are read with the Postgres planner, so
+-- that reading them doesn't count.
+create function pc_run(query text)
+returns table (hit bool, miss bool, evicted bool, invalidated bool) as
+$$
+declare
+  before record;
+  after record;
+begin
+  select * into before from gp_opt_plan_cache;
+  set local optimizer to on;
+  execute query;
+  set local optimizer to off;
+  select * into after from gp_opt_plan_cache;
+
+  hit := after.hits > before.hits;
+  miss := after.misses > before.misses;
+  evicted := after.evictions > before.evictions;
+  invalidated := after.invalidations + after.resets >
+                 before.invalidations + before.resets;
+  return next;
+end;
+$$ language plpgsql set optimizer to off;
+
+create table pc_t (a int, b int) distributed by (a);
+insert into pc_t select i, i from generate_series(1, 100) i;
+analyze pc_t;
+
+set optimizer_plan_caching to on;
+
+-- miss, then hit
+select * from pc_run('select count(*) from pc_t where a < 10');
+select * from pc_run('select count(*) from pc_t where a < 10');
+
+-- another query misses
+select * from pc_run('select count(*) from pc_t where a < 20');
+
+-- a setting ORCA doesn't get in its configuration is part of the key too
+set random_page_cost to 10;
+select * from pc_run('select count(*) from pc_t where a < 10');
+reset random_page_cost;
+select * from pc_run('select count(*) from pc_t where a < 10');
+
+-- a change of the table invalidates its plans
+create index pc_t_b on pc_t (b);
+select * from pc_run('select count(*) from pc_t where a < 10');
+select * from pc_run('select count(*) from pc_t where a < 10');
+
+-- a change of a partition invalidates the plans of its partitioned table
+create table pc_r (a int, b int) distributed by (a)
+  partition by range (b) (start (0) end (20) every (10));
+insert into pc_r select i, i % 20 from generate_series(1, 100) i;
+analyze pc_r;
+select * from pc_run('select count(*) from pc_r join pc_t using (a)');
+select * from pc_run('select count(*) from pc_r join pc_t using (a)');
+alter table pc_r_1_prt_2 set access method ao_row;
+select * from pc_run('select count(*) from pc_r join pc_t using (a)');
+
+-- a cache smaller than a plan keeps only the plan it just added
+set optimizer_plan_cache_size to 1;
+select * from pc_run('select count(*) from pc_t where a < 30');
+select * from pc_run('select count(*) from pc_t where a < 40');
+select * from pc_run('select count(*) from pc_t where a < 30');
+reset optimizer_plan_cache_size;
+
+reset optimizer_plan_caching;
+drop schema orca_plan_cache cascade;
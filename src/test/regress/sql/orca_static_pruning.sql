@@ -149,3 +149,34 @@ INSERT INTO rp_insert VALUES (1, 1), (3, 3);
 EXPLAIN (COSTS OFF, VERBOSE) INSERT INTO rp_insert SELECT * FROM rp_insert;
 INSERT INTO rp_insert SELECT * FROM rp_insert;
 SELECT * FROM rp_insert;
+
+-- The part constraints of the partitions are kept on the root, so that only
+-- the partitions that survive static pruning are looked up. The dropped
+-- column of the root puts its columns at other attnos than those of the
+-- partitions.
+CREATE TABLE rp_lazy (x int, a int, b int) DISTRIBUTED BY (a) PARTITION BY RANGE (b);
+ALTER TABLE rp_lazy DROP COLUMN x;
+CREATE TABLE rp_lazy0 PARTITION OF rp_lazy FOR VALUES FROM (0) TO (10);
+CREATE TABLE rp_lazy1 PARTITION OF rp_lazy FOR VALUES FROM (10) TO (20);
+CREATE TABLE rp_lazy2 PARTITION OF rp_lazy FOR VALUES FROM (20) TO (30);
+INSERT INTO rp_lazy VALUES (1, 1), (11, 11), (21, 21), (22, 22);
+
+SET optimizer_trace_fallback TO on;
+EXPLAIN (COSTS OFF, VERBOSE) SELECT * FROM rp_lazy WHERE b > 20;
+SELECT * FROM rp_lazy WHERE b > 20 ORDER BY a;
+
+-- Multi-level partitioning. ORCA doesn't plan the root, but plans its
+-- partitioned partition, whose part constraints also hold the bound of the
+-- partition itself.
+CREATE TABLE mlp (a int, b int, c int) DISTRIBUTED BY (a) PARTITION BY RANGE (b);
+CREATE TABLE mlp0 PARTITION OF mlp FOR VALUES FROM (0) TO (10) PARTITION BY LIST (c);
+CREATE TABLE mlp0_0 PARTITION OF mlp0 FOR VALUES IN (0);
+CREATE TABLE mlp0_1 PARTITION OF mlp0 FOR VALUES IN (1);
+CREATE TABLE mlp1 PARTITION OF mlp FOR VALUES FROM (10) TO (20);
+INSERT INTO mlp VALUES (1, 1, 0), (2, 2, 1), (11, 11, 1);
+
+EXPLAIN (COSTS OFF, VERBOSE) SELECT * FROM mlp WHERE b < 10 AND c = 1;
+SELECT * FROM mlp WHERE b < 10 AND c = 1;
+EXPLAIN (COSTS OFF, VERBOSE) SELECT * FROM mlp0 WHERE c = 1;
+SELECT * FROM mlp0 WHERE c = 1;
+RESET optimizer_trace_fallback;